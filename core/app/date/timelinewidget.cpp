@@ -572,6 +572,7 @@ void TimeLineWidget::slotDatesMap(const QMap<QDateTime, int>& datesStatMap)
     }
 
     // Parse all new Date stamp and store histogram stats relevant in maps.
+    // The map holds one entry per day, already counted by the database, and is sorted by date.
 
     int count;
     QMap<QDateTime, int>::const_iterator it;
@@ -583,22 +584,12 @@ void TimeLineWidget::slotDatesMap(const QMap<QDateTime, int>& datesStatMap)
     }
     else
     {
-        d->minDateTime = datesStatMap.begin().key();
-        d->maxDateTime = datesStatMap.begin().key();
+        d->minDateTime = datesStatMap.firstKey();
+        d->maxDateTime = datesStatMap.lastKey();
     }
 
     for (it = datesStatMap.begin(); it != datesStatMap.end(); ++it)
     {
-        if (it.key() > d->maxDateTime)
-        {
-            d->maxDateTime = it.key();
-        }
-
-        if (it.key() < d->minDateTime)
-        {
-            d->minDateTime = it.key();
-        }
-
         int year  = it.key().date().year();
         int month = it.key().date().month();
         int day   = it.key().date().dayOfYear();
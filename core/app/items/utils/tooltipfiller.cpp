@@ -46,6 +46,7 @@
 #include "ditemtooltip.h"
 #include "filteraction.h"
 #include "iteminfo.h"
+#include "iteminfolist.h"
 #include "itempropertiestab.h"
 #include "colorlabelwidget.h"
 #include "picklabelwidget.h"
@@ -61,6 +62,15 @@ QString ToolTipFiller::imageInfoTipContents(const ItemInfo& info)
     ApplicationSettings* const settings = ApplicationSettings::instance();
     DToolTipStyleSheet   cnt(settings->getToolTipsFont());
 
+    // Read the item properties shown below with one query per table, instead of one per property.
+
+    DatabaseFields::Set fields;
+    fields |= DatabaseFields::Comment;
+    fields |= DatabaseFields::Rating | DatabaseFields::PickLabel | DatabaseFields::ColorLabel;
+    fields |= DatabaseFields::ImageMetadataAll;
+    fields |= DatabaseFields::VideoMetadataAll;
+    ItemInfoList(QList<ItemInfo>() << info).loadFields(fields);
+
     ImageCommonContainer commonInfo     = info.imageCommonContainer();
     ImageMetadataContainer photoInfo    = info.imageMetadataContainer();
     VideoMetadataContainer videoInfo    = info.videoMetadataContainer();
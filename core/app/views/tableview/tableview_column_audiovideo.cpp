@@ -117,6 +117,40 @@ TableViewColumn::ColumnFlags ColumnAudioVideoProperties::getColumnFlags() const
     return flags;
 }
 
+DatabaseFields::Set ColumnAudioVideoProperties::getDatabaseFields() const
+{
+    DatabaseFields::Set fields;
+
+    switch (subColumn)
+    {
+        case SubColumnAudioBitRate:
+            fields |= DatabaseFields::AudioBitRate;
+            break;
+
+        case SubColumnAudioChannelType:
+            fields |= DatabaseFields::AudioChannelType;
+            break;
+
+        case SubColumnAudioCodec:
+            fields |= DatabaseFields::AudioCodec;
+            break;
+
+        case SubColumnDuration:
+            fields |= DatabaseFields::Duration;
+            break;
+
+        case SubColumnFrameRate:
+            fields |= DatabaseFields::FrameRate;
+            break;
+
+        case SubColumnVideoCodec:
+            fields |= DatabaseFields::VideoCodec;
+            break;
+    }
+
+    return fields;
+}
+
 QVariant ColumnAudioVideoProperties::data(TableViewModel::Item* const item, const int role) const
 {
     if (role != Qt::DisplayRole)
@@ -115,6 +115,33 @@ TableViewColumn::ColumnFlags ColumnDigikamProperties::getColumnFlags() const
     return flags;
 }
 
+DatabaseFields::Set ColumnDigikamProperties::getDatabaseFields() const
+{
+    DatabaseFields::Set fields;
+
+    switch (subColumn)
+    {
+        case SubColumnRating:
+            fields |= DatabaseFields::Rating;
+            break;
+
+        case SubColumnPickLabel:
+            fields |= DatabaseFields::PickLabel;
+            break;
+
+        case SubColumnColorLabel:
+            fields |= DatabaseFields::ColorLabel;
+            break;
+
+        case SubColumnTitle:
+        case SubColumnCaption:
+            fields |= DatabaseFields::Comment;
+            break;
+    }
+
+    return fields;
+}
+
 QVariant ColumnDigikamProperties::data(TableViewModel::Item* const item, const int role) const
 {
     if ( (role != Qt::DisplayRole)       &&
@@ -66,6 +66,7 @@ public:
     virtual ColumnFlags getColumnFlags() const;
     virtual QVariant data(TableViewModel::Item* const item, const int role) const;
     virtual ColumnCompareResult compare(TableViewModel::Item* const itemA, TableViewModel::Item* const itemB) const;
+    virtual DatabaseFields::Set getDatabaseFields() const;
     virtual bool columnAffectedByChangeset(const ImageChangeset& imageChangeset) const;
 
     static TableViewColumnDescription getDescription();
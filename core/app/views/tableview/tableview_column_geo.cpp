@@ -122,6 +122,11 @@ TableViewColumn::ColumnFlags ColumnGeoProperties::getColumnFlags() const
 
     return flags;
 }
+DatabaseFields::Set ColumnGeoProperties::getDatabaseFields() const
+{
+    return DatabaseFields::Set(DatabaseFields::ItemPositionsAll);
+}
+
 QVariant ColumnGeoProperties::data(TableViewModel::Item* const item, const int role) const
 {
     if ( (role != Qt::DisplayRole) &&
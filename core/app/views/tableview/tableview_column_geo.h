@@ -64,6 +64,7 @@ public:
     virtual ColumnFlags getColumnFlags() const;
     virtual QVariant data(TableViewModel::Item* const item, const int role) const;
     virtual ColumnCompareResult compare(TableViewModel::Item* const itemA, TableViewModel::Item* const itemB) const;
+    virtual DatabaseFields::Set getDatabaseFields() const;
     virtual TableViewColumnConfigurationWidget* getConfigurationWidget(QWidget* const parentWidget) const;
     virtual void setConfiguration(const TableViewColumnConfiguration& newConfiguration);
 
@@ -140,6 +140,32 @@ TableViewColumn::ColumnFlags ColumnItemProperties::getColumnFlags() const
     return flags;
 }
 
+DatabaseFields::Set ColumnItemProperties::getDatabaseFields() const
+{
+    DatabaseFields::Set fields;
+
+    switch (subColumn)
+    {
+        case SubColumnWidth:
+        case SubColumnHeight:
+        case SubColumnDimensions:
+        case SubColumnPixelCount:
+        case SubColumnAspectRatio:
+            fields |= DatabaseFields::Width | DatabaseFields::Height;
+            break;
+
+        case SubColumnCreationDateTime:
+            fields |= DatabaseFields::CreationDate;
+            break;
+
+        default:
+            // Other properties are read from the common container.
+            break;
+    }
+
+    return fields;
+}
+
 QVariant ColumnItemProperties::data(TableViewModel::Item* const item, const int role) const
 {
     if ( (role != Qt::DisplayRole) &&
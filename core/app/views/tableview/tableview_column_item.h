@@ -70,6 +70,7 @@ public:
     virtual ColumnFlags getColumnFlags() const;
     virtual QVariant data(TableViewModel::Item* const item, const int role) const;
     virtual ColumnCompareResult compare(TableViewModel::Item* const itemA, TableViewModel::Item* const itemB) const;
+    virtual DatabaseFields::Set getDatabaseFields() const;
 
     static TableViewColumnDescription getDescription();
     static QStringList getSubColumns();
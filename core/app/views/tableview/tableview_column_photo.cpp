@@ -139,6 +139,56 @@ TableViewColumn::ColumnFlags ColumnPhotoProperties::getColumnFlags() const
     return flags;
 }
 
+DatabaseFields::Set ColumnPhotoProperties::getDatabaseFields() const
+{
+    DatabaseFields::Set fields;
+
+    switch (subColumn)
+    {
+        case SubColumnCameraMaker:
+            fields |= DatabaseFields::Make;
+            break;
+
+        case SubColumnCameraModel:
+            fields |= DatabaseFields::Model;
+            break;
+
+        case SubColumnLens:
+            fields |= DatabaseFields::Lens;
+            break;
+
+        case SubColumnAperture:
+            fields |= DatabaseFields::Aperture;
+            break;
+
+        case SubColumnFocal:
+            fields |= DatabaseFields::FocalLength | DatabaseFields::FocalLength35;
+            break;
+
+        case SubColumnExposure:
+            fields |= DatabaseFields::ExposureTime;
+            break;
+
+        case SubColumnSensitivity:
+            fields |= DatabaseFields::Sensitivity;
+            break;
+
+        case SubColumnModeProgram:
+            fields |= DatabaseFields::ExposureMode | DatabaseFields::ExposureProgram;
+            break;
+
+        case SubColumnFlash:
+            fields |= DatabaseFields::FlashMode;
+            break;
+
+        case SubColumnWhiteBalance:
+            fields |= DatabaseFields::WhiteBalance;
+            break;
+    }
+
+    return fields;
+}
+
 QVariant ColumnPhotoProperties::data(TableViewModel::Item* const item, const int role) const
 {
     if (role != Qt::DisplayRole)
@@ -29,6 +29,8 @@
 
 // Qt includes
 
+#include <QHash>
+#include <QSet>
 #include <QTimer>
 
 // Local includes
@@ -42,6 +44,7 @@
 #include "itemfiltermodel.h"
 #include "itemfiltersettings.h"
 #include "iteminfo.h"
+#include "iteminfolist.h"
 #include "tableview_columnfactory.h"
 #include "tableview_selection_model_syncer.h"
 
@@ -124,6 +127,46 @@ public:
     {
     }
 
+    void addToIndex(TableViewModel::Item* const item)
+    {
+        itemsByImageId.insert(item->imageId, item);
+    }
+
+    /// Remove the item and all its sub-items from the image id index
+    void removeFromIndex(TableViewModel::Item* const item)
+    {
+        QList<TableViewModel::Item*> itemsToRemove;
+        itemsToRemove << item;
+
+        while (!itemsToRemove.isEmpty())
+        {
+            TableViewModel::Item* const itemToRemove = itemsToRemove.takeFirst();
+            itemsToRemove << itemToRemove->children;
+
+            QHash<qlonglong, TableViewModel::Item*>::iterator it = itemsByImageId.find(itemToRemove->imageId);
+
+            if ((it != itemsByImageId.end()) && (it.value() == itemToRemove))
+            {
+                itemsByImageId.erase(it);
+            }
+        }
+    }
+
+    /// Read the database fields shown by the columns for all given items, with a few queries
+    void loadColumnsFields(const QList<ItemInfo>& infos, const QList<TableViewColumn*>& columns) const
+    {
+        DatabaseFields::Set fields;
+
+        foreach (TableViewColumn* const column, columns)
+        {
+            fields.setFields(column->getDatabaseFields());
+        }
+
+        ItemInfoList(infos).loadFields(fields);
+    }
+
+public:
+
     QList<TableViewColumn*>     columnObjects;
     TableViewModel::Item*       rootItem;
     ItemFilterSettings         imageFilterSettings;
@@ -133,6 +176,9 @@ public:
     GroupingMode                groupingMode;
     QHash<qlonglong, ItemInfo> cachedItemInfos;
     bool                        outdated;
+
+    /// All items of the tree by image id, to find an item without walking the tree
+    QHash<qlonglong, TableViewModel::Item*> itemsByImageId;
 };
 
 TableViewModel::TableViewModel(TableViewShared* const sharedObject, QObject* const parent)
@@ -373,6 +419,11 @@ void TableViewModel::addColumnAt(const TableViewColumnConfiguration& configurati
 
     endInsertColumns();
 
+    if (s->isActive)
+    {
+        d->loadColumnsFields(s->imageModel->imageInfos(), QList<TableViewColumn*>() << newColumn);
+    }
+
     connect(newColumn, SIGNAL(signalDataChanged(qlonglong)),
             this, SLOT(slotColumnDataChanged(qlonglong)));
 
@@ -494,10 +545,17 @@ void TableViewModel::slotSourceRowsInserted(const QModelIndex& parent, int start
         return;
     }
 
+    QList<QModelIndex> sourceIndexes;
+
     for (int i = start ; i <= end ; ++i)
     {
-        const QModelIndex sourceIndex = s->imageModel->index(i, 0, parent);
+        sourceIndexes << s->imageModel->index(i, 0, parent);
+    }
+
+    d->loadColumnsFields(s->imageModel->imageInfos(sourceIndexes), d->columnObjects);
 
+    foreach (const QModelIndex& sourceIndex, sourceIndexes)
+    {
         addSourceModelIndex(sourceIndex, true);
     }
 }
@@ -532,6 +590,7 @@ void TableViewModel::slotSourceRowsAboutToBeRemoved(const QModelIndex& parent, i
 
         beginRemoveRows(tableViewIndex.parent(), tableViewIndex.row(), tableViewIndex.row());
         item->parent->takeChild(item);
+        d->removeFromIndex(item);
         // delete image info of children from cache
         QList<Item*> itemsToRemoveFromCache = item->children;
 
@@ -641,6 +700,10 @@ void TableViewModel::slotDatabaseImageChanged(const ImageChangeset& imageChanges
         needToResort                            = sortColumnObject->columnAffectedByChangeset(imageChangeset);
     }
 
+    // Items whose data changed, per parent item. The views are notified
+    // once per parent for the range of rows covering all changed items.
+    QHash<Item*, QSet<Item*> > changedItems;
+
     foreach (const qlonglong& id, imageChangeset.ids())
     {
         // first clear the item's cached values
@@ -678,20 +741,20 @@ void TableViewModel::slotDatabaseImageChanged(const ImageChangeset& imageChanges
         }
 
         // Re-check filtering for this item.
-        const QModelIndex changedIndexTopLeft = indexFromImageId(id, 0);
-
-        if (!changedIndexTopLeft.isValid())
-        {
-            continue;
-        }
-
-        const ItemInfo myItemInfo = imageInfo(changedIndexTopLeft);
+        const ItemInfo myItemInfo = infoFromItem(item);
 
         if (!d->imageFilterSettings.matches(myItemInfo))
         {
             // Filter does not match, remove the item.
-            beginRemoveRows(changedIndexTopLeft.parent(), changedIndexTopLeft.row(), changedIndexTopLeft.row());
+            const QModelIndex removedIndex = itemIndex(item);
+
+            // The item or its sub-items may have been changed too.
+            changedItems.remove(item);
+            changedItems[item->parent].remove(item);
+
+            beginRemoveRows(removedIndex.parent(), removedIndex.row(), removedIndex.row());
             item->parent->takeChild(item);
+            d->removeFromIndex(item);
             delete item;
             endRemoveRows();
 
@@ -703,15 +766,53 @@ void TableViewModel::slotDatabaseImageChanged(const ImageChangeset& imageChanges
         // only update now if we do not resort later anyway
         if (!needToResort)
         {
-            const QModelIndex changedIndexBottomRight = index(changedIndexTopLeft.row(),
-                                                              columnCount(changedIndexTopLeft.parent())-1,
-                                                              changedIndexTopLeft.parent());
+            changedItems[item->parent].insert(item);
+        }
+    }
+
+    for (QHash<Item*, QSet<Item*> >::const_iterator it = changedItems.constBegin() ;
+         it != changedItems.constEnd() ; ++it)
+    {
+        Item* const parentItem          = it.key();
+        const QSet<Item*>& itemsInParent = it.value();
+
+        if (itemsInParent.isEmpty())
+        {
+            continue;
+        }
+
+        // One walk through the children gives the rows of all changed items.
+        int firstRow = -1;
+        int lastRow  = -1;
+        int found    = 0;
 
-            if (changedIndexBottomRight.isValid())
+        for (int row = 0 ; (row < parentItem->children.count()) && (found < itemsInParent.count()) ; ++row)
+        {
+            if (itemsInParent.contains(parentItem->children.at(row)))
             {
-                emit(dataChanged(changedIndexTopLeft, changedIndexBottomRight));
+                if (firstRow == -1)
+                {
+                    firstRow = row;
+                }
+
+                lastRow = row;
+                ++found;
             }
         }
+
+        if (firstRow == -1)
+        {
+            continue;
+        }
+
+        const QModelIndex parentIndex             = itemIndex(parentItem);
+        const QModelIndex changedIndexTopLeft     = index(firstRow, 0, parentIndex);
+        const QModelIndex changedIndexBottomRight = index(lastRow, columnCount(parentIndex)-1, parentIndex);
+
+        if (changedIndexTopLeft.isValid() && changedIndexBottomRight.isValid())
+        {
+            emit(dataChanged(changedIndexTopLeft, changedIndexBottomRight));
+        }
     }
 
     if (needToResort)
@@ -764,6 +865,7 @@ void TableViewModel::slotClearModel(const bool sendNotifications)
 
     d->rootItem = new Item();
     d->cachedItemInfos.clear();
+    d->itemsByImageId.clear();
 
     if (sendNotifications)
     {
@@ -791,11 +893,14 @@ void TableViewModel::slotPopulateModel(const bool sendNotifications)
 
     d->rootItem     = new Item();
     d->cachedItemInfos.clear();
+    d->itemsByImageId.clear();
     d->outdated     = false;
     d->sortRequired = false;
 
     const int sourceRowCount = s->imageModel->rowCount(QModelIndex());
 
+    d->loadColumnsFields(s->imageModel->imageInfos(), d->columnObjects);
+
     for (int i = 0 ; i < sourceRowCount ; ++i)
     {
         const QModelIndex sourceModelIndex = s->imageModel->index(i, 0);
@@ -872,6 +977,7 @@ void TableViewModel::addSourceModelIndex(const QModelIndex& imageModelIndex, con
     }
 
     parentItem->insertChild(newRowIndex, item);
+    d->addToIndex(item);
 
     if (sendNotifications)
     {
@@ -908,6 +1014,7 @@ void TableViewModel::addSourceModelIndex(const QModelIndex& imageModelIndex, con
             }
 
             item->insertChild(newRowIndex, groupedItem);
+            d->addToIndex(groupedItem);
         }
 
         if (sendNotifications)
@@ -919,7 +1026,7 @@ void TableViewModel::addSourceModelIndex(const QModelIndex& imageModelIndex, con
 
 TableViewModel::Item* TableViewModel::itemFromImageId(const qlonglong imageId) const
 {
-    return d->rootItem->findChildWithImageId(imageId);
+    return d->itemsByImageId.value(imageId);
 }
 
 TableViewModel::Item* TableViewModel::itemFromIndex(const QModelIndex& i) const
@@ -1034,8 +1141,7 @@ QModelIndex TableViewModel::indexFromImageId(const qlonglong imageId, const int
 
     Item* const parentItem = item->parent;
 
-    /// @todo This is a waste of time because itemFromImageId already did this search.
-    ///       We should modify it to also give the row index.
+    /// @todo Finding the row index is still a linear search in the children of the parent.
     const int rowIndex = parentItem->children.indexOf(item);
 
     return createIndex(rowIndex, columnIndex, item);
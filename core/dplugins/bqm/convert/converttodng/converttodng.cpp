@@ -104,6 +104,12 @@ QString ConvertToDNG::outputSuffix() const
     return QLatin1String("dng");
 }
 
+bool ConvertToDNG::needsInputFile() const
+{
+    // The RAW file is converted by DNGWriter.
+    return true;
+}
+
 void ConvertToDNG::cancel()
 {
     m_dngProcessor.cancel();
@@ -46,6 +46,7 @@ public:
 
     void cancel();
     QString outputSuffix() const;
+    bool needsInputFile() const;
     BatchToolSettings defaultSettings();
 
     BatchTool* clone(QObject* const parent=0) const { return new ConvertToDNG(parent); };
@@ -26,6 +26,7 @@
 // Qt includes
 
 #include <QFileInfo>
+#include <QThread>
 #include <QWidget>
 
 // KDE includes
@@ -69,8 +70,10 @@ BatchToolSettings ConvertToPNG::defaultSettings()
     KSharedConfig::Ptr config = KSharedConfig::openConfig();
     KConfigGroup group        = config->group(QLatin1String("ImageViewer Settings"));
     int compression           = group.readEntry(QLatin1String("PNGCompression"), 9);
+    int threads               = group.readEntry(QLatin1String("PNGEncodingThreads"), QThread::idealThreadCount());
     BatchToolSettings settings;
-    settings.insert(QLatin1String("Quality"), compression);
+    settings.insert(QLatin1String("Quality"),         compression);
+    settings.insert(QLatin1String("EncodingThreads"), threads);
     return settings;
 }
 
@@ -83,6 +86,7 @@ void ConvertToPNG::slotAssignSettings2Widget()
     if (PNGBox)
     {
         PNGBox->setCompressionValue(settings()[QLatin1String("Quality")].toInt());
+        PNGBox->setEncodingThreads(settings()[QLatin1String("EncodingThreads")].toInt());
     }
 
     m_changeSettings = true;
@@ -97,7 +101,8 @@ void ConvertToPNG::slotSettingsChanged()
         if (PNGBox)
         {
             BatchToolSettings settings;
-            settings.insert(QLatin1String("Quality"), PNGBox->getCompressionValue());
+            settings.insert(QLatin1String("Quality"),         PNGBox->getCompressionValue());
+            settings.insert(QLatin1String("EncodingThreads"), PNGBox->getEncodingThreads());
             BatchTool::slotSettingsChanged(settings);
         }
     }
@@ -116,7 +121,8 @@ bool ConvertToPNG::toolOperations()
     }
 
     int PNGCompression = PNGSettings::convertCompressionForLibPng(settings()[QLatin1String("Quality")].toInt());
-    image().setAttribute(QLatin1String("quality"), PNGCompression);
+    image().setAttribute(QLatin1String("quality"),         PNGCompression);
+    image().setAttribute(QLatin1String("encodingThreads"), settings()[QLatin1String("EncodingThreads")].toInt());
 
     return (savefromDImg());
 }
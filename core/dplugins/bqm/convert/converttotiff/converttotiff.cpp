@@ -26,6 +26,7 @@
 // Qt includes
 
 #include <QFileInfo>
+#include <QThread>
 #include <QWidget>
 
 // KDE includes
@@ -69,8 +70,10 @@ BatchToolSettings ConvertToTIFF::defaultSettings()
     KSharedConfig::Ptr config = KSharedConfig::openConfig();
     KConfigGroup group        = config->group(QLatin1String("ImageViewer Settings"));
     bool compression          = group.readEntry(QLatin1String("TIFFCompression"), false);
+    int threads               = group.readEntry(QLatin1String("TIFFEncodingThreads"), QThread::idealThreadCount());
     BatchToolSettings settings;
-    settings.insert(QLatin1String("Quality"), compression);
+    settings.insert(QLatin1String("Quality"),         compression);
+    settings.insert(QLatin1String("EncodingThreads"), threads);
     return settings;
 }
 
@@ -83,6 +86,7 @@ void ConvertToTIFF::slotAssignSettings2Widget()
     if (TIFBox)
     {
         TIFBox->setCompression(settings()[QLatin1String("compress")].toBool());
+        TIFBox->setEncodingThreads(settings()[QLatin1String("EncodingThreads")].toInt());
     }
 
     m_changeSettings = true;
@@ -97,7 +101,8 @@ void ConvertToTIFF::slotSettingsChanged()
         if (TIFBox)
         {
             BatchToolSettings settings;
-            settings.insert(QLatin1String("compress"), TIFBox->getCompression());
+            settings.insert(QLatin1String("compress"),        TIFBox->getCompression());
+            settings.insert(QLatin1String("EncodingThreads"), TIFBox->getEncodingThreads());
             BatchTool::slotSettingsChanged(settings);
         }
     }
@@ -115,7 +120,8 @@ bool ConvertToTIFF::toolOperations()
         return false;
     }
 
-    image().setAttribute(QLatin1String("compress"), settings()[QLatin1String("compress")].toBool());
+    image().setAttribute(QLatin1String("compress"),        settings()[QLatin1String("compress")].toBool());
+    image().setAttribute(QLatin1String("encodingThreads"), settings()[QLatin1String("EncodingThreads")].toInt());
 
     return (savefromDImg());
 }
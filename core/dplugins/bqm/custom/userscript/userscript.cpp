@@ -186,6 +186,12 @@ QString UserScript::outputSuffix () const
     return (BatchTool::outputSuffix());
 }
 
+bool UserScript::needsInputFile() const
+{
+    // The script gets the input file name.
+    return true;
+}
+
 bool UserScript::toolOperations()
 {
     QString script = settings()[QLatin1String("Script")].toString();
@@ -44,6 +44,7 @@ public:
     ~UserScript();
 
     QString outputSuffix() const;
+    bool needsInputFile() const;
 
     BatchToolSettings defaultSettings();
 
@@ -27,7 +27,6 @@
 
 #include <QLabel>
 #include <QWidget>
-#include <QFile>
 
 // KDE includes
 
@@ -109,16 +108,9 @@ bool AssignTemplate::toolOperations()
 {
     DMetadata meta;
 
-    if (image().isNull())
+    if (!loadMetadata(meta))
     {
-        if (!meta.load(inputUrl().toLocalFile()))
-        {
-            return false;
-        }
-    }
-    else
-    {
-        meta.setData(image().getMetadata());
+        return false;
     }
 
     QString title = settings()[QLatin1String("TemplateTitle")].toString();
@@ -138,29 +130,7 @@ bool AssignTemplate::toolOperations()
         meta.setMetadataTemplate(t);
     }
 
-    bool ret = true;
-
-    if (image().isNull())
-    {
-        QFile::remove(outputUrl().toLocalFile());
-        ret = QFile::copy(inputUrl().toLocalFile(), outputUrl().toLocalFile());
-
-        if (ret && !title.isEmpty())
-        {
-            ret = meta.save(outputUrl().toLocalFile());
-        }
-    }
-    else
-    {
-        if (!title.isEmpty())
-        {
-            image().setMetadata(meta.data());
-        }
-
-        ret = savefromDImg();
-    }
-
-    return ret;
+    return saveMetadata(meta, !title.isEmpty());
 }
 
 } // namespace DigikamBqmAssignTemplatePlugin
@@ -119,15 +119,20 @@ bool RemoveMetadata::toolOperations()
         return false;
     }
 
-    bool ret = true;
+    bool ret     = true;
+    bool pending = false;
     DMetadata meta;
 
     if (image().isNull())
     {
+        // Metadata changed by the previous tools of the chain is not written to disk yet.
+        pending = hasPendingMetadata();
+
         QFile::remove(outputUrl().toLocalFile());
         ret = QFile::copy(inputUrl().toLocalFile(), outputUrl().toLocalFile());
 
-        if (!ret || !meta.load(outputUrl().toLocalFile()))
+        // The metadata pending from previous tools, or the one of the copied file.
+        if (!ret || !loadMetadata(meta))
         {
             return ret;
         }
@@ -163,7 +168,7 @@ bool RemoveMetadata::toolOperations()
         meta.removeXmpTags(QStringList() << QLatin1String("video"));
     }
 
-    if (ret && (removeExif || removeIptc || removeXmp || removeXmpVideo))
+    if (ret && (pending || removeExif || removeIptc || removeXmp || removeXmpVideo))
     {
         ret = meta.save(outputUrl().toLocalFile());
     }
@@ -23,19 +23,10 @@
 
 #include "timeadjust.h"
 
-// C ANSI includes
-
-extern "C"
-{
-#include <unistd.h>
-#include <utime.h>
-}
-
 // Qt includes
 
 #include <QLabel>
 #include <QWidget>
-#include <QFile>
 
 // KDE includes
 
@@ -44,6 +35,7 @@ extern "C"
 // Local includes
 
 #include "dimg.h"
+#include "dfileoperations.h"
 #include "dlayoutbox.h"
 #include "dmetadata.h"
 
@@ -172,17 +164,8 @@ void TimeAdjust::slotSettingsChanged()
 
 bool TimeAdjust::toolOperations()
 {
-    bool metaLoadState = true;
     DMetadata meta;
-
-    if (image().isNull())
-    {
-        metaLoadState = meta.load(inputUrl().toLocalFile());
-    }
-    else
-    {
-        meta.setData(image().getMetadata());
-    }
+    bool metaLoadState = loadMetadata(meta);
 
     TimeAdjustContainer prm;
 
@@ -419,50 +402,19 @@ bool TimeAdjust::toolOperations()
         }
     }
 
-    bool ret = true;
+    bool ret = saveMetadata(meta, metadataChanged && metaLoadState);
 
-    if (image().isNull())
-    {
-        QFile::remove(outputUrl().toLocalFile());
-        ret = QFile::copy(inputUrl().toLocalFile(), outputUrl().toLocalFile());
-
-        if (ret && metadataChanged && metaLoadState)
-        {
-            ret = meta.save(outputUrl().toLocalFile());
-        }
-    }
-    else
+    if (ret && prm.updFileModDate)
     {
-        if (metadataChanged)
+        if (isLastChainedTool())
         {
-            image().setMetadata(meta.data());
+            ret = DFileOperations::setModificationTime(outputUrl().toLocalFile(), dt);
+            setPendingFileDate(QDateTime());
         }
-
-        ret = savefromDImg();
-    }
-
-    if (ret && prm.updFileModDate)
-    {
-        // Since QFileInfo does not support timestamp updates,
-        // we have to use the utime() system call.
-
-        int modtime;
-        QDateTime unixDate;
-        unixDate.setDate(QDate(1970, 1, 1));
-        unixDate.setTime(QTime(0, 0, 0, 0));
-
-        if (dt < unixDate)
-            modtime = -(dt.secsTo(unixDate) + (60 * 60));
         else
-            modtime = dt.toTime_t();
-
-        struct utimbuf ut;
-        ut.modtime = modtime;
-        ut.actime  = QDateTime::currentDateTime().toTime_t();
-
-        if (::utime(QFile::encodeName(outputUrl().toLocalFile()).constData(), &ut) != 0)
         {
-            ret = false;
+            // Nothing is written yet: the date is applied once the last tool wrote the file.
+            setPendingFileDate(dt);
         }
     }
 
@@ -0,0 +1,474 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-09
+ * Description : a disk cache of transcoded previews served by
+ *               the DLNA media server.
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "dlnapreviewcache.h"
+
+// C++ includes
+
+#include <algorithm>
+#include <climits>
+
+// Qt includes
+
+#include <QtConcurrent>    // krazy:exclude=includes
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "previewloadthread.h"
+#include "dimg.h"
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN DLNAPreviewCache::Private
+{
+public:
+
+    struct Entry
+    {
+        Entry()
+          : size(0),
+            lastAccess(0)
+        {
+        }
+
+        qint64 size;
+        qint64 lastAccess;
+    };
+
+    enum TranscodeResult
+    {
+        Transcoded = 0,
+        NotAnImage,     ///< The file cannot be decoded, it is served as is.
+        WriteError      ///< The preview cannot be stored, as with a full disk. It is tried again next time.
+    };
+
+public:
+
+    explicit Private()
+      : previewSize(2048),
+        maxCacheSize(0),
+        cacheSize(0),
+        accessCounter(0),
+        prefetchGeneration(0),
+        cancel(false)
+    {
+        // Transcoding is CPU and memory bound: a few threads are enough to stay ahead of a renderer.
+        pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+    }
+
+    QString key(const QFileInfo& info) const;
+    QString cacheFilePath(const QString& key) const;
+
+    /// Scan the cache directory to rebuild the index of entries.
+    void    loadIndex();
+
+    /// Remove the least recently used entries until the cache fits in 90% of its maximum size. Call with mutex locked.
+    void    prune();
+
+    /// Transcode the image to the cache file.
+    TranscodeResult transcode(const QString& filePath, const QString& cachePath);
+
+    /// Return the path of the preview of the image, transcoding it if needed.
+    /// If pin is true, the preview is not removed from the cache until release() is called.
+    QString preview(const QString& filePath, bool pin);
+
+    /// Return the number of previews the cache can hold besides the previews being viewed. Call with mutex locked.
+    int     prefetchCapacity() const;
+
+    void    prefetchOne(const QString& filePath, int generation);
+
+public:
+
+    QString               dir;
+    int                   previewSize;
+    qint64                maxCacheSize;
+    qint64                cacheSize;
+    qint64                accessCounter;
+
+    QHash<QString, Entry> entries;
+
+    /// Keys of the files which cannot be decoded. They are served without transcoding.
+    /// Write errors are not recorded: they can be transient, as with a full disk.
+    QSet<QString>         failed;
+
+    /// Keys of the previews being transcoded. Other requests for the same key wait for the result.
+    QSet<QString>         inFlight;
+
+    /// Keys of the previews being served, with the count of requests. They are not pruned.
+    QHash<QString, int>   pinned;
+
+    QMutex                mutex;
+    QWaitCondition        condVar;
+
+    QThreadPool           pool;
+    QList<QFuture<void> > prefetchTasks;
+
+    /// Incremented by each prefetch: the files of a container browsed before are not transcoded anymore.
+    int                   prefetchGeneration;
+    volatile bool         cancel;
+};
+
+QString DLNAPreviewCache::Private::key(const QFileInfo& info) const
+{
+    // The key changes if the image is modified, or if the preview settings change.
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.absoluteFilePath().toUtf8());
+    hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(QByteArray::number(previewSize));
+    hash.addData("JPG");
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString DLNAPreviewCache::Private::cacheFilePath(const QString& key) const
+{
+    return dir + QLatin1Char('/') + key + QLatin1String(".jpg");
+}
+
+void DLNAPreviewCache::Private::loadIndex()
+{
+    QDir cacheDir(dir);
+
+    // Oldest files are the first to be removed when the cache is pruned.
+
+    QFileInfoList list = cacheDir.entryInfoList(QStringList() << QLatin1String("*.jpg"),
+                                                QDir::Files, QDir::Time | QDir::Reversed);
+
+    foreach (const QFileInfo& info, list)
+    {
+        Entry entry;
+        entry.size       = info.size();
+        entry.lastAccess = ++accessCounter;
+
+        entries.insert(info.completeBaseName(), entry);
+        cacheSize       += entry.size;
+    }
+
+    prune();
+
+    qCDebug(DIGIKAM_MEDIASRV_LOG) << "Preview cache" << dir << "contains" << entries.count()
+                                  << "files," << cacheSize / 1024 << "Kb";
+}
+
+void DLNAPreviewCache::Private::prune()
+{
+    if (cacheSize <= maxCacheSize)
+    {
+        return;
+    }
+
+    QList<QPair<qint64, QString> > lru;
+
+    for (QHash<QString, Entry>::const_iterator it = entries.constBegin() ; it != entries.constEnd() ; ++it)
+    {
+        lru << qMakePair(it.value().lastAccess, it.key());
+    }
+
+    std::sort(lru.begin(), lru.end());
+
+    const qint64 target = maxCacheSize / 10 * 9;
+
+    for (int i = 0 ; (i < lru.size()) && (cacheSize > target) ; ++i)
+    {
+        const QString& k = lru.at(i).second;
+
+        if (inFlight.contains(k) || pinned.contains(k))
+        {
+            continue;
+        }
+
+        // A file being streamed can still be read after removal on Unix. Elsewhere, keep it until next time.
+
+        if (QFile::remove(cacheFilePath(k)) || !QFile::exists(cacheFilePath(k)))
+        {
+            cacheSize -= entries.take(k).size;
+        }
+    }
+}
+
+DLNAPreviewCache::Private::TranscodeResult DLNAPreviewCache::Private::transcode(const QString& filePath,
+                                                                                const QString& cachePath)
+{
+    DImg dimg = PreviewLoadThread::loadFastSynchronously(filePath, previewSize);
+
+    if (dimg.isNull())
+    {
+        return NotAnImage;
+    }
+
+    // Write to a temporary file, renamed on commit: a concurrent reader never sees a partial preview.
+
+    QSaveFile file(cachePath);
+
+    if (!file.open(QIODevice::WriteOnly) || !dimg.copyQImage().save(&file, "JPG") || !file.commit())
+    {
+        qCWarning(DIGIKAM_MEDIASRV_LOG) << "Cannot write preview cache file" << cachePath;
+        return WriteError;
+    }
+
+    return Transcoded;
+}
+
+QString DLNAPreviewCache::Private::preview(const QString& filePath, bool pin)
+{
+    QFileInfo info(filePath);
+
+    if (!info.isFile())
+    {
+        return QString();
+    }
+
+    const QString k         = key(info);
+    const QString cachePath = cacheFilePath(k);
+
+    {
+        QMutexLocker lock(&mutex);
+
+        while (inFlight.contains(k))
+        {
+            condVar.wait(&mutex);
+        }
+
+        if (failed.contains(k))
+        {
+            return QString();
+        }
+
+        QHash<QString, Entry>::iterator it = entries.find(k);
+
+        if (it != entries.end())
+        {
+            it->lastAccess = ++accessCounter;
+
+            if (pin)
+            {
+                ++pinned[k];
+            }
+
+            return cachePath;
+        }
+
+        inFlight.insert(k);
+    }
+
+    // Transcode without the lock: requests for other files go on meanwhile.
+
+    TranscodeResult result = transcode(filePath, cachePath);
+    const bool ok          = (result == Transcoded);
+    qint64 size            = ok ? QFileInfo(cachePath).size() : 0;
+
+    QMutexLocker lock(&mutex);
+
+    inFlight.remove(k);
+
+    if (ok)
+    {
+        Entry entry;
+        entry.size       = size;
+        entry.lastAccess = ++accessCounter;
+        entries.insert(k, entry);
+        cacheSize       += size;
+
+        if (pin)
+        {
+            ++pinned[k];
+        }
+
+        prune();
+    }
+    else if (result == NotAnImage)
+    {
+        failed.insert(k);
+    }
+
+    condVar.wakeAll();
+
+    return (ok ? cachePath : QString());
+}
+
+int DLNAPreviewCache::Private::prefetchCapacity() const
+{
+    // Before the first preview, estimate a JPEG preview to a quarter byte per pixel of a square image.
+
+    const qint64 previewBytes = entries.isEmpty() ? qint64(previewSize) * previewSize / 4
+                                                  : cacheSize / entries.count();
+
+    // Prefetched previews fill at most half of the cache, so that they do not
+    // evict each other, nor the previews being viewed, before they are served.
+
+    return (int)qMin(qint64(INT_MAX), qMax(qint64(1), maxCacheSize / 2 / qMax(qint64(1), previewBytes)));
+}
+
+void DLNAPreviewCache::Private::prefetchOne(const QString& filePath, int generation)
+{
+    {
+        QMutexLocker lock(&mutex);
+
+        if (cancel || (generation != prefetchGeneration))
+        {
+            return;
+        }
+    }
+
+    preview(filePath, false);
+}
+
+// --------------------------------------------------------------------------------------------
+
+DLNAPreviewCache::DLNAPreviewCache(const QString& cacheDir,
+                                   int previewSize,
+                                   qint64 maxCacheSize)
+    : d(new Private)
+{
+    d->dir          = cacheDir;
+    d->previewSize  = previewSize;
+    d->maxCacheSize = maxCacheSize;
+
+    if (d->dir.isEmpty())
+    {
+        d->dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+                 QLatin1String("/mediaserver/previews");
+    }
+
+    QDir().mkpath(d->dir);
+    d->loadIndex();
+}
+
+DLNAPreviewCache::~DLNAPreviewCache()
+{
+    cancelPrefetch();
+    delete d;
+}
+
+QString DLNAPreviewCache::preview(const QString& filePath)
+{
+    return d->preview(filePath, true);
+}
+
+void DLNAPreviewCache::release(const QString& previewPath)
+{
+    const QString k = QFileInfo(previewPath).completeBaseName();
+
+    QMutexLocker lock(&d->mutex);
+
+    QHash<QString, int>::iterator it = d->pinned.find(k);
+
+    if (it == d->pinned.end())
+    {
+        return;
+    }
+
+    if (--it.value() == 0)
+    {
+        d->pinned.erase(it);
+
+        // The cache can have grown over its size while the preview was served.
+        d->prune();
+    }
+}
+
+void DLNAPreviewCache::prefetch(const QStringList& filePaths)
+{
+    QMutexLocker lock(&d->mutex);
+
+    d->cancel = false;
+
+    // Drop finished jobs.
+
+    for (QList<QFuture<void> >::iterator it = d->prefetchTasks.begin() ; it != d->prefetchTasks.end() ; )
+    {
+        if (it->isFinished())
+        {
+            it = d->prefetchTasks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // The previous container is not browsed anymore: its files not transcoded yet are skipped.
+
+    const int generation = ++d->prefetchGeneration;
+    const int count      = qMin(filePaths.size(), d->prefetchCapacity());
+
+    if (count < filePaths.size())
+    {
+        qCDebug(DIGIKAM_MEDIASRV_LOG) << "Prefetch" << count << "previews of" << filePaths.size()
+                                      << "files, the cache cannot hold more";
+    }
+
+    for (int i = 0 ; i < count ; ++i)
+    {
+        d->prefetchTasks << QtConcurrent::run(&d->pool, d, &Private::prefetchOne, filePaths.at(i), generation);
+    }
+}
+
+void DLNAPreviewCache::cancelPrefetch()
+{
+    QList<QFuture<void> > tasks;
+
+    {
+        QMutexLocker lock(&d->mutex);
+        d->cancel = true;
+        tasks     = d->prefetchTasks;
+        d->prefetchTasks.clear();
+    }
+
+    foreach (QFuture<void> t, tasks)
+    {
+        t.waitForFinished();
+    }
+}
+
+QString DLNAPreviewCache::cacheDir() const
+{
+    return d->dir;
+}
+
+qint64 DLNAPreviewCache::cacheSize() const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return d->cacheSize;
+}
+
+} // namespace Digikam
@@ -0,0 +1,102 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-09
+ * Description : a disk cache of transcoded previews served by
+ *               the DLNA media server.
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_DLNA_PREVIEW_CACHE_H
+#define DIGIKAM_DLNA_PREVIEW_CACHE_H
+
+// Qt includes
+
+#include <QString>
+#include <QStringList>
+
+namespace Digikam
+{
+
+/**
+ * Previews of images served to renderers are transcoded to JPEG once and
+ * stored as files in the user cache directory. Entries are keyed by file
+ * path, modification time, file size, preview size and format, so a
+ * modified image gets a new entry. The cache size is bounded: least
+ * recently used entries are removed first.
+ *
+ * All methods are thread-safe: the HTTP server serves requests from
+ * several threads.
+ */
+class DLNAPreviewCache
+{
+public:
+
+    /**
+     * Create a cache in the given directory, or in the media server
+     * directory of the user cache location if empty.
+     */
+    explicit DLNAPreviewCache(const QString& cacheDir = QString(),
+                              int previewSize = 2048,
+                              qint64 maxCacheSize = 512 * 1024 * 1024);
+    ~DLNAPreviewCache();
+
+    /**
+     * Return the path of the cached preview file of the image at filePath,
+     * transcoding it if it is not in the cache yet. If another thread is
+     * transcoding the same image, wait for it. Return an empty string if the
+     * file cannot be decoded as an image, or if the preview cannot be written
+     * to the cache: the file must then be served as is. Only the files which
+     * cannot be decoded are not transcoded again.
+     * A returned preview is kept in the cache until release() is called:
+     * call it once the file is opened to be served.
+     */
+    QString preview(const QString& filePath);
+
+    /**
+     * Release a preview returned by preview(). It can then be removed from the cache.
+     */
+    void release(const QString& previewPath);
+
+    /**
+     * Transcode in background the images not in the cache yet,
+     * for example the contents of a container browsed by a renderer.
+     * Only the first files fitting in half of the cache are transcoded,
+     * and the files of the previous call not transcoded yet are skipped.
+     */
+    void prefetch(const QStringList& filePaths);
+
+    /**
+     * Stop background transcoding and wait for the running jobs.
+     */
+    void cancelPrefetch();
+
+    QString cacheDir()  const;
+    qint64  cacheSize() const;
+
+private:
+
+    DLNAPreviewCache(const DLNAPreviewCache&); // Disable
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_DLNA_PREVIEW_CACHE_H
@@ -42,15 +42,11 @@
 #include <QUrl>
 #include <QList>
 #include <QMap>
-#include <QImage>
-#include <QByteArray>
-#include <QBuffer>
 
 // Local includes
 
 #include "digikam_debug.h"
-#include "previewloadthread.h"
-#include "dimg.h"
+#include "dlnapreviewcache.h"
 #include "drawdecoder.h"
 
 NPT_SET_LOCAL_LOGGER("digiKam.media.server.delegate")
@@ -76,6 +72,8 @@ public:
     MediaServerMap                                                      map;
 
     PLT_MediaCache<NPT_Reference<NPT_List<NPT_String> >, NPT_TimeStamp> dirCache;
+
+    DLNAPreviewCache                                                    previewCache;
 };
 
 DLNAMediaServerDelegate::DLNAMediaServerDelegate(const char* url_root,
@@ -88,6 +86,7 @@ DLNAMediaServerDelegate::DLNAMediaServerDelegate(const char* url_root,
 
 DLNAMediaServerDelegate::~DLNAMediaServerDelegate()
 {
+    d->previewCache.cancelPrefetch();
     delete d;
 }
 
@@ -242,14 +241,21 @@ NPT_Result DLNAMediaServerDelegate::OnBrowseDirectChildren(PLT_ActionReference&
         {
             QString container = QString::fromUtf8(dir.GetChars());
             QList<QUrl> urls  = d->map.value(container.remove(QLatin1Char('/')));
+            QStringList files;
 
             foreach(const QUrl& u, urls)
             {
                 // Internal URL separator between container path and local file path.
                 // Ex: Linux => "/country/town/Paris/?file:/mnt/data/travel/Paris/eiffeltower.jpg
                 //     Win32 => "/Friends/US/Brown/?file:C:/Users/Foo/My Images/Friends/US/Brown/homer.png
-                list << QLatin1String("?file:") + u.toLocalFile();
+                list  << QLatin1String("?file:") + u.toLocalFile();
+                files << u.toLocalFile();
             }
+
+            // A renderer browsing a container will most likely request its items next.
+            // Transcode them in background, the requests are then served from the preview cache.
+
+            d->previewCache.prefetch(files);
         }
 
         qCDebug(DIGIKAM_MEDIASRV_LOG) << "OnBrowseDirectChildren() ::"
@@ -722,28 +728,10 @@ NPT_Result DLNAMediaServerDelegate::ServeFile(const NPT_HttpRequest&        requ
                                               NPT_HttpResponse&             response,
                                               const NPT_String&             file_path)
 {
-    // Try to stream image file as transcoded preview.
-    // This will serve image in reduced size, including all know image formats
-    // supported by digiKam core, as JPEG, PNG, TIFF, and RAW files for ex.
-
-    DImg dimg = PreviewLoadThread::loadFastSynchronously(QString::fromUtf8(file_path.GetChars()), 2048);
-
-    if (dimg.isNull())
-    {
-        // Not a supported image format. Try to stream file as well, without transcoding.
-        // TODO : support video file as transcoded video stream using QtAV (if possible).
-
-        qCDebug(DIGIKAM_MEDIASRV_LOG) << file_path.GetChars() << "not recognized as an image to stream as preview.";
-
-        NPT_CHECK_WARNING(PLT_HttpServer::ServeFile(request, context, response, file_path));
-        return NPT_SUCCESS;
-    }
-
     // This code is basically the same than PLT_HttpServer::ServeFile() excepted the
-    // image trancoding pass served as byte stream.
+    // image transcoded as preview which is served from the preview cache.
 
     NPT_InputStreamReference stream;
-    NPT_File                 file(file_path);
     NPT_FileInfo             file_info;
 
     // prevent hackers from accessing files outside of our root
@@ -759,7 +747,7 @@ NPT_Result DLNAMediaServerDelegate::ServeFile(const NPT_HttpRequest&        requ
 
     const NPT_String* range_spec = request.GetHeaders().GetHeaderValue(NPT_HTTP_HEADER_RANGE);
 
-    // handle potential 304 only if range header not set
+    // handle potential 304 only if range header not set, before any decoding
 
     NPT_DateTime  date;
     NPT_TimeStamp timestamp;
@@ -786,18 +774,40 @@ NPT_Result DLNAMediaServerDelegate::ServeFile(const NPT_HttpRequest&        requ
         }
     }
 
-    // Trancoding image as preview.
+    // Try to stream image file as transcoded preview.
+    // This will serve image in reduced size, including all know image formats
+    // supported by digiKam core, as JPEG, PNG, TIFF, and RAW files for ex.
+    // The preview is transcoded once and stored in the cache, next requests
+    // and range requests of the same image are served from the cached file.
+
+    QString preview = d->previewCache.preview(QString::fromUtf8(file_path.GetChars()));
+
+    if (preview.isEmpty())
+    {
+        // Not a supported image format. Try to stream file as well, without transcoding.
+        // TODO : support video file as transcoded video stream using QtAV (if possible).
+
+        qCDebug(DIGIKAM_MEDIASRV_LOG) << file_path.GetChars() << "not recognized as an image to stream as preview.";
+
+        NPT_CHECK_WARNING(PLT_HttpServer::ServeFile(request, context, response, file_path));
+        return NPT_SUCCESS;
+    }
 
-    QImage preview = dimg.copyQImage();
-    QByteArray ba;
-    QBuffer    buffer(&ba);
-    buffer.open(QIODevice::WriteOnly);
-    preview.save(&buffer, "JPG");
-    buffer.close();
+    // The file stream is seekable: PLT_HttpServer::ServeStream() answers range requests with partial contents.
 
-    stream         = new NPT_MemoryStream(ba.data(), (NPT_Size)ba.size());
+    QByteArray preview_path = preview.toUtf8();
+    NPT_File   file(NPT_String(preview_path.constData(), preview_path.size()));
 
-    if (stream.IsNull())
+    // The preview is kept in the cache until the file is open. An open file can still
+    // be read once removed on Unix, and cannot be removed elsewhere.
+
+    const bool opened = NPT_SUCCEEDED(file.Open(NPT_FILE_OPEN_MODE_READ)) &&
+                        NPT_SUCCEEDED(file.GetInputStream(stream))        &&
+                        !stream.IsNull();
+
+    d->previewCache.release(preview);
+
+    if (!opened)
     {
         return NPT_ERROR_NO_SUCH_ITEM;
     }
@@ -811,8 +821,6 @@ NPT_Result DLNAMediaServerDelegate::ServeFile(const NPT_HttpRequest&        requ
         response.GetHeaders().SetHeader("Cache-Control", "max-age=0,must-revalidate", true);
     }
 
-    PLT_HttpRequestContext tmp_context(request, context);
-
     NPT_CHECK_WARNING(PLT_HttpServer::ServeStream(request, context, response, stream,
                       "image/jpeg"));
 
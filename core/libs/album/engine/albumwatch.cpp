@@ -28,7 +28,9 @@
 
 #include <QFileSystemWatcher>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QFileInfo>
+#include <QTimer>
 #include <QDir>
 
 // Local includes
@@ -36,10 +38,13 @@
 #include "digikam_debug.h"
 #include "album.h"
 #include "albummanager.h"
+#include "albumwatchjournal.h"
 #include "collectionlocation.h"
 #include "collectionmanager.h"
 #include "dbengineparameters.h"
 #include "scancontroller.h"
+#include "coredb.h"
+#include "coredbaccess.h"
 #include "dio.h"
 
 namespace Digikam
@@ -50,7 +55,9 @@ class Q_DECL_HIDDEN AlbumWatch::Private
 public:
 
     explicit Private()
-      : dirWatch(0)
+      : dirWatch(0),
+        inotify(0),
+        journalTimer(0)
     {
     }
 
@@ -62,6 +69,14 @@ public:
 
     QFileSystemWatcher* dirWatch;
 
+    /// When available, the file names of the changes are recorded in the journal,
+    /// and only these files are scanned. dirWatch only gets the folders which
+    /// inotify cannot watch.
+    InotifyWatcher*     inotify;
+    AlbumWatchJournal   journal;
+    QTimer*             journalTimer;
+    QElapsedTimer       journalAge;
+
     DbEngineParameters  params;
     QStringList         fileNameBlackList;
     QList<QDateTime>    dbPathModificationDateList;
@@ -149,8 +164,27 @@ AlbumWatch::AlbumWatch(AlbumManager* const parent)
       d(new Private)
 {
     d->dirWatch = new QFileSystemWatcher(this);
+    d->inotify  = new InotifyWatcher(this);
 
-    qCDebug(DIGIKAM_GENERAL_LOG) << "AlbumWatch use QFileSystemWatcher";
+    if (d->inotify->isValid())
+    {
+        qCDebug(DIGIKAM_GENERAL_LOG) << "AlbumWatch use inotify with a file change journal";
+
+        connect(d->inotify, SIGNAL(signalEvents(QList<InotifyWatcher::Event>)),
+                this, SLOT(slotInotifyEvents(QList<InotifyWatcher::Event>)));
+    }
+    else
+    {
+        qCDebug(DIGIKAM_GENERAL_LOG) << "AlbumWatch use QFileSystemWatcher";
+    }
+
+    // Wait for a short pause in the changes, as when a file is written in several steps
+    d->journalTimer = new QTimer(this);
+    d->journalTimer->setSingleShot(true);
+    d->journalTimer->setInterval(1000);
+
+    connect(d->journalTimer, SIGNAL(timeout()),
+            this, SLOT(slotFlushJournal()));
 
     connect(d->dirWatch, SIGNAL(directoryChanged(QString)),
             this, SLOT(slotQFSWatcherDirty(QString)));
@@ -182,6 +216,15 @@ void AlbumWatch::clear()
     {
         d->dirWatch->removePaths(d->dirWatch->directories());
     }
+
+    foreach(const QString& dir, d->inotify->directories())
+    {
+        d->inotify->removePath(dir);
+    }
+
+    d->journalTimer->stop();
+    d->journalAge.invalidate();
+    d->journal.takeChanges();
 }
 
 void AlbumWatch::removeWatchedPAlbums(const PAlbum* const album)
@@ -198,6 +241,14 @@ void AlbumWatch::removeWatchedPAlbums(const PAlbum* const album)
             d->dirWatch->removePath(dir);
         }
     }
+
+    foreach(const QString& dir, d->inotify->directories())
+    {
+        if (dir.startsWith(album->folderPath()))
+        {
+            d->inotify->removePath(dir);
+        }
+    }
 }
 
 void AlbumWatch::setDbEngineParameters(const DbEngineParameters& params)
@@ -242,7 +293,10 @@ void AlbumWatch::slotAlbumAdded(Album* a)
         return;
     }
 
-    d->dirWatch->addPath(dir);
+    if (!d->inotify->addPath(dir))
+    {
+        d->dirWatch->addPath(dir);
+    }
 }
 
 void AlbumWatch::slotAlbumAboutToBeDeleted(Album* a)
@@ -260,6 +314,7 @@ void AlbumWatch::slotAlbumAboutToBeDeleted(Album* a)
         return;
     }
 
+    d->inotify->removePath(dir);
     d->dirWatch->removePath(dir);
 }
 
@@ -299,4 +354,138 @@ void AlbumWatch::slotQFSWatcherDirty(const QString& path)
     }
 }
 
+void AlbumWatch::slotInotifyEvents(const QList<InotifyWatcher::Event>& events)
+{
+    foreach(const InotifyWatcher::Event& event, events)
+    {
+        // Filter out changes on the database files
+        if (!event.name.isEmpty() && d->inBlackList(event.name))
+        {
+            continue;
+        }
+
+        switch (event.type)
+        {
+            case InotifyWatcher::FileCreated:
+                d->journal.fileCreated(event.dir, event.name);
+                break;
+
+            case InotifyWatcher::FileModified:
+                d->journal.fileModified(event.dir, event.name);
+                break;
+
+            case InotifyWatcher::FileDeleted:
+                d->journal.fileDeleted(event.dir, event.name);
+                break;
+
+            case InotifyWatcher::FileMovedFrom:
+                d->journal.fileMovedFrom(event.dir, event.name, event.cookie);
+                break;
+
+            case InotifyWatcher::FileMovedTo:
+                d->journal.fileMovedTo(event.dir, event.name, event.cookie);
+                break;
+
+            case InotifyWatcher::DirectoryCreated:
+                // only the new folder needs to be scanned
+                d->journal.directoryChanged(event.dir + QLatin1Char('/') + event.name);
+                break;
+
+            case InotifyWatcher::DirectoryDeleted:
+                d->journal.directoryChanged(event.dir);
+                break;
+
+            case InotifyWatcher::Overflow:
+                d->journal.overflow();
+                break;
+        }
+    }
+
+    if (d->journal.isEmpty())
+    {
+        return;
+    }
+
+    if (!d->journalAge.isValid())
+    {
+        d->journalAge.start();
+    }
+
+    // Do not wait forever for a pause while files are written continuously
+
+    if (d->journalAge.elapsed() > 5000)
+    {
+        slotFlushJournal();
+    }
+    else
+    {
+        d->journalTimer->start();
+    }
+}
+
+void AlbumWatch::slotFlushJournal()
+{
+    d->journalTimer->stop();
+    d->journalAge.invalidate();
+
+    if (d->journal.isEmpty())
+    {
+        return;
+    }
+
+    AlbumWatchJournal::Changes changes = d->journal.takeChanges();
+
+    // Our own file operations give their own hints to the scanner
+    if (DIO::itemsUnderProcessing())
+    {
+        return;
+    }
+
+    if (changes.overflow)
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Some file changes were lost, triggering rescan of all collections";
+
+        foreach(const CollectionLocation& location, CollectionManager::instance()->allAvailableLocations())
+        {
+            rescanDirectory(location.albumRootPath());
+        }
+
+        return;
+    }
+
+    // Keep the identity of the renamed and moved items, with their tags and other properties
+
+    foreach(const AlbumWatchJournal::Move& move, changes.moves)
+    {
+        PAlbum* const srcAlbum = AlbumManager::instance()->findPAlbum(QUrl::fromLocalFile(move.srcDir));
+        PAlbum* const dstAlbum = AlbumManager::instance()->findPAlbum(QUrl::fromLocalFile(move.dstDir));
+
+        if (!srcAlbum || !dstAlbum)
+        {
+            continue;
+        }
+
+        qlonglong id = CoreDbAccess().db()->getImageId(srcAlbum->id(), move.srcName);
+
+        if (id != -1)
+        {
+            ScanController::instance()->hintAtMoveOrCopyOfItem(id, dstAlbum, move.dstName);
+        }
+    }
+
+    foreach(const QString& dir, changes.directories)
+    {
+        rescanDirectory(dir);
+    }
+
+    QHash<QString, QStringList>::const_iterator it;
+
+    for (it = changes.files.constBegin() ; it != changes.files.constEnd() ; ++it)
+    {
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Detected change of" << it.value().count() << "files, triggering scan of" << it.key();
+
+        ScanController::instance()->scheduleCollectionScanFiles(it.key(), it.value());
+    }
+}
+
 } // namespace Digikam
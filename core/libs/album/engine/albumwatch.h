@@ -31,6 +31,10 @@
 #include <QString>
 #include <QUrl>
 
+// Local includes
+
+#include "inotifywatcher.h"
+
 namespace Digikam
 {
 
@@ -57,6 +61,8 @@ protected Q_SLOTS:
     void slotAlbumAdded(Album* album);
     void slotAlbumAboutToBeDeleted(Album* album);
     void slotQFSWatcherDirty(const QString& path);
+    void slotInotifyEvents(const QList<InotifyWatcher::Event>& events);
+    void slotFlushJournal();
 
 private:
 
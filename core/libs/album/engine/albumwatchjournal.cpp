@@ -0,0 +1,256 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Journal of file changes reported by the directory watch
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "albumwatchjournal.h"
+
+// Qt includes
+
+#include <QSet>
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN AlbumWatchJournal::Private
+{
+public:
+
+    enum FileState
+    {
+        Created,
+        Modified,
+        Deleted
+    };
+
+    class PendingMove
+    {
+    public:
+
+        QString dir;
+        QString name;
+        bool    known;
+    };
+
+public:
+
+    explicit Private()
+      : maxFilesPerDirectory(500),
+        overflow(false)
+    {
+    }
+
+    /**
+     * Merges the new state of a file with the recorded one.
+     * Returns true if the file was known before this journal, i.e. was not created since the last scan.
+     */
+    bool setState(const QString& dir, const QString& name, FileState state);
+
+public:
+
+    int                                        maxFilesPerDirectory;
+    bool                                       overflow;
+
+    QHash<QString, QHash<QString, FileState> > files;
+    QSet<QString>                              directories;
+    QHash<quint32, PendingMove>                pendingMoves;
+    QList<Move>                                moves;
+};
+
+bool AlbumWatchJournal::Private::setState(const QString& dir, const QString& name, FileState state)
+{
+    if (directories.contains(dir))
+    {
+        return true;
+    }
+
+    QHash<QString, FileState>& dirFiles    = files[dir];
+    QHash<QString, FileState>::iterator it = dirFiles.find(name);
+    bool known                             = (it == dirFiles.end() || it.value() != Created);
+
+    switch (state)
+    {
+        case Created:
+        {
+            if (it == dirFiles.end())
+            {
+                dirFiles.insert(name, Created);
+            }
+            else if (it.value() == Deleted)
+            {
+                // replaced by a new file with the same name
+                it.value() = Modified;
+            }
+
+            break;
+        }
+
+        case Modified:
+        {
+            if (it == dirFiles.end())
+            {
+                dirFiles.insert(name, Modified);
+            }
+            else if (it.value() == Deleted)
+            {
+                it.value() = Modified;
+            }
+
+            break;
+        }
+
+        case Deleted:
+        {
+            if (it != dirFiles.end() && it.value() == Created)
+            {
+                // a temporary file, never seen by the scanner
+                dirFiles.erase(it);
+            }
+            else
+            {
+                dirFiles[name] = Deleted;
+            }
+
+            break;
+        }
+    }
+
+    if (dirFiles.isEmpty())
+    {
+        files.remove(dir);
+    }
+    else if (dirFiles.count() > maxFilesPerDirectory)
+    {
+        // Listing the folder once is cheaper than checking each file
+        files.remove(dir);
+        directories.insert(dir);
+    }
+
+    return known;
+}
+
+// -------------------------------------------------------------------------------------
+
+AlbumWatchJournal::AlbumWatchJournal(int maxFilesPerDirectory)
+    : d(new Private)
+{
+    d->maxFilesPerDirectory = maxFilesPerDirectory;
+}
+
+AlbumWatchJournal::~AlbumWatchJournal()
+{
+    delete d;
+}
+
+void AlbumWatchJournal::fileCreated(const QString& dir, const QString& name)
+{
+    d->setState(dir, name, Private::Created);
+}
+
+void AlbumWatchJournal::fileModified(const QString& dir, const QString& name)
+{
+    d->setState(dir, name, Private::Modified);
+}
+
+void AlbumWatchJournal::fileDeleted(const QString& dir, const QString& name)
+{
+    d->setState(dir, name, Private::Deleted);
+}
+
+void AlbumWatchJournal::fileMovedFrom(const QString& dir, const QString& name, quint32 cookie)
+{
+    Private::PendingMove move;
+    move.dir   = dir;
+    move.name  = name;
+    move.known = d->setState(dir, name, Private::Deleted);
+
+    d->pendingMoves.insert(cookie, move);
+}
+
+void AlbumWatchJournal::fileMovedTo(const QString& dir, const QString& name, quint32 cookie)
+{
+    QHash<quint32, Private::PendingMove>::iterator it = d->pendingMoves.find(cookie);
+
+    // A file renamed from a name created since the last scan, as a partial download, is just a new file
+
+    if (it != d->pendingMoves.end())
+    {
+        if (it->known)
+        {
+            Move move;
+            move.srcDir  = it->dir;
+            move.srcName = it->name;
+            move.dstDir  = dir;
+            move.dstName = name;
+            d->moves << move;
+        }
+
+        d->pendingMoves.erase(it);
+    }
+
+    d->setState(dir, name, Private::Created);
+}
+
+void AlbumWatchJournal::directoryChanged(const QString& dir)
+{
+    d->files.remove(dir);
+    d->directories.insert(dir);
+}
+
+void AlbumWatchJournal::overflow()
+{
+    d->overflow = true;
+}
+
+bool AlbumWatchJournal::isEmpty() const
+{
+    return (d->files.isEmpty()       &&
+            d->directories.isEmpty() &&
+            d->moves.isEmpty()       &&
+            !d->overflow);
+}
+
+AlbumWatchJournal::Changes AlbumWatchJournal::takeChanges()
+{
+    Changes changes;
+    changes.overflow    = d->overflow;
+    changes.directories = d->directories.toList();
+    changes.moves       = d->moves;
+
+    QHash<QString, QHash<QString, Private::FileState> >::const_iterator it;
+
+    for (it = d->files.constBegin() ; it != d->files.constEnd() ; ++it)
+    {
+        changes.files.insert(it.key(), it.value().keys());
+    }
+
+    // Moves with a missing destination were already recorded as deletions
+
+    d->overflow = false;
+    d->files.clear();
+    d->directories.clear();
+    d->pendingMoves.clear();
+    d->moves.clear();
+
+    return changes;
+}
+
+} // namespace Digikam
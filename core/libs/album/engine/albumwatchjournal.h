@@ -0,0 +1,119 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Journal of file changes reported by the directory watch
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_ALBUM_WATCH_JOURNAL_H
+#define DIGIKAM_ALBUM_WATCH_JOURNAL_H
+
+// Qt includes
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace Digikam
+{
+
+/**
+ * Collects the file changes of the watched album folders between two scans.
+ * Several changes of the same file are merged, files created and deleted again
+ * before the next scan are dropped and renames are matched to keep the identity
+ * of the item. Folders with too many changes, or with changed sub-folders,
+ * are given back for a rescan of the whole folder.
+ */
+class AlbumWatchJournal
+{
+public:
+
+    class Move
+    {
+    public:
+
+        QString srcDir;
+        QString srcName;
+        QString dstDir;
+        QString dstName;
+    };
+
+    class Changes
+    {
+    public:
+
+        Changes()
+          : overflow(false)
+        {
+        }
+
+        /// Folders which need a rescan of all their entries.
+        QStringList                 directories;
+
+        /// Folder -> names of the changed files, for the other folders.
+        QHash<QString, QStringList> files;
+
+        /// Renamed or moved files, which were known before.
+        QList<Move>                 moves;
+
+        /// Some changes were lost, the whole collection must be checked.
+        bool                        overflow;
+    };
+
+public:
+
+    explicit AlbumWatchJournal(int maxFilesPerDirectory = 500);
+    ~AlbumWatchJournal();
+
+    void fileCreated(const QString& dir, const QString& name);
+    void fileModified(const QString& dir, const QString& name);
+    void fileDeleted(const QString& dir, const QString& name);
+
+    /**
+     * The two halves of a rename. Both are matched with the cookie given by the watcher.
+     */
+    void fileMovedFrom(const QString& dir, const QString& name, quint32 cookie);
+    void fileMovedTo(const QString& dir, const QString& name, quint32 cookie);
+
+    void directoryChanged(const QString& dir);
+    void overflow();
+
+    bool isEmpty() const;
+
+    /**
+     * Returns all changes recorded since the last call and clears the journal.
+     */
+    Changes takeChanges();
+
+private:
+
+    // Disable
+    AlbumWatchJournal(const AlbumWatchJournal&);
+    AlbumWatchJournal& operator=(const AlbumWatchJournal&);
+
+private:
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_ALBUM_WATCH_JOURNAL_H
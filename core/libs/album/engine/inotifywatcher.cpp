@@ -0,0 +1,292 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Directory watch backend reporting file names with Linux inotify
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "inotifywatcher.h"
+
+// C ANSI includes
+
+#ifdef Q_OS_LINUX
+#   include <sys/inotify.h>
+#   include <sys/ioctl.h>
+#   include <unistd.h>
+#   include <errno.h>
+#   include <limits.h>
+#   include <string.h>
+#endif
+
+// Qt includes
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSocketNotifier>
+
+// Local includes
+
+#include "digikam_debug.h"
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN InotifyWatcher::Private
+{
+public:
+
+    explicit Private()
+      : fd(-1),
+        notifier(0)
+    {
+    }
+
+    int                 fd;
+    QSocketNotifier*    notifier;
+
+    QHash<int, QString> pathByWatch;
+    QHash<QString, int> watchByPath;
+};
+
+InotifyWatcher::InotifyWatcher(QObject* const parent)
+    : QObject(parent),
+      d(new Private)
+{
+#ifdef Q_OS_LINUX
+
+    d->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (d->fd == -1)
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot initialize inotify:" << QString::fromLocal8Bit(strerror(errno));
+        return;
+    }
+
+    d->notifier = new QSocketNotifier(d->fd, QSocketNotifier::Read, this);
+
+    connect(d->notifier, SIGNAL(activated(int)),
+            this, SLOT(slotReadEvents()));
+
+#endif
+}
+
+InotifyWatcher::~InotifyWatcher()
+{
+    // The notifier must not outlive the descriptor
+    delete d->notifier;
+
+#ifdef Q_OS_LINUX
+
+    if (d->fd != -1)
+    {
+        close(d->fd);
+    }
+
+#endif
+
+    delete d;
+}
+
+bool InotifyWatcher::isValid() const
+{
+    return (d->fd != -1);
+}
+
+bool InotifyWatcher::addPath(const QString& dir)
+{
+#ifdef Q_OS_LINUX
+
+    if (d->fd == -1)
+    {
+        return false;
+    }
+
+    if (d->watchByPath.contains(dir))
+    {
+        return true;
+    }
+
+    // Files are reported when they are closed after writing, in addition to each write,
+    // for the programs which keep them open and write them in several steps.
+
+    int wd = inotify_add_watch(d->fd, QFile::encodeName(dir).constData(),
+                               IN_CREATE      | IN_DELETE     | IN_MOVED_FROM   | IN_MOVED_TO |
+                               IN_CLOSE_WRITE | IN_MODIFY     | IN_ATTRIB       |
+                               IN_DELETE_SELF | IN_MOVE_SELF  | IN_ONLYDIR);
+
+    if (wd == -1)
+    {
+        qCWarning(DIGIKAM_GENERAL_LOG) << "Cannot watch" << dir << ":" << QString::fromLocal8Bit(strerror(errno));
+        return false;
+    }
+
+    d->watchByPath[dir] = wd;
+    d->pathByWatch[wd]  = dir;
+
+    return true;
+
+#else
+
+    Q_UNUSED(dir);
+
+    return false;
+
+#endif
+}
+
+void InotifyWatcher::removePath(const QString& dir)
+{
+    if (!d->watchByPath.contains(dir))
+    {
+        return;
+    }
+
+    int wd = d->watchByPath.take(dir);
+    d->pathByWatch.remove(wd);
+
+#ifdef Q_OS_LINUX
+
+    inotify_rm_watch(d->fd, wd);
+
+#endif
+}
+
+QStringList InotifyWatcher::directories() const
+{
+    return d->watchByPath.keys();
+}
+
+void InotifyWatcher::slotReadEvents()
+{
+#ifdef Q_OS_LINUX
+
+    int available = 0;
+
+    if (ioctl(d->fd, FIONREAD, &available) == -1)
+    {
+        available = 0;
+    }
+
+    // one event with the longest name must fit in the buffer
+
+    QByteArray buffer(qMax(available, (int)(sizeof(struct inotify_event) + NAME_MAX + 1)), 0);
+    ssize_t length = read(d->fd, buffer.data(), buffer.size());
+
+    if (length <= 0)
+    {
+        return;
+    }
+
+    QList<Event> events;
+    const char* ptr       = buffer.constData();
+    const char* const end = ptr + length;
+
+    while (ptr < end)
+    {
+        const struct inotify_event* const ev = reinterpret_cast<const struct inotify_event*>(ptr);
+        ptr                                 += sizeof(struct inotify_event) + ev->len;
+
+        Event event;
+
+        if (ev->mask & IN_Q_OVERFLOW)
+        {
+            event.type = Overflow;
+            events << event;
+            continue;
+        }
+
+        if (ev->mask & IN_IGNORED)
+        {
+            // the watch was removed by the kernel, as when the directory was deleted
+            d->watchByPath.remove(d->pathByWatch.take(ev->wd));
+            continue;
+        }
+
+        QString dir = d->pathByWatch.value(ev->wd);
+
+        if (dir.isNull())
+        {
+            continue;
+        }
+
+        event.dir    = dir;
+        event.cookie = ev->cookie;
+
+        if (ev->len)
+        {
+            event.name = QFile::decodeName(ev->name);
+        }
+
+        if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+        {
+            QFileInfo info(dir);
+            event.type = DirectoryDeleted;
+            event.dir  = info.path();
+            event.name = info.fileName();
+        }
+        else if (ev->mask & IN_ISDIR)
+        {
+            if      (ev->mask & (IN_CREATE | IN_MOVED_TO))
+            {
+                event.type = DirectoryCreated;
+            }
+            else if (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+            {
+                event.type = DirectoryDeleted;
+            }
+            else
+            {
+                continue;
+            }
+        }
+        else if (ev->mask & IN_CREATE)
+        {
+            event.type = FileCreated;
+        }
+        else if (ev->mask & IN_DELETE)
+        {
+            event.type = FileDeleted;
+        }
+        else if (ev->mask & IN_MOVED_FROM)
+        {
+            event.type = FileMovedFrom;
+        }
+        else if (ev->mask & IN_MOVED_TO)
+        {
+            event.type = FileMovedTo;
+        }
+        else
+        {
+            event.type = FileModified;
+        }
+
+        events << event;
+    }
+
+    if (!events.isEmpty())
+    {
+        emit signalEvents(events);
+    }
+
+#endif
+}
+
+} // namespace Digikam
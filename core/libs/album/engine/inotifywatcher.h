@@ -0,0 +1,111 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Directory watch backend reporting file names with Linux inotify
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_INOTIFY_WATCHER_H
+#define DIGIKAM_INOTIFY_WATCHER_H
+
+// Qt includes
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace Digikam
+{
+
+/**
+ * Unlike QFileSystemWatcher, which only tells that something changed in a directory,
+ * this watcher reports the name of each created, modified, deleted or renamed entry.
+ * It is only available on Linux, isValid() returns false on other systems.
+ */
+class InotifyWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    enum EventType
+    {
+        FileCreated = 0,
+        FileModified,
+        FileDeleted,
+        FileMovedFrom,
+        FileMovedTo,
+        DirectoryCreated,    ///< A sub-directory appeared in dir.
+        DirectoryDeleted,    ///< A sub-directory of dir disappeared.
+        Overflow             ///< The event queue of the kernel overflowed, events were lost.
+    };
+
+    class Event
+    {
+    public:
+
+        Event()
+          : type(Overflow),
+            cookie(0)
+        {
+        }
+
+        EventType type;
+        QString   dir;
+        QString   name;
+        quint32   cookie;     ///< Same value for the two halves of a rename.
+    };
+
+public:
+
+    explicit InotifyWatcher(QObject* const parent = 0);
+    ~InotifyWatcher();
+
+    bool isValid() const;
+
+    /**
+     * Watch the entries of the directory dir. Sub-directories must be added separately.
+     * Returns false if dir cannot be watched, for example when the watch limit
+     * of the system is reached.
+     */
+    bool addPath(const QString& dir);
+    void removePath(const QString& dir);
+    QStringList directories() const;
+
+Q_SIGNALS:
+
+    /**
+     * Emitted with all events read at once, in the order of the kernel.
+     */
+    void signalEvents(const QList<InotifyWatcher::Event>& events);
+
+private Q_SLOTS:
+
+    void slotReadEvents();
+
+private:
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_INOTIFY_WATCHER_H
@@ -136,6 +136,10 @@ void AlbumManager::slotDatesJobData(const QMap<QDateTime, int>& datesStatMap)
         ++it;
     }
 
+    // all the Year albums, including the ones created below
+    QMap<int, DAlbum*> yearAlbums = yAlbumMap;
+
+    // datesStatMap holds one entry per day, sum them by month
     QMap<YearMonth, int> yearMonthMap;
 
     for (QMap<QDateTime, int>::const_iterator it = datesStatMap.constBegin() ;
@@ -181,21 +185,7 @@ void AlbumManager::slotDatesJobData(const QMap<QDateTime, int>& datesStatMap)
         }
 
         // Check if Year Album already exist.
-        DAlbum* yAlbum = 0;
-        AlbumIterator it(d->rootDAlbum);
-
-        while (it.current())
-        {
-            DAlbum* const a = (DAlbum*)(*it);
-
-            if (a->date() == QDate(year, 1, 1) && a->range() == DAlbum::Year)
-            {
-                yAlbum = a;
-                break;
-            }
-
-            ++it;
-        }
+        DAlbum* yAlbum = yearAlbums.value(year);
 
         // If no, create Year album.
         if (!yAlbum)
@@ -205,8 +195,13 @@ void AlbumManager::slotDatesJobData(const QMap<QDateTime, int>& datesStatMap)
             yAlbum->setParent(d->rootDAlbum);
             d->allAlbumsIdHash.insert(yAlbum->globalID(), yAlbum);
             emit signalAlbumAdded(yAlbum);
+
+            yearAlbums.insert(year, yAlbum);
         }
 
+        // The Year album holds a new Month album, do not delete it.
+        yAlbumMap.remove(year);
+
         // Create Month album
         DAlbum* const mAlbum = new DAlbum(md);
 
@@ -75,6 +75,11 @@ void CollectionScanner::setDeferredFileScanning(bool defer)
     d->deferredFileScanning = defer;
 }
 
+void CollectionScanner::setDeepVerify(bool on)
+{
+    d->deepVerify = on;
+}
+
 QStringList CollectionScanner::deferredAlbumPaths() const
 {
     return d->deferredAlbumPaths.toList();
@@ -114,6 +114,14 @@ public:
     void setDeferredFileScanning(bool defer);
     QStringList deferredAlbumPaths() const;
 
+    /**
+     * A complete scan skips the folders which did not change since they were
+     * scanned last time, as recorded in the scan journal of the database.
+     * Call this to read all folders and check all files instead.
+     * Default is off.
+     */
+    void setDeepVerify(bool on);
+
     // -----------------------------------------------------------------------------
 
     /** @name Scan operations
@@ -160,6 +168,15 @@ public:
      */
     void partialScan(const QString& albumRoot, const QString& album);
 
+    /**
+     * Carries out a partial scan of the given files of the album at dirPath,
+     * as reported by a file watcher. New files are added, known files are checked
+     * for modification and files which do not exist anymore are marked as removed.
+     * The other files and the sub-albums of the album are not read.
+     * A changed XMP sidecar is reported as a change of the file it belongs to.
+     */
+    void partialScanFiles(const QString& dirPath, const QStringList& fileNames);
+
     /**
      * The given file will be scanned according to the given mode.
      * Returns the image id of the file.
@@ -217,6 +217,9 @@ CollectionScanner::Private::Private()
       updatingHashHint(false),
       recordHistoryIds(false),
       deferredFileScanning(false),
+      deepVerify(false),
+      useScanJournal(false),
+      skippedAlbums(0),
       observer(0)
 {
 }
@@ -266,4 +269,111 @@ void CollectionScanner::Private::finishScanner(ItemScanner& scanner)
     }
 }
 
+void CollectionScanner::Private::loadScanJournal()
+{
+    useScanJournal = false;
+    skippedAlbums  = 0;
+    scanJournal.clear();
+    childAlbums.clear();
+
+    if (deepVerify)
+    {
+        return;
+    }
+
+    CoreDbAccess access;
+
+    if (access.db()->getScanJournalVersion() <= 0)
+    {
+        return;
+    }
+
+    // Folders skipped with other filters may contain files which are now relevant
+
+    if (access.db()->getSetting(QLatin1String("scanJournalFilters")) != scanJournalFilters())
+    {
+        qCDebug(DIGIKAM_DATABASE_LOG) << "File filters changed since the last scan, the scan journal is not used";
+        return;
+    }
+
+    scanJournal = access.db()->getAlbumScanJournal();
+
+    if (scanJournal.isEmpty())
+    {
+        return;
+    }
+
+    // The modification date of a folder does not change when one of its sub-folders changes,
+    // so the known sub-albums of an unchanged folder must still be visited.
+
+    foreach (const AlbumShortInfo& info, access.db()->getAlbumShortInfos())
+    {
+        if (info.relativePath == QLatin1String("/"))
+        {
+            continue;
+        }
+
+        int slash = info.relativePath.lastIndexOf(QLatin1Char('/'));
+
+        childAlbums[info.albumRootId].insert(slash <= 0 ? QLatin1String("/") : info.relativePath.left(slash),
+                                             info.relativePath);
+    }
+
+    useScanJournal = true;
+}
+
+QString CollectionScanner::Private::scanJournalFilters() const
+{
+    QStringList filters = nameFilters.toList();
+    QStringList ignored = ignoreDirectory.toList();
+    filters.sort();
+    ignored.sort();
+
+    return filters.join(QLatin1Char(';')) + QLatin1Char('|') + ignored.join(QLatin1Char(';'));
+}
+
+AlbumScanJournalEntry CollectionScanner::Private::albumFingerprint(int albumId, const QString& path) const
+{
+    QFileInfo info(path);
+    AlbumScanJournalEntry fingerprint;
+
+    fingerprint.albumId          = albumId;
+    fingerprint.modificationDate = info.lastModified();
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    fingerprint.changeDate       = info.metadataChangeTime();
+#else
+    fingerprint.changeDate       = info.created();
+#endif
+
+    return fingerprint;
+}
+
+bool CollectionScanner::Private::isAlbumUnchanged(const AlbumScanJournalEntry& fingerprint) const
+{
+    if (!useScanJournal)
+    {
+        return false;
+    }
+
+    QHash<int, AlbumScanJournalEntry>::const_iterator it = scanJournal.constFind(fingerprint.albumId);
+
+    if (it == scanJournal.constEnd() || it->scanDate.isNull())
+    {
+        return false;
+    }
+
+    // A folder changed in the same seconds as it was listed can have been modified afterwards
+    // without any visible change of its dates.
+
+    if (qAbs(it->modificationDate.secsTo(it->scanDate)) < 2 ||
+        qAbs(it->changeDate.secsTo(it->scanDate))       < 2)
+    {
+        return false;
+    }
+
+    return (it->modificationDate.toMSecsSinceEpoch() / 1000 == fingerprint.modificationDate.toMSecsSinceEpoch() / 1000 &&
+            it->changeDate.toMSecsSinceEpoch()       / 1000 == fingerprint.changeDate.toMSecsSinceEpoch()       / 1000);
+}
+
 } // namespace Digikam
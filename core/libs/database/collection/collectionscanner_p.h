@@ -50,6 +50,7 @@
 #include "drawfiles.h"
 #include "digikam_debug.h"
 #include "coredb.h"
+#include "coredbalbuminfo.h"
 #include "collectionmanager.h"
 #include "collectionlocation.h"
 #include "collectionscannerobserver.h"
@@ -147,6 +148,11 @@ public:
 
     void finishScanner(ItemScanner& scanner);
 
+    void                  loadScanJournal();
+    QString               scanJournalFilters() const;
+    AlbumScanJournalEntry albumFingerprint(int albumId, const QString& path) const;
+    bool                  isAlbumUnchanged(const AlbumScanJournalEntry& fingerprint) const;
+
 public:
 
     QSet<QString>                                 nameFilters;
@@ -172,6 +178,12 @@ public:
     bool                                          deferredFileScanning;
     QSet<QString>                                 deferredAlbumPaths;
 
+    bool                                          deepVerify;
+    bool                                          useScanJournal;
+    int                                           skippedAlbums;
+    QHash<int, AlbumScanJournalEntry>             scanJournal;
+    QHash<int, QMultiHash<QString, QString> >     childAlbums;     ///< album root id -> parent album path -> child album paths
+
     CollectionScannerObserver*                    observer;
 };
 
@@ -41,6 +41,8 @@ void CollectionScanner::completeScan()
     mainEntryPoint(true);
     d->resetRemovedItemsTime();
 
+    d->loadScanJournal();
+
     //TODO: Implement a mechanism to watch for album root changes while we keep this list
     QList<CollectionLocation> allLocations = CollectionManager::instance()->allAvailableLocations();
 
@@ -49,9 +51,20 @@ void CollectionScanner::completeScan()
         // count for progress info
         int count = 0;
 
-        foreach (const CollectionLocation& location, allLocations)
+        if (d->useScanJournal)
+        {
+            // Counting the files would read all folders which the journal allows to skip
+            foreach (const AlbumScanJournalEntry& entry, d->scanJournal)
+            {
+                count += entry.entryCount;
+            }
+        }
+        else
         {
-            count += countItemsInFolder(location.albumRootPath());
+            foreach (const CollectionLocation& location, allLocations)
+            {
+                count += countItemsInFolder(location.albumRootPath());
+            }
         }
 
         emit totalFilesToScan(count);
@@ -94,6 +107,14 @@ void CollectionScanner::completeScan()
         return;
     }
 
+    // The journal entries written by this scan are valid for the current file filters
+    CoreDbAccess().db()->setSetting(QLatin1String("scanJournalFilters"), d->scanJournalFilters());
+
+    if (d->skippedAlbums)
+    {
+        qCDebug(DIGIKAM_DATABASE_LOG) << "Complete scan skipped" << d->skippedAlbums << "unchanged folders";
+    }
+
     if (d->deferredFileScanning)
     {
         qCDebug(DIGIKAM_DATABASE_LOG) << "Complete scan (file scanning deferred) took:" << time.elapsed() << "msecs.";
@@ -308,6 +329,125 @@ void CollectionScanner::partialScan(const QString& albumRoot, const QString& alb
     updateRemovedItemsTime();
 }
 
+void CollectionScanner::partialScanFiles(const QString& dirPath, const QStringList& fileNames)
+{
+    QString albumRoot = CollectionManager::instance()->albumRootPath(dirPath);
+    QString album     = CollectionManager::instance()->album(dirPath);
+
+    if (albumRoot.isNull() || album.isEmpty())
+    {
+        qCWarning(DIGIKAM_DATABASE_LOG) << "partialScanFiles() called with a path outside of the collection" << dirPath;
+        return;
+    }
+
+    CollectionLocation location = CollectionManager::instance()->locationForAlbumRootPath(albumRoot);
+
+    if (location.isNull())
+    {
+        qCWarning(DIGIKAM_DATABASE_LOG) << "Did not find a CollectionLocation for album root path " << albumRoot;
+        return;
+    }
+
+    QDir dir(location.albumRootPath() + album);
+
+    if (!dir.exists() || !dir.isReadable())
+    {
+        // The removal of the folder itself is handled by a scan of its parent
+        return;
+    }
+
+    mainEntryPoint(false);
+    d->resetRemovedItemsTime();
+
+    MetaEngineSettingsContainer settings = MetaEngineSettings::instance()->settings();
+    QStringList names                    = fileNames;
+
+    // A changed sidecar means a changed item
+
+    foreach (const QString& fileName, fileNames)
+    {
+        if (fileName.endsWith(QLatin1String(".xmp"), Qt::CaseInsensitive))
+        {
+            QString itemName = fileName.left(fileName.length() - 4);
+
+            if (!names.contains(itemName))
+            {
+                names << itemName;
+            }
+        }
+    }
+
+    int albumID = checkAlbum(location, album);
+    QList<qlonglong> removedIds;
+
+    foreach (const QString& fileName, names)
+    {
+        if (!d->checkObserver())
+        {
+            emit cancelled();
+            return;
+        }
+
+        QFileInfo info(dir, fileName);
+        qlonglong imageId = CoreDbAccess().db()->getImageId(albumID, fileName);
+
+        if (!info.isFile())
+        {
+            if (imageId != -1)
+            {
+                removedIds << imageId;
+            }
+
+            continue;
+        }
+
+        // filter with name filter and ignore temp files we created ourselves
+        if (!d->nameFilters.contains(info.suffix().toLower()) ||
+            info.completeSuffix().contains(QLatin1String("digikamtempfile.")))
+        {
+            continue;
+        }
+
+        if (imageId == -1)
+        {
+            scanNewFile(info, albumID);
+        }
+        else
+        {
+            bool hasSidecar = false;
+
+            if (settings.useXMPSidecar4Reading)
+            {
+                QString fileForLR = info.fileName();
+                fileForLR.chop(info.suffix().size());
+
+                hasSidecar = (dir.exists(fileForLR + QLatin1String("xmp")) ||
+                              dir.exists(info.fileName() + QLatin1String(".xmp")));
+            }
+
+            scanFileNormal(info, CoreDbAccess().db()->getItemScanInfo(imageId), hasSidecar);
+        }
+    }
+
+    // Mark items in the db which are not on disk anymore.
+    if (!removedIds.isEmpty())
+    {
+        CoreDbOperationGroup group;
+        CoreDbAccess().db()->removeItems(removedIds, QList<int>() << albumID);
+        itemsWereRemoved(removedIds);
+    }
+
+    finishHistoryScanning();
+
+    if (!d->checkObserver())
+    {
+        emit cancelled();
+        return;
+    }
+
+    updateRemovedItemsTime();
+}
+
 qlonglong CollectionScanner::scanFile(const QString& filePath, FileScanMode mode)
 {
     QFileInfo info(filePath);
@@ -579,6 +719,48 @@ void CollectionScanner::scanAlbum(const CollectionLocation& location, const QStr
     }
 
     int albumID                          = checkAlbum(location, album);
+
+    // Take the fingerprint before listing, so that changes made during the scan are seen next time
+    AlbumScanJournalEntry fingerprint    = d->albumFingerprint(albumID, dir.path());
+
+    if (d->isAlbumUnchanged(fingerprint))
+    {
+        // No file was added, removed or renamed in this folder since it was scanned last time.
+        // Only visit the sub-albums, which have their own modification date.
+
+        ++d->skippedAlbums;
+
+        QStringList subalbums = d->childAlbums.value(location.id()).values(album);
+        subalbums.sort();
+
+        foreach (const QString& subalbum, subalbums)
+        {
+            if (!d->checkObserver())
+            {
+                return;
+            }
+
+            if (d->ignoreDirectory.contains(subalbum.section(QLatin1Char('/'), -1)))
+            {
+                continue;
+            }
+
+            scanAlbum(location, subalbum);
+        }
+
+        d->scannedAlbums << albumID;
+
+        if (d->wantSignals)
+        {
+            int entryCount = d->scanJournal.value(albumID).entryCount;
+
+            emit scannedFiles(entryCount);
+            emit finishedScanningAlbum(location.albumRootPath(), album, entryCount);
+        }
+
+        return;
+    }
+
     QList<ItemScanInfo> scanInfos        = CoreDbAccess().db()->getItemScanInfos(albumID);
     MetaEngineSettingsContainer settings = MetaEngineSettings::instance()->settings();
 
@@ -728,6 +910,18 @@ void CollectionScanner::scanAlbum(const CollectionLocation& location, const QStr
     // mark album as scanned
     d->scannedAlbums << albumID;
 
+    // Files of deferred albums are only scanned later, the folder must not be skipped until then
+    if (d->deferredAlbumPaths.contains(dir.path()))
+    {
+        CoreDbAccess().db()->removeAlbumScanJournalEntry(albumID);
+    }
+    else
+    {
+        fingerprint.entryCount = list.count();
+        fingerprint.scanDate   = QDateTime::currentDateTime();
+        CoreDbAccess().db()->setAlbumScanJournalEntry(fingerprint);
+    }
+
     if (d->wantSignals)
     {
         emit finishedScanningAlbum(location.albumRootPath(), album, list.count());
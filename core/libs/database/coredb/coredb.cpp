@@ -45,6 +45,7 @@ extern "C"
 #include <QFileInfo>
 #include <QDir>
 #include <QVariant>
+#include <QRegularExpression>
 
 // KDE includes
 
@@ -71,7 +72,9 @@ public:
 
     explicit Private()
       : db(0),
-        uniqueHashVersion(-1)
+        uniqueHashVersion(-1),
+        fullTextIndexVersion(-1),
+        scanJournalVersion(-1)
     {
     }
 
@@ -82,11 +85,26 @@ public:
     QList<int>           recentlyAssignedTags;
 
     int                  uniqueHashVersion;
+    int                  fullTextIndexVersion;
+    int                  scanJournalVersion;
 
 public:
 
     QString constructRelatedImagesSQL(bool fromOrTo, DatabaseRelation::Type type, bool boolean);
     QList<qlonglong> execRelatedImagesQuery(DbEngineSqlQuery& query, qlonglong id, DatabaseRelation::Type type);
+
+    /**
+     * Read the given columns of the rows of a table matching a list of image ids.
+     * The ids are passed in chunks, to stay below the bound values limit of the database.
+     * The values of each row are returned keyed by image id.
+     */
+    QHash<qlonglong, QVariantList> execItemsFieldsQuery(const QString& table,
+                                                        const QString& idColumn,
+                                                        const QStringList& fieldNames,
+                                                        const QList<qlonglong>& imageIds);
+
+    /// Maximum number of ids bound in a single query, below the SQLite default limit of 999.
+    static const int itemsQueryChunkSize = 500;
 };
 
 const QString CoreDB::Private::configGroupName(QLatin1String("CoreDB Settings"));
@@ -158,6 +176,51 @@ QList<qlonglong> CoreDB::Private::execRelatedImagesQuery(DbEngineSqlQuery& query
     return imageIds;
 }
 
+QHash<qlonglong, QVariantList> CoreDB::Private::execItemsFieldsQuery(const QString& table,
+                                                                     const QString& idColumn,
+                                                                     const QStringList& fieldNames,
+                                                                     const QList<qlonglong>& imageIds)
+{
+    QHash<qlonglong, QVariantList> results;
+
+    if (imageIds.isEmpty() || fieldNames.isEmpty())
+    {
+        return results;
+    }
+
+    results.reserve(imageIds.size());
+    const int columns = fieldNames.size() + 1;
+
+    for (int start = 0 ; start < imageIds.size() ; start += itemsQueryChunkSize)
+    {
+        QList<qlonglong> chunk = imageIds.mid(start, itemsQueryChunkSize);
+        QVariantList     boundValues;
+        QVariantList     values;
+
+        foreach (const qlonglong& id, chunk)
+        {
+            boundValues << id;
+        }
+
+        QString query(QString::fromUtf8("SELECT "));
+        query += idColumn + QString::fromUtf8(", ");
+        query += fieldNames.join(QString::fromUtf8(", "));
+        query += QString::fromUtf8(" FROM ") + table;
+        query += QString::fromUtf8(" WHERE ") + idColumn + QString::fromUtf8(" IN (");
+        addBoundValuePlaceholders(query, boundValues.size());
+        query += QString::fromUtf8(");");
+
+        db->execSql(query, boundValues, &values);
+
+        for (int i = 0 ; i + columns <= values.size() ; i += columns)
+        {
+            results.insert(values.at(i).toLongLong(), values.mid(i + 1, columns - 1));
+        }
+    }
+
+    return results;
+}
+
 // --------------------------------------------------------
 
 CoreDB::CoreDB(CoreDbBackend* const backend)
@@ -401,6 +464,73 @@ QList<AlbumShortInfo> CoreDB::getAlbumShortInfos()
     return albumList;
 }
 
+QHash<int, AlbumScanJournalEntry> CoreDB::getAlbumScanJournal()
+{
+    QHash<int, AlbumScanJournalEntry> journal;
+
+    if (getScanJournalVersion() <= 0)
+    {
+        return journal;
+    }
+
+    QList<QVariant> values;
+
+    d->db->execSql(QString::fromUtf8("SELECT album, modificationDate, changeDate, entryCount, scanDate "
+                                     "FROM AlbumScanJournal;"),
+                   &values);
+
+    for (QList<QVariant>::const_iterator it = values.constBegin() ; it != values.constEnd() ; )
+    {
+        AlbumScanJournalEntry entry;
+
+        entry.albumId          = (*it).toInt();
+        ++it;
+        entry.modificationDate = (*it).toDateTime();
+        ++it;
+        entry.changeDate       = (*it).toDateTime();
+        ++it;
+        entry.entryCount       = (*it).toInt();
+        ++it;
+        entry.scanDate         = (*it).toDateTime();
+        ++it;
+
+        journal.insert(entry.albumId, entry);
+    }
+
+    return journal;
+}
+
+void CoreDB::setAlbumScanJournalEntry(const AlbumScanJournalEntry& entry)
+{
+    if (getScanJournalVersion() <= 0)
+    {
+        return;
+    }
+
+    QList<QVariant> boundValues;
+    boundValues << entry.albumId
+                << entry.modificationDate
+                << entry.changeDate
+                << entry.entryCount
+                << entry.scanDate;
+
+    d->db->execSql(QString::fromUtf8("REPLACE INTO AlbumScanJournal "
+                                     "(album, modificationDate, changeDate, entryCount, scanDate) "
+                                     "VALUES (?,?,?,?,?);"),
+                   boundValues);
+}
+
+void CoreDB::removeAlbumScanJournalEntry(int albumId)
+{
+    if (getScanJournalVersion() <= 0)
+    {
+        return;
+    }
+
+    d->db->execSql(QString::fromUtf8("DELETE FROM AlbumScanJournal WHERE album=?;"),
+                   albumId);
+}
+
 QList<TagShortInfo> CoreDB::getTagShortInfos()
 {
     QList<QVariant> values;
@@ -1108,6 +1238,112 @@ void CoreDB::setUniqueHashVersion(int version)
     setSetting(QLatin1String("uniqueHashVersion"), QString::number(d->uniqueHashVersion));
 }
 
+int CoreDB::getFullTextIndexVersion()
+{
+    if (d->fullTextIndexVersion == -1)
+    {
+        d->fullTextIndexVersion = getSetting(QLatin1String("fullTextIndexVersion")).toInt();
+    }
+
+    return d->fullTextIndexVersion;
+}
+
+void CoreDB::setFullTextIndexVersion(int version)
+{
+    d->fullTextIndexVersion = version;
+    setSetting(QLatin1String("fullTextIndexVersion"), QString::number(d->fullTextIndexVersion));
+}
+
+int CoreDB::getScanJournalVersion()
+{
+    if (d->scanJournalVersion == -1)
+    {
+        d->scanJournalVersion = getSetting(QLatin1String("scanJournalVersion")).toInt();
+    }
+
+    return d->scanJournalVersion;
+}
+
+void CoreDB::setScanJournalVersion(int version)
+{
+    d->scanJournalVersion = version;
+    setSetting(QLatin1String("scanJournalVersion"), QString::number(d->scanJournalVersion));
+}
+
+QString CoreDB::fullTextCommentCondition(const QString& text, QList<QVariant>* const boundValues)
+{
+    if (getFullTextIndexVersion() <= 0)
+    {
+        return QString();
+    }
+
+    // Keep only the words, so that no query syntax can be passed by the user.
+    // Each word is used as a prefix, so that a word the engine indexed in a longer token is still found.
+
+    QStringList terms;
+    QString     condition;
+
+    switch (d->db->databaseType())
+    {
+        case BdEngineBackend::DbType::SQLite:
+        {
+            // The unicode61 tokenizer of FTS5 splits the text on all non-alphanumeric characters.
+            QStringList words = text.split(QRegularExpression(QLatin1String("[\\W_]+"),
+                                                              QRegularExpression::UseUnicodePropertiesOption),
+                                           QString::SkipEmptyParts);
+
+            // FTS5 query: all the words as prefix tokens, implicitly joined with AND.
+            foreach (const QString& word, words)
+            {
+                terms << QLatin1Char('"') + word + QLatin1String("\"*");
+            }
+
+            condition = QLatin1String("ImageComments.id IN (SELECT rowid FROM ImageCommentsSearch WHERE ImageCommentsSearch MATCH ?)");
+            break;
+        }
+
+        case BdEngineBackend::DbType::MySQL:
+        {
+            // InnoDB keeps underscores in the words, and can keep a word with an apostrophe
+            // as one token. Only the part before the apostrophe is then a prefix of the token.
+            QStringList words = text.split(QRegularExpression(QLatin1String("[^\\w']+"),
+                                                              QRegularExpression::UseUnicodePropertiesOption),
+                                           QString::SkipEmptyParts);
+
+            // The default InnoDB stopwords, and the words shorter than innodb_ft_min_token_size,
+            // are not indexed. A required term with such a word would never match.
+
+            static const QStringList stopwords = QString::fromLatin1("a about an are as at be by com de en for from how i in is "
+                                                                     "it la of on or that the this to was what when where who "
+                                                                     "will with und www").split(QLatin1Char(' '));
+
+            foreach (const QString& token, words)
+            {
+                const QString word = token.section(QLatin1Char('\''), 0, 0);
+
+                if (word.length() >= 3 && !stopwords.contains(word.toLower()))
+                {
+                    // Boolean mode query: all the words are required, as prefixes.
+                    terms << QLatin1Char('+') + word + QLatin1Char('*');
+                }
+            }
+
+            condition = QLatin1String("MATCH (ImageComments.comment) AGAINST (? IN BOOLEAN MODE)");
+            break;
+        }
+    }
+
+    if (terms.isEmpty())
+    {
+        return QString();
+    }
+
+    *boundValues << terms.join(QLatin1Char(' '))
+                 << text;
+
+    return condition + QLatin1String(" AND ImageComments.comment = ?");
+}
+
 /*
 QString CoreDB::getItemCaption(qlonglong imageID)
 {
@@ -1345,17 +1581,54 @@ QVector<QList<int> > CoreDB::getItemsTagIDs(const QList<qlonglong> imageIds)
     }
 
     QVector<QList<int> > results(imageIds.size());
-    DbEngineSqlQuery query = d->db->prepareQuery(QString::fromUtf8("SELECT tagid FROM ImageTags WHERE imageID=?;"));
-    QVariantList values;
+    QHash<qlonglong, int> indexes;
 
     for (int i = 0 ; i < imageIds.size() ; ++i)
     {
-        d->db->execSql(query, imageIds[i], &values);
-        QList<int>& tagIds = results[i];
+        indexes.insert(imageIds.at(i), i);
+    }
+
+    // Ids are looked up by chunks of IN (...) lists instead of one query per item.
+
+    for (int start = 0 ; start < imageIds.size() ; start += Private::itemsQueryChunkSize)
+    {
+        QVariantList boundValues;
+        QVariantList values;
+
+        foreach (const qlonglong& id, imageIds.mid(start, Private::itemsQueryChunkSize))
+        {
+            boundValues << id;
+        }
 
-        foreach (const QVariant& v, values)
+        QString query(QString::fromUtf8("SELECT imageid, tagid FROM ImageTags WHERE imageid IN ("));
+        addBoundValuePlaceholders(query, boundValues.size());
+        query += QString::fromUtf8(");");
+
+        d->db->execSql(query, boundValues, &values);
+
+        for (QList<QVariant>::const_iterator it = values.constBegin() ; it != values.constEnd() ; )
         {
-            tagIds << v.toInt();
+            qlonglong imageId = (*it).toLongLong();
+            ++it;
+            int tagId         = (*it).toInt();
+            ++it;
+
+            results[indexes.value(imageId)] << tagId;
+        }
+    }
+
+    // A list can contain the same id twice.
+
+    if (indexes.size() != imageIds.size())
+    {
+        for (int i = 0 ; i < imageIds.size() ; ++i)
+        {
+            int index = indexes.value(imageIds.at(i));
+
+            if (index != i)
+            {
+                results[i] = results.at(index);
+            }
         }
     }
 
@@ -1706,6 +1979,127 @@ QVariantList CoreDB::getVideoMetadata(qlonglong imageID, DatabaseFields::VideoMe
     return values;
 }
 
+QHash<qlonglong, QVariantList> CoreDB::getItemsImagesFields(const QList<qlonglong>& imageIds,
+                                                            DatabaseFields::Images fields)
+{
+    if (fields == DatabaseFields::ImagesNone)
+    {
+        return QHash<qlonglong, QVariantList>();
+    }
+
+    QStringList fieldNames                = imagesFieldList(fields);
+    QHash<qlonglong, QVariantList> result = d->execItemsFieldsQuery(QLatin1String("Images"),
+                                                                    QLatin1String("id"),
+                                                                    fieldNames, imageIds);
+
+    // Convert date times to QDateTime, they come as QString
+    if (fields & DatabaseFields::ModificationDate)
+    {
+        int index = fieldNames.indexOf(QLatin1String("modificationDate"));
+
+        for (QHash<qlonglong, QVariantList>::iterator it = result.begin() ; it != result.end() ; ++it)
+        {
+            (*it)[index] = it->at(index).toDateTime();
+        }
+    }
+
+    return result;
+}
+
+QHash<qlonglong, QVariantList> CoreDB::getItemsInformation(const QList<qlonglong>& imageIds,
+                                                           DatabaseFields::ItemInformation fields)
+{
+    if (fields == DatabaseFields::ItemInformationNone)
+    {
+        return QHash<qlonglong, QVariantList>();
+    }
+
+    QStringList fieldNames                = imageInformationFieldList(fields);
+    QHash<qlonglong, QVariantList> result = d->execItemsFieldsQuery(QLatin1String("ImageInformation"),
+                                                                    QLatin1String("imageid"),
+                                                                    fieldNames, imageIds);
+
+    // Convert date times to QDateTime, they come as QString
+    int creationIndex     = fieldNames.indexOf(QLatin1String("creationDate"));
+    int digitizationIndex = fieldNames.indexOf(QLatin1String("digitizationDate"));
+
+    for (QHash<qlonglong, QVariantList>::iterator it = result.begin() ; it != result.end() ; ++it)
+    {
+        if (creationIndex != -1)
+        {
+            (*it)[creationIndex] = it->at(creationIndex).toDateTime();
+        }
+
+        if (digitizationIndex != -1)
+        {
+            (*it)[digitizationIndex] = it->at(digitizationIndex).toDateTime();
+        }
+    }
+
+    return result;
+}
+
+QHash<qlonglong, QVariantList> CoreDB::getItemsImageMetadata(const QList<qlonglong>& imageIds,
+                                                             DatabaseFields::ImageMetadata fields)
+{
+    if (fields == DatabaseFields::ImageMetadataNone)
+    {
+        return QHash<qlonglong, QVariantList>();
+    }
+
+    return d->execItemsFieldsQuery(QLatin1String("ImageMetadata"), QLatin1String("imageid"),
+                                   imageMetadataFieldList(fields), imageIds);
+}
+
+QHash<qlonglong, QVariantList> CoreDB::getItemsVideoMetadata(const QList<qlonglong>& imageIds,
+                                                             DatabaseFields::VideoMetadata fields)
+{
+    if (fields == DatabaseFields::VideoMetadataNone)
+    {
+        return QHash<qlonglong, QVariantList>();
+    }
+
+    return d->execItemsFieldsQuery(QLatin1String("VideoMetadata"), QLatin1String("imageid"),
+                                   videoMetadataFieldList(fields), imageIds);
+}
+
+QHash<qlonglong, QVariantList> CoreDB::getItemsPositions(const QList<qlonglong>& imageIds,
+                                                         DatabaseFields::ItemPositions fields)
+{
+    if (fields == DatabaseFields::ItemPositionsNone)
+    {
+        return QHash<qlonglong, QVariantList>();
+    }
+
+    QStringList fieldNames                = imagePositionsFieldList(fields);
+    QHash<qlonglong, QVariantList> result = d->execItemsFieldsQuery(QLatin1String("ImagePositions"),
+                                                                    QLatin1String("imageid"),
+                                                                    fieldNames, imageIds);
+
+    // For some reason REAL values may come as QString QVariants. Convert here.
+    for (QHash<qlonglong, QVariantList>::iterator it = result.begin() ; it != result.end() ; ++it)
+    {
+        for (int i = 0 ; i < it->size() ; ++i)
+        {
+            if (it->at(i).type() == QVariant::String                     &&
+                !it->at(i).isNull()                                      &&
+                (fieldNames.at(i) == QLatin1String("latitudeNumber")  ||
+                 fieldNames.at(i) == QLatin1String("longitudeNumber") ||
+                 fieldNames.at(i) == QLatin1String("altitude")        ||
+                 fieldNames.at(i) == QLatin1String("orientation")     ||
+                 fieldNames.at(i) == QLatin1String("tilt")            ||
+                 fieldNames.at(i) == QLatin1String("roll")            ||
+                 fieldNames.at(i) == QLatin1String("accuracy"))
+               )
+            {
+                (*it)[i] = it->at(i).toDouble();
+            }
+        }
+    }
+
+    return result;
+}
+
 QVariantList CoreDB::getItemPosition(qlonglong imageID, DatabaseFields::ItemPositions fields)
 {
     QVariantList values;
@@ -2039,6 +2433,55 @@ QList<CommentInfo> CoreDB::getItemComments(qlonglong imageID)
     return list;
 }
 
+QHash<qlonglong, QList<CommentInfo> > CoreDB::getItemsComments(const QList<qlonglong>& imageIds)
+{
+    QStringList fieldNames;
+    fieldNames << QLatin1String("id")
+               << QLatin1String("type")
+               << QLatin1String("language")
+               << QLatin1String("author")
+               << QLatin1String("date")
+               << QLatin1String("comment");
+
+    QHash<qlonglong, QList<CommentInfo> > results;
+    const int columns = fieldNames.size() + 1;
+
+    for (int start = 0 ; start < imageIds.size() ; start += Private::itemsQueryChunkSize)
+    {
+        QVariantList boundValues;
+        QVariantList values;
+
+        foreach (const qlonglong& id, imageIds.mid(start, Private::itemsQueryChunkSize))
+        {
+            boundValues << id;
+        }
+
+        QString query(QString::fromUtf8("SELECT imageid, "));
+        query += fieldNames.join(QString::fromUtf8(", "));
+        query += QString::fromUtf8(" FROM ImageComments WHERE imageid IN (");
+        addBoundValuePlaceholders(query, boundValues.size());
+        query += QString::fromUtf8(");");
+
+        d->db->execSql(query, boundValues, &values);
+
+        for (int i = 0 ; i + columns <= values.size() ; i += columns)
+        {
+            CommentInfo info;
+            info.imageId  = values.at(i).toLongLong();
+            info.id       = values.at(i + 1).toInt();
+            info.type     = (DatabaseComment::Type)values.at(i + 2).toInt();
+            info.language = values.at(i + 3).toString();
+            info.author   = values.at(i + 4).toString();
+            info.date     = values.at(i + 5).toDateTime();
+            info.comment  = values.at(i + 6).toString();
+
+            results[info.imageId] << info;
+        }
+    }
+
+    return results;
+}
+
 int CoreDB::setImageComment(qlonglong imageID, const QString& comment, DatabaseComment::Type type,
                             const QString& language, const QString& author, const QDateTime& date)
 {
@@ -3396,37 +3839,30 @@ QList<QDateTime> CoreDB::getAllCreationDates()
 
 QMap<QDateTime, int> CoreDB::getAllCreationDatesAndNumberOfImages()
 {
+    // Items are counted per day by the database: the result has one entry
+    // per day holding items, not one entry per item.
+
     QList<QVariant> values;
-    d->db->execSql(QString::fromUtf8("SELECT creationDate FROM ImageInformation "
-                                     "INNER JOIN Images ON Images.id=ImageInformation.imageid "
-                                     " WHERE Images.status=1;"),
-                   &values);
+    d->db->execDBAction(d->db->getDBAction(QLatin1String("getCreationDatesHistogram")), &values);
 
     QMap<QDateTime, int> datesStatMap;
 
-    foreach (const QVariant& value, values)
+    for (QList<QVariant>::const_iterator it = values.constBegin() ; it != values.constEnd() ;)
     {
-        if (!value.isNull())
-        {
-            QDateTime dateTime = value.toDateTime();
-
-            if (!dateTime.isValid())
-            {
-                continue;
-            }
-
-            QMap<QDateTime, int>::iterator it2 = datesStatMap.find(dateTime);
+        QDate date = (*it).toDate();
+        ++it;
+        int count  = (*it).toInt();
+        ++it;
 
-            if (it2 == datesStatMap.end())
-            {
-                datesStatMap.insert(dateTime, 1);
-            }
-            else
-            {
-                it2.value()++;
-            }
+        if (!date.isValid())
+        {
+            continue;
         }
+
+        // Different text representations can map to the same day.
+        datesStatMap[QDateTime(date)] += count;
     }
+
     return datesStatMap;
 }
 
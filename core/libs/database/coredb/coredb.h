@@ -35,6 +35,7 @@
 #include <QDateTime>
 #include <QPair>
 #include <QMap>
+#include <QHash>
 #include <QUuid>
 
 // Local includes
@@ -122,6 +123,35 @@ public:
 
     void setUniqueHashVersion(int version);
 
+    /**
+     * Returns the version of the full text index of the ImageComments table,
+     * or 0 if the database has none. The value is cached.
+     */
+    int getFullTextIndexVersion();
+
+    void setFullTextIndexVersion(int version);
+
+    /**
+     * Returns the version of the album scan journal table,
+     * or 0 if the database has none. The value is cached.
+     */
+    int getScanJournalVersion();
+
+    void setScanJournalVersion(int version);
+
+    /**
+     * Returns a condition on ImageComments rows, matching the comments equal to the given text.
+     * The full text index selects the comments containing all the words of the text, and an
+     * equality condition on these rows checks the whole text. The words the index cannot match,
+     * as MySQL stopwords, are left to the equality condition. The results are thus the same
+     * as with the equality condition alone, with both database backends.
+     * The index cannot be used for a "contains" search: the text may start in the middle of a word.
+     * The bound values of the condition are appended to boundValues.
+     * Returns a null string if there is no full text index, or if the text has no word the
+     * index can match. The caller shall then use an equality condition only.
+     */
+    QString fullTextCommentCondition(const QString& text, QList<QVariant>* const boundValues);
+
     bool isUniqueHashV2();
 
     // ----------- AlbumRoot operations -----------
@@ -199,6 +229,27 @@ public:
      */
     QList<AlbumShortInfo> getAlbumShortInfos();
 
+    /**
+     * Returns the album scan journal, keyed by album id.
+     * The journal records the directory fingerprint of each album seen by
+     * the last complete collection scan, so that the next one can skip the
+     * files of unchanged directories.
+     * Returns an empty hash if the database has no scan journal.
+     */
+    QHash<int, AlbumScanJournalEntry> getAlbumScanJournal();
+
+    /**
+     * Records the fingerprint of an album directory in the scan journal.
+     * Does nothing if the database has no scan journal.
+     */
+    void setAlbumScanJournalEntry(const AlbumScanJournalEntry& entry);
+
+    /**
+     * Removes the scan journal entry of the given album,
+     * so that the next complete scan will look at all its files.
+     */
+    void removeAlbumScanJournalEntry(int albumId);
+
     /**
      * Returns all tags in the database with their parent id and name,
      * ordered by id.
@@ -702,8 +753,8 @@ public:
     QList<QDateTime> getAllCreationDates();
 
     /**
-     * Returns a QMap<QDateTime,int> of creationDate -> count of items
-     * with the tag
+     * Returns a QMap<QDateTime,int> of creation day -> count of visible items
+     * created this day. Items are grouped by the database, keys are at midnight.
      */
     QMap<QDateTime, int> getAllCreationDatesAndNumberOfImages();
 
@@ -899,6 +950,24 @@ public:
     QVariantList getVideoMetadata(qlonglong imageID,
                                   DatabaseFields::VideoMetadata metadataFields = DatabaseFields::VideoMetadataAll);
 
+    /**
+     * For a list of items, return the requested fields of the Images, ImageInformation,
+     * ImageMetadata, VideoMetadata and ImagePositions tables, as the single item versions above.
+     * Values are returned in a hash keyed by image id. Items without entry in the table
+     * are not contained in the hash.
+     * The values are read with a few queries matching chunks of ids, instead of one query per item.
+     */
+    QHash<qlonglong, QVariantList> getItemsImagesFields(const QList<qlonglong>& imageIds,
+                                                        DatabaseFields::Images fields);
+    QHash<qlonglong, QVariantList> getItemsInformation(const QList<qlonglong>& imageIds,
+                                                       DatabaseFields::ItemInformation fields);
+    QHash<qlonglong, QVariantList> getItemsImageMetadata(const QList<qlonglong>& imageIds,
+                                                         DatabaseFields::ImageMetadata fields);
+    QHash<qlonglong, QVariantList> getItemsVideoMetadata(const QList<qlonglong>& imageIds,
+                                                         DatabaseFields::VideoMetadata fields);
+    QHash<qlonglong, QVariantList> getItemsPositions(const QList<qlonglong>& imageIds,
+                                                     DatabaseFields::ItemPositions fields);
+
     /**
      * Add (or replace) the ItemPosition of the specified item.
      * If there is already an entry, it will be discarded.
@@ -950,6 +1019,12 @@ public:
      */
     QList<CommentInfo> getItemComments(qlonglong imageID);
 
+    /**
+     * For a list of items, retrieves all available comments, keyed by image id.
+     * Amounts to calling getItemComments for each id in imageIds, but is optimized.
+     */
+    QHash<qlonglong, QList<CommentInfo> > getItemsComments(const QList<qlonglong>& imageIds);
+
     /**
      * Sets the comments for the image. A comment for the image with the same
      * source, language and author will be overwritten.
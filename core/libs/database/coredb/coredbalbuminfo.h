@@ -221,6 +221,38 @@ public:
 
 // --------------------------------------------------------------------------
 
+/**
+ * The fingerprint of an album directory, as recorded by the last complete collection scan.
+ */
+class AlbumScanJournalEntry
+{
+public:
+
+    explicit AlbumScanJournalEntry()
+      : albumId(0),
+        entryCount(0)
+    {
+    };
+
+    bool isNull() const
+    {
+        return albumId == 0;
+    }
+
+public:
+
+    int       albumId;
+    /// Modification time of the directory: changes when entries are added, removed or renamed.
+    QDateTime modificationDate;
+    /// Status change time of the directory.
+    QDateTime changeDate;
+    /// Number of files and directories in the directory, before name filtering.
+    int       entryCount;
+    QDateTime scanDate;
+};
+
+// --------------------------------------------------------------------------
+
 class TagShortInfo
 {
 public:
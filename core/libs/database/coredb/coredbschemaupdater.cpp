@@ -69,6 +69,16 @@ int CoreDbSchemaUpdater::uniqueHashVersion()
     return 2;
 }
 
+int CoreDbSchemaUpdater::fullTextIndexVersion()
+{
+    return 1;
+}
+
+int CoreDbSchemaUpdater::scanJournalVersion()
+{
+    return 1;
+}
+
 bool CoreDbSchemaUpdater::isUniqueHashUpToDate()
 {
     return CoreDbAccess().db()->getUniqueHashVersion() >= uniqueHashVersion();
@@ -151,6 +161,8 @@ bool CoreDbSchemaUpdater::update()
     }
 
     updateFilterSettings();
+    updateFullTextIndex();
+    updateScanJournal();
 
     if (d->observer)
     {
@@ -540,6 +552,68 @@ bool CoreDbSchemaUpdater::updateFilterSettings()
     return true;
 }
 
+bool CoreDbSchemaUpdater::updateFullTextIndex()
+{
+    // The full text index is optional: it is not part of the schema version,
+    // and searches fall back to LIKE queries if it cannot be created.
+    //
+    // With SQLite, triggers on ImageComments keep the index up to date. They need the FTS5
+    // module: with an SQLite library built without it, all comment writes would fail.
+    // The index is only created if FTS5 is available, and it is dropped if the database
+    // is opened later with a library without FTS5. It is created again when FTS5 is back.
+
+    if (d->parameters.isSQLite() &&
+        !d->backend->execDBAction(d->backend->getDBAction(QLatin1String("CheckFullTextIndexSupport"))))
+    {
+        if (d->albumDB->getFullTextIndexVersion() > 0)
+        {
+            d->backend->execDBAction(d->backend->getDBAction(QLatin1String("DropFullTextIndex")));
+            d->albumDB->setFullTextIndexVersion(0);
+            qCWarning(DIGIKAM_COREDB_LOG) << "Core database: SQLite has no FTS5 module. The full text index is dropped.";
+        }
+
+        return false;
+    }
+
+    if (d->albumDB->getFullTextIndexVersion() >= fullTextIndexVersion())
+    {
+        return true;
+    }
+
+    if (!d->backend->execDBAction(d->backend->getDBAction(QLatin1String("CreateFullTextIndex"))))
+    {
+        qCWarning(DIGIKAM_COREDB_LOG) << "Core database: cannot create the full text index. Text searches will not use it.";
+        return false;
+    }
+
+    d->albumDB->setFullTextIndexVersion(fullTextIndexVersion());
+    qCDebug(DIGIKAM_COREDB_LOG) << "Core database: full text index created";
+
+    return true;
+}
+
+bool CoreDbSchemaUpdater::updateScanJournal()
+{
+    // The scan journal is optional: it is not part of the schema version,
+    // and the collection scanner walks all folders if it does not exist.
+
+    if (d->albumDB->getScanJournalVersion() >= scanJournalVersion())
+    {
+        return true;
+    }
+
+    if (!d->backend->execDBAction(d->backend->getDBAction(QLatin1String("CreateScanJournal"))))
+    {
+        qCWarning(DIGIKAM_COREDB_LOG) << "Core database: cannot create the album scan journal. Collection scans will not use it.";
+        return false;
+    }
+
+    d->albumDB->setScanJournalVersion(scanJournalVersion());
+    qCDebug(DIGIKAM_COREDB_LOG) << "Core database: album scan journal created";
+
+    return true;
+}
+
 bool CoreDbSchemaUpdater::createDatabase()
 {
     if ( createTables() && createIndices() && createTriggers())
@@ -50,6 +50,8 @@ public:
     static int  schemaVersion();
     static int  filterSettingsVersion();
     static int  uniqueHashVersion();
+    static int  fullTextIndexVersion();
+    static int  scanJournalVersion();
     static bool isUniqueHashUpToDate();
 
 public:
@@ -77,6 +79,8 @@ private:
     void defaultIgnoreDirectoryFilterSettings(QStringList& defaultIgnoreDirectoryFilter);
     bool createFilterSettings();
     bool updateFilterSettings();
+    bool updateFullTextIndex();
+    bool updateScanJournal();
     bool createDatabase();
     bool createTables();
     bool createIndices();
@@ -35,6 +35,7 @@
 #include "collectionlocation.h"
 #include "coredbaccess.h"
 #include "iteminfo.h"
+#include "itemscanner.h"
 #include "thumbnailcreator.h"
 
 namespace Digikam
@@ -68,4 +69,16 @@ int DatabaseLoadSaveFileInfoProvider::orientationHint(const QString& path)
     return info.orientation();
 }
 
+QString DatabaseLoadSaveFileInfoProvider::rawPreviewIndex(const QString& path)
+{
+    ItemInfo info = ItemInfo::fromLocalFile(path);
+
+    if (info.isNull())
+    {
+        return QString();
+    }
+
+    return CoreDbAccess().db()->getImageProperty(info.id(), ItemScanner::rawPreviewIndexPropertyName());
+}
+
 } // namespace Digikam
@@ -45,7 +45,8 @@ class DIGIKAM_DATABASE_EXPORT DatabaseLoadSaveFileInfoProvider : public LoadSave
 {
 public:
 
-    virtual int orientationHint(const QString& path);
+    virtual int     orientationHint(const QString& path);
+    virtual QString rawPreviewIndex(const QString& path);
 };
 
 } // namespace Digikam
@@ -35,6 +35,7 @@ DBJobsThread::DBJobsThread(QObject* const parent)
     : ActionThreadBase(parent)
 {
     setObjectName(QLatin1String("DBJobsThread"));
+    setJobsPriority(ThreadScheduler::Interactive);
 }
 
 DBJobsThread::~DBJobsThread()
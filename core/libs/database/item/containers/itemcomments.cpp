@@ -46,9 +46,14 @@ public:
     }
 
     void init(CoreDbAccess& access, qlonglong imageId)
+    {
+        init(imageId, access.db()->getItemComments(imageId));
+    }
+
+    void init(qlonglong imageId, const QList<CommentInfo>& commentInfos)
     {
         id    = imageId;
-        infos = access.db()->getItemComments(id);
+        infos = commentInfos;
 
         for (int i = 0 ; i < infos.size() ; ++i)
         {
@@ -169,6 +174,12 @@ ItemComments::ItemComments(CoreDbAccess& access, qlonglong imageid)
     d->init(access, imageid);
 }
 
+ItemComments::ItemComments(qlonglong imageid, const QList<CommentInfo>& infos)
+    : d(new Private)
+{
+    d->init(imageid, infos);
+}
+
 ItemComments::ItemComments(const ItemComments& other)
 {
     d = other.d;
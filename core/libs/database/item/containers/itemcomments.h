@@ -98,6 +98,12 @@ public:
      */
     ItemComments(CoreDbAccess& access, qlonglong imageid);
 
+    /**
+     * Create a ItemComments object for the image with the specified id,
+     * from comments already read from the database, see CoreDB::getItemsComments().
+     */
+    ItemComments(qlonglong imageid, const QList<CommentInfo>& infos);
+
     ItemComments(const ItemComments& other);
     ~ItemComments();
 
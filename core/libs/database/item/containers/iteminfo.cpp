@@ -31,6 +31,8 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QHash>
+#include <QPair>
+#include <QSet>
 
 // Local includes
 
@@ -800,6 +802,263 @@ void ItemInfoList::loadTagIds() const
     }
 }
 
+void ItemInfoList::loadFields(const DatabaseFields::Set& fields) const
+{
+    if (fields.getItemInformation() & (DatabaseFields::ColorLabel | DatabaseFields::PickLabel))
+    {
+        // Labels are computed from the tag ids.
+        loadTagIds();
+    }
+
+    // The values are read with fixed field sets, so that the position of each value is known.
+
+    const DatabaseFields::Images imagesFields            = DatabaseFields::Category         |
+                                                           DatabaseFields::ModificationDate |
+                                                           DatabaseFields::FileSize         |
+                                                           DatabaseFields::UniqueHash       |
+                                                           DatabaseFields::ManualOrder;
+    const DatabaseFields::ItemInformation infoFields     = DatabaseFields::Rating           |
+                                                           DatabaseFields::CreationDate     |
+                                                           DatabaseFields::Width            |
+                                                           DatabaseFields::Height           |
+                                                           DatabaseFields::Format;
+    const DatabaseFields::ItemPositions positionsFields  = DatabaseFields::LatitudeNumber   |
+                                                           DatabaseFields::LongitudeNumber  |
+                                                           DatabaseFields::Altitude;
+
+    const DatabaseFields::Images          requestedImages        = fields.getImages() & imagesFields;
+    const DatabaseFields::ItemInformation requestedInfo          = fields.getItemInformation();
+    const DatabaseFields::ImageMetadata   requestedImageMetadata = fields.getImageMetadata();
+    const DatabaseFields::VideoMetadata   requestedVideoMetadata = fields.getVideoMetadata();
+    const bool requestedComments                                 = fields.getItemComments() & DatabaseFields::Comment;
+    const bool requestedPositions                                = fields.hasFieldsFromItemPositions();
+
+    QSet<qlonglong> imagesIds;
+    QSet<qlonglong> infoIds;
+    QSet<qlonglong> commentsIds;
+    QSet<qlonglong> positionsIds;
+    QSet<qlonglong> imageMetadataIds;
+    QSet<qlonglong> videoMetadataIds;
+
+    {
+        ItemInfoReadLocker lock;
+
+        foreach (const ItemInfo& info, *this)
+        {
+            if (!info.m_data)
+            {
+                continue;
+            }
+
+            const qlonglong id = info.m_data->id;
+
+            if (((requestedImages & DatabaseFields::Category)         && !info.m_data->categoryCached)         ||
+                ((requestedImages & DatabaseFields::ModificationDate) && !info.m_data->modificationDateCached) ||
+                ((requestedImages & DatabaseFields::FileSize)         && !info.m_data->fileSizeCached)         ||
+                ((requestedImages & DatabaseFields::UniqueHash)       && !info.m_data->uniqueHashCached)       ||
+                ((requestedImages & DatabaseFields::ManualOrder)      && !info.m_data->manualOrderCached))
+            {
+                imagesIds << id;
+            }
+
+            if (((requestedInfo & DatabaseFields::Rating)                                && !info.m_data->ratingCached)       ||
+                ((requestedInfo & DatabaseFields::CreationDate)                          && !info.m_data->creationDateCached) ||
+                ((requestedInfo & (DatabaseFields::Width | DatabaseFields::Height))      && !info.m_data->imageSizeCached)    ||
+                ((requestedInfo & DatabaseFields::Format)                                && !info.m_data->formatCached))
+            {
+                infoIds << id;
+            }
+
+            if (requestedComments && (!info.m_data->defaultCommentCached || !info.m_data->defaultTitleCached))
+            {
+                commentsIds << id;
+            }
+
+            if (requestedPositions && !info.m_data->positionsCached)
+            {
+                positionsIds << id;
+            }
+
+            if (info.m_data->hasImageMetadata &&
+                (requestedImageMetadata & ~info.m_data->imageMetadataCached))
+            {
+                imageMetadataIds << id;
+            }
+
+            if (info.m_data->hasVideoMetadata &&
+                (requestedVideoMetadata & ~info.m_data->videoMetadataCached))
+            {
+                videoMetadataIds << id;
+            }
+        }
+    }
+
+    if (imagesIds.isEmpty()        && infoIds.isEmpty()          && commentsIds.isEmpty() &&
+        positionsIds.isEmpty()     && imageMetadataIds.isEmpty() && videoMetadataIds.isEmpty())
+    {
+        return;
+    }
+
+    QHash<qlonglong, QVariantList>        imagesValues;
+    QHash<qlonglong, QVariantList>        infoValues;
+    QHash<qlonglong, QList<CommentInfo> > commentsValues;
+    QHash<qlonglong, QVariantList>        positionsValues;
+    QHash<qlonglong, QVariantList>        imageMetadataValues;
+    QHash<qlonglong, QVariantList>        videoMetadataValues;
+
+    {
+        CoreDbAccess access;
+        imagesValues        = access.db()->getItemsImagesFields(imagesIds.toList(), imagesFields);
+        infoValues          = access.db()->getItemsInformation(infoIds.toList(), infoFields);
+        commentsValues      = access.db()->getItemsComments(commentsIds.toList());
+        positionsValues     = access.db()->getItemsPositions(positionsIds.toList(), positionsFields);
+        imageMetadataValues = access.db()->getItemsImageMetadata(imageMetadataIds.toList(), requestedImageMetadata);
+        videoMetadataValues = access.db()->getItemsVideoMetadata(videoMetadataIds.toList(), requestedVideoMetadata);
+    }
+
+    // Default comments and titles are chosen outside of the lock, as ItemInfo::comment() does.
+
+    QHash<qlonglong, QPair<QString, QString> > defaultComments;
+
+    foreach (const qlonglong& id, commentsIds)
+    {
+        ItemComments comments(id, commentsValues.value(id));
+        defaultComments.insert(id, qMakePair(comments.defaultComment(),
+                                             comments.defaultComment(DatabaseComment::Title)));
+    }
+
+    ItemInfoWriteLocker lock;
+
+    foreach (const ItemInfo& info, *this)
+    {
+        if (!info.m_data)
+        {
+            continue;
+        }
+
+        ItemInfoData* const data = info.m_data.constCastData();
+        const qlonglong id       = data->id;
+
+        if (imagesIds.contains(id))
+        {
+            // Missing rows leave the default values, as the single item accessors do.
+
+            QVariantList values = imagesValues.value(id);
+
+            if (values.size() == 5)
+            {
+                data->category         = (DatabaseItem::Category)values.at(0).toInt();
+                data->modificationDate = values.at(1).toDateTime();
+                data->fileSize         = values.at(2).toLongLong();
+                data->uniqueHash       = values.at(3).toString();
+                data->manualOrder      = values.at(4).toLongLong();
+            }
+
+            data->categoryCached         = true;
+            data->modificationDateCached = true;
+            data->fileSizeCached         = true;
+            data->uniqueHashCached       = true;
+            data->manualOrderCached      = true;
+        }
+
+        if (infoIds.contains(id))
+        {
+            QVariantList values = infoValues.value(id);
+
+            if (values.size() == 5)
+            {
+                data->rating       = values.at(0).toInt();
+                data->creationDate = values.at(1).toDateTime();
+                data->imageSize    = QSize(values.at(2).toInt(), values.at(3).toInt());
+                data->format       = values.at(4).toString();
+            }
+
+            data->ratingCached       = true;
+            data->creationDateCached = true;
+            data->imageSizeCached    = true;
+            data->formatCached       = true;
+        }
+
+        if (defaultComments.contains(id))
+        {
+            const QPair<QString, QString>& comments = defaultComments[id];
+            data->defaultComment       = comments.first;
+            data->defaultTitle         = comments.second;
+            data->defaultCommentCached = true;
+            data->defaultTitleCached   = true;
+        }
+
+        if (positionsIds.contains(id))
+        {
+            QVariantList values = positionsValues.value(id);
+
+            if (values.size() == 3)
+            {
+                data->latitude       = values.at(0).toDouble();
+                data->longitude      = values.at(1).toDouble();
+                data->altitude       = values.at(2).toDouble();
+                data->hasCoordinates = !values.at(0).isNull() && !values.at(1).isNull();
+                data->hasAltitude    = !values.at(2).isNull();
+            }
+            else
+            {
+                data->hasCoordinates = false;
+                data->hasAltitude    = false;
+            }
+
+            data->positionsCached = true;
+        }
+
+        if (imageMetadataIds.contains(id))
+        {
+            QHash<qlonglong, QVariantList>::const_iterator it = imageMetadataValues.constFind(id);
+
+            if (it == imageMetadataValues.constEnd())
+            {
+                data->hasImageMetadata    = false;
+                data->databaseFieldsHashRaw.removeAllFields(DatabaseFields::ImageMetadataAll);
+                data->imageMetadataCached = DatabaseFields::ImageMetadataNone;
+            }
+            else
+            {
+                int fieldsIndex = 0;
+
+                for (DatabaseFields::ImageMetadataIteratorSetOnly fit(requestedImageMetadata) ; !fit.atEnd() ; ++fit)
+                {
+                    data->databaseFieldsHashRaw.insertField(*fit, it->at(fieldsIndex));
+                    ++fieldsIndex;
+                }
+
+                data->imageMetadataCached |= requestedImageMetadata;
+            }
+        }
+
+        if (videoMetadataIds.contains(id))
+        {
+            QHash<qlonglong, QVariantList>::const_iterator it = videoMetadataValues.constFind(id);
+
+            if (it == videoMetadataValues.constEnd())
+            {
+                data->hasVideoMetadata    = false;
+                data->databaseFieldsHashRaw.removeAllFields(DatabaseFields::VideoMetadataAll);
+                data->videoMetadataCached = DatabaseFields::VideoMetadataNone;
+            }
+            else
+            {
+                int fieldsIndex = 0;
+
+                for (DatabaseFields::VideoMetadataIteratorSetOnly fit(requestedVideoMetadata) ; !fit.atEnd() ; ++fit)
+                {
+                    data->databaseFieldsHashRaw.insertField(*fit, it->at(fieldsIndex));
+                    ++fieldsIndex;
+                }
+
+                data->videoMetadataCached |= requestedVideoMetadata;
+            }
+        }
+    }
+}
+
 int ItemInfo::orientation() const
 {
     if (!m_data)
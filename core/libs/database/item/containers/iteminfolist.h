@@ -57,6 +57,18 @@ public:
     void loadGroupImageIds() const;
     void loadTagIds()        const;
 
+    /**
+     * Read the given fields of all items from the database with a few queries,
+     * instead of one query per item and field when the values are accessed later.
+     * Values already cached are not read again.
+     * Supported are the fields cached by ItemInfo: category, modification date, file size,
+     * unique hash and manual order from Images, rating, creation date, size and format
+     * from ItemInformation, the default comment and title (DatabaseFields::Comment),
+     * coordinates and altitude from ItemPositions, and all ImageMetadata and VideoMetadata fields.
+     * Requesting the color or pick label loads the tag ids. Other fields are ignored.
+     */
+    void loadFields(const DatabaseFields::Set& fields) const;
+
     bool static namefileLessThan(const ItemInfo& d1, const ItemInfo& d2);
 
     /**
@@ -673,14 +673,13 @@ bool ItemQueryBuilder::buildField(QString& sql, SearchXmlCachingReader& reader,
                 return false;
             }
 
-            foreach (const QString& value, values)
-            {
-                sql += QString::fromUtf8("( Upper(VideoMetadata.videoCodec) LIKE '%") + value.toUpper() + QString::fromUtf8("%' ");
+            sql += QString::fromUtf8("( ");
 
-                if (value != values.last())
-                {
-                    sql += QString::fromUtf8("OR ");
-                }
+            for (int i = 0 ; i < values.size() ; ++i)
+            {
+                addSqlOperator(sql, SearchXml::Or, i == 0);
+                sql          += QString::fromUtf8(" Upper(VideoMetadata.videoCodec) LIKE ? ");
+                *boundValues << QString(QLatin1Char('%') + values.at(i).toUpper() + QLatin1Char('%'));
             }
 
             sql += QString::fromUtf8(") ");
@@ -688,7 +687,8 @@ bool ItemQueryBuilder::buildField(QString& sql, SearchXmlCachingReader& reader,
         else
         {
             QString value = reader.value();
-            sql += QString::fromUtf8("(Upper(VideoMetadata.videoCodec) LIKE '%") + value.toUpper() + QString::fromUtf8("%') ");
+            sql          += QString::fromUtf8("(Upper(VideoMetadata.videoCodec) LIKE ?) ");
+            *boundValues << QString(QLatin1Char('%') + value.toUpper() + QLatin1Char('%'));
         }
     }
     else if (name == QLatin1String("make"))
@@ -802,12 +802,7 @@ bool ItemQueryBuilder::buildField(QString& sql, SearchXmlCachingReader& reader,
     }
     else if (name == QLatin1String("comment"))
     {
-        sql += QString::fromUtf8(" (Images.id IN "
-               " (SELECT imageid FROM ImageComments "
-               "  WHERE type=? AND comment ");
-        ItemQueryBuilder::addSqlRelation(sql, relation);
-        sql += QString::fromUtf8(" ?)) ");
-        *boundValues << DatabaseComment::Comment << fieldQuery.prepareForLike(reader.value());
+        buildCommentField(sql, reader, DatabaseComment::Comment, boundValues);
     }
     else if (name == QLatin1String("commentauthor"))
     {
@@ -820,21 +815,11 @@ bool ItemQueryBuilder::buildField(QString& sql, SearchXmlCachingReader& reader,
     }
     else if (name == QLatin1String("headline"))
     {
-        sql += QString::fromUtf8(" (Images.id IN "
-               " (SELECT imageid FROM ImageComments "
-               "  WHERE type=? AND comment ");
-        ItemQueryBuilder::addSqlRelation(sql, relation);
-        sql += QString::fromUtf8(" ?)) ");
-        *boundValues << DatabaseComment::Headline << fieldQuery.prepareForLike(reader.value());
+        buildCommentField(sql, reader, DatabaseComment::Headline, boundValues);
     }
     else if (name == QLatin1String("title"))
     {
-        sql += QString::fromUtf8(" (Images.id IN "
-               " (SELECT imageid FROM ImageComments "
-               "  WHERE type=? AND comment ");
-        ItemQueryBuilder::addSqlRelation(sql, relation);
-        sql += QString::fromUtf8(" ?)) ");
-        *boundValues << DatabaseComment::Title << fieldQuery.prepareForLike(reader.value());
+        buildCommentField(sql, reader, DatabaseComment::Title, boundValues);
     }
     else if (name == QLatin1String("imagetagproperty"))
     {
@@ -926,10 +911,10 @@ bool ItemQueryBuilder::buildField(QString& sql, SearchXmlCachingReader& reader,
         buildField(sql, reader, QLatin1String("albumcollection"), boundValues, hooks);
 
         addSqlOperator(sql, SearchXml::Or, false);
-        buildField(sql, reader, QLatin1String("comment"), boundValues, hooks);
+        buildCommentField(sql, reader, DatabaseComment::Comment, boundValues);
 
         addSqlOperator(sql, SearchXml::Or, false);
-        buildField(sql, reader, QLatin1String("title"), boundValues, hooks);
+        buildCommentField(sql, reader, DatabaseComment::Title, boundValues);
 
         sql += QLatin1String(" ) ");
     }
@@ -946,6 +931,51 @@ bool ItemQueryBuilder::buildField(QString& sql, SearchXmlCachingReader& reader,
     return true;
 }
 
+void ItemQueryBuilder::buildCommentField(QString& sql, SearchXmlCachingReader& reader, int type,
+                                         QList<QVariant>* boundValues) const
+{
+    SearchXml::Relation relation = reader.fieldRelation();
+
+    // The words of the full text index are matched from their start. A "contains" search
+    // can start in the middle of a word, only the equality gives the same results with the index.
+
+    if (relation == SearchXml::Equal &&
+        buildFullTextCommentField(sql, reader.value(), type, boundValues))
+    {
+        return;
+    }
+
+    FieldQueryBuilder fieldQuery(sql, reader, boundValues, 0, relation);
+
+    sql += QString::fromUtf8(" (Images.id IN "
+           " (SELECT imageid FROM ImageComments "
+           "  WHERE type=? AND comment ");
+    ItemQueryBuilder::addSqlRelation(sql, relation);
+    sql += QString::fromUtf8(" ?)) ");
+    *boundValues << type << fieldQuery.prepareForLike(reader.value());
+}
+
+bool ItemQueryBuilder::buildFullTextCommentField(QString& sql, const QString& value, int type,
+                                                 QList<QVariant>* boundValues) const
+{
+    QList<QVariant> conditionValues;
+    QString         condition = CoreDbAccess().db()->fullTextCommentCondition(value, &conditionValues);
+
+    if (condition.isNull())
+    {
+        return false;
+    }
+
+    sql += QString::fromUtf8(" (Images.id IN "
+           " (SELECT imageid FROM ImageComments "
+           "  WHERE type=? AND ");
+    sql += condition;
+    sql += QString::fromUtf8(" )) ");
+    *boundValues << type << conditionValues;
+
+    return true;
+}
+
 void ItemQueryBuilder::addSqlOperator(QString& sql, SearchXml::Operator op, bool isFirst)
 {
     if (isFirst)
@@ -72,6 +72,22 @@ protected:
     bool buildField(QString& sql, SearchXmlCachingReader& reader, const QString& name,
                     QList<QVariant>* boundValues, ItemQueryPostHooks* const hooks) const;
 
+    /**
+     * Add a condition on the ImageComments entries of the given type. Equality searches
+     * use the full text index, see CoreDB::fullTextCommentCondition(). The other searches,
+     * as "contains", use the relation on the comment only.
+     */
+    void buildCommentField(QString& sql, SearchXmlCachingReader& reader, int type,
+                           QList<QVariant>* boundValues) const;
+
+    /**
+     * Add a condition matching the items with an ImageComments entry of the given type
+     * equal to value, using the full text index of the database.
+     * Returns false, adding nothing, if the full text index cannot be used.
+     */
+    bool buildFullTextCommentField(QString& sql, const QString& value, int type,
+                                   QList<QVariant>* boundValues) const;
+
     QString possibleDate(const QString& str, bool& exact) const;
 
 protected:
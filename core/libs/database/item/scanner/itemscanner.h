@@ -244,6 +244,12 @@ public:
 
     static MetadataFields allImageMetadataFields();
 
+    /**
+     * Name of the property by which the RawPreviewIndex of RAW files
+     * is stored in the database (ImageProperties table).
+     */
+    static QString rawPreviewIndexPropertyName();
+
 protected:
 
     QString detectImageFormat() const;
@@ -262,6 +268,8 @@ protected:
     void commitTags();
     void scanFaces();
     void commitFaces();
+    void scanRawPreviewIndex();
+    void commitRawPreviewIndex();
 
     bool checkRatingFromMetadata(const QVariant& ratingFromMetadata) const;
     void checkCreationDateFromMetadata(QVariant& dateFromMetadata)   const;
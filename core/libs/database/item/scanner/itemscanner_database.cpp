@@ -99,6 +99,11 @@ void ItemScanner::commit()
         commitFaces();
     }
 
+    if (d->commit.commitRawPreviewIndex)
+    {
+        commitRawPreviewIndex();
+    }
+
     commitImageHistory();
 }
 
@@ -192,6 +192,7 @@ void ItemScanner::scanFile(ScanMode mode)
         if (d->scanInfo.category == DatabaseItem::Image)
         {
             scanItemInformation();
+            scanRawPreviewIndex();
             scanImageHistoryIfModified();
         }
         else if (d->scanInfo.category == DatabaseItem::Video ||
@@ -224,6 +225,7 @@ void ItemScanner::scanFile(ScanMode mode)
         if (d->scanInfo.category == DatabaseItem::Image)
         {
             scanItemInformation();
+            scanRawPreviewIndex();
 
             if (d->hasMetadata)
             {
@@ -38,6 +38,7 @@ ItemScannerCommit::ItemScannerCommit()
       commitItemCopyright(false),
       commitFaces(false),
       commitIPTCCore(false),
+      commitRawPreviewIndex(false),
       hasColorTag(false),
       hasPickTag(false)
 {
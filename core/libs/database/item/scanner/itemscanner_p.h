@@ -91,6 +91,7 @@ public:
     bool                             commitItemCopyright;
     bool                             commitFaces;
     bool                             commitIPTCCore;
+    bool                             commitRawPreviewIndex;
     bool                             hasColorTag;
     bool                             hasPickTag;
 
@@ -109,6 +110,8 @@ public:
 
     QVariantList                     iptcCoreMetadataInfos;
 
+    QString                          rawPreviewIndex;
+
     QList<int>                       tagIds;
     QString                          historyXml;
     QString                          uuid;
@@ -24,6 +24,10 @@
 
 #include "itemscanner_p.h"
 
+// Local includes
+
+#include "rawpreviewindex.h"
+
 namespace Digikam
 {
 
@@ -502,6 +506,35 @@ void ItemScanner::commitFaces()
     }
 }
 
+QString ItemScanner::rawPreviewIndexPropertyName()
+{
+    return QLatin1String("rawPreviewIndex");
+}
+
+void ItemScanner::scanRawPreviewIndex()
+{
+    if (d->img.detectedFormat() != DImg::RAW)
+    {
+        return;
+    }
+
+    // Only the properties of the previews are read here. Preview loading uses them to pick its source.
+    d->commit.commitRawPreviewIndex = true;
+    d->commit.rawPreviewIndex       = RawPreviewIndex::fromFile(d->fileInfo.filePath()).toString();
+}
+
+void ItemScanner::commitRawPreviewIndex()
+{
+    if (d->commit.rawPreviewIndex.isEmpty())
+    {
+        CoreDbAccess().db()->removeImageProperty(d->scanInfo.id, rawPreviewIndexPropertyName());
+    }
+    else
+    {
+        CoreDbAccess().db()->setImageProperty(d->scanInfo.id, rawPreviewIndexPropertyName(), d->commit.rawPreviewIndex);
+    }
+}
+
 void ItemScanner::checkCreationDateFromMetadata(QVariant& dateFromMetadata) const
 {
     // creation date: fall back to file system property
@@ -28,6 +28,10 @@
 #include "itemfiltermodel_p.h"
 #include "itemfiltermodelthreads.h"
 
+// Qt includes
+
+#include <QSet>
+
 // Local includes
 
 #include "digikam_debug.h"
@@ -426,10 +430,10 @@ void ItemFilterModel::setItemFilterSettings(const ItemFilterSettings& settings)
         d->versionFilterCopy   = d->versionFilter;
         d->groupFilterCopy     = d->groupFilter;
 
-        d->needPrepareComments = settings.isFilteringByText();
+        d->prepareFields       = settings.watchFlags();
         d->needPrepareTags     = settings.isFilteringByTags();
         d->needPrepareGroups   = true;
-        d->needPrepare         = d->needPrepareComments || d->needPrepareTags || d->needPrepareGroups;
+        d->needPrepare         = d->needPrepareTags || d->needPrepareGroups;
 
         d->hasOneMatch         = false;
         d->hasOneMatchForText  = false;
@@ -552,6 +556,7 @@ void ItemFilterModel::slotModelReset()
         d->hasOneMatchForText = false;
     }
     d->filterResults.clear();
+    d->sortKeys.clear();
 }
 
 bool ItemFilterModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
@@ -648,40 +653,30 @@ void ItemFilterModelPreparer::process(ItemFilterModelTodoPackage package)
     }
 
     // get thread-local copy
-    bool needPrepareTags, needPrepareComments, needPrepareGroups;
+    bool needPrepareTags, needPrepareGroups;
+    DatabaseFields::Set prepareFields;
     QList<ItemFilterModelPrepareHook*> prepareHooks;
 
     {
         QMutexLocker lock(&d->mutex);
         needPrepareTags     = d->needPrepareTags;
-        needPrepareComments = d->needPrepareComments;
         needPrepareGroups   = d->needPrepareGroups;
+        prepareFields       = d->prepareFields;
         prepareHooks        = d->prepareHooks;
     }
 
-    //TODO: Make efficient!!
-    if (needPrepareComments)
-    {
-        foreach (const ItemInfo& info, package.infos)
-        {
-            info.comment();
-        }
-    }
-
-    if (!checkVersion(package))
-    {
-        emit discarded(package);
-        return;
-    }
-
     // The downside of QVector: At some point, we may need a QList for an API.
     // Nonetheless, QList and ItemInfo is fast. We could as well
     // reimplement ItemInfoList to ItemInfoVector (internally with templates?)
-    ItemInfoList infoList;
+    ItemInfoList infoList(package.infos.toList());
 
-    if (needPrepareTags || needPrepareGroups)
+    // Read the values the filter needs for the whole package with a few queries.
+    infoList.loadFields(prepareFields);
+
+    if (!checkVersion(package))
     {
-        infoList = ItemInfoList(package.infos.toList());
+        emit discarded(package);
+        return;
     }
 
     if (needPrepareTags)
@@ -791,6 +786,7 @@ void ItemFilterModel::setItemSortSettings(const ItemSortSettings& sorter)
 {
     Q_D(ItemFilterModel);
     d->sorter = sorter;
+    d->sortKeys.setSortSettings(d->sorter);
     setCategorizedModel(d->sorter.categorizationMode != ItemSortSettings::NoCategories);
     invalidate();
 }
@@ -963,7 +959,61 @@ QString ItemFilterModel::categoryIdentifier(const ItemInfo& i) const
 bool ItemFilterModel::infosLessThan(const ItemInfo& left, const ItemInfo& right) const
 {
     Q_D(const ItemFilterModel);
-    return d->sorter.lessThan(left, right);
+
+    if (left.isNull() || right.isNull())
+    {
+        return d->sorter.lessThan(left, right);
+    }
+
+    // Sorting compares each item many times. Read the sort values of all items
+    // once, sort them in parallel, then only compare the resulting ranks.
+
+    if (!d->sortKeys.isSorted()            ||
+        !d->sortKeys.contains(left.id())   ||
+        !d->sortKeys.contains(right.id()))
+    {
+        QList<ItemInfo> missing;
+        QSet<qlonglong> missingIds;
+
+        if (d->imageModel)
+        {
+            foreach (const ItemInfo& info, d->imageModel->imageInfos())
+            {
+                if (!info.isNull() && !d->sortKeys.contains(info.id()) && !missingIds.contains(info.id()))
+                {
+                    missingIds << info.id();
+                    missing    << info;
+                }
+            }
+        }
+
+        // Group leaders may not be part of the model.
+
+        if (!d->sortKeys.contains(left.id()) && !missingIds.contains(left.id()))
+        {
+            missingIds << left.id();
+            missing    << left;
+        }
+
+        if (!d->sortKeys.contains(right.id()) && !missingIds.contains(right.id()))
+        {
+            missingIds << right.id();
+            missing    << right;
+        }
+
+        d->sortKeys.update(missing);
+        d->sortKeys.sort();
+    }
+
+    int leftRank  = d->sortKeys.rank(left.id());
+    int rightRank = d->sortKeys.rank(right.id());
+
+    if ((leftRank == -1) || (rightRank == -1))
+    {
+        return d->sorter.lessThan(left, right);
+    }
+
+    return leftRank < rightRank;
 }
 
 // -------------- Watching changes -----------------------------------------------------------------
@@ -1012,15 +1062,22 @@ void ItemFilterModel::slotImageChange(const ImageChangeset& changeset)
         return;
     }
 
+    // is one of the values affected that we filter or sort by?
+    DatabaseFields::Set set = changeset.changes();
+    bool sortAffected       = (set & d->sorter.watchFlags());
+
+    if (sortAffected)
+    {
+        // sort values will be read again on next sort
+        d->sortKeys.remove(changeset.ids());
+    }
+
     // already scheduled to re-filter?
     if (d->updateFilterTimer->isActive())
     {
         return;
     }
 
-    // is one of the values affected that we filter or sort by?
-    DatabaseFields::Set set = changeset.changes();
-    bool sortAffected       = (set & d->sorter.watchFlags());
     bool filterAffected     = (set & d->filter.watchFlags()) || (set & d->groupFilter.watchFlags());
     bool categoryAffected   = sortAffected && (d->sorter.categorizationMode == ItemSortSettings::CategoryByAlbum);
 
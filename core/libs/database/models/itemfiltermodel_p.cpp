@@ -44,7 +44,6 @@ ItemFilterModel::ItemFilterModelPrivate::ItemFilterModelPrivate()
     sentOutForReAdd       = 0;
     updateFilterTimer     = 0;
     needPrepare           = false;
-    needPrepareComments   = false;
     needPrepareTags       = false;
     needPrepareGroups     = false;
     preparer              = 0;
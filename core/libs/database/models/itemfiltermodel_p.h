@@ -38,6 +38,7 @@
 
 #include "iteminfo.h"
 #include "itemfiltermodel.h"
+#include "itemsortkeys.h"
 #include "digikam_export.h"
 
 // NOTE: we need the EXPORT macro in a private header because
@@ -102,6 +103,7 @@ public:
 
     ItemFilterSettings                 filter;
     ItemSortSettings                   sorter;
+    mutable ItemSortKeys               sortKeys;
     VersionItemFilterSettings          versionFilter;
     GroupItemFilterSettings            groupFilter;
 
@@ -114,10 +116,12 @@ public:
     QTimer*                             updateFilterTimer;
 
     bool                                needPrepare;
-    bool                                needPrepareComments;
     bool                                needPrepareTags;
     bool                                needPrepareGroups;
 
+    /// The database fields read by the filter, loaded in bulk by the preparer.
+    DatabaseFields::Set                 prepareFields;
+
     QMutex                              mutex;
     ItemFilterSettings                 filterCopy;
     VersionItemFilterSettings          versionFilterCopy;
@@ -50,6 +50,7 @@ namespace Digikam
 ItemFilterSettings::ItemFilterSettings()
 {
     m_untaggedFilter       = false;
+    m_includeTagCount      = 0;
     m_isUnratedExcluded    = false;
     m_ratingFilter         = 0;
     m_mimeTypeFilter       = MimeFilter::AllFiles;
@@ -204,6 +205,54 @@ void ItemFilterSettings::setDayFilter(const QList<QDateTime>& days)
     }
 }
 
+/** Returns the tag ids as a bit set indexed by tag id. If count is given,
+ *  it is set to the number of distinct tag ids.
+ */
+static QBitArray tagIdsToBits(const QList<int>& tagIds, int* const count = 0)
+{
+    int maxId = -1;
+
+    foreach (int id, tagIds)
+    {
+        maxId = qMax(maxId, id);
+    }
+
+    QBitArray bits(maxId + 1);
+
+    foreach (int id, tagIds)
+    {
+        if (id >= 0)
+        {
+            bits.setBit(id);
+        }
+    }
+
+    if (count)
+    {
+        *count = bits.count(true);
+    }
+
+    return bits;
+}
+
+static inline bool testTagBit(const QBitArray& bits, int id)
+{
+    return ((id >= 0) && (id < bits.size()) && bits.testBit(id));
+}
+
+static inline bool containsAnyTagBit(const QBitArray& bits, const QList<int>& tagIds)
+{
+    foreach (int id, tagIds)
+    {
+        if (testTagBit(bits, id))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void ItemFilterSettings::setTagFilter(const QList<int>& includedTags,
                                        const QList<int>& excludedTags,
                                        MatchingCondition matchingCondition,
@@ -217,6 +266,11 @@ void ItemFilterSettings::setTagFilter(const QList<int>& includedTags,
     m_untaggedFilter      = showUnTagged;
     m_colorLabelTagFilter = clTagIds;
     m_pickLabelTagFilter  = plTagIds;
+
+    m_includeTagBits      = tagIdsToBits(m_includeTagFilter, &m_includeTagCount);
+    m_excludeTagBits      = tagIdsToBits(m_excludeTagFilter);
+    m_colorLabelTagBits   = tagIdsToBits(m_colorLabelTagFilter);
+    m_pickLabelTagBits    = tagIdsToBits(m_pickLabelTagFilter);
 }
 
 void ItemFilterSettings::setRatingFilter(int rating, RatingCondition ratingCondition, bool isUnratedExcluded)
@@ -275,30 +329,57 @@ void ItemFilterSettings::setIdWhitelist(const QList<qlonglong>& idList, const QS
     }
 }
 
-template <class ContainerA, class ContainerB>
-bool containsAnyOf(const ContainerA& listA, const ContainerB& listB)
+template <class ContainerA, typename Value, class ContainerB>
+bool containsNoneOfExcept(const ContainerA& list, const ContainerB& noneOfList, const Value& exception)
 {
-    foreach (const typename ContainerA::value_type& a, listA)
+    foreach (const typename ContainerB::value_type& n, noneOfList)
     {
-        if (listB.contains(a))
+        if (n != exception && list.contains(n))
         {
-            return true;
+            return false;
         }
     }
-    return false;
+    return true;
 }
 
-template <class ContainerA, typename Value, class ContainerB>
-bool containsNoneOfExcept(const ContainerA& list, const ContainerB& noneOfList, const Value& exception)
+bool ItemFilterSettings::matchesTags(const QList<int>& tagIds) const
 {
-    foreach (const typename ContainerB::value_type& n, noneOfList)
+    bool match = m_includeTagFilter.isEmpty();
+
+    if (m_matchingCond == OrCondition)
     {
-        if (n != exception && list.contains(n))
+        match |= containsAnyTagBit(m_includeTagBits, tagIds);
+        match |= (m_untaggedFilter && tagIds.isEmpty());
+    }
+    else // AND matching condition...
+    {
+        // m_untaggedFilter and non-empty tag filter, combined with AND, is logically no match
+        if (!m_untaggedFilter)
         {
-            return false;
+            // Tag ids of an item are unique: all included tags are found if as many item tags are included.
+            int found = 0;
+
+            foreach (int id, tagIds)
+            {
+                if (testTagBit(m_includeTagBits, id))
+                {
+                    ++found;
+                }
+            }
+
+            if (found == m_includeTagCount)
+            {
+                match = true;
+            }
         }
     }
-    return true;
+
+    if (containsAnyTagBit(m_excludeTagBits, tagIds))
+    {
+        match = false;
+    }
+
+    return match;
 }
 
 bool ItemFilterSettings::matches(const ItemInfo& info, bool* const foundText) const
@@ -315,58 +396,21 @@ bool ItemFilterSettings::matches(const ItemInfo& info, bool* const foundText) co
 
     bool match = false;
 
-    if (!m_includeTagFilter.isEmpty() || !m_excludeTagFilter.isEmpty())
-    {
-        QList<int>                 tagIds = info.tagIds();
-        QList<int>::const_iterator it;
-
-        match = m_includeTagFilter.isEmpty();
-
-        if (m_matchingCond == OrCondition)
-        {
-            for (it = m_includeTagFilter.begin() ; it != m_includeTagFilter.end() ; ++it)
-            {
-                if (tagIds.contains(*it))
-                {
-                    match = true;
-                    break;
-                }
-            }
-
-            match |= (m_untaggedFilter && tagIds.isEmpty());
-        }
-        else // AND matching condition...
-        {
-            // m_untaggedFilter and non-empty tag filter, combined with AND, is logically no match
-            if (!m_untaggedFilter)
-            {
-                for (it = m_includeTagFilter.begin(); it != m_includeTagFilter.end(); ++it)
-                {
-                    if (!tagIds.contains(*it))
-                    {
-                        break;
-                    }
-                }
+    // Read the tags of the item once, for all tags filters.
+    QList<int> tagIds;
 
-                if (it == m_includeTagFilter.end())
-                {
-                    match = true;
-                }
-            }
-        }
+    if (isFilteringByTags() || isFilteringByPickLabels() || isFilteringByColorLabels())
+    {
+        tagIds = info.tagIds();
+    }
 
-        for (it = m_excludeTagFilter.begin() ; it != m_excludeTagFilter.end() ; ++it)
-        {
-            if (tagIds.contains(*it))
-            {
-                match = false;
-                break;
-            }
-        }
+    if (!m_includeTagFilter.isEmpty() || !m_excludeTagFilter.isEmpty())
+    {
+        match = matchesTags(tagIds);
     }
     else if (m_untaggedFilter)
     {
-        match = !TagsCache::instance()->containsPublicTags(info.tagIds());
+        match = !TagsCache::instance()->containsPublicTags(tagIds);
     }
     else
     {
@@ -377,10 +421,9 @@ bool ItemFilterSettings::matches(const ItemInfo& info, bool* const foundText) co
 
     if (!m_pickLabelTagFilter.isEmpty())
     {
-        QList<int> tagIds = info.tagIds();
-        bool matchPL      = false;
+        bool matchPL = false;
 
-        if (containsAnyOf(m_pickLabelTagFilter, tagIds))
+        if (containsAnyTagBit(m_pickLabelTagBits, tagIds))
         {
             matchPL = true;
         }
@@ -388,7 +431,7 @@ bool ItemFilterSettings::matches(const ItemInfo& info, bool* const foundText) co
         {
             int noPickLabelTagId = TagsCache::instance()->tagForPickLabel(NoPickLabel);
 
-            if (m_pickLabelTagFilter.contains(noPickLabelTagId))
+            if (testTagBit(m_pickLabelTagBits, noPickLabelTagId))
             {
                 // Searching for "has no ColorLabel" requires special handling:
                 // Scan that the tag ids contains none of the ColorLabel tags, except maybe the NoColorLabel tag
@@ -403,10 +446,9 @@ bool ItemFilterSettings::matches(const ItemInfo& info, bool* const foundText) co
 
     if (!m_colorLabelTagFilter.isEmpty())
     {
-        QList<int> tagIds = info.tagIds();
-        bool matchCL      = false;
+        bool matchCL = false;
 
-        if (containsAnyOf(m_colorLabelTagFilter, tagIds))
+        if (containsAnyTagBit(m_colorLabelTagBits, tagIds))
         {
             matchCL = true;
         }
@@ -414,7 +456,7 @@ bool ItemFilterSettings::matches(const ItemInfo& info, bool* const foundText) co
         {
             int noColorLabelTagId = TagsCache::instance()->tagForColorLabel(NoColorLabel);
 
-            if (m_colorLabelTagFilter.contains(noColorLabelTagId))
+            if (testTagBit(m_colorLabelTagBits, noColorLabelTagId))
             {
                 // Searching for "has no ColorLabel" requires special handling:
                 // Scan that the tag ids contains none of the ColorLabel tags, except maybe the NoColorLabel tag
@@ -30,6 +30,7 @@
 
 // Qt includes
 
+#include <QBitArray>
 #include <QHash>
 #include <QList>
 #include <QMap>
@@ -123,6 +124,12 @@ public:
                       const QList<int>& clTagIds,
                       const QList<int>& plTagIds);
 
+    /** Returns if an item with the given tags passes the included and excluded tags filter.
+     *  Tags are looked up in bit sets indexed by tag id, the cost only depends on the number
+     *  of tags of the item, not on the number of tags in the filter.
+     */
+    bool matchesTags(const QList<int>& tagIds) const;
+
 public:
 
     /// --- Rating filter ---
@@ -232,6 +239,13 @@ private:
     QList<int>                        m_colorLabelTagFilter;
     QList<int>                        m_pickLabelTagFilter;
 
+    /// Tags filter lists above as bit sets indexed by tag id
+    QBitArray                         m_includeTagBits;
+    QBitArray                         m_excludeTagBits;
+    QBitArray                         m_colorLabelTagBits;
+    QBitArray                         m_pickLabelTagBits;
+    int                               m_includeTagCount;
+
     /// --- Rating filter ---
     int                               m_ratingFilter;
     RatingCondition                   m_ratingCond;
@@ -0,0 +1,581 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-05
+ * Description : Precomputed sort keys snapshot used by ItemFilterModel
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "itemsortkeys.h"
+
+// C++ includes
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Qt includes
+
+#include <QCollator>
+#include <QDateTime>
+#include <QHash>
+#include <QVector>
+
+// Local includes
+
+#include "iteminfo.h"
+#include "iteminfolist.h"
+#include "threadscheduler.h"
+
+namespace Digikam
+{
+
+/// Below this count, sorting in one thread is faster than dispatching chunks.
+const int ParallelSortThreshold = 5000;
+
+class Q_DECL_HIDDEN ItemSortKeys::Private
+{
+public:
+
+    class RowLessThan
+    {
+    public:
+
+        explicit RowLessThan(const Private* const d)
+            : d(d)
+        {
+        }
+
+        bool operator()(int left, int right) const
+        {
+            return d->lessThan(left, right);
+        }
+
+    private:
+
+        const Private* d;
+    };
+
+public:
+
+    explicit Private()
+        : freeRows(0),
+          sorted(false)
+    {
+    }
+
+    QCollator createCollator() const;
+    QCollatorSortKey emptyKey() const;
+
+    void readValues(const QList<ItemInfo>& infos, const QVector<int>& targetRows, int begin, int end);
+    void sortRange(int begin, int end);
+    void mergeRange(int begin, int middle, int end);
+
+    int  compareStrings(const QVector<QString>& strings,
+                        const QVector<bool>& versioned,
+                        const std::vector<QCollatorSortKey>& keys,
+                        int left, int right) const;
+    int  compare(int left, int right, ItemSortSettings::SortRole role) const;
+    bool lessThan(int left, int right) const;
+
+    static qint64 dateTimeValue(const QDateTime& dateTime);
+
+public:
+
+    ItemSortSettings              settings;
+
+    /// Maps image id to row in the columns below.
+    QHash<qlonglong, int>         rows;
+
+    /// The columns. A row with id -1 is free.
+    QVector<qlonglong>            ids;
+    QVector<QString>              names;
+    QVector<bool>                 namesVersioned;
+    std::vector<QCollatorSortKey> nameKeys;
+    QVector<QString>              paths;
+    QVector<bool>                 pathsVersioned;
+    std::vector<QCollatorSortKey> pathKeys;       // Only filled when sorting by path.
+    QVector<qint64>               creationDates;
+    QVector<qint64>               modificationDates;
+    QVector<qlonglong>            fileSizes;
+    QVector<int>                  ratings;
+    QVector<qint64>               pixels;
+    QVector<int>                  aspectRatios;
+    QVector<double>               similarities;
+    QVector<qlonglong>            manualOrders;
+    QVector<int>                  ranks;
+
+    /// Rows ordered by sort, valid when sorted is true.
+    QVector<int>                  order;
+
+    int                           freeRows;
+    bool                          sorted;
+};
+
+// ---------------------------------------------------------------------------------------
+
+QCollator ItemSortKeys::Private::createCollator() const
+{
+    // Same settings as ItemSortSettings::naturalCompare()
+    QCollator collator;
+    collator.setNumericMode(settings.strTypeNatural);
+    collator.setIgnorePunctuation(false);
+    collator.setCaseSensitivity(settings.sortCaseSensitivity);
+
+    return collator;
+}
+
+QCollatorSortKey ItemSortKeys::Private::emptyKey() const
+{
+    return createCollator().sortKey(QString());
+}
+
+qint64 ItemSortKeys::Private::dateTimeValue(const QDateTime& dateTime)
+{
+    if (!dateTime.isValid())
+    {
+        return std::numeric_limits<qint64>::min();
+    }
+
+    return dateTime.toMSecsSinceEpoch();
+}
+
+void ItemSortKeys::Private::readValues(const QList<ItemInfo>& infos, const QVector<int>& targetRows, int begin, int end)
+{
+    // A collator per thread, QCollator is not meant to be shared.
+    QCollator collator    = createCollator();
+    const bool sortByPath = (settings.sortRole == ItemSortSettings::SortByFilePath);
+
+    for (int i = begin ; i < end ; ++i)
+    {
+        const ItemInfo& info = infos.at(i);
+        const int row        = targetRows.at(i);
+
+        ids[row]             = info.id();
+
+        names[row]           = info.name();
+        namesVersioned[row]  = names.at(row).contains(QLatin1String("_v"), Qt::CaseInsensitive);
+        nameKeys[row]        = collator.sortKey(names.at(row));
+
+        paths[row]           = info.filePath();
+        pathsVersioned[row]  = paths.at(row).contains(QLatin1String("_v"), Qt::CaseInsensitive);
+
+        if (sortByPath)
+        {
+            pathKeys[row]    = collator.sortKey(paths.at(row));
+        }
+
+        creationDates[row]     = dateTimeValue(info.dateTime());
+        modificationDates[row] = dateTimeValue(info.modDateTime());
+        fileSizes[row]         = info.fileSize();
+        ratings[row]           = info.rating();
+
+        if ((settings.sortRole == ItemSortSettings::SortByImageSize) ||
+            (settings.sortRole == ItemSortSettings::SortByAspectRatio))
+        {
+            QSize size         = info.dimensions();
+            pixels[row]        = (qint64)size.width() * size.height();
+            aspectRatios[row]  = size.height() ? (int)((double(size.width()) / double(size.height())) * 1000000) : 0;
+        }
+
+        // make sure that the original image has always the highest similarity.
+        similarities[row]      = (info.id() == info.currentReferenceImage()) ? 1.1 : info.currentSimilarity();
+        manualOrders[row]      = info.manualOrder();
+    }
+}
+
+int ItemSortKeys::Private::compareStrings(const QVector<QString>& strings,
+                                          const QVector<bool>& versioned,
+                                          const std::vector<QCollatorSortKey>& keys,
+                                          int left, int right) const
+{
+    // Versioned file names are compared ignoring punctuation, see ItemSortSettings::naturalCompare().
+    // Their collation keys do not apply, whichever side is versioned, and paths keys are only
+    // computed when sorting by path.
+
+    if (versioned.at(left) || versioned.at(right) || (&keys == &pathKeys && pathKeys.empty()))
+    {
+        return ItemSortSettings::naturalCompare(strings.at(left), strings.at(right),
+                                                settings.currentSortOrder,
+                                                settings.sortCaseSensitivity,
+                                                settings.strTypeNatural);
+    }
+
+    return ItemSortSettings::compareByOrder(keys[left].compare(keys[right]), settings.currentSortOrder);
+}
+
+int ItemSortKeys::Private::compare(int left, int right, ItemSortSettings::SortRole role) const
+{
+    const Qt::SortOrder sortOrder = settings.currentSortOrder;
+
+    switch (role)
+    {
+        case ItemSortSettings::SortByFileName:
+            return compareStrings(names, namesVersioned, nameKeys, left, right);
+        case ItemSortSettings::SortByFilePath:
+            return compareStrings(paths, pathsVersioned, pathKeys, left, right);
+        case ItemSortSettings::SortByFileSize:
+            return ItemSortSettings::compareByOrder(fileSizes.at(left), fileSizes.at(right), sortOrder);
+        case ItemSortSettings::SortByCreationDate:
+            return ItemSortSettings::compareByOrder(creationDates.at(left), creationDates.at(right), sortOrder);
+        case ItemSortSettings::SortByModificationDate:
+            return ItemSortSettings::compareByOrder(modificationDates.at(left), modificationDates.at(right), sortOrder);
+        case ItemSortSettings::SortByRating:
+            // Same inverted order as ItemSortSettings::compare()
+            return - ItemSortSettings::compareByOrder(ratings.at(left), ratings.at(right), sortOrder);
+        case ItemSortSettings::SortByImageSize:
+            return ItemSortSettings::compareByOrder(pixels.at(left), pixels.at(right), sortOrder);
+        case ItemSortSettings::SortByAspectRatio:
+            return ItemSortSettings::compareByOrder(aspectRatios.at(left), aspectRatios.at(right), sortOrder);
+        case ItemSortSettings::SortBySimilarity:
+            return ItemSortSettings::compareByOrder(similarities.at(left), similarities.at(right), sortOrder);
+        case ItemSortSettings::SortByManualOrder:
+            return ItemSortSettings::compareByOrder(manualOrders.at(left), manualOrders.at(right), sortOrder);
+        default:
+            return 1;
+    }
+}
+
+bool ItemSortKeys::Private::lessThan(int left, int right) const
+{
+    // Same hierarchy of sort roles as ItemSortSettings::lessThan()
+
+    int result = compare(left, right, settings.sortRole);
+
+    if (result != 0)
+    {
+        return result < 0;
+    }
+
+    if (ids.at(left) == ids.at(right))
+    {
+        return false;
+    }
+
+    const ItemSortSettings::SortRole hierarchy[] =
+    {
+        ItemSortSettings::SortByFileName,
+        ItemSortSettings::SortByCreationDate,
+        ItemSortSettings::SortByModificationDate,
+        ItemSortSettings::SortByFilePath,
+        ItemSortSettings::SortByFileSize,
+        ItemSortSettings::SortBySimilarity,
+        ItemSortSettings::SortByManualOrder
+    };
+
+    for (const ItemSortSettings::SortRole role : hierarchy)
+    {
+        if ((result = compare(left, right, role)) != 0)
+        {
+            return result < 0;
+        }
+    }
+
+    return false;
+}
+
+void ItemSortKeys::Private::sortRange(int begin, int end)
+{
+    std::sort(order.begin() + begin, order.begin() + end, RowLessThan(this));
+}
+
+void ItemSortKeys::Private::mergeRange(int begin, int middle, int end)
+{
+    std::inplace_merge(order.begin() + begin, order.begin() + middle, order.begin() + end, RowLessThan(this));
+}
+
+// ---------------------------------------------------------------------------------------
+
+ItemSortKeys::ItemSortKeys()
+    : d(new Private)
+{
+}
+
+ItemSortKeys::~ItemSortKeys()
+{
+    delete d;
+}
+
+void ItemSortKeys::setSortSettings(const ItemSortSettings& settings)
+{
+    bool valuesAffected = (settings.sortRole            != d->settings.sortRole)            ||
+                          (settings.sortCaseSensitivity != d->settings.sortCaseSensitivity) ||
+                          (settings.strTypeNatural      != d->settings.strTypeNatural);
+
+    d->settings = settings;
+
+    if (valuesAffected)
+    {
+        clear();
+    }
+    else
+    {
+        d->sorted = false;
+    }
+}
+
+void ItemSortKeys::update(const QList<ItemInfo>& infos)
+{
+    if (infos.isEmpty())
+    {
+        return;
+    }
+
+    // Assign a row to each item: its current row if known, else a new one.
+
+    QVector<int> targetRows;
+    targetRows.reserve(infos.size());
+    int newRow = d->ids.size();
+
+    foreach (const ItemInfo& info, infos)
+    {
+        QHash<qlonglong, int>::const_iterator it = d->rows.constFind(info.id());
+
+        if (it != d->rows.constEnd())
+        {
+            targetRows << it.value();
+        }
+        else
+        {
+            d->rows.insert(info.id(), newRow);
+            targetRows << newRow++;
+        }
+    }
+
+    // Read the values missing from the ItemInfo cache with a few queries, instead of one per item and field.
+
+    DatabaseFields::Set fields;
+    fields |= DatabaseFields::ModificationDate | DatabaseFields::FileSize | DatabaseFields::ManualOrder;
+    fields |= DatabaseFields::CreationDate     | DatabaseFields::Rating   |
+              DatabaseFields::Width            | DatabaseFields::Height;
+    ItemInfoList(infos).loadFields(fields);
+
+    // Grow all columns at once, before to fill them from several threads.
+
+    const QCollatorSortKey empty = d->emptyKey();
+
+    d->ids.resize(newRow);
+    d->names.resize(newRow);
+    d->namesVersioned.resize(newRow);
+    d->nameKeys.resize(newRow, empty);
+    d->paths.resize(newRow);
+    d->pathsVersioned.resize(newRow);
+
+    if (d->settings.sortRole == ItemSortSettings::SortByFilePath)
+    {
+        d->pathKeys.resize(newRow, empty);
+    }
+
+    d->creationDates.resize(newRow);
+    d->modificationDates.resize(newRow);
+    d->fileSizes.resize(newRow);
+    d->ratings.resize(newRow);
+    d->pixels.resize(newRow);
+    d->aspectRatios.resize(newRow);
+    d->similarities.resize(newRow);
+    d->manualOrders.resize(newRow);
+    d->ranks.resize(newRow);
+
+    const int count  = infos.size();
+    const int chunks = (count < ParallelSortThreshold) ? 1 : qMax(1, ThreadScheduler::instance()->maximumThreadCount());
+
+    if (chunks == 1)
+    {
+        d->readValues(infos, targetRows, 0, count);
+    }
+    else
+    {
+        ThreadSchedulerTasks tasks;
+        const int chunkSize = count / chunks + 1;
+
+        for (int begin = 0 ; begin < count ; begin += chunkSize)
+        {
+            tasks.run(d,
+                      &Private::readValues,
+                      infos,
+                      targetRows,
+                      begin,
+                      qMin(begin + chunkSize, count));
+        }
+
+        tasks.waitForDone();
+    }
+
+    d->sorted = false;
+}
+
+void ItemSortKeys::remove(const QList<qlonglong>& imageIds)
+{
+    foreach (const qlonglong& id, imageIds)
+    {
+        QHash<qlonglong, int>::iterator it = d->rows.find(id);
+
+        if (it != d->rows.end())
+        {
+            d->ids[it.value()] = -1;
+            d->rows.erase(it);
+            d->freeRows++;
+            d->sorted = false;
+        }
+    }
+
+    // Too many holes: cheaper to read values again than to sort them.
+    if (d->freeRows > d->rows.size())
+    {
+        clear();
+    }
+}
+
+void ItemSortKeys::clear()
+{
+    d->rows.clear();
+    d->ids.clear();
+    d->names.clear();
+    d->namesVersioned.clear();
+    d->nameKeys.clear();
+    d->paths.clear();
+    d->pathsVersioned.clear();
+    d->pathKeys.clear();
+    d->creationDates.clear();
+    d->modificationDates.clear();
+    d->fileSizes.clear();
+    d->ratings.clear();
+    d->pixels.clear();
+    d->aspectRatios.clear();
+    d->similarities.clear();
+    d->manualOrders.clear();
+    d->ranks.clear();
+    d->order.clear();
+    d->freeRows = 0;
+    d->sorted   = false;
+}
+
+bool ItemSortKeys::isEmpty() const
+{
+    return d->rows.isEmpty();
+}
+
+int ItemSortKeys::count() const
+{
+    return d->rows.size();
+}
+
+bool ItemSortKeys::contains(qlonglong imageId) const
+{
+    return d->rows.contains(imageId);
+}
+
+bool ItemSortKeys::isSorted() const
+{
+    return d->sorted;
+}
+
+void ItemSortKeys::sort()
+{
+    d->order.clear();
+    d->order.reserve(d->rows.size());
+
+    for (int row = 0 ; row < d->ids.size() ; ++row)
+    {
+        if (d->ids.at(row) != -1)
+        {
+            d->order << row;
+        }
+    }
+
+    const int count  = d->order.size();
+    const int chunks = (count < ParallelSortThreshold) ? 1 : qMax(1, ThreadScheduler::instance()->maximumThreadCount());
+
+    if (chunks == 1)
+    {
+        d->sortRange(0, count);
+    }
+    else
+    {
+        // Sort chunks in parallel, then merge them pairwise, each level in parallel.
+
+        QVector<int> bounds;
+        const int chunkSize = count / chunks + 1;
+
+        for (int begin = 0 ; begin < count ; begin += chunkSize)
+        {
+            bounds << begin;
+        }
+
+        bounds << count;
+
+        ThreadSchedulerTasks tasks;
+
+        for (int i = 0 ; i < bounds.size() - 1 ; ++i)
+        {
+            tasks.run(d, &Private::sortRange, bounds.at(i), bounds.at(i + 1));
+        }
+
+        tasks.waitForDone();
+
+        while (bounds.size() > 2)
+        {
+            QVector<int> next;
+            int i = 0;
+
+            for ( ; i + 2 < bounds.size() ; i += 2)
+            {
+                tasks.run(d, &Private::mergeRange, bounds.at(i), bounds.at(i + 1), bounds.at(i + 2));
+                next << bounds.at(i);
+            }
+
+            if (i < bounds.size() - 1)
+            {
+                // odd trailing chunk, merged at next level
+                next << bounds.at(i);
+            }
+
+            next << bounds.last();
+
+            tasks.waitForDone();
+
+            bounds = next;
+        }
+    }
+
+    for (int i = 0 ; i < count ; ++i)
+    {
+        d->ranks[d->order.at(i)] = i;
+    }
+
+    d->sorted = true;
+}
+
+int ItemSortKeys::rank(qlonglong imageId) const
+{
+    if (!d->sorted)
+    {
+        return -1;
+    }
+
+    QHash<qlonglong, int>::const_iterator it = d->rows.constFind(imageId);
+
+    if (it == d->rows.constEnd())
+    {
+        return -1;
+    }
+
+    return d->ranks.at(it.value());
+}
+
+} // namespace Digikam
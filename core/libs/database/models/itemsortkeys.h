@@ -0,0 +1,100 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-05
+ * Description : Precomputed sort keys snapshot used by ItemFilterModel
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_ITEM_SORT_KEYS_H
+#define DIGIKAM_ITEM_SORT_KEYS_H
+
+// Qt includes
+
+#include <QList>
+
+// Local includes
+
+#include "itemsortsettings.h"
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+class ItemInfo;
+
+/**
+ * A columnar snapshot of the values ItemSortSettings::lessThan() compares.
+ * Values are read once from ItemInfo, file names and paths are converted
+ * to collation keys, and all items are sorted in parallel to a rank.
+ * Comparing two items is then a comparison of two integers.
+ *
+ * The snapshot is not thread-safe, it is meant to be used from the
+ * thread owning the model.
+ */
+class DIGIKAM_DATABASE_EXPORT ItemSortKeys
+{
+public:
+
+    explicit ItemSortKeys();
+    ~ItemSortKeys();
+
+    /** Set the sort settings. If the role or string comparison settings changed,
+     *  all values are dropped, else only the ranks are invalidated.
+     */
+    void setSortSettings(const ItemSortSettings& settings);
+
+    /** Read the values of the given items, adding new items or replacing
+     *  the values of known items. Ranks are invalidated.
+     */
+    void update(const QList<ItemInfo>& infos);
+
+    /** Forget the values of the given items, for example when they changed.
+     */
+    void remove(const QList<qlonglong>& imageIds);
+
+    void clear();
+
+    bool isEmpty()                  const;
+    int  count()                    const;
+    bool contains(qlonglong imageId) const;
+
+    /** Return true if ranks are up to date with the stored values.
+     */
+    bool isSorted()                 const;
+
+    /** Sort all stored items in parallel and compute ranks.
+     */
+    void sort();
+
+    /** Return the position of the item in the sorted snapshot,
+     *  or -1 if the item is unknown or ranks are not up to date.
+     */
+    int  rank(qlonglong imageId)     const;
+
+private:
+
+    ItemSortKeys(const ItemSortKeys&); // Disable
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_ITEM_SORT_KEYS_H
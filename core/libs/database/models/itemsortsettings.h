@@ -213,7 +213,11 @@ public:
         collator.setIgnorePunctuation(false);
         collator.setCaseSensitivity(caseSensitive);
 
-        if (a.contains(QLatin1String("_v"), Qt::CaseInsensitive))
+        // Versioned file names are compared ignoring punctuation. Test both names,
+        // the result must not depend on the order of the arguments.
+
+        if (a.contains(QLatin1String("_v"), Qt::CaseInsensitive) ||
+            b.contains(QLatin1String("_v"), Qt::CaseInsensitive))
         {
             collator.setIgnorePunctuation(true);
         }
@@ -27,6 +27,7 @@
 // Qt includes
 
 #include <QHash>
+#include <QSet>
 
 // Local includes
 
@@ -61,6 +62,9 @@ public:
     QRect                  detailRect;
     QVector<int>           staticListContainingThumbnailRole;
 
+    /// The thumbnails requested for the items in view by the last call to prepareThumbnails()
+    QList<LoadingDescription> preparedDescriptions;
+
     bool                   emitDataChanged;
 
     int preloadThumbnailSize() const
@@ -90,6 +94,7 @@ ItemThumbnailModel::~ItemThumbnailModel()
 void ItemThumbnailModel::setThumbnailLoadThread(ThumbnailLoadThread* const thread)
 {
     d->thread = thread;
+    d->preparedDescriptions.clear();
 
     connect(d->thread, SIGNAL(signalThumbnailLoaded(LoadingDescription,QPixmap)),
             this, SLOT(slotThumbnailLoaded(LoadingDescription,QPixmap)));
@@ -164,7 +169,46 @@ void ItemThumbnailModel::prepareThumbnails(const QList<QModelIndex>& indexesToPr
         ids << imageInfoRef(index).thumbnailIdentifier();
     }
 
-    d->thread->findGroup(ids, thumbSize.size());
+    d->thread->findGroup(ids, thumbSize.size(), this);
+
+    QList<LoadingDescription> descriptions = d->thread->lastDescriptions();
+
+    // Two stage loading: read the placeholders of the items still to be loaded,
+    // they are displayed by data() until the thumbnails are available.
+
+    QSet<QString> pendingPaths;
+
+    foreach (const LoadingDescription& description, descriptions)
+    {
+        pendingPaths << description.filePath;
+    }
+
+    QList<ThumbnailIdentifier> pendingIds;
+
+    foreach (const ThumbnailIdentifier& id, ids)
+    {
+        if (pendingPaths.contains(id.filePath))
+        {
+            pendingIds << id;
+        }
+    }
+
+    d->thread->loadPlaceholders(pendingIds);
+
+    // Cancel the requests of the items which are not in view anymore.
+
+    QList<LoadingDescription> offscreen;
+
+    foreach (const LoadingDescription& description, d->preparedDescriptions)
+    {
+        if (!pendingPaths.contains(description.filePath))
+        {
+            offscreen << description;
+        }
+    }
+
+    d->thread->cancelGroup(offscreen, this);
+    d->preparedDescriptions = descriptions;
 }
 
 void ItemThumbnailModel::preloadThumbnails(const QList<ItemInfo>& infos)
@@ -236,7 +280,8 @@ QVariant ItemThumbnailModel::data(const QModelIndex& index, int role) const
         }
         else
         {
-            if (d->thread->find(info.thumbnailIdentifier(), thumbnail, d->thumbSize.size()))
+            if (d->thread->find(info.thumbnailIdentifier(), thumbnail, d->thumbSize.size()) ||
+                d->thread->findPlaceholder(info.thumbnailIdentifier(), thumbnail, d->thumbSize.size()))
             {
                 return thumbnail;
             }
@@ -99,7 +99,9 @@ public:
 
 public Q_SLOTS:
 
-    /** Prepare the thumbnail loading for the given indexes
+    /** Prepare the thumbnail loading for the given indexes.
+     *  Placeholders of these items are loaded, and the requests of
+     *  the previously prepared items not given here anymore are canceled.
      */
     void prepareThumbnails(const QList<QModelIndex>& indexesToPrepare);
     void prepareThumbnails(const QList<QModelIndex>& indexesToPrepare, const ThumbnailSize& thumbSize);
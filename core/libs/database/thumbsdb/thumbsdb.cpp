@@ -239,6 +239,60 @@ QHash<QString, int> ThumbsDb::getFilePathsWithThumbnail()
     return filePaths;
 }
 
+BdEngineBackend::QueryState ThumbsDb::replacePlaceholder(int thumbId, const QByteArray& data)
+{
+    return d->db->execSql(QLatin1String("REPLACE INTO Placeholders (thumbId, data) VALUES (?,?);"),
+                          thumbId, data);
+}
+
+bool ThumbsDb::hasPlaceholder(int thumbId)
+{
+    QList<QVariant> values;
+    d->db->execSql(QLatin1String("SELECT thumbId FROM Placeholders WHERE thumbId=?;"),
+                   thumbId, &values);
+
+    return !values.isEmpty();
+}
+
+QHash<QString, QByteArray> ThumbsDb::findPlaceholdersByFilePaths(const QStringList& paths)
+{
+    QHash<QString, QByteArray> placeholders;
+
+    // Paths are passed in chunks, to stay below the bound values limit of the database.
+    const int chunkSize = 500;
+
+    for (int i = 0 ; i < paths.size() ; i += chunkSize)
+    {
+        QStringList chunk = paths.mid(i, chunkSize);
+        QString     sql   = QLatin1String("SELECT path, data FROM FilePaths "
+                                          " INNER JOIN Placeholders ON FilePaths.thumbId = Placeholders.thumbId "
+                                          "  WHERE path IN (");
+
+        QList<QVariant> boundValues;
+
+        for (int j = 0 ; j < chunk.size() ; ++j)
+        {
+            sql         += (j == 0) ? QLatin1String("?") : QLatin1String(",?");
+            boundValues << chunk.at(j);
+        }
+
+        sql += QLatin1String(");");
+
+        QList<QVariant> values;
+        d->db->execSql(sql, boundValues, &values);
+
+        for (QList<QVariant>::const_iterator it = values.constBegin() ; it != values.constEnd() ;)
+        {
+            QString path = (*it).toString();
+            ++it;
+            placeholders.insert(path, (*it).toByteArray());
+            ++it;
+        }
+    }
+
+    return placeholders;
+}
+
 BdEngineBackend::QueryState ThumbsDb::insertUniqueHash(const QString& uniqueHash, qlonglong fileSize, int thumbId)
 {
     return d->db->execSql(QLatin1String("REPLACE INTO UniqueHashes (uniqueHash, fileSize, thumbId) VALUES (?,?,?);"),
@@ -29,6 +29,7 @@
 
 #include <QDateTime>
 #include <QString>
+#include <QStringList>
 #include <QHash>
 #include <QList>
 
@@ -121,6 +122,22 @@ public:
 
     QHash<QString, int> getFilePathsWithThumbnail();
 
+    // ----------- Placeholder methods ----------
+
+    /**
+     * Placeholders are very small versions of the thumbnails, stored apart from the
+     * thumbnail data to be read fast in bulk. They are meant to be displayed until
+     * the thumbnail is loaded.
+     */
+    BdEngineBackend::QueryState replacePlaceholder(int thumbId, const QByteArray& data);
+    bool hasPlaceholder(int thumbId);
+
+    /**
+     * Returns the placeholder data of the given file paths, keyed by path.
+     * Paths without placeholder are not in the returned hash.
+     */
+    QHash<QString, QByteArray> findPlaceholdersByFilePaths(const QStringList& paths);
+
     void replaceUniqueHash(const QString& oldUniqueHash, int oldFileSize, const QString& newUniqueHash, int newFileSize);
     BdEngineBackend::QueryState updateModificationDate(int thumbId, const QDateTime& modificationDate);
 
@@ -48,7 +48,7 @@ namespace Digikam
 
 int ThumbsDbSchemaUpdater::schemaVersion()
 {
-    return 3;
+    return 4;
 }
 
 // -------------------------------------------------------------------------------------
@@ -233,6 +233,10 @@ bool ThumbsDbSchemaUpdater::makeUpdates()
         {
             updateV2ToV3();
         }
+        if (d->currentVersion == 3)
+        {
+            updateV3ToV4();
+        }
     }
 
     return true;
@@ -297,4 +301,19 @@ bool ThumbsDbSchemaUpdater::updateV2ToV3()
     return true;
 }
 
+bool ThumbsDbSchemaUpdater::updateV3ToV4()
+{
+    if (!d->dbAccess->backend()->execDBAction(d->dbAccess->backend()->getDBAction(QLatin1String("UpdateThumbnailsDBSchemaFromV3ToV4"))))
+    {
+        qCDebug(DIGIKAM_THUMBSDB_LOG) << "Thumbs database: schema upgrade from V3 to V4 failed!";
+        return false;
+    }
+
+    // Digikam for database version 3 can work with version 4, though not using the placeholders.
+    d->currentVersion         = 4;
+    d->currentRequiredVersion = 1;
+
+    return true;
+}
+
 } // namespace Digikam
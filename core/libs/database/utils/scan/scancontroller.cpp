@@ -165,11 +165,14 @@ void ScanController::run()
         bool doInit             = false;
         bool doScan             = false;
         bool doScanDeferred     = false;
+        bool doDeepVerify       = false;
         bool doFinishScan       = false;
         bool doPartialScan      = false;
+        bool doFileScan         = false;
         bool doUpdateUniqueHash = false;
 
-        QString task;
+        QString     task;
+        QStringList taskFiles;
         {
             QMutexLocker lock(&d->mutex);
 
@@ -183,6 +186,7 @@ void ScanController::run()
                 d->needsCompleteScan = false;
                 doScan               = true;
                 doScanDeferred       = d->deferFileScanning;
+                doDeepVerify         = d->deepVerify;
             }
             else if (d->needsUpdateUniqueHash)
             {
@@ -198,6 +202,15 @@ void ScanController::run()
             {
                 doPartialScan = true;
                 task          = d->scanTasks.takeFirst();
+                d->fileScanTasks.remove(task);
+            }
+            else if (!d->fileScanTasks.isEmpty() && !d->scanSuspended)
+            {
+                QHash<QString, QSet<QString> >::iterator it = d->fileScanTasks.begin();
+                doFileScan    = true;
+                task          = it.key();
+                taskFiles     = it.value().toList();
+                d->fileScanTasks.erase(it);
             }
             else
             {
@@ -228,6 +241,7 @@ void ScanController::run()
 
             scanner.setNeedFileCount(d->needTotalFiles);
             scanner.setDeferredFileScanning(doScanDeferred);
+            scanner.setDeepVerify(doDeepVerify);
             scanner.setHintContainer(d->hints);
 
             SimpleCollectionScannerObserver observer(&d->continueScan);
@@ -278,6 +292,15 @@ void ScanController::run()
             scanner.partialScan(task);
             emit partialScanDone(task);
         }
+        else if (doFileScan)
+        {
+            CollectionScanner scanner;
+            scanner.setHintContainer(d->hints);
+            SimpleCollectionScannerObserver observer(&d->continuePartialScan);
+            scanner.setObserver(&observer);
+            scanner.partialScanFiles(task, taskFiles);
+            emit partialScanDone(task);
+        }
         else if (doUpdateUniqueHash)
         {
             CoreDbAccess access;
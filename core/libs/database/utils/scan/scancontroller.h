@@ -152,8 +152,9 @@ public:
     /**
      * Scan Whole collection without to display a progress dialog
      * or to manage splashscreen, as for NewItemsFinder tool.
+     * With deepVerify, the folders unchanged since the last scan are checked too.
      */
-    void completeCollectionScanInBackground(bool defer);
+    void completeCollectionScanInBackground(bool defer, bool deepVerify = false);
 
     /**
      * Schedules a scan of the specified part of the collection.
@@ -180,6 +181,15 @@ public:
      */
     void scheduleCollectionScanExternal(const QString& path);
 
+    /**
+     * Schedules a scan of the given files of the album at dirPath only.
+     * Asynchronous, returns immediately.
+     * The file names of several calls for the same album are merged.
+     * If a scan of the whole album is already scheduled, nothing is done.
+     * This method is for the file change journal of AlbumWatch.
+     */
+    void scheduleCollectionScanFiles(const QString& dirPath, const QStringList& fileNames);
+
     /**
      * Implementation of FileMetadataWrite, see there. Calling these methods is equivalent.
      */
@@ -216,7 +226,7 @@ private:
      */
     void scanFileDirectly(const QString& filePath);
     void scanFileDirectlyNormal(const ItemInfo& info);
-    void completeCollectionScanCore(bool needTotalFiles, bool defer);
+    void completeCollectionScanCore(bool needTotalFiles, bool defer, bool deepVerify = false);
 
     //@}
 
@@ -49,6 +49,7 @@ ScanController::Private::Private()
       idle(false),
       scanSuspended(0),
       deferFileScanning(false),
+      deepVerify(false),
       finishScanAllowed(true),
       continueInitialization(false),
       continueScan(false),
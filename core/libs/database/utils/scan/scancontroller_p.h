@@ -31,6 +31,8 @@
 // Qt includes
 
 #include <QStringList>
+#include <QHash>
+#include <QSet>
 #include <QFileInfo>
 #include <QPixmap>
 #include <QIcon>
@@ -128,9 +130,11 @@ public:
     int                             scanSuspended;
 
     QStringList                     scanTasks;
+    QHash<QString, QSet<QString> >  fileScanTasks;
 
     QStringList                     completeScanDeferredAlbums;
     bool                            deferFileScanning;
+    bool                            deepVerify;
     bool                            finishScanAllowed;
 
     QMutex                          mutex;
@@ -75,12 +75,12 @@ void ScanController::completeCollectionScan(bool defer)
     d->progressDialog = 0;
 }
 
-void ScanController::completeCollectionScanInBackground(bool defer)
+void ScanController::completeCollectionScanInBackground(bool defer, bool deepVerify)
 {
-    completeCollectionScanCore(true, defer);
+    completeCollectionScanCore(true, defer, deepVerify);
 }
 
-void ScanController::completeCollectionScanCore(bool needTotalFiles, bool defer)
+void ScanController::completeCollectionScanCore(bool needTotalFiles, bool defer, bool deepVerify)
 {
     d->needTotalFiles = needTotalFiles;
 
@@ -88,6 +88,7 @@ void ScanController::completeCollectionScanCore(bool needTotalFiles, bool defer)
         QMutexLocker lock(&d->mutex);
         d->needsCompleteScan = true;
         d->deferFileScanning = defer;
+        d->deepVerify        = deepVerify;
         d->condVar.wakeAll();
     }
 
@@ -136,6 +137,18 @@ void ScanController::scheduleCollectionScanExternal(const QString& path)
     }
 }
 
+void ScanController::scheduleCollectionScanFiles(const QString& dirPath, const QStringList& fileNames)
+{
+    QMutexLocker lock(&d->mutex);
+
+    if (!d->scanTasks.contains(dirPath))
+    {
+        d->fileScanTasks[dirPath] += fileNames.toSet();
+    }
+
+    d->condVar.wakeAll();
+}
+
 void ScanController::scanFileDirectly(const QString& filePath)
 {
     suspendCollectionScan();
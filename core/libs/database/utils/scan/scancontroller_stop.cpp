@@ -60,6 +60,7 @@ void ScanController::cancelAllAndSuspendCollectionScan()
     d->continueScan           = false;
 
     d->scanTasks.clear();
+    d->fileScanTasks.clear();
     d->continuePartialScan    = false;
 
     d->relaxedTimer->stop();
@@ -333,6 +333,11 @@ public:
     void       setMetadata(const MetaEngineData& data);
     void       setIccProfile(const IccProfile& profile);
 
+    /** Attributes can also be set before loading as hints for the loaders:
+        "scaledLoadingSize" (int) allows a reduced size decoding not smaller than this size,
+        "loadingRegion" (QRect, original image coordinates) asks for a region of the image only.
+        If a loader honored the region, it sets "loadedRegion" to this region after loading.
+     */
     void       setAttribute(const QString& key, const QVariant& value);
     QVariant   attribute(const QString& key)    const;
     bool       hasAttribute(const QString& key) const;
@@ -73,7 +73,13 @@ void DImg::convertDepth(int depth)
     {
         // downgrading from 16 bit to 8 bit
 
-        uchar*  data = new uchar[width()*height() * 4];
+        uchar*  data = DImgBufferPool::instance()->acquire(size_t(width()) * height() * 4);
+
+        if (!data)
+        {
+            return;
+        }
+
         uchar*  dptr = data;
         ushort* sptr = reinterpret_cast<ushort*>(bits());
         uint dim     = width() * height() * 4;
@@ -83,7 +89,7 @@ void DImg::convertDepth(int depth)
             *dptr++ = (*sptr++ * 256UL) / 65536UL;
         }
 
-        delete [] m_priv->data;
+        DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
         m_priv->data       = data;
         m_priv->sixteenBit = false;
     }
@@ -91,7 +97,13 @@ void DImg::convertDepth(int depth)
     {
         // upgrading from 8 bit to 16 bit
 
-        uchar*  data = new uchar[width()*height() * 8];
+        uchar*  data = DImgBufferPool::instance()->acquire(size_t(width()) * height() * 8);
+
+        if (!data)
+        {
+            return;
+        }
+
         ushort* dptr = reinterpret_cast<ushort*>(data);
         uchar*  sptr = bits();
 
@@ -115,7 +127,7 @@ void DImg::convertDepth(int depth)
             *dptr++ = (*sptr++ * 65536ULL) / 256ULL + noise;
         }
 
-        delete [] m_priv->data;
+        DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
         m_priv->data       = data;
         m_priv->sixteenBit = true;
     }
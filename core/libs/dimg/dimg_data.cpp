@@ -73,11 +73,13 @@ void DImg::putImageData(uint width, uint height, bool sixteenBit, bool alpha, uc
     // set image data, metadata is untouched
 
     bool null = (width == 0) || (height == 0);
-    // allocateData, or code below will set null to false
-    setImageData(true, width, height, sixteenBit, alpha);
 
     // replace data
-    delete [] m_priv->data;
+    DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
+    m_priv->data = 0;
+
+    // allocateData, or code below will set null to false
+    setImageData(true, width, height, sixteenBit, alpha);
 
     if (null)
     {
@@ -111,7 +113,7 @@ void DImg::putImageData(uchar* const data, bool copyData)
 {
     if (!data)
     {
-        delete [] m_priv->data;
+        DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
         m_priv->data = 0;
         m_priv->null = true;
     }
@@ -157,8 +159,8 @@ void DImg::copyImageData(const Private* const src)
 
 size_t DImg::allocateData()
 {
-    size_t size  = m_priv->width * m_priv->height * (m_priv->sixteenBit ? 8 : 4);
-    m_priv->data = DImgLoader::new_failureTolerant(size);
+    size_t size  = m_priv->dataSize();
+    m_priv->data = DImgBufferPool::instance()->acquire(size);
 
     if (!m_priv->data)
     {
@@ -70,6 +70,7 @@ extern "C"
 #include "dmetadata.h"
 #include "dshareddata.h"
 #include "dimagehistory.h"
+#include "dimgbufferpool.h"
 #include "iccprofile.h"
 #include "metaengine_rotation.h"
 #include "drawdecoder.h"
@@ -143,10 +144,18 @@ public:
 
     ~Private()
     {
-        delete [] data;
+        DImgBufferPool::releaseSafely(data, dataSize());
         delete [] lanczos_func;
     }
 
+    /**
+     * The number of bytes of the image data for the current geometry.
+     */
+    size_t dataSize() const
+    {
+        return size_t(width) * height * (sixteenBit ? 8 : 4);
+    }
+
     static QStringList fileOriginAttributes()
     {
         QStringList list;
@@ -40,16 +40,19 @@ void DImg::crop(int x, int y, int w, int h)
         return;
     }
 
-    uint  oldw = width();
-    uint  oldh = height();
-    QScopedArrayPointer<uchar> old(stripImageData());
+    uint   oldw      = width();
+    uint   oldh      = height();
+    size_t oldSize   = m_priv->dataSize();
+    uchar* const old = stripImageData();
 
     // set new image data, bits(), width(), height() change
     setImageDimension(w, h);
     allocateData();
 
     // copy image region (x|y), wxh, from old data to point (0|0) of new data
-    bitBlt(old.data(), bits(), x, y, w, h, 0, 0, oldw, oldh, width(), height(), sixteenBit(), bytesDepth(), bytesDepth());
+    bitBlt(old, bits(), x, y, w, h, 0, 0, oldw, oldh, width(), height(), sixteenBit(), bytesDepth(), bytesDepth());
+
+    DImgBufferPool::instance()->release(old, oldSize);
 }
 
 void DImg::resize(int w, int h)
@@ -61,7 +64,7 @@ void DImg::resize(int w, int h)
 
     DImg image = smoothScale(w, h);
 
-    delete [] m_priv->data;
+    DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
     m_priv->data = image.stripImageData();
     setImageDimension(w, h);
 }
@@ -84,7 +87,7 @@ void DImg::rotate(ANGLE angle)
 
             if (sixteenBit())
             {
-                ullong* newData = DImgLoader::new_failureTolerant<ullong>(w * h);
+                ullong* newData = reinterpret_cast<ullong*>(DImgBufferPool::instance()->acquire(m_priv->dataSize()));
                 ullong* from    = reinterpret_cast<ullong*>(m_priv->data);
                 ullong* to      = 0;
 
@@ -101,12 +104,12 @@ void DImg::rotate(ANGLE angle)
 
                 switchDims = true;
 
-                delete [] m_priv->data;
+                DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
                 m_priv->data = (uchar*)newData;
             }
             else
             {
-                uint* newData = DImgLoader::new_failureTolerant<uint>(w * h);
+                uint* newData = reinterpret_cast<uint*>(DImgBufferPool::instance()->acquire(m_priv->dataSize()));
                 uint* from    = reinterpret_cast<uint*>(m_priv->data);
                 uint* to      = 0;
 
@@ -123,7 +126,7 @@ void DImg::rotate(ANGLE angle)
 
                 switchDims = true;
 
-                delete [] m_priv->data;
+                DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
                 m_priv->data = (uchar*)newData;
             }
 
@@ -214,7 +217,7 @@ void DImg::rotate(ANGLE angle)
 
             if (sixteenBit())
             {
-                ullong* newData = DImgLoader::new_failureTolerant<ullong>(w * h);
+                ullong* newData = reinterpret_cast<ullong*>(DImgBufferPool::instance()->acquire(m_priv->dataSize()));
                 ullong* from    = reinterpret_cast<ullong*>(m_priv->data);
                 ullong* to      = 0;
 
@@ -231,12 +234,12 @@ void DImg::rotate(ANGLE angle)
 
                 switchDims = true;
 
-                delete [] m_priv->data;
+                DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
                 m_priv->data = (uchar*)newData;
             }
             else
             {
-                uint* newData = DImgLoader::new_failureTolerant<uint>(w * h);
+                uint* newData = reinterpret_cast<uint*>(DImgBufferPool::instance()->acquire(m_priv->dataSize()));
                 uint* from    = reinterpret_cast<uint*>(m_priv->data);
                 uint* to      = 0;
 
@@ -253,7 +256,7 @@ void DImg::rotate(ANGLE angle)
 
                 switchDims = true;
 
-                delete [] m_priv->data;
+                DImgBufferPool::instance()->release(m_priv->data, m_priv->dataSize());
                 m_priv->data = (uchar*)newData;
             }
 
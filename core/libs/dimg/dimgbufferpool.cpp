@@ -0,0 +1,286 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Pool of DImg pixel buffers
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "dimgbufferpool.h"
+
+// Qt includes
+
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "dimgloader.h"
+#include "kmemoryinfo.h"
+
+namespace Digikam
+{
+
+DImgBufferPool::Statistics::Statistics()
+    : allocations(0),
+      reuses(0),
+      releases(0),
+      drops(0),
+      pooledBytes(0),
+      peakPooledBytes(0)
+{
+}
+
+QString DImgBufferPool::Statistics::toString() const
+{
+    return QString::fromLatin1("%1 buffers allocated, %2 reused, %3 released, %4 freed, %5 MB pooled, peak %6 MB")
+           .arg(allocations)
+           .arg(reuses)
+           .arg(releases)
+           .arg(drops)
+           .arg(pooledBytes     / (1024 * 1024))
+           .arg(peakPooledBytes / (1024 * 1024));
+}
+
+// ----------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN DImgBufferPool::Private
+{
+public:
+
+    class Buffer
+    {
+    public:
+
+        uchar* data;
+        size_t size;
+    };
+
+public:
+
+    explicit Private()
+        : maximumSize(0)
+    {
+    }
+
+    void freeOldest();
+
+public:
+
+    mutable QMutex mutex;
+
+    /// Pooled buffers, the oldest first
+    QList<Buffer>  buffers;
+
+    qint64         maximumSize;
+    Statistics     statistics;
+};
+
+void DImgBufferPool::Private::freeOldest()
+{
+    const Buffer buffer = buffers.takeFirst();
+
+    statistics.pooledBytes -= buffer.size;
+    statistics.drops++;
+
+    delete [] buffer.data;
+}
+
+// ----------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN DImgBufferPoolCreator
+{
+public:
+
+    DImgBufferPool object;
+};
+
+Q_GLOBAL_STATIC(DImgBufferPoolCreator, creator)
+
+DImgBufferPool* DImgBufferPool::instance()
+{
+    return &creator->object;
+}
+
+DImgBufferPool::DImgBufferPool()
+    : d(new Private)
+{
+    // A large RAW image in 16 bits takes about 200 MB.
+    KMemoryInfo memory = KMemoryInfo::currentInfo();
+    qint64 megabytes   = 128;
+
+    if (memory.isValid() == 1)
+    {
+        megabytes = qBound(64, int(memory.megabytes(KMemoryInfo::TotalRam) * 0.05), 512);
+    }
+
+    d->maximumSize = megabytes * 1024 * 1024;
+}
+
+DImgBufferPool::~DImgBufferPool()
+{
+    clear();
+    delete d;
+}
+
+size_t DImgBufferPool::minimumSize()
+{
+    // Below, the heap serves requests quickly and without page faults.
+    return 64 * 1024;
+}
+
+uchar* DImgBufferPool::acquire(size_t size)
+{
+    if (size >= minimumSize())
+    {
+        QMutexLocker lock(&d->mutex);
+
+        // Best fit, with at most 1/8 wasted.
+
+        const size_t largest = size + size / 8;
+        int found            = -1;
+
+        for (int i = d->buffers.size() - 1 ; i >= 0 ; --i)
+        {
+            const size_t candidate = d->buffers.at(i).size;
+
+            if ((candidate >= size) && (candidate <= largest) &&
+                ((found == -1) || (candidate < d->buffers.at(found).size)))
+            {
+                found = i;
+
+                if (candidate == size)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (found != -1)
+        {
+            const Private::Buffer buffer = d->buffers.takeAt(found);
+            d->statistics.pooledBytes   -= buffer.size;
+            d->statistics.reuses++;
+
+            return buffer.data;
+        }
+
+        d->statistics.allocations++;
+    }
+
+    return DImgLoader::new_failureTolerant(size);
+}
+
+void DImgBufferPool::release(uchar* const data, size_t size)
+{
+    if (!data)
+    {
+        return;
+    }
+
+    if (size >= minimumSize())
+    {
+        QMutexLocker lock(&d->mutex);
+
+        if (qint64(size) <= d->maximumSize)
+        {
+            while (!d->buffers.isEmpty() && (d->statistics.pooledBytes + qint64(size) > d->maximumSize))
+            {
+                d->freeOldest();
+            }
+
+            Private::Buffer buffer;
+            buffer.data = data;
+            buffer.size = size;
+            d->buffers << buffer;
+
+            d->statistics.releases++;
+            d->statistics.pooledBytes    += size;
+            d->statistics.peakPooledBytes = qMax(d->statistics.peakPooledBytes, d->statistics.pooledBytes);
+
+            return;
+        }
+
+        d->statistics.drops++;
+    }
+
+    delete [] data;
+}
+
+void DImgBufferPool::releaseSafely(uchar* const data, size_t size)
+{
+    if (creator.isDestroyed())
+    {
+        delete [] data;
+        return;
+    }
+
+    instance()->release(data, size);
+}
+
+void DImgBufferPool::setMaximumSize(qint64 bytes)
+{
+    QMutexLocker lock(&d->mutex);
+
+    d->maximumSize = qMax(bytes, qint64(0));
+
+    while (!d->buffers.isEmpty() && (d->statistics.pooledBytes > d->maximumSize))
+    {
+        d->freeOldest();
+    }
+
+    qCDebug(DIGIKAM_DIMG_LOG) << "Pixel buffer pool holds up to" << d->maximumSize / (1024 * 1024) << "MB";
+}
+
+qint64 DImgBufferPool::maximumSize() const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return d->maximumSize;
+}
+
+void DImgBufferPool::clear()
+{
+    QMutexLocker lock(&d->mutex);
+
+    while (!d->buffers.isEmpty())
+    {
+        d->freeOldest();
+    }
+}
+
+DImgBufferPool::Statistics DImgBufferPool::statistics() const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return d->statistics;
+}
+
+void DImgBufferPool::resetStatistics()
+{
+    QMutexLocker lock(&d->mutex);
+
+    const qint64 pooledBytes            = d->statistics.pooledBytes;
+    d->statistics                       = Statistics();
+    d->statistics.pooledBytes           = pooledBytes;
+    d->statistics.peakPooledBytes       = pooledBytes;
+}
+
+} // namespace Digikam
@@ -0,0 +1,140 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Pool of DImg pixel buffers
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_DIMG_BUFFER_POOL_H
+#define DIGIKAM_DIMG_BUFFER_POOL_H
+
+// C++ includes
+
+#include <cstddef>
+
+// Qt includes
+
+#include <QString>
+#include <QtGlobal>
+
+// Local includes
+
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+/**
+ * Keeps the pixel buffers of destroyed DImg objects to use them again for new images
+ * of about the same size, instead of returning multi-megabyte blocks to the heap and
+ * requesting them again right afterwards. This happens at each step of the batch queue
+ * manager tools and when thumbnails and previews are scaled.
+ *
+ * A released buffer is stored with the number of bytes of its image, and is used for
+ * requests up to 1/8 smaller. Buffers smaller than minimumSize() are not pooled.
+ * The pool holds at most maximumSize() bytes, by default a part of the physical
+ * memory as reported by KMemoryInfo. The oldest buffers are freed first. The pool is
+ * emptied with clear() when a batch queue run or an image editor session ends.
+ *
+ * All buffers are allocated with new[]: a buffer taken from the pool can be
+ * freed with delete [] by its owner, as DImg::stripImageData() callers do.
+ */
+class DIGIKAM_EXPORT DImgBufferPool
+{
+public:
+
+    class DIGIKAM_EXPORT Statistics
+    {
+    public:
+
+        explicit Statistics();
+
+        QString toString() const;
+
+    public:
+
+        /// Buffers allocated from the heap, and buffers taken from the pool instead
+        qint64 allocations;
+        qint64 reuses;
+
+        /// Buffers released to the pool, and buffers freed because the pool was full
+        qint64 releases;
+        qint64 drops;
+
+        qint64 pooledBytes;
+        qint64 peakPooledBytes;
+    };
+
+public:
+
+    static DImgBufferPool* instance();
+
+    /**
+     * Returns a buffer of at least size bytes, or 0 if the memory cannot be allocated.
+     */
+    uchar* acquire(size_t size);
+
+    /**
+     * Gives back a buffer holding at least size bytes. The buffer must have been
+     * allocated with new[], by acquire() or otherwise.
+     */
+    void release(uchar* const data, size_t size);
+
+    /**
+     * As release(), but frees the buffer if the pool was already destroyed at exit,
+     * as for DImg objects destroyed by other global objects.
+     */
+    static void releaseSafely(uchar* const data, size_t size);
+
+    /**
+     * The maximum number of bytes held by the pool. 0 disables the pool.
+     */
+    void   setMaximumSize(qint64 bytes);
+    qint64 maximumSize() const;
+
+    static size_t minimumSize();
+
+    /**
+     * Frees all pooled buffers.
+     */
+    void clear();
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+
+    explicit DImgBufferPool();
+    ~DImgBufferPool();
+
+    // Disable
+    DImgBufferPool(const DImgBufferPool&);
+    DImgBufferPool& operator=(const DImgBufferPool&);
+
+private:
+
+    friend class DImgBufferPoolCreator;
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_DIMG_BUFFER_POOL_H
@@ -28,7 +28,6 @@
 
 #include <QObject>
 #include <QDateTime>
-#include <QThreadPool>
 
 // Local includes
 
@@ -275,7 +274,7 @@ QString DImgThreadedFilter::readParametersError(const FilterAction&) const
 
 QList<int> DImgThreadedFilter::multithreadedSteps(int stop, int start) const
 {
-    uint  nbCore = QThreadPool::globalInstance()->maxThreadCount();
+    uint  nbCore = ThreadScheduler::instance()->maximumThreadCount();
     float step   = ((float)stop - (float)start) / (float)nbCore;
     QList<int> vals;
 
@@ -35,6 +35,7 @@
 #include "dimg.h"
 #include "dynamicthread.h"
 #include "filteraction.h"
+#include "threadscheduler.h"
 
 class QObject;
 
@@ -88,13 +89,14 @@ public:
         return m_name;
     };
 
-    /** This method return a list of steps to process parallelized operation in filter using QtConcurrents API.
+    /** This method return a list of steps to process parallelized operation in filter using ThreadSchedulerTasks.
      *  Usually, start and stop are rows or columns from image to process. By default, whole image will be processed
      *  and start value is 0. In this case stop will be last row or column to process.
-     *  Between range [start,stop], this method will divide by equal steps depending of number of CPU cores available.
+     *  Between range [start,stop], this method will divide by equal steps depending of number of tasks
+     *  ThreadScheduler runs at the same time.
      *  To be sure that all values will be processed, in case of CPU core division give rest, the last step compensate
      *  the difference.
-     *  See Blur filter loop implementation for example to see how to use this method with QtConcurrents API.
+     *  See Blur filter loop implementation for example to see how to use this method with ThreadSchedulerTasks.
      */
     QList<int> multithreadedSteps(int stop, int start=0) const;
 
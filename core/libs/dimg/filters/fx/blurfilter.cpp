@@ -27,7 +27,6 @@
 
 // Qt includes
 
-#include <QtConcurrent>    // krazy:exclude=includes
 #include <QtMath>
 #include <QMutex>
 
@@ -218,7 +217,7 @@ void BlurFilter::blurMultithreaded(uint start, uint stop)
             qCDebug(DIGIKAM_DIMG_LOG) << "Radius too small...";
         }
 
-        progress = (int)(((double)y * (100.0 / QThreadPool::globalInstance()->maxThreadCount())) / (stop-start));
+        progress = (int)(((double)y * (100.0 / ThreadScheduler::instance()->maximumThreadCount())) / (stop-start));
 
         if ((progress % 5 == 0) && (progress > oldProgress))
         {
@@ -246,19 +245,18 @@ void BlurFilter::filterImage()
     }
 
     QList<int> vals = multithreadedSteps(m_orgImage.height());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
     {
-        tasks.append(QtConcurrent::run(this,
-                                       &BlurFilter::blurMultithreaded,
-                                       vals[j],
-                                       vals[j+1]
-                                      ));
+        tasks.run(this,
+                  &BlurFilter::blurMultithreaded,
+                  vals[j],
+                  vals[j+1]
+                 );
     }
 
-    foreach(QFuture<void> t, tasks)
-        t.waitForFinished();
+    tasks.waitForDone();
 }
 
 FilterAction BlurFilter::filterAction()
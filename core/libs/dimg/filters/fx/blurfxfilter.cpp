@@ -37,7 +37,6 @@
 // Qt includes
 
 #include <QDateTime>
-#include <QtConcurrent>    // krazy:exclude=includes
 #include <QtMath>
 
 // Local includes
@@ -253,7 +252,7 @@ void BlurFXFilter::zoomBlur(DImg* const orgImage, DImg* const destImage, int X,
     }
 
     QList<int> vals = multithreadedSteps(xMax, xMin);
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -270,14 +269,13 @@ void BlurFXFilter::zoomBlur(DImg* const orgImage, DImg* const destImage, int X,
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::zoomBlurMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::zoomBlurMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)(h - yMin) * 100.0) / (yMax - yMin));
@@ -409,7 +407,7 @@ void BlurFXFilter::radialBlur(DImg* const orgImage, DImg* const destImage, int X
     }
 
     QList<int> vals = multithreadedSteps(xMax, xMin);
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -427,14 +425,13 @@ void BlurFXFilter::radialBlur(DImg* const orgImage, DImg* const destImage, int X
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::radialBlurMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::radialBlurMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)(h - yMin) * 100.0) / (yMax - yMin));
@@ -604,7 +601,7 @@ void BlurFXFilter::motionBlur(DImg* const orgImage, DImg* const destImage, int D
     }
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -623,14 +620,13 @@ void BlurFXFilter::motionBlur(DImg* const orgImage, DImg* const destImage, int D
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::motionBlurMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::motionBlurMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 100.0) / orgImage->height());
@@ -748,7 +744,7 @@ void BlurFXFilter::softenerBlur(DImg* const orgImage, DImg* const destImage)
     int progress;
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -763,14 +759,13 @@ void BlurFXFilter::softenerBlur(DImg* const orgImage, DImg* const destImage)
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::softenerBlurMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::softenerBlurMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 100.0) / orgImage->height());
@@ -874,7 +869,7 @@ void BlurFXFilter::shakeBlur(DImg* const orgImage, DImg* const destImage, int Di
     QScopedArrayPointer<uchar> layer4(new uchar[numBytes]);
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -894,14 +889,13 @@ void BlurFXFilter::shakeBlur(DImg* const orgImage, DImg* const destImage, int Di
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::shakeBlurStage1Multithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::shakeBlurStage1Multithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 50.0) / orgImage->height());
@@ -912,8 +906,6 @@ void BlurFXFilter::shakeBlur(DImg* const orgImage, DImg* const destImage, int Di
         }
     }
 
-    tasks.clear();
-
     for (uint h = 0; runningFlag() && (h < orgImage->height()); ++h)
     {
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
@@ -921,14 +913,13 @@ void BlurFXFilter::shakeBlur(DImg* const orgImage, DImg* const destImage, int Di
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::shakeBlurStage2Multithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::shakeBlurStage2Multithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(50.0 + ((double)h * 50.0) / orgImage->height());
@@ -1086,7 +1077,7 @@ void BlurFXFilter::focusBlur(DImg* const orgImage, DImg* const destImage,
     // Blending results.
 
     QList<int> vals = multithreadedSteps(xMax, xMin);
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage    = orgImage;
@@ -1105,14 +1096,13 @@ void BlurFXFilter::focusBlur(DImg* const orgImage, DImg* const destImage,
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::focusBlurMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::focusBlurMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(80.0 + ((double)(h - yMin) * 20.0) / (yMax - yMin));
@@ -1302,7 +1292,7 @@ void BlurFXFilter::smartBlur(DImg* const orgImage, DImg* const destImage, int Ra
 
     QList<int> valsw = multithreadedSteps(orgImage->width());
     QList<int> valsh = multithreadedSteps(orgImage->height());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage      = orgImage;
@@ -1320,14 +1310,13 @@ void BlurFXFilter::smartBlur(DImg* const orgImage, DImg* const destImage, int Ra
             prm.start = valsw[j];
             prm.stop  = valsw[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::smartBlurStage1Multithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::smartBlurStage1Multithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 50.0) / orgImage->height());
@@ -1340,8 +1329,6 @@ void BlurFXFilter::smartBlur(DImg* const orgImage, DImg* const destImage, int Ra
 
     // we have reached the second part of main loop
 
-    tasks.clear();
-
     for (uint w = 0 ; runningFlag() && (w < orgImage->width()) ; ++w)
     {
         for (int j = 0 ; runningFlag() && (j < valsh.count()-1) ; ++j)
@@ -1349,14 +1336,13 @@ void BlurFXFilter::smartBlur(DImg* const orgImage, DImg* const destImage, int Ra
             prm.start = valsh[j];
             prm.stop  = valsh[j+1];
             prm.w     = w;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::smartBlurStage2Multithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::smartBlurStage2Multithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(50.0 + ((double)w * 50.0) / orgImage->width());
@@ -1511,7 +1497,7 @@ void BlurFXFilter::mosaic(DImg* const orgImage, DImg* const destImage, int SizeW
     }
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -1528,14 +1514,13 @@ void BlurFXFilter::mosaic(DImg* const orgImage, DImg* const destImage, int SizeW
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::mosaicMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::mosaicMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 100.0) / orgImage->height());
@@ -1850,7 +1835,7 @@ void BlurFXFilter::MakeConvolution(DImg* const orgImage, DImg* const destImage,
 
     QList<int> valsw = multithreadedSteps(orgImage->width());
     QList<int> valsh = multithreadedSteps(orgImage->height());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -1869,14 +1854,13 @@ void BlurFXFilter::MakeConvolution(DImg* const orgImage, DImg* const destImage,
             prm.start = valsw[j];
             prm.stop  = valsw[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::MakeConvolutionStage1Multithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::MakeConvolutionStage1Multithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 50.0) / orgImage->height());
@@ -1889,8 +1873,6 @@ void BlurFXFilter::MakeConvolution(DImg* const orgImage, DImg* const destImage,
 
     // We enter in the second main loop
 
-    tasks.clear();
-
     for (uint w = 0; runningFlag() && (w < orgImage->width()); ++w)
     {
         for (int j = 0 ; runningFlag() && (j < valsh.count()-1) ; ++j)
@@ -1898,14 +1880,13 @@ void BlurFXFilter::MakeConvolution(DImg* const orgImage, DImg* const destImage,
             prm.start = valsh[j];
             prm.stop  = valsh[j+1];
             prm.w     = w;
-            tasks.append(QtConcurrent::run(this,
-                                           &BlurFXFilter::MakeConvolutionStage2Multithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &BlurFXFilter::MakeConvolutionStage2Multithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(50.0 + ((double)w * 50.0) / orgImage->width());
@@ -33,7 +33,6 @@
 
 // Qt includes
 
-#include <QtConcurrent>    // krazy:exclude=includes
 #include <QMutex>
 
 // Local includes
@@ -238,7 +237,7 @@ void CharcoalFilter::convolveImageMultithreaded(uint start, uint stop, double* n
             color.setPixel((ddata + x * ddepth + (width * y * ddepth)));
         }
 
-        progress = (int)( ( (double)y * (80.0 / QThreadPool::globalInstance()->maxThreadCount()) ) / (stop-start));
+        progress = (int)( ( (double)y * (80.0 / ThreadScheduler::instance()->maximumThreadCount()) ) / (stop-start));
 
         if ((progress % 5 == 0) && (progress > oldProgress))
         {
@@ -293,21 +292,20 @@ bool CharcoalFilter::convolveImage(const unsigned int order, const double* kerne
     // --------------------------------------------------------
 
     QList<int> vals = multithreadedSteps(m_orgImage.height());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
     {
-        tasks.append(QtConcurrent::run(this,
-                                       &CharcoalFilter::convolveImageMultithreaded,
-                                       vals[j],
-                                       vals[j+1],
-                                       normal_kernel.data(),
-                                       kernelWidth
-                                      ));
+        tasks.run(this,
+                  &CharcoalFilter::convolveImageMultithreaded,
+                  vals[j],
+                  vals[j+1],
+                  normal_kernel.data(),
+                  kernelWidth
+                 );
     }
 
-    foreach (QFuture<void> t, tasks)
-        t.waitForFinished();
+    tasks.waitForDone();
 
     return true;
 }
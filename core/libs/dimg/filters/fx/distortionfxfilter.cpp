@@ -39,7 +39,6 @@
 #include <QDateTime>
 #include <QSize>
 #include <QMutex>
-#include <QtConcurrent>    // krazy:exclude=includes
 #include <QtMath>
 
 // Local includes
@@ -273,7 +272,7 @@ void DistortionFXFilter::fisheye(DImg* orgImage, DImg* destImage, double Coeff,
     int progress;
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -290,14 +289,13 @@ void DistortionFXFilter::fisheye(DImg* orgImage, DImg* destImage, double Coeff,
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::fisheyeMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::fisheyeMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)(h) * 100.0) / orgImage->height());
@@ -400,7 +398,7 @@ void DistortionFXFilter::twirl(DImg* orgImage, DImg* destImage, int dist, bool A
     int progress;
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -417,14 +415,13 @@ void DistortionFXFilter::twirl(DImg* orgImage, DImg* destImage, int dist, bool A
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::twirlMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::twirlMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 100.0) / orgImage->height());
@@ -531,7 +528,7 @@ void DistortionFXFilter::cilindrical(DImg* orgImage, DImg* destImage, double Coe
     memcpy(destImage->bits(), orgImage->bits(), orgImage->numBytes());
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage   = orgImage;
@@ -550,14 +547,13 @@ void DistortionFXFilter::cilindrical(DImg* orgImage, DImg* destImage, double Coe
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::cilindricalMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::cilindricalMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 100.0) / orgImage->height());
@@ -630,7 +626,7 @@ void DistortionFXFilter::multipleCorners(DImg* orgImage, DImg* destImage, int Fa
     int progress;
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -647,14 +643,13 @@ void DistortionFXFilter::multipleCorners(DImg* orgImage, DImg* destImage, int Fa
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::multipleCornersMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::multipleCornersMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 100.0) / orgImage->height());
@@ -682,7 +677,7 @@ void DistortionFXFilter::wavesHorizontalMultithreaded(const Args& prm)
         }
 
         // Update the progress bar in dialog.
-        progress = (int)( ( (double)h * (100.0 / QThreadPool::globalInstance()->maxThreadCount()) ) / (prm.stop - prm.start));
+        progress = (int)( ( (double)h * (100.0 / ThreadScheduler::instance()->maximumThreadCount()) ) / (prm.stop - prm.start));
 
         if ((progress % 5 == 0) && (progress > oldProgress))
         {
@@ -711,7 +706,7 @@ void DistortionFXFilter::wavesVerticalMultithreaded(const Args& prm)
         }
 
         // Update the progress bar in dialog.
-        progress = (int)( ( (double)w * (100.0 / QThreadPool::globalInstance()->maxThreadCount()) ) / (prm.stop - prm.start));
+        progress = (int)( ( (double)w * (100.0 / ThreadScheduler::instance()->maximumThreadCount()) ) / (prm.stop - prm.start));
 
         if ((progress % 5 == 0) && (progress > oldProgress))
         {
@@ -761,38 +756,36 @@ void DistortionFXFilter::waves(DImg* orgImage, DImg* destImage,
     if (Direction)        // Horizontal
     {
         QList<int> vals = multithreadedSteps(orgImage->height());
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
             prm.start = vals[j];
             prm.stop  = vals[j+1];
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::wavesHorizontalMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::wavesHorizontalMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
     }
     else
     {
         QList<int> vals = multithreadedSteps(orgImage->width());
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
             prm.start = vals[j];
             prm.stop  = vals[j+1];
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::wavesVerticalMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::wavesVerticalMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
     }
 }
 
@@ -867,7 +860,7 @@ void DistortionFXFilter::blockWaves(DImg* orgImage, DImg* destImage,
     int progress;
 
     QList<int> vals = multithreadedSteps(orgImage->height());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -883,14 +876,13 @@ void DistortionFXFilter::blockWaves(DImg* orgImage, DImg* destImage,
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.w     = w;
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::blockWavesMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::blockWavesMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)w * 100.0) / orgImage->width());
@@ -969,7 +961,7 @@ void DistortionFXFilter::circularWaves(DImg* orgImage, DImg* destImage, int X, i
     int progress;
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -989,14 +981,13 @@ void DistortionFXFilter::circularWaves(DImg* orgImage, DImg* destImage, int X, i
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::circularWavesMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::circularWavesMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 100.0) / orgImage->height());
@@ -1083,7 +1074,7 @@ void DistortionFXFilter::polarCoordinates(DImg* orgImage, DImg* destImage, bool
     int progress;
 
     QList<int> vals = multithreadedSteps(orgImage->width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.orgImage  = orgImage;
@@ -1100,14 +1091,13 @@ void DistortionFXFilter::polarCoordinates(DImg* orgImage, DImg* destImage, bool
             prm.start = vals[j];
             prm.stop  = vals[j+1];
             prm.h     = h;
-            tasks.append(QtConcurrent::run(this,
-                                           &DistortionFXFilter::polarCoordinatesMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &DistortionFXFilter::polarCoordinatesMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)h * 100.0) / orgImage->height());
@@ -1135,7 +1125,7 @@ void DistortionFXFilter::tileMultithreaded(const Args& prm)
         }
 
         // Update the progress bar in dialog.
-        progress = (int)( ( (double)h * (100.0 / QThreadPool::globalInstance()->maxThreadCount()) ) / (prm.stop - prm.start));
+        progress = (int)( ( (double)h * (100.0 / ThreadScheduler::instance()->maximumThreadCount()) ) / (prm.stop - prm.start));
 
         if ((progress % 5 == 0) && (progress > oldProgress))
         {
@@ -1190,20 +1180,19 @@ void DistortionFXFilter::tile(DImg* orgImage, DImg* destImage,
     d->generator.seed(d->randomSeed);
 
     QList<int> vals = multithreadedSteps(orgImage->height());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
     {
         prm.start = vals[j];
         prm.stop  = vals[j+1];
-        tasks.append(QtConcurrent::run(this,
-                                       &DistortionFXFilter::tileMultithreaded,
-                                       prm
-                                      ));
+        tasks.run(this,
+                  &DistortionFXFilter::tileMultithreaded,
+                  prm
+                 );
     }
 
-    foreach(QFuture<void> t, tasks)
-        t.waitForFinished();
+    tasks.waitForDone();
 }
 
 /*
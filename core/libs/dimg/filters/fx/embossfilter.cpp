@@ -36,7 +36,6 @@
 // Qt includes
 
 #include <QtMath>
-#include <QtConcurrent>    // krazy:exclude=includes
 
 // Local includes
 
@@ -130,21 +129,20 @@ void EmbossFilter::filterImage()
 
     for (uint h = 0 ; runningFlag() && (h < m_orgImage.height()) ; ++h)
     {
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
-            tasks.append(QtConcurrent::run(this,
-                                           &EmbossFilter::embossMultithreaded,
-                                           vals[j],
-                                           vals[j+1],
-                                           h,
-                                           Depth
-                                          ));
+            tasks.run(this,
+                      &EmbossFilter::embossMultithreaded,
+                      vals[j],
+                      vals[j+1],
+                      h,
+                      Depth
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         progress = (int)(((double)h * 100.0) / m_orgImage.height());
 
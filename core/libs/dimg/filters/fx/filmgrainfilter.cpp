@@ -32,7 +32,6 @@
 
 // Qt includes
 
-#include <QtConcurrent>    // krazy:exclude=includes
 #include <QMutex>
 
 // Local includes
@@ -208,7 +207,7 @@ void FilmGrainFilter::filmgrainMultithreaded(uint start, uint stop)
             }
         }
 
-        progress = (int)( ( (double)x * (100.0 / QThreadPool::globalInstance()->maxThreadCount()) ) / (stop-start));
+        progress = (int)( ( (double)x * (100.0 / ThreadScheduler::instance()->maximumThreadCount()) ) / (stop-start));
 
         if ((progress % 5 == 0) && (progress > oldProgress))
         {
@@ -246,19 +245,18 @@ void FilmGrainFilter::filterImage()
     d->generator.seed(1); // noise will always be the same
 
     QList<int> vals = multithreadedSteps(m_orgImage.width());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
     {
-        tasks.append(QtConcurrent::run(this,
-                                       &FilmGrainFilter::filmgrainMultithreaded,
-                                       vals[j],
-                                       vals[j+1]
-                                      ));
+        tasks.run(this,
+                  &FilmGrainFilter::filmgrainMultithreaded,
+                  vals[j],
+                  vals[j+1]
+                 );
     }
 
-    foreach(QFuture<void> t, tasks)
-        t.waitForFinished();
+    tasks.waitForDone();
 }
 
 /** This method compute lead noise of reference matrix point used to simulate graininess size
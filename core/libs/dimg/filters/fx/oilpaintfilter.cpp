@@ -35,7 +35,6 @@
 
 // Qt includes
 
-#include <QtConcurrent>    // krazy:exclude=includes
 #include <QMutex>
 
 // Local includes
@@ -122,7 +121,7 @@ void OilPaintFilter::oilPaintImageMultithreaded(uint start, uint stop)
             mostFrequentColor.setPixel(dptr);
         }
 
-        progress = (int)( ( (double)h2 * (100.0 / QThreadPool::globalInstance()->maxThreadCount()) ) / (stop-start));
+        progress = (int)( ( (double)h2 * (100.0 / ThreadScheduler::instance()->maximumThreadCount()) ) / (stop-start));
 
         if ((progress % 5 == 0) && (progress > oldProgress))
         {
@@ -138,19 +137,18 @@ void OilPaintFilter::oilPaintImageMultithreaded(uint start, uint stop)
 void OilPaintFilter::filterImage()
 {
     QList<int> vals = multithreadedSteps(m_orgImage.height());
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
     {
-        tasks.append(QtConcurrent::run(this,
-                                       &OilPaintFilter::oilPaintImageMultithreaded,
-                                       vals[j],
-                                       vals[j+1]
-                                      ));
+        tasks.run(this,
+                  &OilPaintFilter::oilPaintImageMultithreaded,
+                  vals[j],
+                  vals[j+1]
+                 );
     }
 
-    foreach(QFuture<void> t, tasks)
-        t.waitForFinished();
+    tasks.waitForDone();
 }
 
 /** Function to determine the most frequent color in a matrix
@@ -37,7 +37,6 @@
 #include <QDateTime>
 #include <QRect>
 #include <QtMath>
-#include <QtConcurrent>    // krazy:exclude=includes
 
 // Local includes
 
@@ -228,21 +227,20 @@ void RainDropFilter::rainDropsImage(DImg* const orgImage, DImg* const destImage,
 
     for (int i = 0 ; runningFlag() && (i < Amount) ; ++i)
     {
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
             prm.start        = vals[j];
             prm.stop         = vals[j+1];
 
-            tasks.append(QtConcurrent::run(this,
-                                           &RainDropFilter::rainDropsImageMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &RainDropFilter::rainDropsImageMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         postProgress((int)(progressMin + ((double)(i) *
                                           (double)(progressMax - progressMin)) / (double)Amount));
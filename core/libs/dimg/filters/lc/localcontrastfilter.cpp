@@ -30,7 +30,6 @@
 // Qt includes
 
 #include <QtMath>
-#include <QtConcurrent>    // krazy:exclude=includes
 
 // Local includes
 
@@ -341,21 +340,20 @@ void LocalContrastFilter::processRgbImage(float* const img, int sizex, int sizey
 
             inplaceBlur(blurimage.data(), sizex, sizey, d->par.getBlur(nstage));
 
-            QList <QFuture<void> > tasks;
+            ThreadSchedulerTasks tasks;
 
             for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
             {
-                tasks.append(QtConcurrent::run(this,
-                                               &LocalContrastFilter::blurMultithreaded,
-                                               vals[j],
-                                               vals[j+1],
-                                               img,
-                                               blurimage.data()
-                                              ));
+                tasks.run(this,
+                          &LocalContrastFilter::blurMultithreaded,
+                          vals[j],
+                          vals[j+1],
+                          img,
+                          blurimage.data()
+                         );
             }
 
-            foreach(QFuture<void> t, tasks)
-                t.waitForFinished();
+            tasks.waitForDone();
         }
 
         postProgress(50 + nstage * 5);
@@ -366,21 +364,20 @@ void LocalContrastFilter::processRgbImage(float* const img, int sizex, int sizey
         qCDebug(DIGIKAM_DIMG_LOG) << "highSaturation : " << d->par.highSaturation;
         qCDebug(DIGIKAM_DIMG_LOG) << "lowSaturation : "  << d->par.lowSaturation;
 
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
-            tasks.append(QtConcurrent::run(this,
-                                           &LocalContrastFilter::saturationMultithreaded,
-                                           vals[j],
-                                           vals[j+1],
-                                           img,
-                                           srcimg.data()
-                                          ));
+            tasks.run(this,
+                      &LocalContrastFilter::saturationMultithreaded,
+                      vals[j],
+                      vals[j+1],
+                      img,
+                      srcimg.data()
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
     }
 
     postProgress(70);
@@ -465,35 +462,31 @@ void LocalContrastFilter::inplaceBlur(float* const data, int sizex, int sizey, f
 
     for (uint stage = 0 ; runningFlag() && (stage < 2) ; ++stage)
     {
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < valsy.count()-1) ; ++j)
         {
             prm.start = valsy[j];
             prm.stop  = valsy[j+1];
-            tasks.append(QtConcurrent::run(this,
-                                           &LocalContrastFilter::inplaceBlurYMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &LocalContrastFilter::inplaceBlurYMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
-
-        tasks.clear();
+        tasks.waitForDone();
 
         for (int j = 0 ; runningFlag() && (j < valsx.count()-1) ; ++j)
         {
             prm.start = valsx[j];
             prm.stop  = valsx[j+1];
-            tasks.append(QtConcurrent::run(this,
-                                           &LocalContrastFilter::inplaceBlurXMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &LocalContrastFilter::inplaceBlurXMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
     }
 }
 
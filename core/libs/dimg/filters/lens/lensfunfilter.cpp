@@ -25,7 +25,6 @@
 #include <QByteArray>
 #include <QCheckBox>
 #include <QString>
-#include <QtConcurrent>    // krazy:exclude=includes
 
 // Local includes
 
@@ -241,18 +240,17 @@ void LensFunFilter::filterImage()
     {
         m_orgImage.prepareSubPixelAccess(); // init lanczos kernel
 
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
-            tasks.append(QtConcurrent::run(this,
-                                           &LensFunFilter::filterCCAMultithreaded,
-                                           vals[j],
-                                           vals[j+1]));
+            tasks.run(this,
+                      &LensFunFilter::filterCCAMultithreaded,
+                      vals[j],
+                      vals[j+1]);
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         qCDebug(DIGIKAM_DIMG_LOG) << "Chromatic Aberration Corrections applied.";
     }
@@ -263,18 +261,17 @@ void LensFunFilter::filterImage()
 
     if (d->iface->settings().filterVIG)
     {
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
-            tasks.append(QtConcurrent::run(this,
-                                           &LensFunFilter::filterVIGMultithreaded,
-                                           vals[j],
-                                           vals[j+1]));
+            tasks.run(this,
+                      &LensFunFilter::filterVIGMultithreaded,
+                      vals[j],
+                      vals[j+1]);
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         qCDebug(DIGIKAM_DIMG_LOG) << "Vignetting and Color Corrections applied.";
     }
@@ -295,18 +292,17 @@ void LensFunFilter::filterImage()
 
         m_destImage.prepareSubPixelAccess(); // init lanczos kernel
 
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
-            tasks.append(QtConcurrent::run(this,
-                                           &LensFunFilter::filterDSTMultithreaded,
-                                           vals[j],
-                                           vals[j+1]));
+            tasks.run(this,
+                      &LensFunFilter::filterDSTMultithreaded,
+                      vals[j],
+                      vals[j+1]);
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         qCDebug(DIGIKAM_DIMG_LOG) << "Distortion and Geometry Corrections applied.";
 
@@ -30,10 +30,6 @@
 
 #include <cmath>
 
-// Qt includes
-
-#include <QtConcurrent>    // krazy:exclude=includes
-
 // Local includes
 
 #include "dimg.h"
@@ -377,7 +373,7 @@ void NRFilter::waveletDenoise(float* fimg[3], unsigned int width, unsigned int h
     QScopedArrayPointer<float> temp(new float[qMax(width, height)]);
 
     QList<int> vals = multithreadedSteps(size);
-    QList <QFuture<void> > tasks;
+    ThreadSchedulerTasks tasks;
 
     Args prm;
     prm.thold     = &thold;
@@ -426,14 +422,13 @@ void NRFilter::waveletDenoise(float* fimg[3], unsigned int width, unsigned int h
         {
             prm.start = vals[j];
             prm.stop  = vals[j+1];
-            tasks.append(QtConcurrent::run(this,
-                                        &NRFilter::calculteStdevMultithreaded,
-                                        prm
-                                        ));
+            tasks.run(this,
+                      &NRFilter::calculteStdevMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         stdev[0] = sqrt(stdev[0] / (samples[0] + 1));
         stdev[1] = sqrt(stdev[1] / (samples[1] + 1));
@@ -443,20 +438,17 @@ void NRFilter::waveletDenoise(float* fimg[3], unsigned int width, unsigned int h
 
         // do thresholding
 
-        tasks.clear();
-
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
             prm.start = vals[j];
             prm.stop  = vals[j+1];
-            tasks.append(QtConcurrent::run(this,
-                                           &NRFilter::thresholdingMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &NRFilter::thresholdingMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         hpass = lpass;
     }
@@ -29,10 +29,6 @@
 
 #include <cmath>
 
-// Qt includes
-
-#include <QtConcurrent>    // krazy:exclude=includes
-
 // Local includes
 
 #include "dimg.h"
@@ -316,21 +312,20 @@ void RefocusFilter::convolveImage(const Args& prm)
 
     for (int y1 = 0; runningFlag() && (y1 < prm.height); ++y1)
     {
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
-            tasks.append(QtConcurrent::run(this,
-                                           &RefocusFilter::convolveImageMultithreaded,
-                                           vals[j],
-                                           vals[j+1],
-                                           y1,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &RefocusFilter::convolveImageMultithreaded,
+                      vals[j],
+                      vals[j+1],
+                      y1,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         // Update the progress bar in dialog.
         progress = (int)(((double)y1 * 100.0) / prm.height);
@@ -35,10 +35,6 @@
 #include <cmath>
 #include <cstdlib>
 
-// Qt includes
-
-#include <QtConcurrent>    // krazy:exclude=includes
-
 // Local includes
 
 #include "digikam_debug.h"
@@ -237,7 +233,7 @@ bool SharpenFilter::convolveImage(const unsigned int order, const double* const
 
     for (y = 0 ; runningFlag() && (y < m_destImage.height()) ; ++y)
     {
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
@@ -245,14 +241,13 @@ bool SharpenFilter::convolveImage(const unsigned int order, const double* const
             prm.stop  = vals[j+1];
             prm.y     = y;
 
-            tasks.append(QtConcurrent::run(this,
-                                           &SharpenFilter::convolveImageMultithreaded,
-                                           prm
-                                          ));
+            tasks.run(this,
+                      &SharpenFilter::convolveImageMultithreaded,
+                      prm
+                     );
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         progress = (int)(((double)y * 100.0) / m_destImage.height());
 
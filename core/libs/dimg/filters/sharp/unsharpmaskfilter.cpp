@@ -33,10 +33,6 @@
 #include <cmath>
 #include <cstdlib>
 
-// Qt includes
-
-#include <QtConcurrent>    // krazy:exclude=includes
-
 // Local includes
 
 #include "dimg.h"
@@ -190,19 +186,18 @@ void UnsharpMaskFilter::filterImage()
 
     for (uint y = 0 ; runningFlag() && (y < m_destImage.height()) ; ++y)
     {
-        QList <QFuture<void> > tasks;
+        ThreadSchedulerTasks tasks;
 
         for (int j = 0 ; runningFlag() && (j < vals.count()-1) ; ++j)
         {
-            tasks.append(QtConcurrent::run(this,
-                                           &UnsharpMaskFilter::unsharpMaskMultithreaded,
-                                           vals[j],
-                                           vals[j+1],
-                                           y));
+            tasks.run(this,
+                      &UnsharpMaskFilter::unsharpMaskMultithreaded,
+                      vals[j],
+                      vals[j+1],
+                      y);
         }
 
-        foreach(QFuture<void> t, tasks)
-            t.waitForFinished();
+        tasks.waitForDone();
 
         progress = (int)(10.0 + ((double)y * 90.0) / m_destImage.height());
 
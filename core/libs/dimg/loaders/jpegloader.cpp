@@ -37,6 +37,7 @@ extern "C"
 
 #include <QFile>
 #include <QByteArray>
+#include <QRect>
 
 // Local includes
 
@@ -253,6 +254,15 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         scaledLoadingSize = attribute.toInt();
     }
 
+    // Find out if only a region of the image is wanted, in original image coordinates.
+    QRect loadingRegion;
+    attribute = imageGetAttribute(QLatin1String("loadingRegion"));
+
+    if (attribute.isValid())
+    {
+        loadingRegion = attribute.toRect();
+    }
+
     // -------------------------------------------------------------------
     // Set JPEG decompressor instance
 
@@ -330,7 +340,10 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
     // -------------------------------------------------------------------
     // Load image data.
 
-    uchar* dest = 0;
+    uchar* dest        = 0;
+    bool regionLoading = false;
+
+    loadingRegion      = loadingRegion.intersected(QRect(QPoint(0, 0), originalSize));
 
     if (m_loadFlags & LoadImageData)
     {
@@ -341,7 +354,9 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         // handle scaled loading
         if (scaledLoadingSize)
         {
-            int imgSize = qMax(cinfo.image_width, cinfo.image_height);
+            // With a region, the region only must not get smaller than the requested size.
+            int imgSize = loadingRegion.isValid() ? qMax(loadingRegion.width(), loadingRegion.height())
+                                                  : qMax(cinfo.image_width, cinfo.image_height);
 
             // libjpeg supports 1/1, 1/2, 1/4, 1/8
             int scale = 1;
@@ -378,6 +393,46 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         w = cinfo.output_width;
         h = cinfo.output_height;
 
+        // First column to take from the decoded lines
+        int skipX = 0;
+        QRect outputRegion;
+
+        // handle region loading
+        if (loadingRegion.isValid() && loadingRegion != QRect(QPoint(0, 0), originalSize))
+        {
+            double scale  = (double)cinfo.output_width / (double)originalSize.width();
+            outputRegion  = QRectF(loadingRegion.x()      * scale,
+                                   loadingRegion.y()      * scale,
+                                   loadingRegion.width()  * scale,
+                                   loadingRegion.height() * scale).toRect().intersected(QRect(0, 0, w, h));
+            regionLoading = outputRegion.isValid();
+        }
+
+#ifdef HAVE_JPEG_CROP_SCANLINE
+
+        // Decode only the needed iMCU columns, and skip the rows above the region.
+        if (regionLoading)
+        {
+            // libjpeg enlarges the region to iMCU boundaries.
+            JDIMENSION xoffset   = outputRegion.x();
+            JDIMENSION cropWidth = outputRegion.width();
+            jpeg_crop_scanline(&cinfo, &xoffset, &cropWidth);
+
+            if (outputRegion.y() > 0)
+            {
+                jpeg_skip_scanlines(&cinfo, outputRegion.y());
+            }
+
+            skipX = outputRegion.x() - xoffset;
+            w     = outputRegion.width();
+            h     = outputRegion.height();
+        }
+
+#endif
+
+        // Width of the decoded lines, can be larger than w if a region is loaded
+        int lineWidth = cinfo.output_width;
+
         // -------------------------------------------------------------------
         // Get scanlines
 
@@ -414,7 +469,7 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
             return false;
         }
 
-        data = new_failureTolerant(w * 16 * cinfo.output_components);
+        data = new_failureTolerant(lineWidth * 16 * cinfo.output_components);
         cleanupData->setData(data);
 
         if (!data)
@@ -447,7 +502,7 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         {
             for (i = 0; i < cinfo.rec_outbuf_height; ++i)
             {
-                line[i] = data + (i * w * 3);
+                line[i] = data + (i * lineWidth * 3);
             }
 
             int checkPoint = 0;
@@ -478,10 +533,10 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
                     scans = h - l;
                 }
 
-                ptr = data;
-
                 for (y = 0; y < scans; ++y)
                 {
+                    ptr = line[y] + skipX * 3;
+
                     for (x = 0; x < w; ++x)
                     {
                         ptr2[3] = 0xFF;
@@ -499,7 +554,7 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         {
             for (i = 0; i < cinfo.rec_outbuf_height; ++i)
             {
-                line[i] = data + (i * w);
+                line[i] = data + (i * lineWidth);
             }
 
             int checkPoint = 0;
@@ -529,10 +584,10 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
                     scans = h - l;
                 }
 
-                ptr = data;
-
                 for (y = 0; y < scans; ++y)
                 {
+                    ptr = line[y] + skipX;
+
                     for (x = 0; x < w; ++x)
                     {
                         ptr2[3] = 0xFF;
@@ -550,7 +605,7 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         {
             for (i = 0; i < cinfo.rec_outbuf_height; ++i)
             {
-                line[i] = data + (i * w * 4);
+                line[i] = data + (i * lineWidth * 4);
             }
 
             int checkPoint = 0;
@@ -581,10 +636,10 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
                     scans = h - l;
                 }
 
-                ptr   = data;
-
                 for (y = 0; y < scans; ++y)
                 {
+                    ptr = line[y] + skipX * 4;
+
                     for (x = 0; x < w; ++x)
                     {
                         // Inspired by Qt's JPEG loader
@@ -605,6 +660,39 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
 
         // clean up
         cleanupData->deleteData();
+
+#ifndef HAVE_JPEG_CROP_SCANLINE
+
+        // Without partial decoding, the region is copied from the full image.
+        if (regionLoading)
+        {
+            uchar* const region = new_failureTolerant(outputRegion.width(), outputRegion.height(), 4);
+
+            if (!region)
+            {
+                jpeg_destroy_decompress(&cinfo);
+                qCWarning(DIGIKAM_DIMG_LOG_JPEG) << "Cannot allocate memory!";
+                delete cleanupData;
+                loadingFailed();
+                return false;
+            }
+
+            for (y = 0 ; y < outputRegion.height() ; ++y)
+            {
+                memcpy(region + y * outputRegion.width() * 4,
+                       dest   + ((outputRegion.y() + y) * w + outputRegion.x()) * 4,
+                       outputRegion.width() * 4);
+            }
+
+            delete [] dest;
+            dest = region;
+            w    = outputRegion.width();
+            h    = outputRegion.height();
+            cleanupData->setSize(QSize(w, h));
+            cleanupData->setDest(dest);
+        }
+
+#endif
     }
 
     // -------------------------------------------------------------------
@@ -640,7 +728,12 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
 
     // -------------------------------------------------------------------
 
-    if (startedDecompress)
+    if (regionLoading)
+    {
+        // Do not decode the rows below the region.
+        jpeg_abort_decompress(&cinfo);
+    }
+    else if (startedDecompress)
     {
         jpeg_finish_decompress(&cinfo);
     }
@@ -665,6 +758,12 @@ bool JPEGLoader::load(const QString& filePath, DImgLoaderObserver* const observe
     imageSetAttribute(QLatin1String("originalBitDepth"),   8);
     imageSetAttribute(QLatin1String("originalSize"),       originalSize);
 
+    if (regionLoading)
+    {
+        // Tells the caller that the image data is this region only.
+        imageSetAttribute(QLatin1String("loadedRegion"),   loadingRegion);
+    }
+
     return true;
 }
 
@@ -42,6 +42,8 @@ extern "C"
 #include <QFile>
 #include <QByteArray>
 #include <QSysInfo>
+#include <QThread>
+#include <QVector>
 
 // Local includes
 
@@ -51,12 +53,14 @@ extern "C"
 #include "digikam_version.h"
 #include "dimg.h"
 #include "dimgloaderobserver.h"
+#include "threadscheduler.h"
 
 // libPNG includes
 
 extern "C"
 {
 #include <png.h>
+#include <zlib.h>
 }
 
 #ifdef Q_OS_WIN
@@ -76,6 +80,281 @@ typedef png_bytep iCCP_data;
 typedef png_charp iCCP_data;
 #endif
 
+/**
+ * Encodes the image data of a PNG file in parts which can run concurrently, as pigz does:
+ * each part packs and filters its rows, with the adaptive filter heuristic of libpng, and
+ * compresses them as raw deflate data ending on a byte boundary. The deflate window is
+ * primed with the filtered data preceding the part, so that the parts simply concatenate
+ * to one zlib stream, given its header and the combined Adler-32 checksum.
+ */
+class Q_DECL_HIDDEN PNGStreamEncoder
+{
+public:
+
+    class Part
+    {
+    public:
+
+        Part()
+          : adler(1),
+            length(0)
+        {
+        }
+
+        QByteArray data;        ///< Empty on failure
+        uLong      adler;
+        uLong      length;
+    };
+
+public:
+
+    PNGStreamEncoder(const uchar* const data, uint width, uint height, int bytesDepth,
+                     bool sixteenBit, bool hasAlpha, int level, uint rowsPerPart)
+        : m_data(data),
+          m_width(width),
+          m_height(height),
+          m_bytesDepth(bytesDepth),
+          m_sixteenBit(sixteenBit),
+          m_hasAlpha(hasAlpha),
+          m_pixelBytes((sixteenBit ? 2 : 1) * (hasAlpha ? 4 : 3)),
+          m_rowBytes(width * m_pixelBytes),
+          m_level(level),
+          m_rowsPerPart(qMax(rowsPerPart, 1U))
+    {
+    }
+
+    int numberOfParts() const
+    {
+        return (m_height + m_rowsPerPart - 1) / m_rowsPerPart;
+    }
+
+    /// The two bytes zlib header of the stream.
+    QByteArray header() const
+    {
+        int levelFlags = (m_level < 2) ? 0 : (m_level < 6) ? 1 : (m_level == 6) ? 2 : 3;
+        int header     = ((Z_DEFLATED + (7 << 4)) << 8) | (levelFlags << 6);
+        header        += 31 - (header % 31);
+
+        QByteArray bytes;
+        bytes.append((char)(header >> 8));
+        bytes.append((char)(header & 0xFF));
+
+        return bytes;
+    }
+
+    Part encode(int part) const
+    {
+        Part result;
+        uint first          = part * m_rowsPerPart;
+        uint last           = qMin(first + m_rowsPerPart, m_height);
+        bool isLast         = (last == m_height);
+        QByteArray filtered = filterRows(first, last);
+        QByteArray dictionary;
+
+        if (first > 0)
+        {
+            uint dictionaryRows = qMin(first, 32768 / (m_rowBytes + 1) + 1);
+            dictionary          = filterRows(first - dictionaryRows, first).right(32768);
+        }
+
+        z_stream stream;
+        memset(&stream, 0, sizeof(stream));
+
+        if (deflateInit2(&stream, m_level, Z_DEFLATED, -15, 8, Z_FILTERED) != Z_OK)
+        {
+            return result;
+        }
+
+        if (!dictionary.isEmpty())
+        {
+            deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary.constData()), dictionary.size());
+        }
+
+        QByteArray compressed;
+        compressed.resize(deflateBound(&stream, filtered.size()) + 16);
+
+        stream.next_in   = reinterpret_cast<Bytef*>(filtered.data());
+        stream.avail_in  = filtered.size();
+        stream.next_out  = reinterpret_cast<Bytef*>(compressed.data());
+        stream.avail_out = compressed.size();
+
+        const int flush  = isLast ? Z_FINISH : Z_SYNC_FLUSH;
+
+        forever
+        {
+            int ret = deflate(&stream, flush);
+
+            if (ret == Z_STREAM_END || (ret == Z_OK && !isLast && stream.avail_out > 0))
+            {
+                break;
+            }
+
+            if (ret != Z_OK && ret != Z_BUF_ERROR)
+            {
+                deflateEnd(&stream);
+                return result;
+            }
+
+            // Output buffer is full.
+            int used = compressed.size() - stream.avail_out;
+            compressed.resize(compressed.size() * 2);
+            stream.next_out  = reinterpret_cast<Bytef*>(compressed.data()) + used;
+            stream.avail_out = compressed.size() - used;
+        }
+
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+
+        result.data   = compressed;
+        result.adler  = adler32(adler32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(filtered.constData()), filtered.size());
+        result.length = filtered.size();
+
+        return result;
+    }
+
+private:
+
+    /// Packs a row as RGB(A), with big endian 16 bits samples.
+    void packRow(uint y, uchar* const out) const
+    {
+        const uchar* ptr = m_data + (size_t)y * m_width * m_bytesDepth;
+        uchar* dst       = out;
+
+        for (uint x = 0 ; x < m_width ; ++x, ptr += m_bytesDepth)
+        {
+            if (m_sixteenBit)
+            {
+                const ushort* const p = reinterpret_cast<const ushort*>(ptr);
+                const int order[4]    = { 2, 1, 0, 3 };
+
+                for (int c = 0 ; c < (m_hasAlpha ? 4 : 3) ; ++c)
+                {
+                    *dst++ = (uchar)(p[order[c]] >> 8);
+                    *dst++ = (uchar)(p[order[c]] & 0xFF);
+                }
+            }
+            else
+            {
+                *dst++ = ptr[2];    // Red
+                *dst++ = ptr[1];    // Green
+                *dst++ = ptr[0];    // Blue
+
+                if (m_hasAlpha)
+                {
+                    *dst++ = ptr[3];
+                }
+            }
+        }
+    }
+
+    static uchar paeth(int a, int b, int c)
+    {
+        int p  = a + b - c;
+        int pa = qAbs(p - a);
+        int pb = qAbs(p - b);
+        int pc = qAbs(p - c);
+
+        if (pa <= pb && pa <= pc)
+        {
+            return a;
+        }
+
+        return (pb <= pc) ? b : c;
+    }
+
+    /// Returns the filter type byte and filtered data of the rows, as libpng writes them.
+    QByteArray filterRows(uint first, uint last) const
+    {
+        QByteArray out;
+        out.resize((last - first) * (m_rowBytes + 1));
+
+        QByteArray prior(m_rowBytes, 0);
+        QByteArray current(m_rowBytes, 0);
+        QByteArray candidate(m_rowBytes, 0);
+
+        if (first > 0)
+        {
+            packRow(first - 1, reinterpret_cast<uchar*>(prior.data()));
+        }
+
+        uchar* dst = reinterpret_cast<uchar*>(out.data());
+
+        for (uint y = first ; y < last ; ++y)
+        {
+            packRow(y, reinterpret_cast<uchar*>(current.data()));
+
+            const uchar* const cur = reinterpret_cast<const uchar*>(current.constData());
+            const uchar* const up  = reinterpret_cast<const uchar*>(prior.constData());
+            uchar* const cand      = reinterpret_cast<uchar*>(candidate.data());
+            quint64 bestSum        = ~(quint64)0;
+
+            // Same heuristic as libpng: minimum sum of absolute values of the signed bytes.
+            for (int filter = PNG_FILTER_VALUE_NONE ; filter <= PNG_FILTER_VALUE_PAETH ; ++filter)
+            {
+                quint64 sum = 0;
+
+                for (uint i = 0 ; i < m_rowBytes ; ++i)
+                {
+                    int left     = (i >= m_pixelBytes) ? cur[i - m_pixelBytes] : 0;
+                    int upLeft   = (i >= m_pixelBytes) ? up[i - m_pixelBytes]  : 0;
+                    uchar value  = 0;
+
+                    switch (filter)
+                    {
+                        case PNG_FILTER_VALUE_NONE:
+                            value = cur[i];
+                            break;
+
+                        case PNG_FILTER_VALUE_SUB:
+                            value = (uchar)(cur[i] - left);
+                            break;
+
+                        case PNG_FILTER_VALUE_UP:
+                            value = (uchar)(cur[i] - up[i]);
+                            break;
+
+                        case PNG_FILTER_VALUE_AVG:
+                            value = (uchar)(cur[i] - ((left + up[i]) >> 1));
+                            break;
+
+                        default:
+                            value = (uchar)(cur[i] - paeth(left, up[i], upLeft));
+                            break;
+                    }
+
+                    cand[i] = value;
+                    sum    += (value < 128) ? value : 256 - value;
+                }
+
+                if (sum < bestSum)
+                {
+                    bestSum = sum;
+                    dst[0]  = (uchar)filter;
+                    memcpy(dst + 1, cand, m_rowBytes);
+                }
+            }
+
+            dst += m_rowBytes + 1;
+            prior.swap(current);
+        }
+
+        return out;
+    }
+
+private:
+
+    const uchar* const m_data;
+    const uint         m_width;
+    const uint         m_height;
+    const int          m_bytesDepth;
+    const bool         m_sixteenBit;
+    const bool         m_hasAlpha;
+    const uint         m_pixelBytes;
+    const uint         m_rowBytes;
+    const int          m_level;
+    const uint         m_rowsPerPart;
+};
+
 PNGLoader::PNGLoader(DImg* const image)
     : DImgLoader(image)
 {
@@ -852,93 +1131,175 @@ bool PNGLoader::save(const QString& filePath, DImgLoaderObserver* const observer
     png_set_packing(png_ptr);
     ptr = imageData();
 
-    uint checkPoint = 0;
+    QVariant threadsAttr = imageGetAttribute(QLatin1String("encodingThreads"));
+    int threads          = (threadsAttr.isValid() && threadsAttr.toInt() > 0) ? threadsAttr.toInt()
+                                                                              : QThread::idealThreadCount();
 
-    for (y = 0; y < imageHeight(); ++y)
+    if (threads > 1)
     {
+        // Filtering and zlib compression are the bottleneck: the rows are encoded
+        // in parts concurrently, and written in order as IDAT chunks.
+
+        uint rowBytes = imageWidth() * (imageSixteenBit() ? 2 : 1) * (imageHasAlpha() ? 4 : 3);
+        PNGStreamEncoder encoder(ptr, imageWidth(), imageHeight(), imageBytesDepth(),
+                                 imageSixteenBit(), imageHasAlpha(), compression,
+                                 (1024 * 1024) / qMax(rowBytes, 1U));
 
-        if (observer && y == checkPoint)
+        const int parts  = encoder.numberOfParts();
+        const int window = threads * 2;
+        uLong adler      = adler32(0, Z_NULL, 0);
+        QByteArray idat  = encoder.header();
+
+        for (int first = 0 ; first < parts ; first += window)
         {
-            checkPoint += granularity(observer, imageHeight(), 0.8F);
+            if (observer)
+            {
+                if (!observer->continueQuery(m_image))
+                {
+                    png_destroy_write_struct(&png_ptr, (png_infopp) & info_ptr);
+                    png_destroy_info_struct(png_ptr, (png_infopp) & info_ptr);
+                    delete cleanupData;
+                    return false;
+                }
+
+                observer->progressInfo(m_image, 0.2 + (0.8 * (((float)first) / ((float)parts))));
+            }
+
+            QVector<PNGStreamEncoder::Part> results(qMin(first + window, parts) - first);
+            PNGStreamEncoder::Part* const partResults = results.data();
 
-            if (!observer->continueQuery(m_image))
             {
-                png_destroy_write_struct(&png_ptr, (png_infopp) & info_ptr);
-                png_destroy_info_struct(png_ptr, (png_infopp) & info_ptr);
-                delete cleanupData;
-                return false;
+                // Destroyed before libpng is called: libpng errors jump out of this method.
+                ThreadSchedulerTasks tasks;
+
+                for (int part = first ; part < qMin(first + window, parts) ; ++part)
+                {
+                    tasks.run([&encoder, partResults, first, part]() { partResults[part - first] = encoder.encode(part); });
+                }
             }
 
-            observer->progressInfo(m_image, 0.2 + (0.8 * (((float)y) / ((float)imageHeight()))));
+            foreach (const PNGStreamEncoder::Part& result, results)
+            {
+                if (result.data.isEmpty())
+                {
+                    qCWarning(DIGIKAM_DIMG_LOG_PNG) << "Cannot compress PNG image data. Process aborted!";
+                    png_destroy_write_struct(&png_ptr, (png_infopp) & info_ptr);
+                    png_destroy_info_struct(png_ptr, (png_infopp) & info_ptr);
+                    delete cleanupData;
+                    return false;
+                }
+
+                adler = adler32_combine(adler, result.adler, result.length);
+                idat.append(result.data);
+
+                if (idat.size() >= 65536)
+                {
+                    png_write_chunk(png_ptr, (png_bytep)"IDAT", (png_bytep)idat.data(), idat.size());
+                    idat.clear();
+                }
+            }
         }
 
-        j = 0;
+        idat.append((char)((adler >> 24) & 0xFF));
+        idat.append((char)((adler >> 16) & 0xFF));
+        idat.append((char)((adler >> 8)  & 0xFF));
+        idat.append((char)(adler         & 0xFF));
+        png_write_chunk(png_ptr, (png_bytep)"IDAT", (png_bytep)idat.data(), idat.size());
 
-        if (QSysInfo::ByteOrder == QSysInfo::LittleEndian)
+        // All other chunks were written before the image data by png_write_info().
+        png_write_chunk(png_ptr, (png_bytep)"IEND", NULL, 0);
+    }
+    else
+    {
+        uint checkPoint = 0;
+
+        for (y = 0; y < imageHeight(); ++y)
         {
-            for (x = 0; x < imageWidth()*imageBytesDepth(); x += imageBytesDepth())
+
+            if (observer && y == checkPoint)
             {
-                if (imageSixteenBit())
+                checkPoint += granularity(observer, imageHeight(), 0.8F);
+
+                if (!observer->continueQuery(m_image))
                 {
-                    if (imageHasAlpha())
-                    {
-                        data[j++] = ptr[x + 1]; // Blue
-                        data[j++] = ptr[ x ];
-                        data[j++] = ptr[x + 3]; // Green
-                        data[j++] = ptr[x + 2];
-                        data[j++] = ptr[x + 5]; // Red
-                        data[j++] = ptr[x + 4];
-                        data[j++] = ptr[x + 7]; // Alpha
-                        data[j++] = ptr[x + 6];
-                    }
-                    else
-                    {
-                        data[j++] = ptr[x + 1]; // Blue
-                        data[j++] = ptr[ x ];
-                        data[j++] = ptr[x + 3]; // Green
-                        data[j++] = ptr[x + 2];
-                        data[j++] = ptr[x + 5]; // Red
-                        data[j++] = ptr[x + 4];
-                    }
+                    png_destroy_write_struct(&png_ptr, (png_infopp) & info_ptr);
+                    png_destroy_info_struct(png_ptr, (png_infopp) & info_ptr);
+                    delete cleanupData;
+                    return false;
                 }
-                else
+
+                observer->progressInfo(m_image, 0.2 + (0.8 * (((float)y) / ((float)imageHeight()))));
+            }
+
+            j = 0;
+
+            if (QSysInfo::ByteOrder == QSysInfo::LittleEndian)
+            {
+                for (x = 0; x < imageWidth()*imageBytesDepth(); x += imageBytesDepth())
                 {
-                    if (imageHasAlpha())
+                    if (imageSixteenBit())
                     {
-                        data[j++] = ptr[ x ];  // Blue
-                        data[j++] = ptr[x + 1]; // Green
-                        data[j++] = ptr[x + 2]; // Red
-                        data[j++] = ptr[x + 3]; // Alpha
+                        if (imageHasAlpha())
+                        {
+                            data[j++] = ptr[x + 1]; // Blue
+                            data[j++] = ptr[ x ];
+                            data[j++] = ptr[x + 3]; // Green
+                            data[j++] = ptr[x + 2];
+                            data[j++] = ptr[x + 5]; // Red
+                            data[j++] = ptr[x + 4];
+                            data[j++] = ptr[x + 7]; // Alpha
+                            data[j++] = ptr[x + 6];
+                        }
+                        else
+                        {
+                            data[j++] = ptr[x + 1]; // Blue
+                            data[j++] = ptr[ x ];
+                            data[j++] = ptr[x + 3]; // Green
+                            data[j++] = ptr[x + 2];
+                            data[j++] = ptr[x + 5]; // Red
+                            data[j++] = ptr[x + 4];
+                        }
                     }
                     else
                     {
-                        data[j++] = ptr[ x ];  // Blue
-                        data[j++] = ptr[x + 1]; // Green
-                        data[j++] = ptr[x + 2]; // Red
+                        if (imageHasAlpha())
+                        {
+                            data[j++] = ptr[ x ];  // Blue
+                            data[j++] = ptr[x + 1]; // Green
+                            data[j++] = ptr[x + 2]; // Red
+                            data[j++] = ptr[x + 3]; // Alpha
+                        }
+                        else
+                        {
+                            data[j++] = ptr[ x ];  // Blue
+                            data[j++] = ptr[x + 1]; // Green
+                            data[j++] = ptr[x + 2]; // Red
+                        }
                     }
                 }
             }
-        }
-        else
-        {
-            int bytes = (imageSixteenBit() ? 2 : 1) * (imageHasAlpha() ? 4 : 3);
-
-            for (x = 0; x < imageWidth()*imageBytesDepth(); x += imageBytesDepth())
+            else
             {
-                memcpy(data + j, ptr + x, bytes);
-                j += bytes;
+                int bytes = (imageSixteenBit() ? 2 : 1) * (imageHasAlpha() ? 4 : 3);
+
+                for (x = 0; x < imageWidth()*imageBytesDepth(); x += imageBytesDepth())
+                {
+                    memcpy(data + j, ptr + x, bytes);
+                    j += bytes;
+                }
             }
-        }
 
-        row_ptr = (png_bytep) data;
+            row_ptr = (png_bytep) data;
+
+            png_write_rows(png_ptr, &row_ptr, 1);
+            ptr += (imageWidth() * imageBytesDepth());
+        }
 
-        png_write_rows(png_ptr, &row_ptr, 1);
-        ptr += (imageWidth() * imageBytesDepth());
+        png_write_end(png_ptr, info_ptr);
     }
 
     // -------------------------------------------------------------------
 
-    png_write_end(png_ptr, info_ptr);
     png_destroy_write_struct(&png_ptr, (png_infopp) & info_ptr);
     png_destroy_info_struct(png_ptr, (png_infopp) & info_ptr);
 
@@ -31,6 +31,7 @@
 #include <QLabel>
 #include <QLayout>
 #include <QGridLayout>
+#include <QThread>
 
 // KDE includes
 
@@ -53,13 +54,17 @@ public:
         PNGGrid             = 0;
         labelPNGcompression = 0;
         PNGcompression      = 0;
+        labelPNGthreads     = 0;
+        PNGthreads          = 0;
     }
 
     QGridLayout*  PNGGrid;
 
     QLabel*       labelPNGcompression;
+    QLabel*       labelPNGthreads;
 
     DIntNumInput* PNGcompression;
+    DIntNumInput* PNGthreads;
 };
 
 PNGSettings::PNGSettings(QWidget* parent)
@@ -84,15 +89,30 @@ PNGSettings::PNGSettings(QWidget* parent)
                                          "<p><b>Note: PNG is always a lossless image "
                                          "compression format.</b></p>"));
 
+    d->PNGthreads      = new DIntNumInput(this);
+    d->PNGthreads->setDefaultValue(QThread::idealThreadCount());
+    d->PNGthreads->setRange(1, qMax(QThread::idealThreadCount(), 1), 1);
+    d->labelPNGthreads = new QLabel(i18n("Encoding threads:"), this);
+
+    d->PNGthreads->setWhatsThis(i18n("<p>The number of threads used to compress PNG images.</p>"
+                                     "<p>The image is compressed in parts on several CPU cores, "
+                                     "which is much faster for large images. Use <b>1</b> to "
+                                     "compress on one core only.</p>"));
+
     d->PNGGrid->addWidget(d->labelPNGcompression, 0, 0, 1, 2);
     d->PNGGrid->addWidget(d->PNGcompression,      1, 1, 1, 2);
+    d->PNGGrid->addWidget(d->labelPNGthreads,     2, 0, 1, 2);
+    d->PNGGrid->addWidget(d->PNGthreads,          3, 1, 1, 2);
     d->PNGGrid->setColumnStretch(1, 10);
-    d->PNGGrid->setRowStretch(2, 10);
+    d->PNGGrid->setRowStretch(4, 10);
     d->PNGGrid->setContentsMargins(spacing, spacing, spacing, spacing);
     d->PNGGrid->setSpacing(spacing);
 
     connect(d->PNGcompression, SIGNAL(valueChanged(int)),
             this, SIGNAL(signalSettingsChanged()));
+
+    connect(d->PNGthreads, SIGNAL(valueChanged(int)),
+            this, SIGNAL(signalSettingsChanged()));
 }
 
 PNGSettings::~PNGSettings()
@@ -110,6 +130,16 @@ int PNGSettings::getCompressionValue() const
     return d->PNGcompression->value();
 }
 
+void PNGSettings::setEncodingThreads(int val)
+{
+    d->PNGthreads->setValue(val);
+}
+
+int PNGSettings::getEncodingThreads() const
+{
+    return d->PNGthreads->value();
+}
+
 int PNGSettings::convertCompressionForLibPng(int value)
 {
     // PNG compression slider settings : 1 - 9 ==> libpng settings : 100 - 1.
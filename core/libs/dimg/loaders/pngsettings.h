@@ -47,6 +47,9 @@ public:
     void setCompressionValue(int val);
     int  getCompressionValue() const;
 
+    void setEncodingThreads(int val);
+    int  getEncodingThreads() const;
+
     static int convertCompressionForLibPng(int value);
 
 Q_SIGNALS:
@@ -43,6 +43,7 @@
 extern "C"
 {
 #include <tiffvers.h>
+#include <zlib.h>
 }
 
 // C++ includes
@@ -53,6 +54,9 @@ extern "C"
 
 #include <QFile>
 #include <QByteArray>
+#include <QRect>
+#include <QThread>
+#include <QVector>
 
 // Local includes
 
@@ -61,6 +65,7 @@ extern "C"
 #include "digikam_debug.h"
 #include "dimgloaderobserver.h"
 #include "dmetadata.h"
+#include "threadscheduler.h"
 #include "tiffloader.h"     //krazy:exclude=includes
 
 namespace Digikam
@@ -88,6 +93,435 @@ void TIFFLoader::dimg_tiff_error(const char* module, const char* format, va_list
     }
 }
 
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * Reads the samples of a region of the current TIFF directory in blocks of rows,
+ * from strips or from tiles. A block holds the region columns of one strip or of one
+ * row of tiles, so that a block can be handled like the data returned by
+ * TIFFReadEncodedStrip() for a whole image of the region size. With separated planes,
+ * all blocks of the first plane come first, as the strips in the file.
+ * Only whole bytes samples (16 and 32 bits) are supported.
+ */
+class Q_DECL_HIDDEN TIFFRegionReader
+{
+public:
+
+    TIFFRegionReader(TIFF* const tif, const QRect& region, uint32 imageWidth, uint32 imageHeight,
+                     uint16 bitsPerSample, uint16 samplesPerPixel, uint16 planarConfig)
+        : m_tif(tif),
+          m_region(region),
+          m_tiled(TIFFIsTiled(tif)),
+          m_tileWidth(0),
+          m_blockHeight(0),
+          m_imageWidth(imageWidth),
+          m_imageHeight(imageHeight),
+          m_planes(planarConfig == PLANARCONFIG_SEPARATE ? samplesPerPixel : 1),
+          m_pixelBytes((bitsPerSample / 8) * (planarConfig == PLANARCONFIG_SEPARATE ? 1 : samplesPerPixel)),
+          m_blocksPerPlane(0),
+          m_fileBlockSize(0)
+    {
+        if (m_tiled)
+        {
+            uint32 tileLength = 0;
+            TIFFGetField(tif, TIFFTAG_TILEWIDTH,  &m_tileWidth);
+            TIFFGetField(tif, TIFFTAG_TILELENGTH, &tileLength);
+            m_blockHeight   = tileLength;
+            m_fileBlockSize = TIFFTileSize(tif);
+        }
+        else
+        {
+            TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &m_blockHeight);
+            m_blockHeight   = qMin(m_blockHeight, imageHeight);
+            m_fileBlockSize = TIFFStripSize(tif);
+        }
+
+        if (m_blockHeight && (!m_tiled || m_tileWidth) && m_region.isValid())
+        {
+            uint32 firstBlock = m_region.top()    / m_blockHeight;
+            uint32 lastBlock  = m_region.bottom() / m_blockHeight;
+            m_blocksPerPlane  = lastBlock - firstBlock + 1;
+            m_fileBlock.reset(DImgLoader::new_failureTolerant(m_fileBlockSize));
+        }
+    }
+
+    bool isValid() const
+    {
+        return (m_blocksPerPlane && !m_fileBlock.isNull());
+    }
+
+    tstrip_t numberOfBlocks() const
+    {
+        return m_blocksPerPlane * m_planes;
+    }
+
+    /// The maximum size of a block in bytes.
+    tsize_t blockSize() const
+    {
+        return qMax((tsize_t)m_blockHeight * m_region.width() * m_pixelBytes, m_fileBlockSize);
+    }
+
+    /// Reads the given block to buffer, which must have blockSize().
+    /// Returns the number of bytes read, or -1 on failure.
+    tsize_t readBlock(tstrip_t block, uchar* const buffer)
+    {
+        uint16 plane    = block / m_blocksPerPlane;
+        uint32 rowStart = (m_region.top() / m_blockHeight + block % m_blocksPerPlane) * m_blockHeight;
+        uint32 rowEnd   = qMin(rowStart + m_blockHeight, m_imageHeight);
+        uint32 firstRow = qMax(rowStart, (uint32)m_region.top());
+        uint32 lastRow  = qMin(rowEnd,   (uint32)m_region.bottom() + 1);
+        tsize_t rowSize = (tsize_t)m_region.width() * m_pixelBytes;
+
+        if (!m_tiled)
+        {
+            tstrip_t strip = TIFFComputeStrip(m_tif, rowStart, plane);
+
+            // The usual case of a whole image: no need to copy the data.
+            if (m_region.x() == 0 && (uint32)m_region.width() == m_imageWidth &&
+                firstRow == rowStart && lastRow == rowEnd)
+            {
+                return TIFFReadEncodedStrip(m_tif, strip, buffer, -1);
+            }
+
+            if (TIFFReadEncodedStrip(m_tif, strip, m_fileBlock.data(), -1) == -1)
+            {
+                return -1;
+            }
+
+            tsize_t scanlineSize = (tsize_t)m_imageWidth * m_pixelBytes;
+
+            for (uint32 row = firstRow ; row < lastRow ; ++row)
+            {
+                memcpy(buffer + (row - firstRow) * rowSize,
+                       m_fileBlock.data() + (row - rowStart) * scanlineSize + m_region.x() * m_pixelBytes,
+                       rowSize);
+            }
+        }
+        else
+        {
+            tsize_t tileRowSize = (tsize_t)m_tileWidth * m_pixelBytes;
+            uint32  regionRight = m_region.right() + 1;
+
+            for (uint32 col = (m_region.x() / m_tileWidth) * m_tileWidth ; col < regionRight ; col += m_tileWidth)
+            {
+                ttile_t tile = TIFFComputeTile(m_tif, col, rowStart, 0, plane);
+
+                if (TIFFReadEncodedTile(m_tif, tile, m_fileBlock.data(), -1) == -1)
+                {
+                    return -1;
+                }
+
+                uint32 firstCol = qMax(col, (uint32)m_region.x());
+                uint32 lastCol  = qMin(col + m_tileWidth, regionRight);
+
+                for (uint32 row = firstRow ; row < lastRow ; ++row)
+                {
+                    memcpy(buffer + (row - firstRow) * rowSize + (firstCol - m_region.x()) * m_pixelBytes,
+                           m_fileBlock.data() + (row - rowStart) * tileRowSize + (firstCol - col) * m_pixelBytes,
+                           (lastCol - firstCol) * m_pixelBytes);
+                }
+            }
+        }
+
+        return (lastRow - firstRow) * rowSize;
+    }
+
+private:
+
+    TIFF* const                m_tif;
+    QRect                      m_region;
+    bool                       m_tiled;
+    uint32                     m_tileWidth;
+    uint32                     m_blockHeight;
+    uint32                     m_imageWidth;
+    uint32                     m_imageHeight;
+    uint16                     m_planes;
+    tsize_t                    m_pixelBytes;
+    tstrip_t                   m_blocksPerPlane;
+    tsize_t                    m_fileBlockSize;
+    QScopedArrayPointer<uchar> m_fileBlock;
+};
+
+/**
+ * Returns the width of the current directory if it is a reduced resolution version of the
+ * main image with the same sample layout, in which the wanted size (in original image
+ * coordinates) is still at least minimumSize large. Returns 0 otherwise.
+ */
+static uint32 tiffReducedLevelWidth(TIFF* const tif, uint16 bitsPerSample, uint16 samplesPerPixel,
+                                    const QSize& originalSize, const QSize& wantedSize, int minimumSize)
+{
+    uint32 w = 0;
+    uint32 h = 0;
+    uint16 bits_per_sample   = 0;
+    uint16 samples_per_pixel = 0;
+
+    TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGEWIDTH,      &w);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGELENGTH,     &h);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE,   &bits_per_sample);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samples_per_pixel);
+
+    if (w == 0 || h == 0 || w >= (uint32)originalSize.width() ||
+        bits_per_sample != bitsPerSample || samples_per_pixel != samplesPerPixel)
+    {
+        return 0;
+    }
+
+    double scale = (double)w / (double)originalSize.width();
+
+    if (qMax(wantedSize.width(), wantedSize.height()) * scale < minimumSize)
+    {
+        return 0;
+    }
+
+    return w;
+}
+
+/**
+ * Pyramid TIFF files store reduced resolution versions of the image, either in SubIFDs
+ * of the main image or as following images marked with the reduced image file type.
+ * Selects the smallest one where the wanted size is not smaller than minimumSize,
+ * or stays on the main image if there is none. Returns true if a reduced level was selected.
+ */
+static bool tiffSelectReducedLevel(TIFF* const tif, const QSize& originalSize, const QSize& wantedSize, int minimumSize)
+{
+    uint16 bits_per_sample   = 0;
+    uint16 samples_per_pixel = 0;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE,   &bits_per_sample);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samples_per_pixel);
+
+    uint32          bestWidth     = originalSize.width();
+    toff_t          bestSubIfd    = 0;
+    tdir_t          bestDirectory = 0;
+    uint16          subIfdCount   = 0;
+    toff_t*         subIfdArray   = 0;
+    QVector<toff_t> subIfds;
+
+    if (TIFFGetField(tif, TIFFTAG_SUBIFD, &subIfdCount, &subIfdArray) && subIfdArray)
+    {
+        // The array belongs to the current directory.
+        for (uint16 i = 0 ; i < subIfdCount ; ++i)
+        {
+            subIfds << subIfdArray[i];
+        }
+    }
+
+    foreach (const toff_t& offset, subIfds)
+    {
+        if (!TIFFSetSubDirectory(tif, offset))
+        {
+            break;
+        }
+
+        uint32 width = tiffReducedLevelWidth(tif, bits_per_sample, samples_per_pixel,
+                                             originalSize, wantedSize, minimumSize);
+
+        if (width && width < bestWidth)
+        {
+            bestWidth  = width;
+            bestSubIfd = offset;
+        }
+    }
+
+    if (!subIfds.isEmpty())
+    {
+        TIFFSetDirectory(tif, 0);
+    }
+
+    // The pyramid levels follow the main image. Stop at the first page which is not one.
+    for (tdir_t dir = 1 ; TIFFReadDirectory(tif) ; ++dir)
+    {
+        uint32 subFileType = 0;
+        TIFFGetFieldDefaulted(tif, TIFFTAG_SUBFILETYPE, &subFileType);
+
+        if (!(subFileType & FILETYPE_REDUCEDIMAGE))
+        {
+            break;
+        }
+
+        uint32 width = tiffReducedLevelWidth(tif, bits_per_sample, samples_per_pixel,
+                                             originalSize, wantedSize, minimumSize);
+
+        if (width && width < bestWidth)
+        {
+            bestWidth     = width;
+            bestSubIfd    = 0;
+            bestDirectory = dir;
+        }
+    }
+
+    if (bestSubIfd)
+    {
+        return TIFFSetSubDirectory(tif, bestSubIfd);
+    }
+
+    return (TIFFSetDirectory(tif, bestDirectory) && bestDirectory != 0);
+}
+
+// ---------------------------------------------------------------------------------------------------
+
+/**
+ * Packs one row of DImg data to a TIFF RGB(A) scanline, with alpha pre-multiplied.
+ */
+static void tiffPackScanline(const uchar* const data, uint32 w, uint32 y, int bytesDepth,
+                             bool sixteenBit, bool hasAlpha, uint8* const buf)
+{
+    const uchar*  pixel        = 0;
+    const uint16* pixel16      = 0;
+    double        alpha_factor = 0;
+    uint8         r8 = 0, g8 = 0, b8 = 0, a8 = 0;
+    uint16        r16 = 0, g16 = 0, b16 = 0, a16 = 0;
+    uint16*       buf16;
+    int           i = 0;
+
+    for (uint32 x = 0 ; x < w ; ++x)
+    {
+        pixel = &data[((y * w) + x) * bytesDepth];
+
+        if (sixteenBit)          // 16 bits image.
+        {
+            pixel16 = reinterpret_cast<const ushort*>(pixel);
+            b16 = pixel16[0];
+            g16 = pixel16[1];
+            r16 = pixel16[2];
+
+            if (hasAlpha)
+            {
+                // TIFF makes you pre-multiply the RGB components by alpha
+
+                a16          = pixel16[3];
+                alpha_factor = ((double)a16 / 65535.0);
+                r16          = (uint16)(r16 * alpha_factor);
+                g16          = (uint16)(g16 * alpha_factor);
+                b16          = (uint16)(b16 * alpha_factor);
+            }
+
+            // This might be endian dependent
+
+            buf16    = reinterpret_cast<ushort*>(buf+i);
+            *buf16++ = r16;
+            *buf16++ = g16;
+            *buf16++ = b16;
+            i       += 6;
+
+            if (hasAlpha)
+            {
+                *buf16++ = a16;
+                i       += 2;
+            }
+        }
+        else                            // 8 bits image.
+        {
+            b8 = (uint8)pixel[0];
+            g8 = (uint8)pixel[1];
+            r8 = (uint8)pixel[2];
+
+            if (hasAlpha)
+            {
+                // TIFF makes you pre-multiply the RGB components by alpha
+
+                a8           = (uint8)(pixel[3]);
+                alpha_factor = ((double)a8 / 255.0);
+                r8           = (uint8)(r8 * alpha_factor);
+                g8           = (uint8)(g8 * alpha_factor);
+                b8           = (uint8)(b8 * alpha_factor);
+            }
+
+            // This might be endian dependent
+
+            buf[i++] = r8;
+            buf[i++] = g8;
+            buf[i++] = b8;
+
+            if (hasAlpha)
+            {
+                buf[i++] = a8;
+            }
+        }
+    }
+}
+
+/**
+ * Encodes strips of the main image as libtiff does with COMPRESSION_ADOBE_DEFLATE,
+ * a zip quality of 9 and the horizontal predictor, so that they can be written with
+ * TIFFWriteRawStrip(). encode() is thread-safe and can run concurrently for all strips.
+ */
+class Q_DECL_HIDDEN TIFFStripEncoder
+{
+public:
+
+    TIFFStripEncoder(const uchar* const data, uint32 width, uint32 height, uint32 rowsPerStrip,
+                     int bytesDepth, bool sixteenBit, bool hasAlpha, tsize_t scanlineSize)
+        : m_data(data),
+          m_width(width),
+          m_height(height),
+          m_rowsPerStrip(rowsPerStrip),
+          m_bytesDepth(bytesDepth),
+          m_sixteenBit(sixteenBit),
+          m_hasAlpha(hasAlpha),
+          m_scanlineSize(scanlineSize)
+    {
+    }
+
+    /// Returns the compressed strip, or a null array on failure.
+    QByteArray encode(tstrip_t strip) const
+    {
+        uint32 firstRow = strip * m_rowsPerStrip;
+        uint32 rows     = qMin(m_rowsPerStrip, m_height - firstRow);
+        int    samples  = m_hasAlpha ? 4 : 3;
+        QByteArray raw((int)(m_scanlineSize * rows), 0);
+
+        for (uint32 row = 0 ; row < rows ; ++row)
+        {
+            uint8* const line = reinterpret_cast<uint8*>(raw.data()) + row * m_scanlineSize;
+            tiffPackScanline(m_data, m_width, firstRow + row, m_bytesDepth, m_sixteenBit, m_hasAlpha, line);
+
+            // Horizontal differencing, from the end of the row, on native samples.
+            if (m_sixteenBit)
+            {
+                uint16* const values = reinterpret_cast<uint16*>(line);
+
+                for (int i = m_width * samples - 1 ; i >= samples ; --i)
+                {
+                    values[i] = (uint16)(values[i] - values[i - samples]);
+                }
+            }
+            else
+            {
+                for (int i = m_width * samples - 1 ; i >= samples ; --i)
+                {
+                    line[i] = (uint8)(line[i] - line[i - samples]);
+                }
+            }
+        }
+
+        uLongf size = compressBound(raw.size());
+        QByteArray compressed((int)size, 0);
+
+        if (compress2(reinterpret_cast<Bytef*>(compressed.data()), &size,
+                      reinterpret_cast<const Bytef*>(raw.constData()), raw.size(), 9) != Z_OK)
+        {
+            return QByteArray();
+        }
+
+        compressed.resize(size);
+
+        return compressed;
+    }
+
+private:
+
+    const uchar* const m_data;
+    const uint32       m_width;
+    const uint32       m_height;
+    const uint32       m_rowsPerStrip;
+    const int          m_bytesDepth;
+    const bool         m_sixteenBit;
+    const bool         m_hasAlpha;
+    const tsize_t      m_scanlineSize;
+};
+
+// ---------------------------------------------------------------------------------------------------
+
 TIFFLoader::TIFFLoader(DImg* const image)
     : DImgLoader(image)
 {
@@ -128,6 +562,54 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         TIFFPrintDirectory(tif, stdout, 0);
     }
 
+    // -------------------------------------------------------------------
+    // Read image ICC profile from the main image, reduced levels may not have it.
+
+    QByteArray profile_rawdata;
+
+    if (m_loadFlags & LoadICCData)
+    {
+        uchar*  profile_data = 0;
+        uint32  profile_size;
+
+        if (TIFFGetField(tif, TIFFTAG_ICCPROFILE, &profile_size, &profile_data))
+        {
+            profile_rawdata.resize(profile_size);
+            memcpy(profile_rawdata.data(), profile_data, profile_size);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    // Find out if only a region of the image is wanted, in original image coordinates,
+    // and if we can load a reduced resolution level of a pyramid TIFF. TIFF specific.
+
+    uint32 originalWidth  = 0;
+    uint32 originalHeight = 0;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGEWIDTH,  &originalWidth);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGELENGTH, &originalHeight);
+    QSize originalSize(originalWidth, originalHeight);
+
+    QRect loadingRegion;
+    QVariant attribute = imageGetAttribute(QLatin1String("loadingRegion"));
+
+    if (attribute.isValid())
+    {
+        loadingRegion = attribute.toRect().intersected(QRect(QPoint(0, 0), originalSize));
+    }
+
+    attribute = imageGetAttribute(QLatin1String("scaledLoadingSize"));
+
+    if (attribute.isValid() && (m_loadFlags & LoadImageData) && !originalSize.isEmpty())
+    {
+        QSize wantedSize = loadingRegion.isValid() ? loadingRegion.size() : originalSize;
+
+        if (tiffSelectReducedLevel(tif, originalSize, wantedSize, attribute.toInt()))
+        {
+            qCDebug(DIGIKAM_DIMG_LOG_TIFF) << "Loading TIFF reduced resolution level for size"
+                                           << attribute.toInt() << "of" << filePath;
+        }
+    }
+
     // -------------------------------------------------------------------
     // Get image information.
 
@@ -137,7 +619,6 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
     uint16    photometric;
     uint16    planar_config;
     uint32    rows_per_strip;
-    tsize_t   strip_size;
     tstrip_t  num_of_strips;
 
     TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGEWIDTH, &w);
@@ -147,7 +628,15 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
     TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samples_per_pixel);
     TIFFGetFieldDefaulted(tif, TIFFTAG_PLANARCONFIG, &planar_config);
 
-    if (TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rows_per_strip) == 0 || rows_per_strip == 0)
+    if (TIFFIsTiled(tif))
+    {
+        // Tiles are read by rows of tiles, which are handled like strips.
+        if (TIFFGetField(tif, TIFFTAG_TILELENGTH, &rows_per_strip) == 0)
+        {
+            rows_per_strip = 0;
+        }
+    }
+    else if (TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rows_per_strip) == 0 || rows_per_strip == 0)
     {
         qCWarning(DIGIKAM_DIMG_LOG_TIFF)  << "TIFF loader: Cannot handle non-stripped images. Loading file "
                    << filePath;
@@ -260,18 +749,12 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
     }
 
     // -------------------------------------------------------------------
-    // Read image ICC profile
+    // Set image ICC profile
 
     if (m_loadFlags & LoadICCData)
     {
-        uchar*  profile_data = 0;
-        uint32  profile_size;
-
-        if (TIFFGetField(tif, TIFFTAG_ICCPROFILE, &profile_size, &profile_data))
+        if (!profile_rawdata.isEmpty())
         {
-            QByteArray profile_rawdata;
-            profile_rawdata.resize(profile_size);
-            memcpy(profile_rawdata.data(), profile_data, profile_size);
             imageSetIccProfile(IccProfile(profile_rawdata));
         }
         else
@@ -281,6 +764,28 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         }
     }
 
+    // -------------------------------------------------------------------
+    // Map the wanted region to the loaded resolution level.
+
+    QRect region(0, 0, w, h);
+    bool  regionLoading = false;
+
+    if ((m_loadFlags & LoadImageData) && loadingRegion.isValid() &&
+        loadingRegion != QRect(QPoint(0, 0), originalSize))
+    {
+        double scale = (double)w / (double)originalSize.width();
+        QRect mapped = QRectF(loadingRegion.x()      * scale,
+                              loadingRegion.y()      * scale,
+                              loadingRegion.width()  * scale,
+                              loadingRegion.height() * scale).toRect().intersected(region);
+
+        if (mapped.isValid())
+        {
+            region        = mapped;
+            regionLoading = true;
+        }
+    }
+
     // -------------------------------------------------------------------
     // Get image data.
 
@@ -293,13 +798,12 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
             observer->progressInfo(m_image, 0.1F);
         }
 
-        strip_size    = TIFFStripSize(tif);
-        num_of_strips = TIFFNumberOfStrips(tif);
-
         if (bits_per_sample == 16)          // 16 bits image.
         {
-            data.reset(new_failureTolerant(w, h, 8));
-            QScopedArrayPointer<uchar> strip(new_failureTolerant(strip_size));
+            TIFFRegionReader reader(tif, region, w, h, bits_per_sample, samples_per_pixel, planar_config);
+            data.reset(new_failureTolerant(region.width(), region.height(), 8));
+            QScopedArrayPointer<uchar> strip(reader.isValid() ? new_failureTolerant(reader.blockSize()) : 0);
+            num_of_strips = reader.numberOfBlocks();
 
             if (!data || strip.isNull())
             {
@@ -329,7 +833,7 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
                     observer->progressInfo(m_image, 0.1 + (0.8 * (((float)st) / ((float)num_of_strips))));
                 }
 
-                bytesRead = TIFFReadEncodedStrip(tif, st, strip.data(), strip_size);
+                bytesRead = reader.readBlock(st, strip.data());
 
                 if (bytesRead == -1)
                 {
@@ -461,8 +965,10 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         }
         else if (bits_per_sample == 32)          // 32 bits image.
         {
-            data.reset(new_failureTolerant(w, h, 8));
-            QScopedArrayPointer<uchar> strip(new_failureTolerant(strip_size));
+            TIFFRegionReader reader(tif, region, w, h, bits_per_sample, samples_per_pixel, planar_config);
+            data.reset(new_failureTolerant(region.width(), region.height(), 8));
+            QScopedArrayPointer<uchar> strip(reader.isValid() ? new_failureTolerant(reader.blockSize()) : 0);
+            num_of_strips = reader.numberOfBlocks();
 
             if (!data || strip.isNull())
             {
@@ -486,7 +992,7 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
                     return false;
                 }
 
-                bytesRead = TIFFReadEncodedStrip(tif, st, strip.data(), strip_size);
+                bytesRead = reader.readBlock(st, strip.data());
 
                 if (bytesRead == -1)
                 {
@@ -528,7 +1034,7 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
                     observer->progressInfo(m_image, 0.1 + (0.8 * (((float)st) / ((float)num_of_strips))));
                 }
 
-                bytesRead = TIFFReadEncodedStrip(tif, st, strip.data(), strip_size);
+                bytesRead = reader.readBlock(st, strip.data());
 
                 if (bytesRead == -1)
                 {
@@ -641,8 +1147,8 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         }
         else       // Non 16 or 32 bits images ==> get it on BGRA 8 bits.
         {
-            data.reset(new_failureTolerant(w, h, 4));
-            QScopedArrayPointer<uchar> strip(new_failureTolerant(w, rows_per_strip, 4));
+            data.reset(new_failureTolerant(region.width(), region.height(), 4));
+            QScopedArrayPointer<uchar> strip(new_failureTolerant(region.width(), rows_per_strip, 4));
 
             if (!data || strip.isNull())
             {
@@ -658,7 +1164,7 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
             // this is inspired by TIFFReadRGBAStrip, tif_getimage.c
             char          emsg[1024] = "";
             TIFFRGBAImage img;
-            uint32        rows_to_read;
+            uint32        rows_to_read = 0;
 
             uint checkpoint          = 0;
 
@@ -677,12 +1183,16 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
             // We rotate ourselves. (Bug 274865)
             img.req_orientation = img.orientation;
 
-            // read strips from image: read rows_per_strip, so always start at beginning of a strip
-            for (uint row = 0 ; row < h ; row += rows_per_strip)
+            uint regionTop    = region.top();
+            uint regionBottom = region.bottom() + 1;
+
+            // read strips or rows of tiles from image: after the first one,
+            // always start at beginning of a strip
+            for (uint row = regionTop ; row < regionBottom ; row += rows_to_read)
             {
-                if (observer && row >= checkpoint)
+                if (observer && row - regionTop >= checkpoint)
                 {
-                    checkpoint += granularity(observer, h, 0.8F);
+                    checkpoint += granularity(observer, region.height(), 0.8F);
 
                     if (!observer->continueQuery(m_image))
                     {
@@ -691,24 +1201,16 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
                         return false;
                     }
 
-                    observer->progressInfo(m_image, 0.1 + (0.8 * (((float)row) / ((float)h))));
+                    observer->progressInfo(m_image, 0.1 + (0.8 * (((float)(row - regionTop)) / ((float)region.height()))));
                 }
 
                 img.row_offset  = row;
-                img.col_offset  = 0;
-
-                if (row + rows_per_strip > img.height)
-                {
-                    rows_to_read = img.height - row;
-                }
-                else
-                {
-                    rows_to_read = rows_per_strip;
-                }
+                img.col_offset  = region.x();
+                rows_to_read    = qMin(rows_per_strip - row % rows_per_strip, regionBottom - row);
 
                 // Read data
 
-                if (TIFFRGBAImageGet(&img, reinterpret_cast<uint32*>(strip.data()), img.width, rows_to_read) == -1)
+                if (TIFFRGBAImageGet(&img, reinterpret_cast<uint32*>(strip.data()), region.width(), rows_to_read) == -1)
                 {
                     qCWarning(DIGIKAM_DIMG_LOG_TIFF) << "Failed to read image data";
                     TIFFClose(tif);
@@ -716,7 +1218,7 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
                     return false;
                 }
 
-                pixelsRead = rows_to_read * img.width;
+                pixelsRead = rows_to_read * region.width();
 
                 uchar* stripPtr = (uchar*)(strip.data());
                 uchar* dataPtr  = (uchar*)(data.data() + offset);
@@ -752,13 +1254,19 @@ bool TIFFLoader::load(const QString& filePath, DImgLoaderObserver* const observe
         observer->progressInfo(m_image, 1.0);
     }
 
-    imageWidth()  = w;
-    imageHeight() = h;
+    imageWidth()  = region.width();
+    imageHeight() = region.height();
     imageData()   = data.take();
     imageSetAttribute(QLatin1String("format"),             QLatin1String("TIFF"));
     imageSetAttribute(QLatin1String("originalColorModel"), colorModel);
     imageSetAttribute(QLatin1String("originalBitDepth"),   bits_per_sample);
-    imageSetAttribute(QLatin1String("originalSize"),       QSize(w, h));
+    imageSetAttribute(QLatin1String("originalSize"),       originalSize);
+
+    if (regionLoading)
+    {
+        // Tells the caller that the image data is this region only.
+        imageSetAttribute(QLatin1String("loadedRegion"),   loadingRegion);
+    }
 
     return true;
 }
@@ -898,122 +1406,111 @@ bool TIFFLoader::save(const QString& filePath, DImgLoaderObserver* const observe
         observer->progressInfo(m_image, 0.1F);
     }
 
-    uchar*  pixel        = 0;
-    uint16* pixel16      = 0;
-    double  alpha_factor = 0;
-    uint32  x = 0, y = 0;
-    uint8   r8 = 0, g8 = 0, b8 = 0, a8 = 0;
-    uint16  r16 = 0, g16 = 0, b16 = 0, a16 = 0;
-    int     i = 0;
+    uint32 x = 0, y = 0;
+    int    i = 0;
 
-    uint8* buf = (uint8*)_TIFFmalloc(TIFFScanlineSize(tif));
-    uint16* buf16;
+    QVariant threadsAttr = imageGetAttribute(QLatin1String("encodingThreads"));
+    int threads          = (threadsAttr.isValid() && threadsAttr.toInt() > 0) ? threadsAttr.toInt()
+                                                                              : QThread::idealThreadCount();
 
-    if (!buf)
+    if (compress && threads > 1)
     {
-        qCWarning(DIGIKAM_DIMG_LOG_TIFF) << "Cannot allocate memory buffer for main image.";
-        TIFFClose(tif);
-        return false;
-    }
+        // Deflate is the bottleneck of compressed files: strips are compressed
+        // concurrently, and written in order as raw strips.
 
-    uint checkpoint = 0;
+        uint32 rowsPerStrip = 0;
+        TIFFGetField(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
 
-    for (y = 0 ; y < h ; ++y)
-    {
+        TIFFStripEncoder encoder(data, w, h, rowsPerStrip, imageBytesDepth(),
+                                 imageSixteenBit(), imageHasAlpha(), TIFFScanlineSize(tif));
 
-        if (observer && y == checkpoint)
-        {
-            checkpoint += granularity(observer, h, 0.8F);
+        const tstrip_t strips = TIFFNumberOfStrips(tif);
+        const tstrip_t window = threads * 4;
 
-            if (!observer->continueQuery(m_image))
+        for (tstrip_t first = 0 ; first < strips ; first += window)
+        {
+            if (observer)
             {
-                _TIFFfree(buf);
-                TIFFClose(tif);
-                return false;
-            }
-
-            observer->progressInfo(m_image, 0.1 + (0.8 * (((float)y) / ((float)h))));
-        }
+                if (!observer->continueQuery(m_image))
+                {
+                    TIFFClose(tif);
+                    return false;
+                }
 
-        i = 0;
+                observer->progressInfo(m_image, 0.1 + (0.8 * (((float)first) / ((float)strips))));
+            }
 
-        for (x = 0 ; x < w ; ++x)
-        {
-            pixel = &data[((y * w) + x) * imageBytesDepth()];
+            QVector<QByteArray> results(qMin(first + window, strips) - first);
+            QByteArray* const stripResults = results.data();
 
-            if (imageSixteenBit())          // 16 bits image.
             {
-                pixel16 = reinterpret_cast<ushort*>(pixel);
-                b16 = pixel16[0];
-                g16 = pixel16[1];
-                r16 = pixel16[2];
+                ThreadSchedulerTasks tasks;
 
-                if (imageHasAlpha())
+                for (tstrip_t st = first ; st < qMin(first + window, strips) ; ++st)
                 {
-                    // TIFF makes you pre-multiply the RGB components by alpha
-
-                    a16          = pixel16[3];
-                    alpha_factor = ((double)a16 / 65535.0);
-                    r16          = (uint16)(r16 * alpha_factor);
-                    g16          = (uint16)(g16 * alpha_factor);
-                    b16          = (uint16)(b16 * alpha_factor);
+                    tasks.run([&encoder, stripResults, first, st]() { stripResults[st - first] = encoder.encode(st); });
                 }
+            }
 
-                // This might be endian dependent
-
-                buf16    = reinterpret_cast<ushort*>(buf+i);
-                *buf16++ = r16;
-                *buf16++ = g16;
-                *buf16++ = b16;
-                i       += 6;
+            for (tstrip_t st = first ; st < qMin(first + window, strips) ; ++st)
+            {
+                QByteArray& strip = results[st - first];
 
-                if (imageHasAlpha())
+                if (strip.isEmpty() || TIFFWriteRawStrip(tif, st, strip.data(), strip.size()) == -1)
                 {
-                    *buf16++ = a16;
-                    i       += 2;
+                    qCWarning(DIGIKAM_DIMG_LOG_TIFF) << "Cannot write main image to target file.";
+                    TIFFClose(tif);
+                    return false;
                 }
             }
-            else                            // 8 bits image.
-            {
-                b8 = (uint8)pixel[0];
-                g8 = (uint8)pixel[1];
-                r8 = (uint8)pixel[2];
+        }
 
-                if (imageHasAlpha())
-                {
-                    // TIFF makes you pre-multiply the RGB components by alpha
+        TIFFWriteDirectory(tif);
+    }
+    else
+    {
+        uint8* buf = (uint8*)_TIFFmalloc(TIFFScanlineSize(tif));
 
-                    a8           = (uint8)(pixel[3]);
-                    alpha_factor = ((double)a8 / 255.0);
-                    r8           = (uint8)(r8 * alpha_factor);
-                    g8           = (uint8)(g8 * alpha_factor);
-                    b8           = (uint8)(b8 * alpha_factor);
-                }
+        if (!buf)
+        {
+            qCWarning(DIGIKAM_DIMG_LOG_TIFF) << "Cannot allocate memory buffer for main image.";
+            TIFFClose(tif);
+            return false;
+        }
+
+        uint checkpoint = 0;
 
-                // This might be endian dependent
+        for (y = 0 ; y < h ; ++y)
+        {
 
-                buf[i++] = r8;
-                buf[i++] = g8;
-                buf[i++] = b8;
+            if (observer && y == checkpoint)
+            {
+                checkpoint += granularity(observer, h, 0.8F);
 
-                if (imageHasAlpha())
+                if (!observer->continueQuery(m_image))
                 {
-                    buf[i++] = a8;
+                    _TIFFfree(buf);
+                    TIFFClose(tif);
+                    return false;
                 }
+
+                observer->progressInfo(m_image, 0.1 + (0.8 * (((float)y) / ((float)h))));
             }
-        }
 
-        if (!TIFFWriteScanline(tif, buf, y, 0))
-        {
-            qCWarning(DIGIKAM_DIMG_LOG_TIFF) << "Cannot write main image to target file.";
-            _TIFFfree(buf);
-            TIFFClose(tif);
-            return false;
+            tiffPackScanline(data, w, y, imageBytesDepth(), imageSixteenBit(), imageHasAlpha(), buf);
+
+            if (!TIFFWriteScanline(tif, buf, y, 0))
+            {
+                qCWarning(DIGIKAM_DIMG_LOG_TIFF) << "Cannot write main image to target file.";
+                _TIFFfree(buf);
+                TIFFClose(tif);
+                return false;
+            }
         }
-    }
 
-    _TIFFfree(buf);
-    TIFFWriteDirectory(tif);
+        _TIFFfree(buf);
+        TIFFWriteDirectory(tif);
+    }
 
     // -------------------------------------------------------------------
     // Write thumbnail in tiff directory IFD1
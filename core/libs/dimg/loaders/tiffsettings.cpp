@@ -32,11 +32,16 @@
 #include <QGridLayout>
 #include <QApplication>
 #include <QStyle>
+#include <QThread>
 
 // KDE includes
 
 #include <klocalizedstring.h>
 
+// Local includes
+
+#include "dnuminput.h"
+
 namespace Digikam
 {
 
@@ -47,13 +52,19 @@ public:
 
     explicit Private()
     {
-        TIFFGrid        = 0;
-        TIFFcompression = 0;
+        TIFFGrid         = 0;
+        TIFFcompression  = 0;
+        labelTIFFthreads = 0;
+        TIFFthreads      = 0;
     }
 
-    QGridLayout* TIFFGrid;
+    QGridLayout*  TIFFGrid;
+
+    QCheckBox*    TIFFcompression;
 
-    QCheckBox*   TIFFcompression;
+    QLabel*       labelTIFFthreads;
+
+    DIntNumInput* TIFFthreads;
 };
 
 TIFFSettings::TIFFSettings(QWidget* const parent)
@@ -72,14 +83,34 @@ TIFFSettings::TIFFSettings(QWidget* const parent)
                                           "<p>A lossless compression format (Deflate) "
                                           "is used to save the file.</p>"));
 
-    d->TIFFGrid->addWidget(d->TIFFcompression, 0, 0, 1, 2);
+    d->TIFFthreads      = new DIntNumInput(this);
+    d->TIFFthreads->setDefaultValue(QThread::idealThreadCount());
+    d->TIFFthreads->setRange(1, qMax(QThread::idealThreadCount(), 1), 1);
+    d->labelTIFFthreads = new QLabel(i18n("Encoding threads:"), this);
+
+    d->TIFFthreads->setWhatsThis(i18n("<p>The number of threads used to compress TIFF images.</p>"
+                                      "<p>The strips of the image are compressed on several CPU "
+                                      "cores, which is much faster for large images. Use <b>1</b> "
+                                      "to compress on one core only.</p>"));
+
+    d->TIFFGrid->addWidget(d->TIFFcompression,  0, 0, 1, 2);
+    d->TIFFGrid->addWidget(d->labelTIFFthreads, 1, 0, 1, 2);
+    d->TIFFGrid->addWidget(d->TIFFthreads,      2, 1, 1, 2);
     d->TIFFGrid->setColumnStretch(1, 10);
-    d->TIFFGrid->setRowStretch(1, 10);
+    d->TIFFGrid->setRowStretch(3, 10);
     d->TIFFGrid->setContentsMargins(spacing, spacing, spacing, spacing);
     d->TIFFGrid->setSpacing(spacing);
 
     connect(d->TIFFcompression, SIGNAL(toggled(bool)),
             this, SIGNAL(signalSettingsChanged()));
+
+    connect(d->TIFFcompression, SIGNAL(toggled(bool)),
+            d->TIFFthreads, SLOT(setEnabled(bool)));
+
+    connect(d->TIFFthreads, SIGNAL(valueChanged(int)),
+            this, SIGNAL(signalSettingsChanged()));
+
+    d->TIFFthreads->setEnabled(d->TIFFcompression->isChecked());
 }
 
 TIFFSettings::~TIFFSettings()
@@ -97,4 +128,14 @@ bool TIFFSettings::getCompression() const
     return d->TIFFcompression->isChecked();
 }
 
+void TIFFSettings::setEncodingThreads(int val)
+{
+    d->TIFFthreads->setValue(val);
+}
+
+int TIFFSettings::getEncodingThreads() const
+{
+    return d->TIFFthreads->value();
+}
+
 } // namespace Digikam
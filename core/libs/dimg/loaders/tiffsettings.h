@@ -47,6 +47,9 @@ public:
     void setCompression(bool b);
     bool getCompression() const;
 
+    void setEncodingThreads(int val);
+    int  getEncodingThreads() const;
+
 Q_SIGNALS:
 
     void signalSettingsChanged();
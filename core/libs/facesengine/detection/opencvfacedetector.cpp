@@ -33,13 +33,16 @@
 // Qt includes
 
 #include <QFile>
+#include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QSet>
 #include <qmath.h>
 
 // Local includes
 
 #include "digikam_debug.h"
+#include "threadscheduler.h"
 
 using namespace std;
 
@@ -103,7 +106,119 @@ static cv::Rect fromQRect(const QRect& rect)
 
 // --------------------------------------------------------------------------------
 
-class Q_DECL_HIDDEN Cascade : public cv::CascadeClassifier
+/**
+ * A cv::CascadeClassifier keeps the state of the running detection and cannot be used
+ * by two threads at once. Instead of loading all cascades for each detector, the classifiers
+ * are shared by all detectors of the application: a detection takes a free classifier
+ * of the cascade file, or loads a new one if all are in use, and gives it back when done.
+ * The number of loaded classifiers follows the number of detections running at once.
+ */
+class Q_DECL_HIDDEN CascadeStore
+{
+public:
+
+    ~CascadeStore()
+    {
+        foreach (const QList<cv::CascadeClassifier*>& list, freeClassifiers)
+        {
+            qDeleteAll(list);
+        }
+    }
+
+    cv::CascadeClassifier* acquire(const QString& file)
+    {
+        {
+            QMutexLocker lock(&mutex);
+
+            if (failedFiles.contains(file))
+            {
+                return 0;
+            }
+
+            QList<cv::CascadeClassifier*>& list = freeClassifiers[file];
+
+            if (!list.isEmpty())
+            {
+                return list.takeLast();
+            }
+        }
+
+        qCDebug(DIGIKAM_FACESENGINE_LOG) << "Loading cascade" << file;
+
+        cv::CascadeClassifier* const classifier = new cv::CascadeClassifier;
+
+        if (!classifier->load(file.toStdString()))
+        {
+            qCDebug(DIGIKAM_FACESENGINE_LOG) << "Failed to load cascade" << file;
+
+            delete classifier;
+
+            QMutexLocker lock(&mutex);
+            failedFiles << file;
+
+            return 0;
+        }
+
+        return classifier;
+    }
+
+    void release(const QString& file, cv::CascadeClassifier* const classifier)
+    {
+        QMutexLocker lock(&mutex);
+        freeClassifiers[file] << classifier;
+    }
+
+private:
+
+    QMutex                                         mutex;
+    QHash<QString, QList<cv::CascadeClassifier*> > freeClassifiers;
+    QSet<QString>                                  failedFiles;
+};
+
+Q_GLOBAL_STATIC(CascadeStore, cascadeStore)
+
+/**
+ * Holds a classifier of the store for the lifetime of the object.
+ */
+class Q_DECL_HIDDEN CascadeLocker
+{
+public:
+
+    explicit CascadeLocker(const QString& file)
+        : file(file),
+          classifier(file.isEmpty() ? 0 : cascadeStore->acquire(file))
+    {
+    }
+
+    ~CascadeLocker()
+    {
+        if (classifier)
+        {
+            cascadeStore->release(file, classifier);
+        }
+    }
+
+    cv::CascadeClassifier* operator->() const
+    {
+        return classifier;
+    }
+
+    bool isNull() const
+    {
+        return !classifier;
+    }
+
+private:
+
+    CascadeLocker(const CascadeLocker&); // Disable
+
+    const QString                file;
+    cv::CascadeClassifier* const classifier;
+};
+
+// --------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN Cascade
 {
 public:
 
@@ -111,7 +226,7 @@ public:
         : primaryCascade(false),
           verifyingCascade(true)
     {
-        const QString file = findFileInDirs(dirs, fileName);
+        file = findFileInDirs(dirs, fileName);
 
         if (file.isEmpty())
         {
@@ -119,13 +234,9 @@ public:
             return;
         }
 
-        qCDebug(DIGIKAM_FACESENGINE_LOG) << "Loading cascade" << file;
+        // Loads the first classifier if no other detector did it before
 
-        if (!load(file.toStdString()))
-        {
-            qCDebug(DIGIKAM_FACESENGINE_LOG) << "Failed to load cascade" << file;
-            return;
-        }
+        CascadeLocker classifier(file);
     }
 
     cv::Size getOriginalWindowSize() const
@@ -232,18 +343,119 @@ public:
 
 public:
 
-    bool   primaryCascade;
-    bool   verifyingCascade;
+    QString file;
+
+    bool    primaryCascade;
+    bool    verifyingCascade;
 
     /**
      * Facial features have a region of interest, e.g., the left eye is typically
      * located in the left upper region of the presumed face.
      * For frontal face cascades, this is 0,0 - 1x1. */
-    QRectF roi;
+    QRectF  roi;
 };
 
 // ---------------------------------------------------------------------------------------------------
 
+/**
+ * One level of the image pyramid scanned by the primary cascades.
+ */
+class Q_DECL_HIDDEN PyramidLevel
+{
+public:
+
+    explicit PyramidLevel(double factor = 1.0)
+        : factor(factor)
+    {
+    }
+
+    /// The image is scaled down by this factor.
+    double                              factor;
+
+    /// Candidates found by each primary cascade, in coordinates of the full image, not yet grouped.
+    QList<std::vector<cv::Rect> >       candidates;
+};
+
+/**
+ * Scales the image for the level and runs each cascade at its trained window size only.
+ * The levels of one image are independent and are processed in parallel.
+ */
+static void detectAtLevel(const cv::Mat& inputImage,
+                          const QList<const Cascade*>& cascades,
+                          const DetectObjectParameters& params,
+                          PyramidLevel* const level)
+{
+    const double factor = level->factor;
+    cv::Mat      scaled;
+
+    if (factor == 1.0)
+    {
+        scaled = inputImage;
+    }
+    else
+    {
+        // OpenCV uses vectorized code for the scaling
+        cv::resize(inputImage, scaled,
+                   cv::Size(cvRound(inputImage.cols / factor), cvRound(inputImage.rows / factor)),
+                   0, 0, cv::INTER_LINEAR);
+    }
+
+    foreach (const Cascade* const cascade, cascades)
+    {
+        std::vector<cv::Rect> candidates;
+        CascadeLocker         classifier(cascade->file);
+
+        if (!classifier.isNull())
+        {
+            const cv::Size window = classifier->getOriginalWindowSize();
+
+            if (scaled.cols >= window.width                     &&
+                scaled.rows >= window.height                    &&
+                window.width  * factor >= params.minSize.width  &&
+                window.height * factor >= params.minSize.height)
+            {
+                // detectMultiScale moves the window by one pixel on the levels scaled down
+                // more than twice, and by two pixels on the others. Here it only searches
+                // this level, as its first one, and always moves by two pixels: the image
+                // shifted by one pixel is scanned too to get the positions in between.
+
+                const int shifts = (factor > 2.0) ? 2 : 1;
+
+                for (int dy = 0 ; dy < shifts ; ++dy)
+                {
+                    for (int dx = 0 ; dx < shifts ; ++dx)
+                    {
+                        if (scaled.cols - dx < window.width || scaled.rows - dy < window.height)
+                        {
+                            continue;
+                        }
+
+                        std::vector<cv::Rect> objects;
+                        const cv::Mat shifted = scaled(cv::Rect(dx, dy, scaled.cols - dx, scaled.rows - dy));
+
+                        // With a minimum and maximum size equal to the window, only this scale is searched.
+                        // No grouping here, the candidates of all levels are grouped together.
+
+                        classifier->detectMultiScale(shifted, objects, params.searchIncrement, 0, params.flags, window, window);
+
+                        for (std::vector<cv::Rect>::const_iterator it = objects.begin() ; it != objects.end() ; ++it)
+                        {
+                            candidates.push_back(cv::Rect(cvRound((it->x + dx) * factor),
+                                                          cvRound((it->y + dy) * factor),
+                                                          cvRound(it->width    * factor),
+                                                          cvRound(it->height   * factor)));
+                        }
+                    }
+                }
+            }
+        }
+
+        level->candidates << candidates;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------
+
 class Q_DECL_HIDDEN OpenCVFaceDetector::Private
 {
 
@@ -270,8 +482,6 @@ public:
 
     double                 speedVsAccuracy;
     double                 sensitivityVsSpecificity;
-
-    QMutex                 mutex;
 };
 
 // --------------------------------------------------------------------------------
@@ -427,18 +637,18 @@ void OpenCVFaceDetector::updateParameters(const cv::Size& /*scaledSize*/, const
 }
 
 QList<QRect> OpenCVFaceDetector::cascadeResult(const cv::Mat& inputImage,
-                                               Cascade& cascade,
+                                               const Cascade& cascade,
                                                const DetectObjectParameters& params) const
 {
+    CascadeLocker classifier(cascade.file);
+
     // Check whether the cascade has loaded successfully. Else report and error and quit
-    if (cascade.empty())
+    if (classifier.isNull())
     {
         qCDebug(DIGIKAM_FACESENGINE_LOG) << "Cascade XML data are not loaded.";
         return QList<QRect>();
     }
 
-    QMutexLocker locker(&d->mutex);
-
     // There can be more than one face in an image. So create a growable sequence of faces.
     // Detect the objects and store them in the sequence
 
@@ -449,7 +659,7 @@ QList<QRect> OpenCVFaceDetector::cascadeResult(const cv::Mat& inputImage,
                                      << "min size (" << params.minSize.width << "," << params.minSize.height << ")";
 
     std::vector<cv::Rect> faces;
-    cascade.detectMultiScale(inputImage, faces,
+    classifier->detectMultiScale(inputImage, faces,
                              params.searchIncrement,                // Increase search scale by this factor every time.
                              params.grouping,                       // Drop groups of less than n detections.
                              params.flags,                          // Optionally, pre-test regions by edge detection.
@@ -467,6 +677,100 @@ QList<QRect> OpenCVFaceDetector::cascadeResult(const cv::Mat& inputImage,
     return results;
 }
 
+QList<QList<QRect> > OpenCVFaceDetector::pyramidResults(const cv::Mat& inputImage,
+                                                       const DetectObjectParameters& params) const
+{
+    QList<const Cascade*> cascades;
+    cv::Size              smallestWindow;
+
+    for (int i = 0 ; i < d->cascades.size() ; ++i)
+    {
+        const Cascade& cascade = d->cascades.at(i);
+        CascadeLocker classifier(cascade.file);
+
+        if (cascade.primaryCascade && !classifier.isNull())
+        {
+            cv::Size window = classifier->getOriginalWindowSize();
+
+            if (cascades.isEmpty() || window.area() < smallestWindow.area())
+            {
+                smallestWindow = window;
+            }
+
+            cascades << &cascade;
+        }
+    }
+
+    QList<QList<QRect> > results;
+
+    if (cascades.isEmpty() || smallestWindow.area() <= 0)
+    {
+        qCDebug(DIGIKAM_FACESENGINE_LOG) << "Cascade XML data are not loaded.";
+        return results;
+    }
+
+    // Build the list of levels once for all primary cascades, as detectMultiScale would do for each
+
+    QList<PyramidLevel> levels;
+
+    for (double factor = 1.0 ; ; factor *= params.searchIncrement)
+    {
+        if (cvRound(inputImage.cols / factor) < smallestWindow.width ||
+            cvRound(inputImage.rows / factor) < smallestWindow.height)
+        {
+            break;
+        }
+
+        levels << PyramidLevel(factor);
+    }
+
+    qCDebug(DIGIKAM_FACESENGINE_LOG) << "Scan" << levels.size() << "levels: image size (" << inputImage.cols << "," << inputImage.rows
+                                     << ") searchIncrement" << params.searchIncrement
+                                     << "grouping" << params.grouping
+                                     << "flags" << params.flags
+                                     << "min size (" << params.minSize.width << "," << params.minSize.height << ")";
+
+    ThreadSchedulerTasks tasks;
+
+    for (int i = 0 ; i < levels.size() ; ++i)
+    {
+        tasks.run(std::bind(&detectAtLevel,
+                            inputImage,
+                            cascades,
+                            params,
+                            &levels[i]));
+    }
+
+    tasks.waitForDone();
+
+    // Group the candidates of all levels, as detectMultiScale does with its own scales
+
+    for (int c = 0 ; c < cascades.size() ; ++c)
+    {
+        std::vector<cv::Rect> faces;
+
+        foreach (const PyramidLevel& level, levels)
+        {
+            faces.insert(faces.end(), level.candidates.at(c).begin(), level.candidates.at(c).end());
+        }
+
+        cv::groupRectangles(faces, params.grouping, 0.2);
+
+        QList<QRect> cascadeResults;
+
+        for (std::vector<cv::Rect>::const_iterator it = faces.begin() ; it != faces.end() ; ++it)
+        {
+            cascadeResults << toQRect(*it);
+        }
+
+        qCDebug(DIGIKAM_FACESENGINE_LOG) << "Pyramid scan gave" << cascadeResults;
+
+        results << cascadeResults;
+    }
+
+    return results;
+}
+
 bool OpenCVFaceDetector::verifyFace(const cv::Mat& inputImage, const QRect& face) const
 {
     // check if we need to verify
@@ -783,18 +1087,10 @@ QList<QRect> OpenCVFaceDetector::detectFaces(const cv::Mat& inputImage, const cv
 
     updateParameters(inputImage.size(), originalSize);
 
-    // Now loop through each cascade, apply it, and get back a vector of detected faces
-    QList<QList<QRect> > primaryResults;
+    // Now apply each primary cascade, and get back a vector of detected faces
+    QList<QList<QRect> > primaryResults = pyramidResults(inputImage, d->primaryParams);
     QList<QRect> results;
 
-    for (int i = 0 ; i < d->cascades.size() ; ++i)
-    {
-        if (d->cascades[i].primaryCascade)
-        {
-            primaryResults << cascadeResult(inputImage, d->cascades[i], d->primaryParams);
-        }
-    }
-
     // Merge overlaps of face regions by different cascades.
     results = mergeFaces(inputImage, primaryResults);
 
@@ -94,7 +94,13 @@ private:
      *  @param params The parameters to be used for detection
      *  @return Returns a vector of Face objects. Each object hold information about 1 face.
      */
-    QList<QRect> cascadeResult(const cv::Mat& inputImage, Cascade& cascade, const DetectObjectParameters& params) const;
+    QList<QRect> cascadeResult(const cv::Mat& inputImage, const Cascade& cascade, const DetectObjectParameters& params) const;
+
+    /**
+     * Detect faces in an image using all primary cascades. The image pyramid is built once
+     * and its levels are scanned in parallel. Returns the results of each cascade.
+     */
+    QList< QList<QRect> > pyramidResults(const cv::Mat& inputImage, const DetectObjectParameters& params) const;
 
     bool verifyFace(const cv::Mat& inputImage, const QRect& face) const;
 
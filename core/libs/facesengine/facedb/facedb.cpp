@@ -56,6 +56,7 @@
 #include "fisherfacemodel.h"
 #include "lbphfacemodel.h"
 #include "facedb.h"                    // krazy:exclude=includes
+#include "facemodelcache.h"
 #include "digikam_debug.h"
 
 namespace Digikam
@@ -66,13 +67,167 @@ class Q_DECL_HIDDEN FaceDb::Private
 
 public:
     explicit Private()
-        : db(0)
+        : db(0),
+          lbphGenerationKey(QLatin1String("LBPHTrainingGeneration")),
+          matricesGenerationKey(QLatin1String("FaceMatricesTrainingGeneration"))
     {
     }
 
+    enum EntrySource
+    {
+        LBPHistograms = 0,
+        FaceMatrices,
+        FaceVectors
+    };
+
+public:
+
+    /**
+     * Returns the generation of the training data stored under key, see FaceModelCache.
+     */
+    QString generation(const QString& key) const;
+
+    /**
+     * Marks the training data stored under key as changed and returns the new generation.
+     */
+    QString renewGeneration(const QString& key) const;
+
+    /**
+     * Returns the training data from the cache file if it is up to date,
+     * otherwise reads it from the database and writes the cache file again.
+     * The entries of a mapped file are valid as long as cache.
+     */
+    QList<FaceModelCache::Entry> entries(FaceModelCache& cache, const QString& key,
+                                         EntrySource source, int recognizerId = 0) const;
+
+    /**
+     * Reads and uncompresses the training data from the database.
+     */
+    QList<FaceModelCache::Entry> databaseEntries(EntrySource source, int recognizerId) const;
+
+public:
+
     FaceDbBackend* db;
+
+    const QString  lbphGenerationKey;
+    const QString  matricesGenerationKey;
 };
 
+QString FaceDb::Private::generation(const QString& key) const
+{
+    QMap<QString, QVariant> parameters;
+    parameters.insert(QLatin1String(":keyword"), key);
+    QList<QVariant> values;
+
+    db->execDBAction(db->getDBAction(QLatin1String("SelectFaceSetting")), parameters, &values);
+
+    if (values.isEmpty() || values.first().toString().isEmpty())
+    {
+        return renewGeneration(key);
+    }
+
+    return values.first().toString();
+}
+
+QString FaceDb::Private::renewGeneration(const QString& key) const
+{
+    QString generation = FaceModelCache::createGeneration();
+
+    QMap<QString, QVariant> parameters;
+    parameters.insert(QLatin1String(":keyword"), key);
+    parameters.insert(QLatin1String(":value"),   generation);
+
+    db->execDBAction(db->getDBAction(QLatin1String("ReplaceFaceSetting")), parameters);
+
+    return generation;
+}
+
+QList<FaceModelCache::Entry> FaceDb::Private::entries(FaceModelCache& cache, const QString& key,
+                                                      EntrySource source, int recognizerId) const
+{
+    QString generation = this->generation(key);
+
+    if (cache.open(generation))
+    {
+        return cache.entries();
+    }
+
+    QList<FaceModelCache::Entry> entries = databaseEntries(source, recognizerId);
+
+    if (cache.write(generation, entries))
+    {
+        qCDebug(DIGIKAM_FACEDB_LOG) << "Wrote" << entries.size() << "entries to face model file" << cache.filePath();
+    }
+
+    return entries;
+}
+
+QList<FaceModelCache::Entry> FaceDb::Private::databaseEntries(EntrySource source, int recognizerId) const
+{
+    QList<FaceModelCache::Entry> entries;
+    DbEngineSqlQuery query = (source == LBPHistograms)
+                           ? db->execQuery(QLatin1String("SELECT id, identity, `context`, `type`, `rows`, `cols`, `data` "
+                                                         "FROM OpenCVLBPHistograms WHERE recognizerid=?;"),
+                                           recognizerId)
+                           : db->execQuery(QLatin1String("SELECT id, identity, `context`, `type`, `rows`, `cols`, `data`, vecdata "
+                                                         "FROM FaceMatrices;"));
+
+    while (query.next())
+    {
+        FaceModelCache::Entry entry;
+
+        entry.databaseId     = query.value(0).toInt();
+        entry.identity       = query.value(1).toInt();
+        entry.context        = query.value(2).toString();
+        QByteArray cData     = query.value((source == FaceVectors) ? 7 : 6).toByteArray();
+
+        if (cData.isEmpty())
+        {
+            // Rows of the DNN recognizer have no matrix, and rows of the OpenCV recognizers
+            // written without DNN support have no vector.
+
+            if (source == LBPHistograms || query.value((source == FaceVectors) ? 6 : 7).toByteArray().isEmpty())
+            {
+                qCWarning(DIGIKAM_FACEDB_LOG) << "Data to checkout from database are empty for Identity "
+                                              << entry.identity;
+            }
+
+            continue;
+        }
+
+        entry.mat.data = qUncompress(cData);
+
+        if (entry.mat.data.isEmpty())
+        {
+            qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot uncompress data to checkout from database for Identity "
+                                          << entry.identity;
+            continue;
+        }
+
+        if (source == FaceVectors)
+        {
+            // cv::Mat
+            entry.mat.type = CV_32FC1;
+            entry.mat.rows = 1;
+            entry.mat.cols = entry.mat.data.size() / sizeof(float);
+        }
+        else
+        {
+            // cv::Mat
+            entry.mat.type = query.value(3).toInt();
+            entry.mat.rows = query.value(4).toInt();
+            entry.mat.cols = query.value(5).toInt();
+        }
+
+        qCDebug(DIGIKAM_FACEDB_LOG) << "Checkout compressed data " << entry.databaseId << " for identity "
+                                    << entry.identity << " with size " << cData.size();
+
+        entries << entry;
+    }
+
+    return entries;
+}
+
 /*
  * NOTE: This constructor is only used in facerec_dnnborrowed.cpp.
  * Create an object of FaceDb to invoke the method getFaceVector
@@ -236,7 +391,15 @@ void FaceDb::updateLBPHFaceModel(LBPHFaceModel& model)
         model.databaseId = insertedId.toInt();
     }
 
+    // The generation changes before and after the rows, so that a cache file
+    // written from the database in between is never taken as up to date.
+
+    QString oldGeneration                    = d->generation(d->lbphGenerationKey);
+    d->renewGeneration(d->lbphGenerationKey);
+
     QList<LBPHistogramMetadata> metadataList = model.histogramMetadata();
+    QList<FaceModelCache::Entry> added;
+    QList<int>                   removed;
 
     for (int i = 0 ; i < metadataList.size() ; ++i)
     {
@@ -288,6 +451,8 @@ void FaceDb::updateLBPHFaceModel(LBPHFaceModel& model)
                             d->db->execSql(QLatin1String("DELETE FROM OpenCVLBPHistograms "
                                                          "WHERE id=? AND recognizerid=? AND identity=? AND `type`=?;"),
                                            values.at(j).toInt(), model.databaseId, metadata.identity, data.type);
+
+                            removed << values.at(j).toInt();
                         }
                     }
 
@@ -297,12 +462,22 @@ void FaceDb::updateLBPHFaceModel(LBPHFaceModel& model)
 
                     model.setWrittenToDatabase(i, insertedId.toInt());
 
+                    FaceModelCache::Entry entry;
+                    entry.databaseId = insertedId.toInt();
+                    entry.identity   = metadata.identity;
+                    entry.context    = metadata.context;
+                    entry.mat        = data;
+                    added << entry;
+
                     qCDebug(DIGIKAM_FACEDB_LOG) << "Commit compressed histogram " << insertedId.toInt() << " for identity "
                                                 << metadata.identity << " with size " << compressed.size();
                 }
             }
         }
     }
+
+    FaceModelCache cache(QString::fromLatin1("lbph-%1").arg(model.databaseId));
+    cache.update(oldGeneration, d->renewGeneration(d->lbphGenerationKey), added, removed);
 }
 
 LBPHFaceModel FaceDb::lbphFaceModel() const
@@ -338,51 +513,25 @@ LBPHFaceModel FaceDb::lbphFaceModel() const
         model.setGridY(it->toInt());
         ++it;
 
-        DbEngineSqlQuery query = d->db->execQuery(QLatin1String("SELECT id, identity, `context`, `type`, `rows`, `cols`, `data` "
-                                                                "FROM OpenCVLBPHistograms WHERE recognizerid=?;"),
-                                                  model.databaseId);
-        QList<OpenCVMatData> histograms;
-        QList<LBPHistogramMetadata> histogramMetadata;
+        // The histograms refer to the mapped file until they are copied in the model
 
-        while (query.next())
+        FaceModelCache cache(QString::fromLatin1("lbph-%1").arg(model.databaseId));
+        QList<FaceModelCache::Entry> entries = d->entries(cache, d->lbphGenerationKey,
+                                                          Private::LBPHistograms, model.databaseId);
+        QList<OpenCVMatData>         histograms;
+        QList<LBPHistogramMetadata>  histogramMetadata;
+
+        foreach (const FaceModelCache::Entry& entry, entries)
         {
             LBPHistogramMetadata metadata;
-            OpenCVMatData        data;
 
-            metadata.databaseId    = query.value(0).toInt();
-            metadata.identity      = query.value(1).toInt();
-            metadata.context       = query.value(2).toString();
+            metadata.databaseId    = entry.databaseId;
+            metadata.identity      = entry.identity;
+            metadata.context       = entry.context;
             metadata.storageStatus = LBPHistogramMetadata::InDatabase;
 
-            // cv::Mat
-            data.type              = query.value(3).toInt();
-            data.rows              = query.value(4).toInt();
-            data.cols              = query.value(5).toInt();
-            QByteArray cData       = query.value(6).toByteArray();
-
-            if (!cData.isEmpty())
-            {
-                data.data = qUncompress(cData);
-
-                if (data.data.isEmpty())
-                {
-                    qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot uncompress histogram data to checkout from database for Identity "
-                                                  << metadata.identity;
-                }
-                else
-                {
-                    qCDebug(DIGIKAM_FACEDB_LOG) << "Checkout compressed histogram " << metadata.databaseId << " for identity "
-                                                << metadata.identity << " with size " << cData.size();
-
-                    histograms        << data;
-                    histogramMetadata << metadata;
-                }
-            }
-            else
-            {
-                qCWarning(DIGIKAM_FACEDB_LOG) << "Histogram data to checkout from database are empty for Identity "
-                                              << metadata.identity;
-            }
+            histograms        << entry.mat;
+            histogramMetadata << metadata;
         }
 
         model.setHistograms(histograms, histogramMetadata);
@@ -404,6 +553,8 @@ void FaceDb::clearLBPHTraining(const QString& context)
     {
         d->db->execSql(QLatin1String("DELETE FROM OpenCVLBPHistograms WHERE `context`=?;"), context);
     }
+
+    d->renewGeneration(d->lbphGenerationKey);
 }
 
 void FaceDb::clearLBPHTraining(const QList<int>& identities, const QString& context)
@@ -419,6 +570,8 @@ void FaceDb::clearLBPHTraining(const QList<int>& identities, const QString& cont
             d->db->execSql(QLatin1String("DELETE FROM OpenCVLBPHistograms WHERE identity=? AND `context`=?;"), id, context);
         }
     }
+
+    d->renewGeneration(d->lbphGenerationKey);
 }
 
 #ifdef HAVE_FACESENGINE_DNN
@@ -431,7 +584,12 @@ void FaceDb::getFaceVector(cv::Mat data, std::vector<float>& vecdata)
 
 void FaceDb::updateEIGENFaceModel(EigenFaceModel& model, const std::vector<cv::Mat>& images_rgb)
 {
+    QString oldGeneration                    = d->generation(d->matricesGenerationKey);
+    d->renewGeneration(d->matricesGenerationKey);
+
     QList<EigenFaceMatMetadata> metadataList = model.matMetadata();
+    QList<FaceModelCache::Entry> addedMatrices;
+    QList<FaceModelCache::Entry> addedVectors;
 
     for (size_t i = 0, j = 0 ; i < (size_t)metadataList.size() ; ++i)
     {
@@ -507,63 +665,62 @@ void FaceDb::updateEIGENFaceModel(EigenFaceModel& model, const std::vector<cv::M
 
                     model.setWrittenToDatabase(i, insertedId.toInt());
 
+                    FaceModelCache::Entry entry;
+                    entry.databaseId = insertedId.toInt();
+                    entry.identity   = metadata.identity;
+                    entry.context    = metadata.context;
+                    entry.mat        = data;
+                    addedMatrices << entry;
+
+                    if (!vec_byte.isEmpty())
+                    {
+                        entry.mat.type = CV_32FC1;
+                        entry.mat.rows = 1;
+                        entry.mat.cols = vecdata.size();
+                        entry.mat.data = vec_byte;
+                        addedVectors << entry;
+                    }
+
                     qCDebug(DIGIKAM_FACEDB_LOG) << "Commit compressed matData " << insertedId << " for identity "
                                                 << metadata.identity << " with size " << compressed.size();
                 }
             }
         }
     }
+
+    // The Eigen and Fisher recognizers share the matrices, the DNN recognizer uses the vectors of the same rows
+
+    QString newGeneration = d->renewGeneration(d->matricesGenerationKey);
+
+    FaceModelCache matrices(QLatin1String("matrices"));
+    matrices.update(oldGeneration, newGeneration, addedMatrices);
+
+    FaceModelCache vectors(QLatin1String("dnn"));
+    vectors.update(oldGeneration, newGeneration, addedVectors);
 }
 
 EigenFaceModel FaceDb::eigenFaceModel() const
 {
     qCDebug(DIGIKAM_FACEDB_LOG) << "Loading EIGEN model";
-    DbEngineSqlQuery query = d->db->execQuery(QLatin1String("SELECT id, identity, `context`, `type`, `rows`, `cols`, `data`, vecdata "
-                                                            "FROM FaceMatrices;"));
+
+    FaceModelCache cache(QLatin1String("matrices"));
+    QList<FaceModelCache::Entry> entries = d->entries(cache, d->matricesGenerationKey, Private::FaceMatrices);
 
     EigenFaceModel model = EigenFaceModel();
     QList<OpenCVMatData>        mats;
     QList<EigenFaceMatMetadata> matMetadata;
 
-    while (query.next())
+    foreach (const FaceModelCache::Entry& entry, entries)
     {
         EigenFaceMatMetadata metadata;
-        OpenCVMatData data;
 
-        metadata.databaseId    = query.value(0).toInt();
-        metadata.identity      = query.value(1).toInt();
-        metadata.context       = query.value(2).toString();
+        metadata.databaseId    = entry.databaseId;
+        metadata.identity      = entry.identity;
+        metadata.context       = entry.context;
         metadata.storageStatus = EigenFaceMatMetadata::InDatabase;
 
-        // cv::Mat
-        data.type              = query.value(3).toInt();
-        data.rows              = query.value(4).toInt();
-        data.cols              = query.value(5).toInt();
-        QByteArray cData       = query.value(6).toByteArray();
-
-        if (!cData.isEmpty())
-        {
-            data.data = qUncompress(cData);
-
-            if (data.data.isEmpty())
-            {
-                qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot uncompress mat data to checkout from database for Identity "
-                                              << metadata.identity;
-            }
-            else
-            {
-                qCDebug(DIGIKAM_FACEDB_LOG) << "Checkout compressed histogram " << metadata.databaseId
-                                            << " for identity " << metadata.identity << " with size " << cData.size();
-
-                mats        << data;
-                matMetadata << metadata;
-            }
-        }
-        else
-        {
-            qCWarning(DIGIKAM_FACEDB_LOG) << "Mat data to checkout from database are empty for Identity "
-                                          << metadata.identity;
-        }
+        mats        << entry.mat;
+        matMetadata << metadata;
     }
 
     model.setMats(mats, matMetadata);
@@ -574,52 +731,25 @@ EigenFaceModel FaceDb::eigenFaceModel() const
 FisherFaceModel FaceDb::fisherFaceModel() const
 {
     qCDebug(DIGIKAM_FACEDB_LOG) << "Loading FISHER model from FaceMatrices";
-    DbEngineSqlQuery query = d->db->execQuery(QLatin1String("SELECT id, identity, `context`, `type`, `rows`, `cols`, `data`, vecdata "
-                                                            "FROM FaceMatrices;"));
+
+    FaceModelCache cache(QLatin1String("matrices"));
+    QList<FaceModelCache::Entry> entries = d->entries(cache, d->matricesGenerationKey, Private::FaceMatrices);
 
     FisherFaceModel model  = FisherFaceModel();
     QList<OpenCVMatData>         mats;
     QList<FisherFaceMatMetadata> matMetadata;
 
-    while (query.next())
+    foreach (const FaceModelCache::Entry& entry, entries)
     {
         FisherFaceMatMetadata metadata;
-        OpenCVMatData data;
 
-        metadata.databaseId    = query.value(0).toInt();
-        metadata.identity      = query.value(1).toInt();
-        metadata.context       = query.value(2).toString();
+        metadata.databaseId    = entry.databaseId;
+        metadata.identity      = entry.identity;
+        metadata.context       = entry.context;
         metadata.storageStatus = FisherFaceMatMetadata::InDatabase;
 
-        // cv::Mat
-        data.type              = query.value(3).toInt();
-        data.rows              = query.value(4).toInt();
-        data.cols              = query.value(5).toInt();
-        QByteArray cData       = query.value(6).toByteArray();
-
-        if (!cData.isEmpty())
-        {
-            data.data = qUncompress(cData);
-
-            if (data.data.isEmpty())
-            {
-                qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot uncompress mat data to checkout from database for Identity "
-                                              << metadata.identity;
-            }
-            else
-            {
-                qCDebug(DIGIKAM_FACEDB_LOG) << "Checkout compressed histogram " << metadata.databaseId << " for identity "
-                                            << metadata.identity << " with size " << cData.size();
-
-                mats        << data;
-                matMetadata << metadata;
-            }
-        }
-        else
-        {
-            qCWarning(DIGIKAM_FACEDB_LOG) << "Mat data to checkout from database are empty for Identity "
-                                          << metadata.identity;
-        }
+        mats        << entry.mat;
+        matMetadata << metadata;
     }
 
     model.setMats(mats, matMetadata);
@@ -630,7 +760,11 @@ FisherFaceModel FaceDb::fisherFaceModel() const
 #ifdef HAVE_FACESENGINE_DNN
 void FaceDb::updateDNNFaceModel(DNNFaceModel& model)
 {
+    QString oldGeneration                  = d->generation(d->matricesGenerationKey);
+    d->renewGeneration(d->matricesGenerationKey);
+
     QList<DNNFaceVecMetadata> metadataList = model.vecMetadata();
+    QList<FaceModelCache::Entry> added;
 
     for (size_t i = 0 ; i < (size_t)metadataList.size() ; ++i)
     {
@@ -672,62 +806,57 @@ void FaceDb::updateDNNFaceModel(DNNFaceModel& model)
 
                 model.setWrittenToDatabase(i, insertedId.toInt());
 
+                FaceModelCache::Entry entry;
+                entry.databaseId = insertedId.toInt();
+                entry.identity   = metadata.identity;
+                entry.context    = metadata.context;
+                entry.mat.type   = CV_32FC1;
+                entry.mat.rows   = 1;
+                entry.mat.cols   = vecdata.size();
+                entry.mat.data   = vec_byte;
+                added << entry;
+
                 qCDebug(DIGIKAM_FACEDB_LOG) << "Commit compressed vecData " << insertedId << " for identity "
                                             << metadata.identity << " with size " << compressed_vecdata.size();
             }
         }
     }
+
+    // The new rows have no matrix: the file of the Eigen and Fisher recognizers only gets the new stamp
+
+    QString newGeneration = d->renewGeneration(d->matricesGenerationKey);
+
+    FaceModelCache vectors(QLatin1String("dnn"));
+    vectors.update(oldGeneration, newGeneration, added);
+
+    FaceModelCache matrices(QLatin1String("matrices"));
+    matrices.update(oldGeneration, newGeneration, QList<FaceModelCache::Entry>());
 }
 
 DNNFaceModel FaceDb::dnnFaceModel() const
 {
     qCDebug(DIGIKAM_FACEDB_LOG) << "Loading DNN model";
-    DbEngineSqlQuery query = d->db->execQuery(QLatin1String("SELECT id, identity, `context`, `type`, `rows`, `cols`, `data`, vecdata "
-                                                            "FROM FaceMatrices;"));
+
+    FaceModelCache cache(QLatin1String("dnn"));
+    QList<FaceModelCache::Entry> entries = d->entries(cache, d->matricesGenerationKey, Private::FaceVectors);
 
     DNNFaceModel model = DNNFaceModel();
     QList<std::vector<float>> mats;
     QList<DNNFaceVecMetadata> matMetadata;
 
-    while (query.next())
+    foreach (const FaceModelCache::Entry& entry, entries)
     {
         DNNFaceVecMetadata metadata;
-        std::vector<float> vecdata;
 
-        metadata.databaseId    = query.value(0).toInt();
-        metadata.identity      = query.value(1).toInt();
-        metadata.context       = query.value(2).toString();
+        metadata.databaseId    = entry.databaseId;
+        metadata.identity      = entry.identity;
+        metadata.context       = entry.context;
         metadata.storageStatus = DNNFaceVecMetadata::InDatabase;
-        QByteArray cData       = query.value(7).toByteArray();
-
-        if (!cData.isEmpty())
-        {
-            QByteArray new_vec = qUncompress(cData);
-
-            if (new_vec.isEmpty())
-            {
-                qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot uncompress mat data to checkout from database for Identity " << metadata.identity;
-            }
-            else
-            {
-                qCDebug(DIGIKAM_FACEDB_LOG) << "Checkout compressed histogram " << metadata.databaseId << " for identity "
-                                            << metadata.identity << " with size " << cData.size();
 
-                float* const it = (float *)new_vec.data();
+        const float* const it  = (const float*)entry.mat.data.constData();
 
-                for (int i = 0; i < 128; ++i)
-                {
-                    vecdata.push_back(*(it+i));
-                }
-
-                mats        << vecdata;
-                matMetadata << metadata;
-            }
-        }
-        else
-        {
-            qCWarning(DIGIKAM_FACEDB_LOG) << "Mat data to checkout from database are empty for Identity " << metadata.identity;
-        }
+        mats        << std::vector<float>(it, it + entry.mat.cols);
+        matMetadata << metadata;
     }
 
     model.setMats(mats, matMetadata);
@@ -746,6 +875,8 @@ void FaceDb::clearEIGENTraining(const QString& context)
     {
         d->db->execSql(QLatin1String("DELETE FROM FaceMatrices WHERE `context`=?;"), context);
     }
+
+    d->renewGeneration(d->matricesGenerationKey);
 }
 
 void FaceDb::clearEIGENTraining(const QList<int>& identities, const QString& context)
@@ -761,6 +892,8 @@ void FaceDb::clearEIGENTraining(const QList<int>& identities, const QString& con
             d->db->execSql(QLatin1String("DELETE FROM FaceMatrices WHERE identity=? AND `context`=?;"), id, context);
         }
     }
+
+    d->renewGeneration(d->matricesGenerationKey);
 }
 
 bool FaceDb::integrityCheck()
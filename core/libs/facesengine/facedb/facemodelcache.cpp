@@ -0,0 +1,473 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Uncompressed on-disk copy of the face recognition training data
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "facemodelcache.h"
+
+// C ANSI includes
+
+#include <string.h>
+
+// Qt includes
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUuid>
+
+// Local includes
+
+#include "dbengineparameters.h"
+#include "facedbaccess.h"
+#include "digikam_debug.h"
+
+namespace Digikam
+{
+
+namespace
+{
+
+/**
+ * File layout, in native byte order: one FileHeader, then for each entry one RecordHeader
+ * followed by the context string in UTF-8 and the matrix data. Each part starts
+ * on a multiple of 8 bytes, so that the mapped data can be read as float or double.
+ */
+
+struct FileHeader
+{
+    char    magic[4];
+    quint32 version;
+    quint32 count;
+    quint32 reserved;
+    char    generation[16];
+};
+
+struct RecordHeader
+{
+    qint32  databaseId;
+    qint32  identity;
+    qint32  type;
+    qint32  rows;
+    qint32  cols;
+    quint32 contextSize;
+    quint64 dataSize;
+};
+
+const char    FileMagic[4]  = { 'D', 'K', 'F', 'M' };
+const quint32 FileVersion   = 1;
+
+inline qint64 aligned(qint64 size)
+{
+    return ((size + 7) & ~qint64(7));
+}
+
+QByteArray generationBytes(const QString& generation)
+{
+    QUuid uuid(generation);
+
+    if (uuid.isNull())
+    {
+        return QByteArray();
+    }
+
+    return uuid.toRfc4122();
+}
+
+bool isHeaderValid(const FileHeader& header)
+{
+    return ((memcmp(header.magic, FileMagic, sizeof(FileMagic)) == 0) &&
+            (header.version == FileVersion));
+}
+
+bool writePadding(QIODevice& device, qint64 size)
+{
+    static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    qint64 padding             = aligned(size) - size;
+
+    return ((padding == 0) || (device.write(zeros, padding) == padding));
+}
+
+bool writeEntry(QIODevice& device, const FaceModelCache::Entry& entry)
+{
+    QByteArray   context = entry.context.toUtf8();
+    RecordHeader record;
+
+    memset(&record, 0, sizeof(RecordHeader));
+    record.databaseId  = entry.databaseId;
+    record.identity    = entry.identity;
+    record.type        = entry.mat.type;
+    record.rows        = entry.mat.rows;
+    record.cols        = entry.mat.cols;
+    record.contextSize = context.size();
+    record.dataSize    = entry.mat.data.size();
+
+    return ((device.write((const char*)&record, sizeof(RecordHeader)) == (qint64)sizeof(RecordHeader)) &&
+            (device.write(context)         == context.size())                                          &&
+            writePadding(device, context.size())                                                       &&
+            (device.write(entry.mat.data)  == entry.mat.data.size())                                   &&
+            writePadding(device, entry.mat.data.size()));
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN FaceModelCache::Private
+{
+public:
+
+    explicit Private()
+      : map(0)
+    {
+    }
+
+    void close()
+    {
+        entries.clear();
+
+        if (map)
+        {
+            file.unmap(map);
+            map = 0;
+        }
+
+        file.close();
+    }
+
+    /**
+     * Reads the entries from the mapped file. Returns false if the file is damaged.
+     */
+    bool parse(qint64 size);
+
+public:
+
+    QString      path;
+    QFile        file;
+    uchar*       map;
+    QList<Entry> entries;
+};
+
+bool FaceModelCache::Private::parse(qint64 size)
+{
+    const FileHeader* const header = reinterpret_cast<const FileHeader*>(map);
+    qint64 offset                  = sizeof(FileHeader);
+
+    for (quint32 i = 0 ; i < header->count ; ++i)
+    {
+        if (offset + (qint64)sizeof(RecordHeader) > size)
+        {
+            return false;
+        }
+
+        const RecordHeader* const record = reinterpret_cast<const RecordHeader*>(map + offset);
+        offset                          += sizeof(RecordHeader);
+
+        qint64 contextOffset             = offset;
+        offset                          += aligned(record->contextSize);
+        qint64 dataOffset                = offset;
+        offset                          += aligned((qint64)record->dataSize);
+
+        if (offset > size || record->rows < 0 || record->cols < 0 ||
+            (quint64)record->rows * record->cols * CV_ELEM_SIZE(record->type) != record->dataSize)
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.databaseId = record->databaseId;
+        entry.identity   = record->identity;
+        entry.context    = QString::fromUtf8((const char*)map + contextOffset, record->contextSize);
+        entry.mat.type   = record->type;
+        entry.mat.rows   = record->rows;
+        entry.mat.cols   = record->cols;
+
+        // No copy: the data is read from the page cache when the model is built
+
+        entry.mat.data   = QByteArray::fromRawData((const char*)map + dataOffset, record->dataSize);
+
+        entries << entry;
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------------
+
+FaceModelCache::FaceModelCache(const QString& name)
+    : d(new Private)
+{
+    d->path = directory() + QLatin1Char('/') + name + QLatin1String(".facemodel");
+}
+
+FaceModelCache::~FaceModelCache()
+{
+    d->close();
+    delete d;
+}
+
+QString FaceModelCache::filePath() const
+{
+    return d->path;
+}
+
+bool FaceModelCache::open(const QString& generation)
+{
+    d->close();
+
+    QByteArray stamp = generationBytes(generation);
+
+    if (stamp.isEmpty())
+    {
+        return false;
+    }
+
+    d->file.setFileName(d->path);
+
+    if (!d->file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    qint64 size = d->file.size();
+
+    if (size < (qint64)sizeof(FileHeader))
+    {
+        d->close();
+        return false;
+    }
+
+    d->map = d->file.map(0, size);
+
+    if (!d->map)
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot map face model file" << d->path << d->file.errorString();
+        d->close();
+        return false;
+    }
+
+    const FileHeader* const header = reinterpret_cast<const FileHeader*>(d->map);
+
+    if (!isHeaderValid(*header) || memcmp(header->generation, stamp.constData(), sizeof(header->generation)) != 0)
+    {
+        qCDebug(DIGIKAM_FACEDB_LOG) << "Face model file" << d->path << "is out of date";
+        d->close();
+        return false;
+    }
+
+    if (!d->parse(size))
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "Face model file" << d->path << "is damaged";
+        d->close();
+        return false;
+    }
+
+    qCDebug(DIGIKAM_FACEDB_LOG) << "Mapped" << d->entries.size() << "face model entries from" << d->path;
+
+    return true;
+}
+
+QList<FaceModelCache::Entry> FaceModelCache::entries() const
+{
+    return d->entries;
+}
+
+bool FaceModelCache::write(const QString& generation, const QList<Entry>& entries)
+{
+    d->close();
+
+    QByteArray stamp = generationBytes(generation);
+
+    if (stamp.isEmpty() || !QDir().mkpath(QFileInfo(d->path).absolutePath()))
+    {
+        return false;
+    }
+
+    FileHeader header;
+    memset(&header, 0, sizeof(FileHeader));
+    memcpy(header.magic, FileMagic, sizeof(FileMagic));
+    memcpy(header.generation, stamp.constData(), sizeof(header.generation));
+    header.version = FileVersion;
+    header.count   = entries.size();
+
+    // Readers see either the old or the new file, never a partial one
+
+    QSaveFile file(d->path);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot write face model file" << d->path << file.errorString();
+        return false;
+    }
+
+    bool done = (file.write((const char*)&header, sizeof(FileHeader)) == (qint64)sizeof(FileHeader));
+
+    foreach (const Entry& entry, entries)
+    {
+        if (!done)
+        {
+            break;
+        }
+
+        done = writeEntry(file, entry);
+    }
+
+    if (!done)
+    {
+        file.cancelWriting();
+    }
+
+    if (!file.commit())
+    {
+        qCWarning(DIGIKAM_FACEDB_LOG) << "Cannot write face model file" << d->path << file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool FaceModelCache::update(const QString& oldGeneration, const QString& newGeneration,
+                            const QList<Entry>& added, const QList<int>& removed)
+{
+    if (!removed.isEmpty())
+    {
+        // Entries cannot be removed in place, the file is written again without them
+
+        if (!open(oldGeneration))
+        {
+            remove();
+            return false;
+        }
+
+        QList<Entry> entries;
+
+        foreach (const Entry& entry, d->entries)
+        {
+            if (!removed.contains(entry.databaseId))
+            {
+                Entry copy    = entry;
+                copy.mat.data = QByteArray(entry.mat.data.constData(), entry.mat.data.size());
+                entries << copy;
+            }
+        }
+
+        entries << added;
+
+        if (!write(newGeneration, entries))
+        {
+            remove();
+            return false;
+        }
+
+        return true;
+    }
+
+    d->close();
+
+    QByteArray oldStamp = generationBytes(oldGeneration);
+    QByteArray newStamp = generationBytes(newGeneration);
+    QFile      file(d->path);
+
+    if (!file.exists())
+    {
+        return false;
+    }
+
+    FileHeader header;
+    bool       done = false;
+
+    if (!oldStamp.isEmpty() && !newStamp.isEmpty() && file.open(QIODevice::ReadWrite) &&
+        file.read((char*)&header, sizeof(FileHeader)) == (qint64)sizeof(FileHeader)    &&
+        isHeaderValid(header)                                                           &&
+        memcmp(header.generation, oldStamp.constData(), sizeof(header.generation)) == 0)
+    {
+        done = file.seek(file.size());
+
+        foreach (const Entry& entry, added)
+        {
+            if (!done)
+            {
+                break;
+            }
+
+            done = writeEntry(file, entry);
+        }
+
+        // The header is written last: after an interruption, the file keeps
+        // the old stamp and is written again from the database.
+
+        if (done)
+        {
+            header.count += added.size();
+            memcpy(header.generation, newStamp.constData(), sizeof(header.generation));
+
+            done = file.seek(0) &&
+                   (file.write((const char*)&header, sizeof(FileHeader)) == (qint64)sizeof(FileHeader)) &&
+                   file.flush();
+        }
+    }
+
+    file.close();
+
+    if (!done)
+    {
+        file.remove();
+    }
+
+    return done;
+}
+
+void FaceModelCache::remove()
+{
+    d->close();
+    QFile::remove(d->path);
+}
+
+QString FaceModelCache::createGeneration()
+{
+    return QUuid::createUuid().toString();
+}
+
+QString FaceModelCache::directory()
+{
+    DbEngineParameters params = FaceDbAccess::parameters();
+    QString database;
+
+    if (params.isSQLite())
+    {
+        database = QFileInfo(DbEngineParameters::faceDatabaseFileSQLite(params.databaseNameFace)).absoluteFilePath();
+    }
+    else
+    {
+        database = QString::fromLatin1("%1:%2/%3").arg(params.hostName).arg(params.port).arg(params.databaseNameFace);
+    }
+
+    // One folder per face database, as several databases can be used in turn
+
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+           QLatin1String("/facemodels/")                                   +
+           QString::fromLatin1(QCryptographicHash::hash(database.toUtf8(), QCryptographicHash::Md5).toHex());
+}
+
+} // namespace Digikam
@@ -0,0 +1,130 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Uncompressed on-disk copy of the face recognition training data
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_FACE_MODEL_CACHE_H
+#define DIGIKAM_FACE_MODEL_CACHE_H
+
+// Qt includes
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+// Local includes
+
+#include "opencvmatdata.h"
+
+namespace Digikam
+{
+
+/**
+ * The face database stores each histogram or face matrix as a compressed blob,
+ * which must be read and uncompressed row by row before the first recognition.
+ * This cache keeps the same data for one recognizer uncompressed in a single file,
+ * which is memory-mapped when the model is loaded.
+ *
+ * The database stays the reference: the file is stamped with a generation value
+ * which FaceDb changes in the database with each change of the training data.
+ * A file with another stamp is out of date and must be written again from the database.
+ * New training data is appended to the file, as long as nothing else changed in between.
+ */
+class FaceModelCache
+{
+public:
+
+    class Entry
+    {
+    public:
+
+        Entry()
+          : databaseId(0),
+            identity(0)
+        {
+        }
+
+        int           databaseId;
+        int           identity;
+        QString       context;
+
+        /// After open(), the data refers to the mapped file and is valid as long as the cache object.
+        OpenCVMatData mat;
+    };
+
+public:
+
+    /**
+     * The name identifies the recognizer, as "lbph-1". The file is located in the cache
+     * folder of the current face database, see directory().
+     */
+    explicit FaceModelCache(const QString& name);
+    ~FaceModelCache();
+
+    QString filePath() const;
+
+    /**
+     * Maps the file. Returns false if it does not exist, is damaged
+     * or was not written for this generation.
+     */
+    bool open(const QString& generation);
+    QList<Entry> entries() const;
+
+    /**
+     * Replaces the file with the entries, stamped with the generation.
+     */
+    bool write(const QString& generation, const QList<Entry>& entries);
+
+    /**
+     * Adds the entries to a file written for oldGeneration, drops the entries with
+     * the removed database ids and stamps the file with newGeneration.
+     * If the file has another stamp, it is removed and false is returned.
+     */
+    bool update(const QString& oldGeneration, const QString& newGeneration,
+                const QList<Entry>& added, const QList<int>& removed = QList<int>());
+
+    void remove();
+
+    /**
+     * Returns a new value for the generation stamps.
+     */
+    static QString createGeneration();
+
+    /**
+     * The cache folder of the face database currently in use.
+     */
+    static QString directory();
+
+private:
+
+    // Disable
+    FaceModelCache(const FaceModelCache&);
+    FaceModelCache& operator=(const FaceModelCache&);
+
+private:
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_FACE_MODEL_CACHE_H
@@ -21,9 +21,18 @@
  *
  * ============================================================ */
 
+#include "fileactionimageinfolist.h"
+
+// Qt includes
+
+#include <QTimer>
+
+// KDE includes
+
+#include <klocalizedstring.h>
+
 // Local includes
 
-#include "fileactionimageinfolist.h"
 #include "digikam_debug.h"
 #include "progressmanager.h"
 
@@ -71,6 +80,8 @@ void TwoProgressItemsContainer::advance(QAtomicPointer<ProgressItem>& ptr, int n
 }
 
 FileActionProgressItemContainer::FileActionProgressItemContainer()
+    : m_lastSpeedUpdate(0),
+      m_writtenFiles(0)
 {
 }
 
@@ -99,13 +110,57 @@ void FileActionProgressItemContainer::schedulingForWrite(int numberOfInfos,
 
     connect(secondItem, SIGNAL(progressItemCompleted(ProgressItem*)),
             this, SIGNAL(signalWrittingDone()));
+
+    QMutexLocker lock(&m_speedMutex);
+
+    if (!m_speedTimer.isValid())
+    {
+        m_speedTimer.start();
+    }
 }
 
 void FileActionProgressItemContainer::written(int numberOfInfos)
 {
+    updateWriteSpeed(numberOfInfos);
     advance(secondItem, numberOfInfos);
 }
 
+void FileActionProgressItemContainer::updateWriteSpeed(int numberOfInfos)
+{
+    QString status;
+
+    {
+        QMutexLocker lock(&m_speedMutex);
+
+        m_writtenFiles += numberOfInfos;
+
+        if (!m_speedTimer.isValid())
+        {
+            return;
+        }
+
+        qint64 elapsed = m_speedTimer.elapsed();
+
+        // once per second is enough
+        if (elapsed - m_lastSpeedUpdate < 1000)
+        {
+            return;
+        }
+
+        m_lastSpeedUpdate = elapsed;
+        int speed         = qRound(m_writtenFiles * 1000.0 / elapsed);
+        status            = i18np("%1 file per second", "%1 files per second", speed);
+    }
+
+    ProgressItem* const item = secondItem;
+
+    if (item)
+    {
+        // written() is called from the file workers, the item belongs to the main thread
+        QTimer::singleShot(0, item, [item, status]() { item->setStatus(status); });
+    }
+}
+
 void FileActionProgressItemContainer::finishedWriting()
 {
 //    checkFinish(secondItem);
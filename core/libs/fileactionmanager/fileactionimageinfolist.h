@@ -27,7 +27,9 @@
 // Qt includes
 
 #include <QAtomicPointer>
+#include <QElapsedTimer>
 #include <QList>
+#include <QMutex>
 #include <QExplicitlySharedDataPointer>
 #include <QDebug>
 
@@ -84,6 +86,18 @@ public:
 Q_SIGNALS:
 
     void signalWrittingDone();
+
+private:
+
+    /// Shows the number of files written per second in the status of the write progress item
+    void updateWriteSpeed(int numberOfInfos);
+
+private:
+
+    QMutex        m_speedMutex;
+    QElapsedTimer m_speedTimer;
+    qint64        m_lastSpeedUpdate;
+    int           m_writtenFiles;
 };
 
 // -------------------------------------------------------------------------------------------------------------------
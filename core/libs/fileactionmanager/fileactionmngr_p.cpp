@@ -24,6 +24,10 @@
 
 #include "fileactionmngr_p.h"
 
+// Qt includes
+
+#include <QThread>
+
 // KDE includes
 
 #include <klocalizedstring.h>
@@ -37,6 +41,12 @@
 namespace Digikam
 {
 
+/**
+ * Time to wait for further changes of an item before writing its file,
+ * as when a rating and a label are assigned in a row.
+ */
+static const qint64 s_writeCoalescingDelay = 500;
+
 FileActionMngr::Private::Private(FileActionMngr* const qq)
     : q(qq)
 {
@@ -53,6 +63,8 @@ FileActionMngr::Private::Private(FileActionMngr* const qq)
         fileWorker->add(new FileActionMngrFileWorker(this));
     }
 
+    writeClock.start();
+
     sleepTimer = new QTimer(this);
     sleepTimer->setSingleShot(true);
     sleepTimer->setInterval(1000);
@@ -136,20 +148,80 @@ bool FileActionMngr::Private::isActive() const
     return dbProgress.activeProgressItems || fileProgress.activeProgressItems;
 }
 
-bool FileActionMngr::Private::shallSendForWriting(qlonglong id)
+bool FileActionMngr::Private::shallSendForWriting(qlonglong id, int flags)
 {
     QMutexLocker lock(&mutex);
 
-    if (scheduledToWrite.contains(id))
+    QHash<qlonglong, QPair<int, qint64> >::iterator it = scheduledToWrite.find(id);
+
+    if (it != scheduledToWrite.end())
     {
+        // written once with the change already scheduled
+        it->first |= flags;
         return false;
     }
 
-    scheduledToWrite << id;
+    scheduledToWrite.insert(id, qMakePair(flags, writeClock.elapsed()));
     return true;
 }
 
-void FileActionMngr::Private::startingToWrite(const QList<ItemInfo>& infos)
+int FileActionMngr::Private::startingToWrite(const ItemInfo& info, int flags)
+{
+    qint64 delay = 0;
+
+    {
+        QMutexLocker lock(&mutex);
+
+        QHash<qlonglong, QPair<int, qint64> >::const_iterator it = scheduledToWrite.constFind(info.id());
+
+        if (it != scheduledToWrite.constEnd())
+        {
+            delay = s_writeCoalescingDelay - (writeClock.elapsed() - it->second);
+        }
+    }
+
+    // The items of a task were scheduled together, only the first ones wait
+    if (delay > 0)
+    {
+        QThread::msleep(delay);
+    }
+
+    lockFileForWriting(info.id());
+
+    QMutexLocker lock(&mutex);
+
+    QHash<qlonglong, QPair<int, qint64> >::iterator it = scheduledToWrite.find(info.id());
+
+    if (it != scheduledToWrite.end())
+    {
+        flags |= it->first;
+        scheduledToWrite.erase(it);
+    }
+
+    return flags;
+}
+
+void FileActionMngr::Private::lockFileForWriting(qlonglong id)
+{
+    QMutexLocker lock(&mutex);
+
+    // Two writes to the same file are never done at the same time
+    while (writing.contains(id))
+    {
+        writeFinished.wait(&mutex);
+    }
+
+    writing << id;
+}
+
+void FileActionMngr::Private::finishedWriting(qlonglong id)
+{
+    QMutexLocker lock(&mutex);
+    writing.remove(id);
+    writeFinished.wakeAll();
+}
+
+void FileActionMngr::Private::cancelWriting(const QList<ItemInfo>& infos)
 {
     QMutexLocker lock(&mutex);
 
@@ -27,9 +27,12 @@
 
 // Qt includes
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMutex>
 #include <QSet>
 #include <QTimer>
+#include <QWaitCondition>
 
 // Local includes
 
@@ -158,11 +161,24 @@ public:
 
     bool isActive() const;
 
-    /// db worker will send info to file worker if returns true
-    bool shallSendForWriting(qlonglong id);
+    /// db worker will send info to file worker if returns true.
+    /// If the item is already scheduled and not yet written, the components
+    /// given by flags are merged with the scheduled ones.
+    bool shallSendForWriting(qlonglong id, int flags);
 
-    /// file worker calls this when receiving a task
-    void startingToWrite(const QList<ItemInfo>& infos);
+    /// file worker calls this before writing the metadata of an item. Waits a moment
+    /// for further changes of the item and for the end of other writes to the same file.
+    /// Returns the components to write, merged with all changes scheduled meanwhile.
+    int  startingToWrite(const ItemInfo& info, int flags);
+
+    /// file worker calls this before changing a file without the scheduled components, as for rotation
+    void lockFileForWriting(qlonglong id);
+
+    /// file worker calls this when a file is written
+    void finishedWriting(qlonglong id);
+
+    /// file worker calls this for the items of a task it stops before writing them
+    void cancelWriting(const QList<ItemInfo>& infos);
 
     void connectToDatabaseWorker();
     void connectDatabaseToFileWorker();
@@ -178,7 +194,11 @@ public Q_SLOTS:
 
 public:
 
-    QSet<qlonglong>                       scheduledToWrite;
+    /// item id -> components to write, and time of the first change
+    QHash<qlonglong, QPair<int, qint64> > scheduledToWrite;
+    QSet<qlonglong>                       writing;
+    QElapsedTimer                         writeClock;
+    QWaitCondition                        writeFinished;
     QString                               dbMessage;
     QString                               writerMessage;
     QMutex                                mutex;
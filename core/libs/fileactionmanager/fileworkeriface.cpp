@@ -54,6 +54,8 @@ void FileActionMngrFileWorker::writeOrientationToFiles(FileActionItemInfoList in
             break;
         }
 
+        d->lockFileForWriting(info.id());
+
         QString path                  = info.filePath();
         DMetadata metadata(path);
         DMetadata::ImageOrientation o = (DMetadata::ImageOrientation)orientation;
@@ -70,6 +72,8 @@ void FileActionMngrFileWorker::writeOrientationToFiles(FileActionItemInfoList in
             ItemAttributesWatch::instance()->fileMetadataChanged(url);
         }
 
+        d->finishedWriting(info.id());
+
         infos.writtenToOne();
     }
 
@@ -83,19 +87,23 @@ void FileActionMngrFileWorker::writeOrientationToFiles(FileActionItemInfoList in
 
 void FileActionMngrFileWorker::writeMetadataToFiles(FileActionItemInfoList infos)
 {
-    d->startingToWrite(infos);
-
     ScanController::instance()->suspendCollectionScan();
 
-    foreach (const ItemInfo& info, infos)
+    for (int i = 0 ; i < infos.size() ; ++i)
     {
         MetadataHub hub;
 
         if (state() == WorkerObject::Deactivating)
         {
+            // the remaining items are not written, they can be scheduled again
+            d->cancelWriting(infos.mid(i));
             break;
         }
 
+        const ItemInfo& info = infos.at(i);
+
+        d->startingToWrite(info, MetadataHub::WRITE_ALL);
+
         hub.load(info);
         QString filePath = info.filePath();
 
@@ -109,6 +117,8 @@ void FileActionMngrFileWorker::writeMetadataToFiles(FileActionItemInfoList infos
             writeScope.changed(hub.write(filePath, MetadataHub::WRITE_ALL));
         }
 
+        d->finishedWriting(info.id());
+
         // hub emits fileMetadataChanged
         infos.writtenToOne();
     }
@@ -120,31 +130,38 @@ void FileActionMngrFileWorker::writeMetadataToFiles(FileActionItemInfoList infos
 
 void FileActionMngrFileWorker::writeMetadata(FileActionItemInfoList infos, int flags)
 {
-    d->startingToWrite(infos);
-
     ScanController::instance()->suspendCollectionScan();
 
-    foreach (const ItemInfo& info, infos)
+    for (int i = 0 ; i < infos.size() ; ++i)
     {
         MetadataHub hub;
 
         if (state() == WorkerObject::Deactivating)
         {
+            // the remaining items are not written, they can be scheduled again
+            d->cancelWriting(infos.mid(i));
             break;
         }
 
+        const ItemInfo& info = infos.at(i);
+
+        // all changes of the item scheduled meanwhile are written at once
+        int components = d->startingToWrite(info, flags);
+
         hub.load(info);
         // apply to file metadata
         if (MetaEngineSettings::instance()->settings().useLazySync)
         {
-            hub.writeToMetadata(info, (MetadataHub::WriteComponents)flags);
+            hub.writeToMetadata(info, (MetadataHub::WriteComponents)components);
         }
         else
         {
             ScanController::FileMetadataWrite writeScope(info);
-            writeScope.changed(hub.writeToMetadata(info, (MetadataHub::WriteComponents)flags));
+            writeScope.changed(hub.writeToMetadata(info, (MetadataHub::WriteComponents)components));
         }
 
+        d->finishedWriting(info.id());
+
         // hub emits fileMetadataChanged
         infos.writtenToOne();
     }
@@ -156,8 +173,6 @@ void FileActionMngrFileWorker::writeMetadata(FileActionItemInfoList infos, int f
 
 void FileActionMngrFileWorker::transform(FileActionItemInfoList infos, int action)
 {
-    d->startingToWrite(infos);
-
     QStringList failedItems;
     ScanController::instance()->suspendCollectionScan();
 
@@ -168,6 +183,8 @@ void FileActionMngrFileWorker::transform(FileActionItemInfoList infos, int actio
             break;
         }
 
+        d->lockFileForWriting(info.id());
+
         QString path                                    = info.filePath();
         QString format                                  = info.format();
         MetaEngine::ImageOrientation currentOrientation = (MetaEngine::ImageOrientation)info.orientation();
@@ -297,6 +314,8 @@ void FileActionMngrFileWorker::transform(FileActionItemInfoList infos, int actio
             ItemAttributesWatch::instance()->fileMetadataChanged(info.fileUrl());
         }
 
+        d->finishedWriting(info.id());
+
         infos.writtenToOne();
     }
 
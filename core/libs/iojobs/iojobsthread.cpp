@@ -65,6 +65,7 @@ IOJobsThread::IOJobsThread(QObject* const parent)
       d(new Private)
 {
     setObjectName(QLatin1String("IOJobsThread"));
+    setJobsPriority(ThreadScheduler::Interactive);
 }
 
 IOJobsThread::~IOJobsThread()
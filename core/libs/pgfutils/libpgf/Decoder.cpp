@@ -80,15 +80,17 @@
 /// @param userDataPos The stream position of the user data (metadata)
 /// @param useOMP If true, then the decoder will use multi-threading based on openMP
 /// @param userDataPolicy Policy of user data (meta-data) handling while reading PGF headers.
+/// @param runner If not null and openMP is not available, then the decoder will use multi-threading based on this runner
 CDecoder::CDecoder(CPGFStream* stream, PGFPreHeader& preHeader, PGFHeader& header, 
 				   PGFPostHeader& postHeader, UINT32*& levelLength, UINT64& userDataPos,
-				   bool useOMP, UINT32 userDataPolicy)
+				   bool useOMP, UINT32 userDataPolicy, CPGFParallelRunner* runner)
 : m_stream(stream)
 , m_startPos(0)
 , m_streamSizeEstimation(0)
 , m_encodedHeaderLength(0)
 , m_currentBlockIndex(0)
 , m_macroBlocksAvailable(0)
+, m_runner(runner)
 #ifdef __PGFROISUPPORT__
 , m_roi(false)
 #endif
@@ -215,7 +217,7 @@ CDecoder::CDecoder(CPGFStream* stream, PGFPreHeader& preHeader, PGFHeader& heade
 #ifdef LIBPGF_USE_OPENMP 
 	m_macroBlockLen = omp_get_num_procs();
 #else
-	m_macroBlockLen = 1;
+	m_macroBlockLen = m_runner ? m_runner->ThreadCount() : 1;
 #endif
 
 	if (useOMP && m_macroBlockLen > 1) {
@@ -528,10 +530,19 @@ void CDecoder::DecodeBuffer() {
 #ifdef LIBPGF_USE_OPENMP
 		// decode in parallel
 		#pragma omp parallel for default(shared) //no declared exceptions in next block
-#endif
 		for (int i=0; i < m_macroBlocksAvailable; i++) {
 			m_macroBlocks[i]->BitplaneDecode();
 		}
+#else
+		if (m_runner) {
+			// decode in parallel
+			m_runner->ParallelFor(m_macroBlocksAvailable, BitplaneDecodeMacroBlock, m_macroBlocks);
+		} else {
+			for (int i=0; i < m_macroBlocksAvailable; i++) {
+				m_macroBlocks[i]->BitplaneDecode();
+			}
+		}
+#endif
 		
 		// prepare current macro block
 		m_currentBlockIndex = 0;
@@ -539,6 +550,13 @@ void CDecoder::DecodeBuffer() {
 	}
 }
 
+//////////////////////////////////////////////////////////////////////
+// Decodes the macro block at given index of the macro blocks array.
+// Called by the parallel runner.
+void CDecoder::BitplaneDecodeMacroBlock(void* macroBlocks, int index) {
+	static_cast<CMacroBlock**>(macroBlocks)[index]->BitplaneDecode();
+}
+
 //////////////////////////////////////////////////////////////////////
 // Reads next block from stream and stores it in the given macro block
 // It might throw an IOException.
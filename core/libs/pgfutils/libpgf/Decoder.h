@@ -102,9 +102,10 @@ public:
 	/// @param userDataPos The stream position of the user data (metadata)
 	/// @param useOMP If true, then the decoder will use multi-threading based on openMP
 	/// @param userDataPolicy Policy of user data (meta-data) handling while reading PGF headers.
+	/// @param runner If not null and openMP is not available, then the decoder will use multi-threading based on this runner
 	CDecoder(CPGFStream* stream, PGFPreHeader& preHeader, PGFHeader& header,
 		     PGFPostHeader& postHeader, UINT32*& levelLength, UINT64& userDataPos, 
-			 bool useOMP, UINT32 userDataPolicy); // throws IOException
+			 bool useOMP, UINT32 userDataPolicy, CPGFParallelRunner* runner = nullptr); // throws IOException
 
 	/////////////////////////////////////////////////////////////////////
 	/// Destructor
@@ -198,6 +199,7 @@ public:
 
 private:
 	void ReadMacroBlock(CMacroBlock* block); ///< throws IOException
+	static void BitplaneDecodeMacroBlock(void* macroBlocks, int index);
 
 	CPGFStream *m_stream;						///< input PGF stream
 	UINT64 m_startPos;							///< stream position at the beginning of the PGF pre-header
@@ -209,6 +211,7 @@ private:
 	int	m_macroBlockLen;						///< array length
 	int	m_macroBlocksAvailable;					///< number of decoded macro blocks (including currently used macro block)
 	CMacroBlock *m_currentBlock;				///< current macro block (used by main thread)
+	CPGFParallelRunner *m_runner;				///< external threads used instead of OpenMP
 
 #ifdef __PGFROISUPPORT__
 	bool   m_roi;								///< true: ensures region of interest (ROI) decoding
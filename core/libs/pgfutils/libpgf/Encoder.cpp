@@ -67,9 +67,11 @@
 /// @param postHeader [in] An already filled in PGF post-header (containing color table, user data, ...)
 /// @param userDataPos [out] File position of user data
 /// @param useOMP If true, then the encoder will use multi-threading based on openMP
-CEncoder::CEncoder(CPGFStream* stream, PGFPreHeader preHeader, PGFHeader header, const PGFPostHeader& postHeader, UINT64& userDataPos, bool useOMP)
+/// @param runner If not null and openMP is not available, then the encoder will use multi-threading based on this runner
+CEncoder::CEncoder(CPGFStream* stream, PGFPreHeader preHeader, PGFHeader header, const PGFPostHeader& postHeader, UINT64& userDataPos, bool useOMP, CPGFParallelRunner* runner)
 : m_stream(stream)
 , m_bufferStartPos(0)
+, m_runner(runner)
 , m_currLevelIndex(0)
 , m_nLevels(header.nLevels)
 , m_favorSpeed(false)
@@ -88,7 +90,7 @@ CEncoder::CEncoder(CPGFStream* stream, PGFPreHeader preHeader, PGFHeader header,
 #ifdef LIBPGF_USE_OPENMP
 	m_macroBlockLen = omp_get_num_procs();
 #else
-	m_macroBlockLen = 1;
+	m_macroBlockLen = m_runner ? m_runner->ThreadCount() : 1;
 #endif
 	
 	if (useOMP && m_macroBlockLen > 1) {
@@ -382,10 +384,18 @@ void CEncoder::EncodeBuffer(ROIBlockHeader h) {
 			*/
 #ifdef LIBPGF_USE_OPENMP
 			#pragma omp parallel for default(shared) //no declared exceptions in next block
-#endif
 			for (int i=0; i < m_lastMacroBlock; i++) {
 				m_macroBlocks[i]->BitplaneEncode();
 			}
+#else
+			if (m_runner) {
+				m_runner->ParallelFor(m_lastMacroBlock, BitplaneEncodeMacroBlock, m_macroBlocks);
+			} else {
+				for (int i=0; i < m_lastMacroBlock; i++) {
+					m_macroBlocks[i]->BitplaneEncode();
+				}
+			}
+#endif
 			for (int i=0; i < m_lastMacroBlock; i++) {
 				WriteMacroBlock(m_macroBlocks[i]);
 			}
@@ -400,6 +410,13 @@ void CEncoder::EncodeBuffer(ROIBlockHeader h) {
 	}
 }
 
+/////////////////////////////////////////////////////////////////////
+// Encode the macro block at given index of the macro blocks array.
+// Called by the parallel runner.
+void CEncoder::BitplaneEncodeMacroBlock(void* macroBlocks, int index) {
+	static_cast<CMacroBlock**>(macroBlocks)[index]->BitplaneEncode();
+}
+
 /////////////////////////////////////////////////////////////////////
 // Write encoded macro block into stream.
 // It might throw an IOException.
@@ -111,8 +111,9 @@ public:
 	/// @param postHeader [in] An already filled in PGF post-header (containing color table, user data, ...)
 	/// @param userDataPos [out] File position of user data
 	/// @param useOMP If true, then the encoder will use multi-threading based on openMP
+	/// @param runner If not null and openMP is not available, then the encoder will use multi-threading based on this runner
 	CEncoder(CPGFStream* stream, PGFPreHeader preHeader, PGFHeader header, const PGFPostHeader& postHeader, 
-		UINT64& userDataPos, bool useOMP); // throws IOException
+		UINT64& userDataPos, bool useOMP, CPGFParallelRunner* runner = nullptr); // throws IOException
 
 	/////////////////////////////////////////////////////////////////////
 	/// Destructor
@@ -211,6 +212,7 @@ public:
 private:
 	void EncodeBuffer(ROIBlockHeader h); // throws IOException
 	void WriteMacroBlock(CMacroBlock* block); // throws IOException
+	static void BitplaneEncodeMacroBlock(void* macroBlocks, int index);
 
 	CPGFStream *m_stream;						///< output PMF stream
 	UINT64	m_startPosition;					///< stream position of PGF start (PreHeader)
@@ -221,6 +223,7 @@ private:
 	int		m_macroBlockLen;					///< array length
 	int		m_lastMacroBlock;					///< array index of the last created macro block
 	CMacroBlock *m_currentBlock;				///< current macro block (used by main thread)
+	CPGFParallelRunner *m_runner;				///< external threads used instead of OpenMP
 
 	UINT32* m_levelLength;						///< temporary saves the level index
 	int     m_currLevelIndex;					///< counts where (=index) to save next value
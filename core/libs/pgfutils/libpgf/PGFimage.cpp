@@ -83,6 +83,7 @@ void CPGFImage::Init() {
 	m_favorSpeedOverSize = false;
 	m_useOMPinEncoder = true;
 	m_useOMPinDecoder = true;
+	m_runner = nullptr;
 	m_cb = nullptr;
 	m_cbArg = nullptr;
 	m_progressMode = PM_Relative;
@@ -143,7 +144,7 @@ void CPGFImage::Open(CPGFStream *stream) {
 
 	// create decoder and read PGFPreHeader PGFHeader PGFPostHeader LevelLengths
 	m_decoder = new CDecoder(stream, m_preHeader, m_header, m_postHeader, m_levelLength, 
-		m_userDataPos, m_useOMPinDecoder, m_userDataPolicy);
+		m_userDataPos, m_useOMPinDecoder, m_userDataPolicy, m_runner);
 
 	if (m_header.nLevels > MaxLevel) ReturnWithError(FormatCannotRead);
 
@@ -1035,7 +1036,7 @@ UINT32 CPGFImage::WriteHeader(CPGFStream* stream) {
 		m_currentLevel = m_header.nLevels;
 
 		// create encoder, write headers and user data, but not level-length area
-		m_encoder = new CEncoder(stream, m_preHeader, m_header, m_postHeader, m_userDataPos, m_useOMPinEncoder);
+		m_encoder = new CEncoder(stream, m_preHeader, m_header, m_postHeader, m_userDataPos, m_useOMPinEncoder, m_runner);
 		if (m_favorSpeedOverSize) m_encoder->FavorSpeedOverSize();
 
 	#ifdef __PGFROISUPPORT__
@@ -1049,7 +1050,7 @@ UINT32 CPGFImage::WriteHeader(CPGFStream* stream) {
 		// very small image: we don't use DWT and encoding
 
 		// create encoder, write headers and user data, but not level-length area
-		m_encoder = new CEncoder(stream, m_preHeader, m_header, m_postHeader, m_userDataPos, m_useOMPinEncoder);
+		m_encoder = new CEncoder(stream, m_preHeader, m_header, m_postHeader, m_userDataPos, m_useOMPinEncoder, m_runner);
 	}
 
 	INT64 nBytes = m_encoder->ComputeHeaderLength();
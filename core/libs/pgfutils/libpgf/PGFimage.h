@@ -259,6 +259,12 @@ public:
 	/// @param prefixSize Is only used in combination with UP_CachePrefix. It defines the number of bytes cached.
 	void ConfigureDecoder(bool useOMP = true, UserdataPolicy policy = UP_CacheAll, UINT32 prefixSize = 0) { ASSERT(prefixSize <= MaxUserDataSize);  m_useOMPinDecoder = useOMP; m_userDataPolicy = (UP_CachePrefix) ? prefixSize : 0xFFFFFFFF - policy; }
 
+	/////////////////////////////////////////////////////////////////////
+	/// Sets the threads used by encoder and decoder when the codec has been compiled without OpenMP support.
+	/// Parallel processing is still controlled by ConfigureEncoder() and ConfigureDecoder().
+	/// @param runner An external thread pool, or null to encode and decode in the calling thread. The runner is not owned.
+	void SetParallelRunner(CPGFParallelRunner* runner) { m_runner = runner; }
+
 	////////////////////////////////////////////////////////////////////
 	/// Reset stream position to start of PGF pre-header or start of data. Must not be called before Open() or before Write(). 
 	/// Use this method after Read() if you want to read the same image several times, e.g. reading different ROIs.
@@ -536,6 +542,7 @@ protected:
 	bool m_favorSpeedOverSize;		///< favor encoding speed over compression ratio
 	bool m_useOMPinEncoder;			///< use Open MP in encoder
 	bool m_useOMPinDecoder;			///< use Open MP in decoder
+	CPGFParallelRunner* m_runner;	///< external threads used instead of Open MP
 #ifdef __PGFROISUPPORT__
 	bool m_streamReinitialized;		///< stream has been reinitialized
 	PGFRect m_roi;					///< region of interest
@@ -628,4 +628,25 @@ __inline UINT64 ByteSwap(UINT64 ui64) {
 #include <omp.h>
 #endif
 
+//-------------------------------------------------------------------------------
+// Parallel loops without OpenMP
+//-------------------------------------------------------------------------------
+/// Runs independent loop iterations on threads provided by the application.
+/// Used by the encoder and decoder to process macro blocks in parallel when
+/// libpgf is compiled without OpenMP support.
+/// @brief External thread pool interface
+class CPGFParallelRunner {
+public:
+	typedef void (*BodyPtr)(void* context, int index);
+
+	virtual ~CPGFParallelRunner() {}
+
+	/// @return The maximum number of iterations run at the same time.
+	virtual int ThreadCount() const = 0;
+
+	/// Calls body(context, i) for all i in [0, count) and returns when all calls are done.
+	/// The body does not throw exceptions.
+	virtual void ParallelFor(int count, BodyPtr body, void* context) = 0;
+};
+
 #endif //PGF_PGFPLATFORM_H
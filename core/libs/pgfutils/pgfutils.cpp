@@ -35,9 +35,11 @@ extern "C"
 
 // Qt includes
 
+#include <QAtomicInt>
 #include <QImage>
 #include <QByteArray>
 #include <QFile>
+#include <QThread>
 #include <qplatformdefs.h>
 
 // Windows includes
@@ -53,6 +55,7 @@ extern "C"
 // Local includes
 
 #include "digikam_debug.h"
+#include "threadscheduler.h"
 
 namespace Digikam
 {
@@ -60,6 +63,75 @@ namespace Digikam
 namespace PGFUtils
 {
 
+/**
+ * Runs libpgf macro blocks encoding and decoding on the ThreadScheduler workers.
+ * The calling thread processes blocks too: a caller running in a worker
+ * never waits for blocks which cannot be started.
+ */
+class Q_DECL_HIDDEN PGFParallelRunner : public CPGFParallelRunner
+{
+public:
+
+    explicit PGFParallelRunner()
+    {
+    }
+
+    int ThreadCount() const
+    {
+        return ThreadScheduler::instance()->maximumThreadCount();
+    }
+
+    void ParallelFor(int count, BodyPtr body, void* context)
+    {
+        QAtomicInt next(0);
+        ThreadSchedulerTasks tasks;
+
+        for (int i = 1 ; i < qMin(count, ThreadCount()) ; ++i)
+        {
+            tasks.run(std::bind(&PGFParallelRunner::runBodies, count, body, context, &next));
+        }
+
+        runBodies(count, body, context, &next);
+
+        tasks.waitForDone();
+    }
+
+    static void runBodies(int count, BodyPtr body, void* context, QAtomicInt* next)
+    {
+        int index;
+
+        while ((index = next->fetchAndAddOrdered(1)) < count)
+        {
+            body(context, index);
+        }
+    }
+};
+
+Q_GLOBAL_STATIC(PGFParallelRunner, parallelRunner)
+
+static QAtomicInt parallelCodec(1);
+
+void setParallelCodec(bool enable)
+{
+    parallelCodec.storeRelease(enable ? 1 : 0);
+}
+
+bool isParallelCodec()
+{
+    return parallelCodec.loadAcquire();
+}
+
+/// Return the runner to use with libpgf, or null to encode and decode in the calling thread.
+static CPGFParallelRunner* currentRunner()
+{
+    if (!isParallelCodec() || (QThread::idealThreadCount() < 2))
+    {
+        return 0;
+    }
+
+    return parallelRunner();
+}
+
 // Private method
 bool writePGFImageDataToStream(const QImage& image,
                                CPGFStream& stream,
@@ -86,7 +158,10 @@ bool readPGFImageData(const QByteArray& data,
 
         CPGFImage pgfImg;
         // NOTE: see bug #273765 : Loading PGF thumbs with OpenMP support through a separated thread do not work properly with libppgf 6.11.24
-        pgfImg.ConfigureDecoder(false);
+        // OpenMP is disabled, parallel decoding uses our own thread pool.
+        CPGFParallelRunner* const runner = currentRunner();
+        pgfImg.ConfigureDecoder(runner != 0);
+        pgfImg.SetParallelRunner(runner);
 
         pgfImg.Open(&stream);
 
@@ -294,7 +369,10 @@ bool writePGFImageDataToStream(const QImage& image,
         pgfImg.SetHeader(header);
 
         // NOTE: see bug #273765 : Loading PGF thumbs with OpenMP support through a separated thread do not work properly with libppgf 6.11.24
-        pgfImg.ConfigureEncoder(false);
+        // OpenMP is disabled, parallel encoding uses our own thread pool.
+        CPGFParallelRunner* const runner = currentRunner();
+        pgfImg.ConfigureEncoder(runner != 0);
+        pgfImg.SetParallelRunner(runner);
 
         if (verbose)
         {
@@ -407,6 +485,9 @@ bool loadPGFScaled(QImage& img, const QString& path, int maximumSize)
     {
         CPGFFileStream stream(fd);
         CPGFImage      pgf;
+        CPGFParallelRunner* const runner = currentRunner();
+        pgf.ConfigureDecoder(runner != 0);
+        pgf.SetParallelRunner(runner);
         pgf.Open(&stream);
 
         // Try to find the right PGF level to get reduced image accordingly
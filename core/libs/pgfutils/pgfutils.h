@@ -82,6 +82,15 @@ DIGIKAM_EXPORT bool loadPGFScaled(QImage& img,
                                   const QString& path,
                                   int maximumSize);
 
+/**
+ * Enable or disable multithreaded encoding and decoding of PGF data. If enabled,
+ * macro blocks are processed in parallel on a thread pool shared by all callers.
+ * libpgf is built without OpenMP, this is the only way to use several cores per image.
+ * Enabled by default. Encoded data are identical in both modes.
+ */
+DIGIKAM_EXPORT void setParallelCodec(bool enable);
+DIGIKAM_EXPORT bool isParallelCodec();
+
 /**
  * Return a libpgf version string
  */
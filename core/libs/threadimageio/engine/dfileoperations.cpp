@@ -522,4 +522,27 @@ bool DFileOperations::copyFile(const QString& srcFile,
     return ret;
 }
 
+bool DFileOperations::setModificationTime(const QString& filePath,
+                                          const QDateTime& dateTime)
+{
+    // Since QFileInfo does not support timestamp updates,
+    // we have to use the utime() system call.
+
+    int modtime;
+    QDateTime unixDate;
+    unixDate.setDate(QDate(1970, 1, 1));
+    unixDate.setTime(QTime(0, 0, 0, 0));
+
+    if (dateTime < unixDate)
+        modtime = -(dateTime.secsTo(unixDate) + (60 * 60));
+    else
+        modtime = dateTime.toTime_t();
+
+    struct utimbuf ut;
+    ut.modtime = modtime;
+    ut.actime  = QDateTime::currentDateTime().toTime_t();
+
+    return (::utime(QFile::encodeName(filePath).constData(), &ut) == 0);
+}
+
 } // namespace Digikam
@@ -26,6 +26,7 @@
 
 // Qt includes
 
+#include <QDateTime>
 #include <QString>
 #include <QStringList>
 #include <QUrl>
@@ -96,6 +97,11 @@ public:
      */
     static bool copyFile(const QString& srcFile,
                          const QString& dstFile);
+
+    /** Set the file modification time, the access time is set to now.
+     */
+    static bool setModificationTime(const QString& filePath,
+                                    const QDateTime& dateTime);
 };
 
 } // namespace Digikam
@@ -449,6 +449,29 @@ void ManagedLoadSaveThread::prependThumbnailGroup(const QList<LoadingDescription
     start(lock);
 }
 
+void ManagedLoadSaveThread::removeThumbnailGroup(const QList<LoadingDescription>& descriptions)
+{
+    // This method removes the waiting loading tasks of the group, the current task is left running.
+
+    if (descriptions.isEmpty())
+    {
+        return;
+    }
+
+    QMutexLocker lock(threadMutex());
+
+    for (int i = 0 ; i < descriptions.size() ; ++i)
+    {
+        LoadingTask* const existingTask = findExistingTask(descriptions.at(i));
+
+        if (existingTask && existingTask != m_currentTask)
+        {
+            m_todo.removeAll(existingTask);
+            delete existingTask;
+        }
+    }
+}
+
 LoadingTask* ManagedLoadSaveThread::createLoadingTask(const LoadingDescription& description,
                                                       bool preloading, LoadingMode loadingMode,
                                                       AccessMode accessMode)
@@ -153,6 +153,7 @@ protected:
     void preloadThumbnail(const LoadingDescription& description);
     void preloadThumbnailGroup(const QList<LoadingDescription>& descriptions);
     void prependThumbnailGroup(const QList<LoadingDescription>& descriptions);
+    void removeThumbnailGroup(const QList<LoadingDescription>& descriptions);
 
 protected:
 
@@ -44,29 +44,28 @@ void SharedLoadSaveThread::load(const LoadingDescription& description, AccessMod
 
 DImg SharedLoadSaveThread::cacheLookup(const QString& filePath, AccessMode /*accessMode*/)
 {
-    LoadingCache* cache = LoadingCache::cache();
-    LoadingCache::CacheLock lock(cache);
-    DImg* cachedImg     = cache->retrieveImage(filePath);
+    // The image store has its own locking, no CacheLock is needed for a lookup.
+    DImg cachedImg = LoadingCache::cache()->retrieveImage(filePath);
 
     // Qt4: uncomment this code.
     // See comments in SharedLoadingTask::execute for explanation.
 
 /*
-    if (cachedImg)
+    if (!cachedImg.isNull())
     {
         if (accessMode == AccessModeReadWrite)
-            return cachedImg->copy();
+            return cachedImg.copy();
         else
-            return *cachedImg;
+            return cachedImg;
     }
     else
     {
         return DImg();
     }
 */
-    if (cachedImg)
+    if (!cachedImg.isNull())
     {
-        return cachedImg->copy();
+        return cachedImg.copy();
     }
     else
     {
@@ -27,7 +27,6 @@
 
 #include <QCoreApplication>
 #include <QEvent>
-#include <QCache>
 #include <QMap>
 
 // Local includes
@@ -46,7 +45,10 @@ class Q_DECL_HIDDEN LoadingCache::Private
 public:
 
     explicit Private(LoadingCache* const q)
-        : q(q)
+        : imageCache(4),            // few, large entries
+          thumbnailImageCache(16),  // shared by all thumbnail threads
+          thumbnailPixmapCache(1),  // main thread only
+          q(q)
     {
         // Note: Don't make the mutex recursive, we need to use a wait condition on it
         watch = 0;
@@ -60,11 +62,15 @@ public:
 
 public:
 
-    QCache<QString, DImg>           imageCache;
-    QCache<QString, QImage>         thumbnailImageCache;
-    QCache<QString, QPixmap>        thumbnailPixmapCache;
+    LoadingCacheStore<DImg>         imageCache;
+    LoadingCacheStore<QImage>       thumbnailImageCache;
+    LoadingCacheStore<QPixmap>      thumbnailPixmapCache;
+
+    /// Protects the file path hashes and the file watch, independently from the CacheLock
+    QMutex                          filePathMutex;
     QMultiMap<QString, QString>     imageFilePathHash;
     QMultiMap<QString, QString>     thumbnailFilePathHash;
+
     QMap<QString, LoadingProcess*>  loadingDict;
     QMutex                          mutex;
     QWaitCondition                  condVar;
@@ -74,10 +80,14 @@ public:
 
 LoadingCacheFileWatch* LoadingCache::Private::fileWatch() const
 {
+    // filePathMutex is held by the caller
+
     // install default watch if no watch is set yet
     if (!watch)
     {
-        q->setFileWatch(new ClassicLoadingCacheFileWatch);
+        LoadingCacheFileWatch* const defaultWatch = new ClassicLoadingCacheFileWatch;
+        defaultWatch->m_cache                     = q;
+        const_cast<Private*>(this)->watch         = defaultWatch;
     }
 
     return watch;
@@ -85,7 +95,7 @@ LoadingCacheFileWatch* LoadingCache::Private::fileWatch() const
 
 void LoadingCache::Private::mapImageFilePath(const QString& filePath, const QString& cacheKey)
 {
-    if (imageFilePathHash.size() > 5*imageCache.size())
+    if (imageFilePathHash.size() > 5*imageCache.count())
     {
         cleanUpImageFilePathHash();
     }
@@ -95,7 +105,7 @@ void LoadingCache::Private::mapImageFilePath(const QString& filePath, const QStr
 
 void LoadingCache::Private::mapThumbnailFilePath(const QString& filePath, const QString& cacheKey)
 {
-    if (thumbnailFilePathHash.size() > 5*(thumbnailImageCache.size() + thumbnailPixmapCache.size()))
+    if (thumbnailFilePathHash.size() > 5*(thumbnailImageCache.count() + thumbnailPixmapCache.count()))
     {
         cleanUpThumbnailFilePathHash();
     }
@@ -156,6 +166,13 @@ LoadingCache* LoadingCache::cache()
 
 void LoadingCache::cleanUp()
 {
+    if (m_instance)
+    {
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Image cache:"           << m_instance->statistics(ImageCache);
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Thumbnail image cache:" << m_instance->statistics(ThumbnailImageCache);
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Thumbnail pixmap cache:" << m_instance->statistics(ThumbnailPixmapCache);
+    }
+
     delete m_instance;
 }
 
@@ -182,18 +199,24 @@ LoadingCache::~LoadingCache()
     m_instance = 0;
 }
 
-DImg* LoadingCache::retrieveImage(const QString& cacheKey) const
+DImg LoadingCache::retrieveImage(const QString& cacheKey) const
 {
-    return d->imageCache[cacheKey];
+    DImg img;
+    d->imageCache.find(cacheKey, &img);
+    return img;
 }
 
-bool LoadingCache::putImage(const QString& cacheKey, const DImg& img, const QString& filePath) const
+bool LoadingCache::putImage(const QString& cacheKey, const DImg& img, const QString& filePath,
+                            int decodeMilliseconds) const
 {
-    int cost                 = img.numBytes();
-    bool successfulyInserted = d->imageCache.insert(cacheKey, new DImg(img), cost);
+    qint64 cost              = img.numBytes();
+    bool successfulyInserted = d->imageCache.insert(cacheKey, img, cost, decodeMilliseconds);
 
     if (successfulyInserted && !filePath.isEmpty())
     {
+        // Call the watch under the mutex: setFileWatch() may delete it once the mutex is released
+
+        QMutexLocker lock(&d->filePathMutex);
         d->mapImageFilePath(filePath, cacheKey);
         d->fileWatch()->addedImage(filePath);
     }
@@ -214,7 +237,7 @@ void LoadingCache::removeImages()
 bool LoadingCache::isCacheable(const DImg& img) const
 {
     // return whether image fits in cache
-    return (uint)d->imageCache.maxCost() >= img.numBytes();
+    return d->imageCache.maxCost() >= (qint64)img.numBytes();
 }
 
 void LoadingCache::addLoadingProcess(LoadingProcess* const process)
@@ -244,19 +267,23 @@ void LoadingCache::notifyNewLoadingProcess(LoadingProcess* const process, const
 void LoadingCache::setCacheSize(int megabytes)
 {
     qCDebug(DIGIKAM_GENERAL_LOG) << "Allowing a cache size of" << megabytes << "MB";
-    d->imageCache.setMaxCost(megabytes * 1024 * 1024);
+    d->imageCache.setMaxCost(qint64(megabytes) * 1024 * 1024);
 }
 
 // --- Thumbnails ----
 
-const QImage* LoadingCache::retrieveThumbnail(const QString& cacheKey) const
+QImage LoadingCache::retrieveThumbnail(const QString& cacheKey) const
 {
-    return d->thumbnailImageCache[cacheKey];
+    QImage thumb;
+    d->thumbnailImageCache.find(cacheKey, &thumb);
+    return thumb;
 }
 
-const QPixmap* LoadingCache::retrieveThumbnailPixmap(const QString& cacheKey) const
+QPixmap LoadingCache::retrieveThumbnailPixmap(const QString& cacheKey) const
 {
-    return d->thumbnailPixmapCache[cacheKey];
+    QPixmap thumb;
+    d->thumbnailPixmapCache.find(cacheKey, &thumb);
+    return thumb;
 }
 
 bool LoadingCache::hasThumbnailPixmap(const QString& cacheKey) const
@@ -264,12 +291,16 @@ bool LoadingCache::hasThumbnailPixmap(const QString& cacheKey) const
     return d->thumbnailPixmapCache.contains(cacheKey);
 }
 
-void LoadingCache::putThumbnail(const QString& cacheKey, const QImage& thumb, const QString& filePath)
+void LoadingCache::putThumbnail(const QString& cacheKey, const QImage& thumb, const QString& filePath,
+                                int decodeMilliseconds)
 {
-    int cost = thumb.byteCount();
+    qint64 cost = thumb.byteCount();
 
-    if (d->thumbnailImageCache.insert(cacheKey, new QImage(thumb), cost))
+    if (d->thumbnailImageCache.insert(cacheKey, thumb, cost, decodeMilliseconds))
     {
+        // Call the watch under the mutex: setFileWatch() may delete it once the mutex is released
+
+        QMutexLocker lock(&d->filePathMutex);
         d->mapThumbnailFilePath(filePath, cacheKey);
         d->fileWatch()->addedThumbnail(filePath);
     }
@@ -277,10 +308,13 @@ void LoadingCache::putThumbnail(const QString& cacheKey, const QImage& thumb, co
 
 void LoadingCache::putThumbnail(const QString& cacheKey, const QPixmap& thumb, const QString& filePath)
 {
-    int cost = thumb.width() * thumb.height() * thumb.depth() / 8;
+    qint64 cost = qint64(thumb.width()) * thumb.height() * thumb.depth() / 8;
 
-    if (d->thumbnailPixmapCache.insert(cacheKey, new QPixmap(thumb), cost))
+    if (d->thumbnailPixmapCache.insert(cacheKey, thumb, cost))
     {
+        // Call the watch under the mutex: setFileWatch() may delete it once the mutex is released
+
+        QMutexLocker lock(&d->filePathMutex);
         d->mapThumbnailFilePath(filePath, cacheKey);
         d->fileWatch()->addedThumbnail(filePath);
     }
@@ -300,32 +334,70 @@ void LoadingCache::removeThumbnails()
 
 void LoadingCache::setThumbnailCacheSize(int numberOfQImages, int numberOfQPixmaps)
 {
-    d->thumbnailImageCache.setMaxCost(numberOfQImages * ThumbnailSize::maxThumbsSize() * ThumbnailSize::maxThumbsSize() * 4);
-    d->thumbnailPixmapCache.setMaxCost(numberOfQPixmaps * ThumbnailSize::maxThumbsSize() * ThumbnailSize::maxThumbsSize() * QPixmap::defaultDepth() / 8);
+    const qint64 maxSize = ThumbnailSize::maxThumbsSize();
+    d->thumbnailImageCache.setMaxCost(numberOfQImages * maxSize * maxSize * 4);
+    d->thumbnailPixmapCache.setMaxCost(numberOfQPixmaps * maxSize * maxSize * QPixmap::defaultDepth() / 8);
+}
+
+LoadingCacheStatistics LoadingCache::statistics(CacheType type) const
+{
+    switch (type)
+    {
+        case ThumbnailImageCache:
+            return d->thumbnailImageCache.statistics();
+        case ThumbnailPixmapCache:
+            return d->thumbnailPixmapCache.statistics();
+        case ImageCache:
+        default:
+            return d->imageCache.statistics();
+    }
+}
+
+void LoadingCache::resetStatistics()
+{
+    d->imageCache.resetStatistics();
+    d->thumbnailImageCache.resetStatistics();
+    d->thumbnailPixmapCache.resetStatistics();
 }
 
 void LoadingCache::setFileWatch(LoadingCacheFileWatch* const watch)
 {
-    delete d->watch;
-    d->watch          = watch;
-    d->watch->m_cache = this;
+    LoadingCacheFileWatch* oldWatch = 0;
+
+    {
+        QMutexLocker lock(&d->filePathMutex);
+        oldWatch          = d->watch;
+        d->watch          = watch;
+        d->watch->m_cache = this;
+    }
+
+    delete oldWatch;
 }
 
 QStringList LoadingCache::imageFilePathsInCache() const
 {
+    QMutexLocker lock(&d->filePathMutex);
     d->cleanUpImageFilePathHash();
     return d->imageFilePathHash.uniqueKeys();
 }
 
 QStringList LoadingCache::thumbnailFilePathsInCache() const
 {
+    QMutexLocker lock(&d->filePathMutex);
     d->cleanUpThumbnailFilePathHash();
     return d->thumbnailFilePathHash.uniqueKeys();
 }
 
 void LoadingCache::notifyFileChanged(const QString& filePath, bool notify)
 {
-    QList<QString> keys = d->imageFilePathHash.values(filePath);
+    QList<QString> keys;
+    QList<QString> thumbnailKeys;
+
+    {
+        QMutexLocker lock(&d->filePathMutex);
+        keys          = d->imageFilePathHash.values(filePath);
+        thumbnailKeys = d->thumbnailFilePathHash.values(filePath);
+    }
 
     foreach (const QString& cacheKey, keys)
     {
@@ -335,9 +407,7 @@ void LoadingCache::notifyFileChanged(const QString& filePath, bool notify)
         }
     }
 
-    keys = d->thumbnailFilePathHash.values(filePath);
-
-    foreach (const QString& cacheKey, keys)
+    foreach (const QString& cacheKey, thumbnailKeys)
     {
         bool removedImage  = d->thumbnailImageCache.remove(cacheKey);
         bool removedPixmap = d->thumbnailPixmapCache.remove(cacheKey);
@@ -372,7 +442,7 @@ LoadingCacheFileWatch::~LoadingCacheFileWatch()
 {
     if (m_cache)
     {
-        LoadingCache::CacheLock lock(m_cache);
+        QMutexLocker lock(&m_cache->d->filePathMutex);
 
         if (m_cache->d->watch == this)
         {
@@ -34,6 +34,7 @@
 
 #include "dimg.h"
 #include "loadsavethread.h"
+#include "loadingcachestore.h"
 #include "digikam_export.h"
 
 namespace Digikam
@@ -74,7 +75,8 @@ class DIGIKAM_EXPORT LoadingCacheFileWatch
 public:
 
     virtual ~LoadingCacheFileWatch();
-    /// Called by the thread when a new entry is added to the cache
+    /// Called by the thread when a new entry is added to the cache.
+    /// The file path mutex of the cache is held: do not call back into the cache.
     virtual void addedImage(const QString& filePath);
     virtual void addedThumbnail(const QString& filePath);
 
@@ -137,7 +139,23 @@ public:
     static void cleanUp();
     virtual ~LoadingCache();
 
-    /// !! All methods of LoadingCache shall only be called when a CacheLock is held !!
+    enum CacheType
+    {
+        ImageCache,
+        ThumbnailImageCache,
+        ThumbnailPixmapCache
+    };
+
+    /**
+     * The CacheLock serializes the management of loading processes: the methods
+     * retrieveLoadingProcess(), addLoadingProcess(), removeLoadingProcess() and
+     * notifyNewLoadingProcess() shall only be called when a CacheLock is held.
+     * A task which looks up the cache and then registers a loading process holds the
+     * lock over both steps, as does a task which puts its result and then unregisters.
+     *
+     * The cached images and thumbnails themselves are stored in lock-striped stores
+     * (see LoadingCacheStore) and can be retrieved, put and removed without the CacheLock.
+     */
 
     class DIGIKAM_EXPORT CacheLock
     {
@@ -155,9 +173,9 @@ public:
 
     /**
      * Retrieves an image for the given string from the cache,
-     * or 0 if no image is found.
+     * or a null image if no image is found.
      */
-    DImg* retrieveImage(const QString& cacheKey) const;
+    DImg retrieveImage(const QString& cacheKey) const;
 
     /// Returns whether the given DImg fits in the cache.
     bool isCacheable(const DImg& img) const;
@@ -168,8 +186,11 @@ public:
      *  When it cannot be put in the cache it is deleted.
      *  The third parameter specifies a file path that will be watched.
      *  If this file changes, the object will be removed from the cache.
+     *  The time it took to load the image is used to weight the entry
+     *  against others when making room: cheap entries are dropped first.
      */
-    bool putImage(const QString& cacheKey, const DImg& img, const QString& filePath) const;
+    bool putImage(const QString& cacheKey, const DImg& img, const QString& filePath,
+                  int decodeMilliseconds = 0) const;
 
     /**
      *  Remove entries for the given cacheKey from the cache
@@ -216,16 +237,17 @@ public:
     /// QPixmaps can only be accessed from the main thread, so the tasks cannot access this cache.
     /**
      * Retrieves a thumbnail for the given filePath from the thumbnail cache,
-     * or a 0 if the thumbnail is not found.
+     * or a null image if the thumbnail is not found.
      */
-    const QImage* retrieveThumbnail(const QString& cacheKey) const;
-    const QPixmap* retrieveThumbnailPixmap(const QString& cacheKey) const;
-    bool  hasThumbnailPixmap(const QString& cacheKey) const;
+    QImage  retrieveThumbnail(const QString& cacheKey) const;
+    QPixmap retrieveThumbnailPixmap(const QString& cacheKey) const;
+    bool    hasThumbnailPixmap(const QString& cacheKey) const;
 
     /**
      * Puts a thumbnail into the thumbnail cache.
      */
-    void putThumbnail(const QString& cacheKey, const QImage& thumb, const QString& filePath);
+    void putThumbnail(const QString& cacheKey, const QImage& thumb, const QString& filePath,
+                      int decodeMilliseconds = 0);
     void putThumbnail(const QString& cacheKey, const QPixmap& thumb, const QString& filePath);
 
     /**
@@ -253,6 +275,16 @@ public:
      */
     void setThumbnailCacheSize(int numberOfQImages, int numberOfQPixmaps);
 
+    // ------- Statistics -----------------------------------
+
+    /**
+     * Returns the hit, miss and eviction counters of the given cache
+     * since creation or the last call to resetStatistics().
+     * The counters are also written to the debug log at clean up.
+     */
+    LoadingCacheStatistics statistics(CacheType type) const;
+    void                   resetStatistics();
+
     // ------- File Watch Management -----------------------------------
 
     /**
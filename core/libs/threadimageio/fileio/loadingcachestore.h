@@ -0,0 +1,582 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : lock-striped, scan resistant storage of the loading cache
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_LOADING_CACHE_STORE_H
+#define DIGIKAM_LOADING_CACHE_STORE_H
+
+// Qt includes
+
+#include <QAtomicInteger>
+#include <QDebug>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QQueue>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace Digikam
+{
+
+/**
+ * Counters of a LoadingCacheStore, summed over all shards.
+ */
+class LoadingCacheStatistics
+{
+public:
+
+    LoadingCacheStatistics()
+        : hits(0),
+          misses(0),
+          insertions(0),
+          evictions(0),
+          rejections(0),
+          count(0),
+          totalCost(0),
+          maxCost(0)
+    {
+    }
+
+    LoadingCacheStatistics& operator+=(const LoadingCacheStatistics& other)
+    {
+        hits       += other.hits;
+        misses     += other.misses;
+        insertions += other.insertions;
+        evictions  += other.evictions;
+        rejections += other.rejections;
+        count      += other.count;
+        return *this;
+    }
+
+    /// Returns the ratio of successful lookups, between 0 and 1.
+    double hitRate() const
+    {
+        quint64 lookups = hits + misses;
+        return lookups ? (double)hits / (double)lookups : 0.0;
+    }
+
+public:
+
+    quint64 hits;
+    quint64 misses;
+    quint64 insertions;
+    /// Entries dropped to make room for new ones. Explicit removals are not counted.
+    quint64 evictions;
+    /// Entries which were larger than the whole cache.
+    quint64 rejections;
+    int     count;
+    qint64  totalCost;
+    qint64  maxCost;
+};
+
+inline QDebug operator<<(QDebug dbg, const LoadingCacheStatistics& s)
+{
+    dbg.nospace() << "hits: "        << s.hits
+                  << ", misses: "     << s.misses
+                  << ", hit rate: "   << s.hitRate()
+                  << ", insertions: " << s.insertions
+                  << ", evictions: "  << s.evictions
+                  << ", rejections: " << s.rejections
+                  << ", entries: "    << s.count
+                  << ", cost: "       << s.totalCost << "/" << s.maxCost;
+
+    return dbg.space();
+}
+
+// --------------------------------------------------------------------------------------------------------------
+
+/**
+ * A cost-limited key/value cache, safe to be used concurrently from several threads.
+ *
+ * Keys are distributed over a number of shards, each protected by its own mutex,
+ * so that lookups from different threads rarely wait for each other.
+ * The cost limit is global: a shard which cannot free enough room itself takes
+ * entries from the other shards, locking one shard at a time.
+ *
+ * Each shard follows the 2Q policy: new entries go to a probation FIFO, which
+ * is evicted first. Keys evicted from probation are remembered without their value,
+ * and only when such a key is inserted again, it enters the protected LRU segment.
+ * A quick scroll through a large album thus only recycles the probation segment
+ * and leaves the working set in the protected segment alone.
+ *
+ * Among the few least recently used candidates of a segment, the entry evicted
+ * is the one which is cheapest to recreate per byte, using the decoding time
+ * given when inserting.
+ *
+ * Values are returned by copy: use implicitly shared types.
+ */
+template <class T>
+class LoadingCacheStore
+{
+public:
+
+    explicit LoadingCacheStore(int shards = 16)
+        : m_shards(qMax(shards, 1)),
+          m_maxCost(0),
+          m_totalCost(0)
+    {
+        for (int i = 0 ; i < m_shards.size() ; ++i)
+        {
+            m_shards[i] = new Shard;
+        }
+    }
+
+    ~LoadingCacheStore()
+    {
+        clear();
+        qDeleteAll(m_shards);
+    }
+
+    void setMaxCost(qint64 maxCost)
+    {
+        m_maxCost.store(maxCost);
+
+        for (int i = 0 ; m_totalCost.load() > maxCost && i < m_shards.size() ; ++i)
+        {
+            Shard* const shard = m_shards.at(i);
+            QMutexLocker lock(&shard->mutex);
+
+            while (m_totalCost.load() > maxCost && evictOne(shard, 0))
+            {
+            }
+        }
+    }
+
+    qint64 maxCost() const
+    {
+        return m_maxCost.load();
+    }
+
+    qint64 totalCost() const
+    {
+        return m_totalCost.load();
+    }
+
+    /**
+     * Inserts value for key, replacing any previous value.
+     * Returns false if the value is larger than the whole cache. In this case,
+     * a previous value for key is removed nevertheless, as QCache does.
+     */
+    bool insert(const QString& key, const T& value, qint64 cost, int decodeMilliseconds = 0)
+    {
+        const int index    = shardIndex(key);
+        Shard* const shard = m_shards.at(index);
+
+        {
+            QMutexLocker lock(&shard->mutex);
+
+            removeEntry(shard, key);
+
+            if (cost > m_maxCost.load())
+            {
+                ++shard->stats.rejections;
+                return false;
+            }
+
+            Entry* const entry        = new Entry;
+            entry->key                = key;
+            entry->value              = value;
+            entry->cost               = cost;
+            entry->decodeMilliseconds = decodeMilliseconds;
+
+            // Only keys which were already evicted once from probation are protected.
+            entry->isProtected        = shard->ghosts.remove(key);
+
+            (entry->isProtected ? shard->protectedList : shard->probation).pushFront(entry);
+            shard->entries.insert(key, entry);
+            m_totalCost.fetchAndAddOrdered(cost);
+            ++shard->stats.insertions;
+
+            while (m_totalCost.load() > m_maxCost.load() && evictOne(shard, entry))
+            {
+            }
+        }
+
+        for (int i = 1 ; m_totalCost.load() > m_maxCost.load() && i < m_shards.size() ; ++i)
+        {
+            Shard* const other = m_shards.at((index + i) % m_shards.size());
+            QMutexLocker lock(&other->mutex);
+
+            while (m_totalCost.load() > m_maxCost.load() && evictOne(other, 0))
+            {
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Looks up key. Returns true and sets value if found.
+     * A successful lookup refreshes the entry, and lookups are counted in the statistics.
+     */
+    bool find(const QString& key, T* const value = 0)
+    {
+        Shard* const shard = m_shards.at(shardIndex(key));
+        QMutexLocker lock(&shard->mutex);
+        Entry* const entry = shard->entries.value(key);
+
+        if (!entry)
+        {
+            ++shard->stats.misses;
+            return false;
+        }
+
+        ++shard->stats.hits;
+
+        // As in 2Q, repeated accesses while in probation are correlated and do not promote.
+        if (entry->isProtected)
+        {
+            shard->protectedList.unlink(entry);
+            shard->protectedList.pushFront(entry);
+        }
+
+        if (value)
+        {
+            *value = entry->value;
+        }
+
+        return true;
+    }
+
+    /// Returns whether key is cached, without refreshing the entry or counting the lookup.
+    bool contains(const QString& key) const
+    {
+        Shard* const shard = m_shards.at(shardIndex(key));
+        QMutexLocker lock(&shard->mutex);
+        return shard->entries.contains(key);
+    }
+
+    bool remove(const QString& key)
+    {
+        Shard* const shard = m_shards.at(shardIndex(key));
+        QMutexLocker lock(&shard->mutex);
+        return removeEntry(shard, key);
+    }
+
+    void clear()
+    {
+        foreach (Shard* const shard, m_shards)
+        {
+            QMutexLocker lock(&shard->mutex);
+
+            foreach (Entry* const entry, shard->entries)
+            {
+                m_totalCost.fetchAndAddOrdered(-entry->cost);
+                delete entry;
+            }
+
+            shard->entries.clear();
+            shard->probation     = List();
+            shard->protectedList = List();
+            shard->ghosts.clear();
+            shard->ghostQueue.clear();
+        }
+    }
+
+    QStringList keys() const
+    {
+        QStringList keys;
+
+        foreach (Shard* const shard, m_shards)
+        {
+            QMutexLocker lock(&shard->mutex);
+            keys << shard->entries.keys();
+        }
+
+        return keys;
+    }
+
+    int count() const
+    {
+        int count = 0;
+
+        foreach (Shard* const shard, m_shards)
+        {
+            QMutexLocker lock(&shard->mutex);
+            count += shard->entries.size();
+        }
+
+        return count;
+    }
+
+    LoadingCacheStatistics statistics() const
+    {
+        LoadingCacheStatistics stats;
+
+        foreach (Shard* const shard, m_shards)
+        {
+            QMutexLocker lock(&shard->mutex);
+            LoadingCacheStatistics shardStats = shard->stats;
+            shardStats.count                  = shard->entries.size();
+            stats                            += shardStats;
+        }
+
+        stats.totalCost = m_totalCost.load();
+        stats.maxCost   = m_maxCost.load();
+
+        return stats;
+    }
+
+    void resetStatistics()
+    {
+        foreach (Shard* const shard, m_shards)
+        {
+            QMutexLocker lock(&shard->mutex);
+            shard->stats = LoadingCacheStatistics();
+        }
+    }
+
+private:
+
+    class Entry
+    {
+    public:
+
+        Entry()
+            : cost(0),
+              decodeMilliseconds(0),
+              isProtected(false),
+              prev(0),
+              next(0)
+        {
+        }
+
+        QString key;
+        T       value;
+        qint64  cost;
+        int     decodeMilliseconds;
+        bool    isProtected;
+        Entry*  prev;
+        Entry*  next;
+    };
+
+    /// Intrusive list, most recent entry first. Does not own the entries.
+    class List
+    {
+    public:
+
+        List()
+            : head(0),
+              tail(0),
+              cost(0)
+        {
+        }
+
+        void pushFront(Entry* const entry)
+        {
+            entry->prev = 0;
+            entry->next = head;
+
+            if (head)
+            {
+                head->prev = entry;
+            }
+            else
+            {
+                tail = entry;
+            }
+
+            head  = entry;
+            cost += entry->cost;
+        }
+
+        void unlink(Entry* const entry)
+        {
+            if (entry->prev)
+            {
+                entry->prev->next = entry->next;
+            }
+            else
+            {
+                head = entry->next;
+            }
+
+            if (entry->next)
+            {
+                entry->next->prev = entry->prev;
+            }
+            else
+            {
+                tail = entry->prev;
+            }
+
+            entry->prev = 0;
+            entry->next = 0;
+            cost       -= entry->cost;
+        }
+
+        Entry* head;
+        Entry* tail;
+        qint64 cost;
+    };
+
+    class Shard
+    {
+    public:
+
+        Shard()
+            : ghostSerial(0)
+        {
+        }
+
+        QMutex                            mutex;
+        QHash<QString, Entry*>            entries;
+        List                              probation;
+        List                              protectedList;
+
+        /// Keys recently evicted from probation, with the serial of their last eviction.
+        QHash<QString, quint64>           ghosts;
+        QQueue<QPair<QString, quint64> >  ghostQueue;
+        quint64                           ghostSerial;
+
+        LoadingCacheStatistics            stats;
+    };
+
+    /// Number of least recently used entries compared when choosing a victim.
+    enum
+    {
+        EvictionCandidates = 4
+    };
+
+private:
+
+    int shardIndex(const QString& key) const
+    {
+        return qHash(key) % (uint)m_shards.size();
+    }
+
+    bool removeEntry(Shard* const shard, const QString& key)
+    {
+        Entry* const entry = shard->entries.take(key);
+
+        if (!entry)
+        {
+            return false;
+        }
+
+        (entry->isProtected ? shard->protectedList : shard->probation).unlink(entry);
+        m_totalCost.fetchAndAddOrdered(-entry->cost);
+        delete entry;
+
+        return true;
+    }
+
+    /**
+     * Returns the least valuable of the oldest entries of list, skipping keep, or 0.
+     * Value is the decoding time saved per byte of cache.
+     */
+    static Entry* victim(const List& list, const Entry* const keep)
+    {
+        Entry* best      = 0;
+        double bestValue = 0.0;
+        int    compared  = 0;
+
+        for (Entry* entry = list.tail ; entry && compared < EvictionCandidates ; entry = entry->prev)
+        {
+            if (entry == keep)
+            {
+                continue;
+            }
+
+            double value = (entry->decodeMilliseconds + 1.0) / qMax(entry->cost, qint64(1));
+
+            if (!best || value < bestValue)
+            {
+                best      = entry;
+                bestValue = value;
+            }
+
+            ++compared;
+        }
+
+        return best;
+    }
+
+    /**
+     * Evicts one entry of shard, never keep. The probation segment is evicted first
+     * when it holds more than a quarter of the shard's fair share of the cost limit.
+     * Returns false if there is nothing to evict.
+     */
+    bool evictOne(Shard* const shard, const Entry* const keep)
+    {
+        const qint64 probationLimit = m_maxCost.load() / m_shards.size() / 4;
+        const bool   fromProbation  = !shard->protectedList.head || shard->probation.cost > probationLimit;
+        Entry* entry                = victim(fromProbation ? shard->probation : shard->protectedList, keep);
+
+        if (!entry)
+        {
+            entry = victim(fromProbation ? shard->protectedList : shard->probation, keep);
+        }
+
+        if (!entry)
+        {
+            return false;
+        }
+
+        if (!entry->isProtected)
+        {
+            rememberGhost(shard, entry->key);
+        }
+
+        removeEntry(shard, entry->key);
+        ++shard->stats.evictions;
+
+        return true;
+    }
+
+    void rememberGhost(Shard* const shard, const QString& key)
+    {
+        const quint64 serial = ++shard->ghostSerial;
+        shard->ghosts.insert(key, serial);
+        shard->ghostQueue.enqueue(qMakePair(key, serial));
+
+        const int maxGhosts = qMax(64, 2 * shard->entries.size());
+
+        while (shard->ghostQueue.size() > maxGhosts)
+        {
+            QPair<QString, quint64> oldest = shard->ghostQueue.dequeue();
+
+            // The key may have been inserted and evicted again since: keep its newer record.
+            if (shard->ghosts.value(oldest.first) == oldest.second)
+            {
+                shard->ghosts.remove(oldest.first);
+            }
+        }
+    }
+
+private:
+
+    QVector<Shard*>        m_shards;
+    QAtomicInteger<qint64> m_maxCost;
+    QAtomicInteger<qint64> m_totalCost;
+
+private:
+
+    Q_DISABLE_COPY(LoadingCacheStore)
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_LOADING_CACHE_STORE_H
@@ -26,6 +26,8 @@
 
 // Qt includes
 
+#include <QElapsedTimer>
+
 // Local includes
 
 #include "digikam_debug.h"
@@ -112,22 +114,24 @@ void SharedLoadingTask::execute()
         LoadingCache::CacheLock lock(cache);
 
         // find possible cached images
-        DImg* cachedImg        = 0;
+        DImg cachedImg;
         QStringList lookupKeys = m_loadingDescription.lookupCacheKeys();
 
         foreach (const QString& key, lookupKeys)
         {
-            if ((cachedImg = cache->retrieveImage(key)))
+            cachedImg = cache->retrieveImage(key);
+
+            if (!cachedImg.isNull())
             {
                 if (m_loadingDescription.needCheckRawDecoding())
                 {
-                    if (cachedImg->rawDecodingSettings() == m_loadingDescription.rawDecodingSettings)
+                    if (cachedImg.rawDecodingSettings() == m_loadingDescription.rawDecodingSettings)
                     {
                         break;
                     }
                     else
                     {
-                        cachedImg = 0;
+                        cachedImg = DImg();
                     }
                 }
                 else
@@ -137,10 +141,10 @@ void SharedLoadingTask::execute()
             }
         }
 
-        if (cachedImg)
+        if (!cachedImg.isNull())
         {
             // image is found in image cache, loading is successful
-            m_img = *cachedImg;
+            m_img = cachedImg;
         }
         else
         {
@@ -203,6 +207,9 @@ void SharedLoadingTask::execute()
     {
         // load image
 
+        QElapsedTimer timer;
+        timer.start();
+
         m_img = DImg(m_loadingDescription.filePath, this, m_loadingDescription.rawDecodingSettings);
 
         LoadingCache::CacheLock lock(cache);
@@ -211,7 +218,7 @@ void SharedLoadingTask::execute()
         if (!m_img.isNull())
         {
             cache->putImage(m_loadingDescription.cacheKey(), m_img,
-                            m_loadingDescription.filePath);
+                            m_loadingDescription.filePath, timer.elapsed());
         }
 
         // remove this from the list of loading processes in cache
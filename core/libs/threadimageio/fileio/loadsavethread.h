@@ -77,6 +77,17 @@ public:
      * Will not be used if DMetadata::ORIENTATION_UNSPECIFIED (default value)
      */
     virtual int orientationHint(const QString& path) = 0;
+
+    /**
+     * Gives the index of the preview sources of a RAW file, as built at scan time
+     * and serialized with RawPreviewIndex::toString().
+     * Returns a null string if it is not known.
+     */
+    virtual QString rawPreviewIndex(const QString& path)
+    {
+        Q_UNUSED(path);
+        return QString();
+    }
 };
 
 // -------------------------------------------------------------------------------------------------------
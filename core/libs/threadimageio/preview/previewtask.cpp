@@ -30,6 +30,8 @@
 
 // Qt includes
 
+#include <QElapsedTimer>
+#include <QFileInfo>
 #include <QImage>
 #include <QVariant>
 #include <QMatrix>
@@ -42,6 +44,7 @@
 #include "jpegutils.h"
 #include "metaenginesettings.h"
 #include "previewloadthread.h"
+#include "rawpreviewindex.h"
 
 namespace Digikam
 {
@@ -60,7 +63,7 @@ void PreviewLoadingTask::execute()
         LoadingCache::CacheLock lock(cache);
 
         // find possible cached images
-        DImg* cachedImg        = 0;
+        DImg cachedImg;
         QStringList lookupKeys = m_loadingDescription.lookupCacheKeys();
 
         // lookupCacheKeys returns "best first". Prepend the cache key to make the list "fastest first":
@@ -69,17 +72,19 @@ void PreviewLoadingTask::execute()
 
         foreach (const QString& key, lookupKeys)
         {
-            if ((cachedImg = cache->retrieveImage(key)))
+            cachedImg = cache->retrieveImage(key);
+
+            if (!cachedImg.isNull())
             {
                 if (m_loadingDescription.needCheckRawDecoding())
                 {
-                    if (cachedImg->rawDecodingSettings() == m_loadingDescription.rawDecodingSettings)
+                    if (cachedImg.rawDecodingSettings() == m_loadingDescription.rawDecodingSettings)
                     {
                         break;
                     }
                     else
                     {
-                        cachedImg = 0;
+                        cachedImg = DImg();
                     }
                 }
                 else
@@ -89,10 +94,10 @@ void PreviewLoadingTask::execute()
             }
         }
 
-        if (cachedImg)
+        if (!cachedImg.isNull())
         {
             // image is found in image cache, loading is successful
-            m_img = *cachedImg;
+            m_img = cachedImg;
         }
         else
         {
@@ -155,102 +160,18 @@ void PreviewLoadingTask::execute()
     {
         // Preview is not in cache, we will load image from file.
 
+        QElapsedTimer timer;
+        timer.start();
+
         DImg::FORMAT format      = DImg::fileFormat(m_loadingDescription.filePath);
         m_fromRawEmbeddedPreview = false;
 
         if (format == DImg::RAW)
         {
-            MetaEnginePreviews previews(m_loadingDescription.filePath);
-            // Check original image size using Exiv2.
-            QSize originalSize  = previews.originalSize();
-
-            // If not valid, get original size from LibRaw
-            if (!originalSize.isValid())
-            {
-                DRawInfo container;
-
-                if (DRawDecoder::rawFileIdentify(container, m_loadingDescription.filePath))
-                {
-                    originalSize = container.imageSize;
-                }
-            }
-
-            switch (m_loadingDescription.previewParameters.previewSettings.quality)
+            // Go straight to the source found at scan time, else probe the sources in turn.
+            if (!loadRawPreviewFromIndex())
             {
-                case PreviewSettings::FastPreview:
-                case PreviewSettings::FastButLargePreview:
-                {
-                    // Size calculations
-                    int sizeLimit = -1;
-                    int bestSize  = qMax(originalSize.width(), originalSize.height());
-                    // for RAWs, the alternative is the half preview, so best size is already originalSize / 2
-                    bestSize     /= 2;
-
-                    if (m_loadingDescription.previewParameters.previewSettings.quality == PreviewSettings::FastButLargePreview)
-                    {
-                        sizeLimit = qMin(m_loadingDescription.previewParameters.size, bestSize);
-                    }
-
-                    if (loadExiv2Preview(previews, sizeLimit))
-                    {
-                        break;
-                    }
-
-                    if (loadLibRawPreview(sizeLimit))
-                    {
-                        break;
-                    }
-
-                    loadHalfSizeRaw();
-                    break;
-                }
-
-                case PreviewSettings::HighQualityPreview:
-                {
-                    switch (m_loadingDescription.previewParameters.previewSettings.rawLoading)
-                    {
-                        case PreviewSettings::RawPreviewAutomatic:
-                        {
-                            // If we find a preview that is larger than half size (which is what we get from half-size original data), we take it
-                            int acceptableSize = qMax(lround(originalSize.width()  * 0.48), lround(originalSize.height() * 0.48));
-
-                            if (loadExiv2Preview(previews, acceptableSize))
-                            {
-                                break;
-                            }
-
-                            if (loadLibRawPreview(acceptableSize))
-                            {
-                                break;
-                            }
-
-                            loadHalfSizeRaw();
-                            break;
-                        }
-
-                        case PreviewSettings::RawPreviewFromEmbeddedPreview:
-                        {
-                            if (loadExiv2Preview(previews))
-                            {
-                                break;
-                            }
-
-                            if (loadLibRawPreview())
-                            {
-                                break;
-                            }
-
-                            loadHalfSizeRaw();
-                            break;
-                        }
-
-                        case PreviewSettings::RawPreviewFromRawHalfSize:
-                        {
-                            loadHalfSizeRaw();
-                            break;
-                        }
-                    }
-                }
+                loadRawPreview();
             }
 
             // So far, everything loaded QImage. Convert to DImg.
@@ -273,7 +194,7 @@ void PreviewLoadingTask::execute()
 
                     if (continueQuery(&m_img))
                     {
-                        // Set a hint to try to load a JPEG or PGF with the fast scale-before-decoding method
+                        // Set a hint to try to load a JPEG, PGF or pyramid TIFF with the fast scale-before-decoding method
                         if (isFast)
                         {
                             m_img.setAttribute(QLatin1String("scaledLoadingSize"), m_loadingDescription.previewParameters.size);
@@ -309,7 +230,7 @@ void PreviewLoadingTask::execute()
         if (!m_img.isNull())
         {
             cache->putImage(m_loadingDescription.cacheKey(), m_img,
-                            m_loadingDescription.filePath);
+                            m_loadingDescription.filePath, timer.elapsed());
         }
 
         // remove this from the list of loading processes in cache
@@ -420,6 +341,214 @@ void PreviewLoadingTask::execute()
     }
 }
 
+void PreviewLoadingTask::loadRawPreview()
+{
+    MetaEnginePreviews previews(m_loadingDescription.filePath);
+    // Check original image size using Exiv2.
+    QSize originalSize  = previews.originalSize();
+
+    // If not valid, get original size from LibRaw
+    if (!originalSize.isValid())
+    {
+        DRawInfo container;
+
+        if (DRawDecoder::rawFileIdentify(container, m_loadingDescription.filePath))
+        {
+            originalSize = container.imageSize;
+        }
+    }
+
+    switch (m_loadingDescription.previewParameters.previewSettings.quality)
+    {
+        case PreviewSettings::FastPreview:
+        case PreviewSettings::FastButLargePreview:
+        {
+            // Size calculations
+            int sizeLimit = -1;
+            int bestSize  = qMax(originalSize.width(), originalSize.height());
+            // for RAWs, the alternative is the half preview, so best size is already originalSize / 2
+            bestSize     /= 2;
+
+            if (m_loadingDescription.previewParameters.previewSettings.quality == PreviewSettings::FastButLargePreview)
+            {
+                sizeLimit = qMin(m_loadingDescription.previewParameters.size, bestSize);
+            }
+
+            if (loadExiv2Preview(previews, sizeLimit))
+            {
+                break;
+            }
+
+            if (loadLibRawPreview(sizeLimit))
+            {
+                break;
+            }
+
+            loadHalfSizeRaw();
+            break;
+        }
+
+        case PreviewSettings::HighQualityPreview:
+        {
+            switch (m_loadingDescription.previewParameters.previewSettings.rawLoading)
+            {
+                case PreviewSettings::RawPreviewAutomatic:
+                {
+                    // If we find a preview that is larger than half size (which is what we get from half-size original data), we take it
+                    int acceptableSize = qMax(lround(originalSize.width()  * 0.48), lround(originalSize.height() * 0.48));
+
+                    if (loadExiv2Preview(previews, acceptableSize))
+                    {
+                        break;
+                    }
+
+                    if (loadLibRawPreview(acceptableSize))
+                    {
+                        break;
+                    }
+
+                    loadHalfSizeRaw();
+                    break;
+                }
+
+                case PreviewSettings::RawPreviewFromEmbeddedPreview:
+                {
+                    if (loadExiv2Preview(previews))
+                    {
+                        break;
+                    }
+
+                    if (loadLibRawPreview())
+                    {
+                        break;
+                    }
+
+                    loadHalfSizeRaw();
+                    break;
+                }
+
+                case PreviewSettings::RawPreviewFromRawHalfSize:
+                {
+                    loadHalfSizeRaw();
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool PreviewLoadingTask::loadRawPreviewFromIndex()
+{
+    LoadSaveFileInfoProvider* const provider = LoadSaveThread::infoProvider();
+
+    if (!provider || !continueQuery(&m_img))
+    {
+        return false;
+    }
+
+    const QString filePath = m_loadingDescription.filePath;
+    RawPreviewIndex index  = RawPreviewIndex::fromString(provider->rawPreviewIndex(filePath));
+
+    // The index is obsolete if the file was changed since it was scanned.
+    if (index.isNull() || index.fileSize != QFileInfo(filePath).size())
+    {
+        return false;
+    }
+
+    // Same size requirements as in loadRawPreview()
+
+    QSize originalSize             = index.originalSize;
+    int size                       = m_loadingDescription.previewParameters.size;
+    int previewIndex               = -1;
+    RawPreviewIndex::Source source = RawPreviewIndex::NoSource;
+
+    switch (m_loadingDescription.previewParameters.previewSettings.quality)
+    {
+        case PreviewSettings::FastPreview:
+        {
+            // The smallest preview which does not need upscaling, else any embedded preview.
+            source = index.bestSource(size > 0 ? size : -1, &previewIndex);
+
+            if (source == RawPreviewIndex::HalfSizeRaw)
+            {
+                source = index.bestSource(-1, &previewIndex);
+            }
+
+            break;
+        }
+
+        case PreviewSettings::FastButLargePreview:
+        {
+            int bestSize = qMax(originalSize.width(), originalSize.height()) / 2;
+            source       = index.bestSource(qMin(size, bestSize), &previewIndex);
+            break;
+        }
+
+        case PreviewSettings::HighQualityPreview:
+        {
+            switch (m_loadingDescription.previewParameters.previewSettings.rawLoading)
+            {
+                case PreviewSettings::RawPreviewAutomatic:
+                {
+                    int acceptableSize = qMax(lround(originalSize.width()  * 0.48), lround(originalSize.height() * 0.48));
+                    source             = index.bestSource(acceptableSize, &previewIndex);
+                    break;
+                }
+
+                case PreviewSettings::RawPreviewFromEmbeddedPreview:
+                {
+                    source = index.bestSource(-1, &previewIndex);
+                    break;
+                }
+
+                case PreviewSettings::RawPreviewFromRawHalfSize:
+                {
+                    source = RawPreviewIndex::HalfSizeRaw;
+                    break;
+                }
+            }
+        }
+    }
+
+    switch (source)
+    {
+        case RawPreviewIndex::EmbeddedPreview:
+        {
+            MetaEnginePreviews previews(filePath);
+            const RawPreviewIndex::Entry& entry = index.embeddedPreviews.at(previewIndex);
+
+            // Exiv2 reads the data of this preview only.
+            if (previews.width(previewIndex)  == entry.size.width() &&
+                previews.height(previewIndex) == entry.size.height())
+            {
+                m_qimage                 = previews.image(previewIndex);
+                m_fromRawEmbeddedPreview = !m_qimage.isNull();
+            }
+
+            break;
+        }
+
+        case RawPreviewIndex::LibRawPreview:
+        {
+            loadLibRawPreview();
+            break;
+        }
+
+        case RawPreviewIndex::HalfSizeRaw:
+        {
+            loadHalfSizeRaw();
+            break;
+        }
+
+        case RawPreviewIndex::NoSource:
+        {
+            break;
+        }
+    }
+
+    return !m_qimage.isNull();
+}
+
 bool PreviewLoadingTask::needToScale()
 {
     switch (m_loadingDescription.previewParameters.previewSettings.quality)
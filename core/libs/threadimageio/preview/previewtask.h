@@ -51,6 +51,8 @@ public:
 
 private:
 
+    void loadRawPreview();
+    bool loadRawPreviewFromIndex();
     bool loadExiv2Preview(MetaEnginePreviews& previews, int sizeLimit = -1);
     bool loadLibRawPreview(int sizeLimit = -1);
     bool loadHalfSizeRaw();
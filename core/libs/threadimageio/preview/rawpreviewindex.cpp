@@ -0,0 +1,206 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-14
+ * Description : Index of the preview sources available in a RAW file
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "rawpreviewindex.h"
+
+// Qt includes
+
+#include <QFileInfo>
+#include <QStringList>
+
+// Local includes
+
+#include "drawdecoder.h"
+#include "metaengine_previews.h"
+
+namespace Digikam
+{
+
+// Increase when the serialized format changes. Older values are ignored.
+static const int rawPreviewIndexVersion = 1;
+
+static QString sizeToString(const QSize& size)
+{
+    return QString::fromLatin1("%1x%2").arg(size.width()).arg(size.height());
+}
+
+static QSize sizeFromString(const QString& value)
+{
+    QStringList dims = value.split(QLatin1Char('x'));
+
+    if (dims.size() != 2)
+    {
+        return QSize();
+    }
+
+    return QSize(dims.at(0).toInt(), dims.at(1).toInt());
+}
+
+static int longestSide(const QSize& size)
+{
+    return qMax(size.width(), size.height());
+}
+
+RawPreviewIndex::RawPreviewIndex()
+    : fileSize(-1)
+{
+}
+
+bool RawPreviewIndex::isNull() const
+{
+    return (fileSize == -1);
+}
+
+RawPreviewIndex RawPreviewIndex::fromFile(const QString& filePath)
+{
+    RawPreviewIndex index;
+    index.fileSize = QFileInfo(filePath).size();
+
+    MetaEnginePreviews previews(filePath);
+    index.originalSize = previews.originalSize();
+
+    for (int i = 0 ; i < previews.count() ; ++i)
+    {
+        index.embeddedPreviews << Entry(QSize(previews.width(i), previews.height(i)), previews.dataSize(i));
+    }
+
+    DRawInfo container;
+
+    if (DRawDecoder::rawFileIdentify(container, filePath))
+    {
+        index.libRawPreviewSize = container.thumbSize;
+
+        if (!index.originalSize.isValid())
+        {
+            index.originalSize = container.imageSize;
+        }
+    }
+
+    return index;
+}
+
+QString RawPreviewIndex::toString() const
+{
+    if (isNull())
+    {
+        return QString();
+    }
+
+    QStringList entries;
+
+    foreach (const Entry& entry, embeddedPreviews)
+    {
+        entries << sizeToString(entry.size) + QLatin1Char(':') + QString::number(entry.dataSize);
+    }
+
+    QStringList fields;
+    fields << QString::number(rawPreviewIndexVersion)
+           << QString::number(fileSize)
+           << sizeToString(originalSize)
+           << sizeToString(libRawPreviewSize)
+           << entries.join(QLatin1Char(','));
+
+    return fields.join(QLatin1Char(';'));
+}
+
+RawPreviewIndex RawPreviewIndex::fromString(const QString& value)
+{
+    RawPreviewIndex index;
+    QStringList fields = value.split(QLatin1Char(';'));
+
+    if (fields.size() != 5 || fields.at(0).toInt() != rawPreviewIndexVersion)
+    {
+        return index;
+    }
+
+    bool ok = false;
+    qlonglong fileSize = fields.at(1).toLongLong(&ok);
+
+    if (!ok)
+    {
+        return index;
+    }
+
+    index.originalSize      = sizeFromString(fields.at(2));
+    index.libRawPreviewSize = sizeFromString(fields.at(3));
+
+    foreach (const QString& entry, fields.at(4).split(QLatin1Char(','), QString::SkipEmptyParts))
+    {
+        QStringList parts = entry.split(QLatin1Char(':'));
+
+        if (parts.size() != 2)
+        {
+            return RawPreviewIndex();
+        }
+
+        index.embeddedPreviews << Entry(sizeFromString(parts.at(0)), parts.at(1).toInt());
+    }
+
+    index.fileSize = fileSize;
+
+    return index;
+}
+
+RawPreviewIndex::Source RawPreviewIndex::bestSource(int sizeLimit, int* const previewIndex) const
+{
+    if (isNull())
+    {
+        return NoSource;
+    }
+
+    if (sizeLimit == -1)
+    {
+        if (!embeddedPreviews.isEmpty())
+        {
+            *previewIndex = 0;
+            return EmbeddedPreview;
+        }
+
+        if (libRawPreviewSize.isValid())
+        {
+            return LibRawPreview;
+        }
+
+        return HalfSizeRaw;
+    }
+
+    // Previews are sorted largest first: the last large enough one is the cheapest to decode.
+
+    for (int i = embeddedPreviews.size() - 1 ; i >= 0 ; --i)
+    {
+        if (longestSide(embeddedPreviews.at(i).size) >= sizeLimit)
+        {
+            *previewIndex = i;
+            return EmbeddedPreview;
+        }
+    }
+
+    if (longestSide(libRawPreviewSize) >= sizeLimit)
+    {
+        return LibRawPreview;
+    }
+
+    return HalfSizeRaw;
+}
+
+} // namespace Digikam
@@ -0,0 +1,118 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-14
+ * Description : Index of the preview sources available in a RAW file
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_RAW_PREVIEW_INDEX_H
+#define DIGIKAM_RAW_PREVIEW_INDEX_H
+
+// Qt includes
+
+#include <QList>
+#include <QSize>
+#include <QString>
+
+// Local includes
+
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+/**
+ * Describes the images a preview of a RAW file can be taken from: the previews
+ * embedded in the file, as listed by Exiv2, the thumbnail found by LibRaw,
+ * and the half size demosaicing of the raw data.
+ * The index is built at scan time and stored in the database, so that
+ * preview loading can go straight to the cheapest suitable source.
+ */
+class DIGIKAM_EXPORT RawPreviewIndex
+{
+public:
+
+    enum Source
+    {
+        NoSource = 0,
+        /// One of the embedded previews read with Exiv2
+        EmbeddedPreview,
+        /// The embedded thumbnail read with LibRaw
+        LibRawPreview,
+        /// Half size decoding of the raw data
+        HalfSizeRaw
+    };
+
+    class Entry
+    {
+    public:
+
+        explicit Entry(const QSize& size = QSize(), int dataSize = 0)
+            : size(size),
+              dataSize(dataSize)
+        {
+        }
+
+        QSize size;
+        int   dataSize;
+    };
+
+public:
+
+    RawPreviewIndex();
+
+    bool isNull() const;
+
+    /**
+     * Read the preview properties of the given file with Exiv2 and LibRaw.
+     * No image data is decoded.
+     */
+    static RawPreviewIndex fromFile(const QString& filePath);
+
+    /**
+     * Serialize the index to be stored in the database, and read it back.
+     * fromString() returns a null index for an empty or unknown string.
+     */
+    QString toString() const;
+    static RawPreviewIndex fromString(const QString& value);
+
+    /**
+     * Return the cheapest source with an image at least sizeLimit pixels large
+     * on its longest side. With a sizeLimit of -1, the largest embedded
+     * preview is taken, as any size is acceptable.
+     * For EmbeddedPreview, previewIndex is set to the index to pass to MetaEnginePreviews.
+     */
+    Source bestSource(int sizeLimit, int* const previewIndex) const;
+
+public:
+
+    /// File size at scan time, to detect an obsolete index
+    qlonglong    fileSize;
+
+    QSize        originalSize;
+
+    /// Sorted largest first, in the same order as MetaEnginePreviews
+    QList<Entry> embeddedPreviews;
+
+    QSize        libRawPreviewSize;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_RAW_PREVIEW_INDEX_H
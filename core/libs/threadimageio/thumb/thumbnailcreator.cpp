@@ -173,6 +173,11 @@ int ThumbnailCreator::storedSize() const
     return d->storageSize();
 }
 
+int ThumbnailCreator::placeholderSize()
+{
+    return 32;
+}
+
 QString ThumbnailCreator::errorString() const
 {
     return d->error;
@@ -246,6 +251,12 @@ QImage ThumbnailCreator::load(const ThumbnailIdentifier& identifier, const QRect
             else
             {
                 image = loadFromDatabase(info);
+
+                // Thumbnails stored by earlier versions have no placeholder yet.
+                if (!image.isNull() && rect.isNull())
+                {
+                    storePlaceholderInDatabase(d->dbIdForReplacement, image);
+                }
             }
 
             break;
@@ -658,17 +669,36 @@ QImage ThumbnailCreator::loadImageDetail(const ThumbnailInfo& info, const DMetad
 
     // load DImg
     DImg img;
-    //TODO: scaledLoading if detailRect is large
     //TODO: use code from PreviewTask, including cache storage
+
+    int orientation = exifOrientation(info, metadata, false, false);
+
+    // The JPEG and TIFF loaders can decode the detail only, at reduced size. As the rect
+    // refers to the oriented image, this is only possible for images which are not rotated.
+    DImg::FORMAT format = DImg::fileFormat(path);
+
+    if ((format == DImg::JPEG || format == DImg::TIFF)       &&
+        (orientation == DMetadata::ORIENTATION_NORMAL        ||
+         orientation == DMetadata::ORIENTATION_UNSPECIFIED))
+    {
+        img.setAttribute(QLatin1String("loadingRegion"),     detailRect);
+        img.setAttribute(QLatin1String("scaledLoadingSize"), d->storageSize());
+    }
+
     img.load(path, false, profile ? true : false, false, false, d->observer, d->fastRawSettings);
 
     if (profile)
         *profile = img.getIccProfile();
 
+    if (img.attribute(QLatin1String("loadedRegion")).isValid())
+    {
+        return img.copyQImage();
+    }
+
     // We must rotate before clipping because the rect refers to the oriented image.
     // I do not know currently how to back-rotate the rect for clipping before rotation.
     // If someone has the mathematics, have a go.
-    img.rotateAndFlip(exifOrientation(info, metadata, false, false));
+    img.rotateAndFlip(orientation);
 
     QRect mappedDetail = TagRegion::mapFromOriginalSize(img, detailRect);
     img.crop(mappedDetail.intersected(QRect(0, 0, img.width(), img.height())));
@@ -820,6 +850,14 @@ void ThumbnailCreator::storeInDatabase(const ThumbnailInfo& info, const Thumbnai
         }
     }
 
+    // Detail thumbnails are not displayed in icon views, they have no placeholder.
+    QByteArray placeholder;
+
+    if (info.customIdentifier.isNull())
+    {
+        placeholder = placeholderData(image);
+    }
+
     ThumbsDbAccess access;
     BdEngineBackend::QueryState lastQueryState = BdEngineBackend::QueryState(BdEngineBackend::ConnectionError);
 
@@ -890,6 +928,17 @@ void ThumbnailCreator::storeInDatabase(const ThumbnailInfo& info, const Thumbnai
             }
         }
 
+        // Insert placeholder, replacing the one of the previous thumbnail
+        if (!placeholder.isNull())
+        {
+            lastQueryState = access.db()->replacePlaceholder(dbInfo.id, placeholder);
+
+            if (BdEngineBackend::NoErrors != lastQueryState)
+            {
+                continue;
+            }
+        }
+
         lastQueryState = access.backend()->commitTransaction();
 
         if (BdEngineBackend::NoErrors != lastQueryState)
@@ -900,6 +949,60 @@ void ThumbnailCreator::storeInDatabase(const ThumbnailInfo& info, const Thumbnai
     }
 }
 
+QByteArray ThumbnailCreator::placeholderData(const ThumbnailImage& image) const
+{
+    // The placeholder is stored ready for display: small, rotated and without alpha channel.
+
+    QImage qimage = image.qimage.scaled(placeholderSize(), placeholderSize(),
+                                        Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    if (d->exifRotate)
+    {
+        qimage = exifRotate(qimage, image.exifOrientation);
+    }
+
+    qimage = handleAlphaChannel(qimage);
+
+    QByteArray data;
+    QBuffer    buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+
+    if (qimage.hasAlphaChannel())
+    {
+        qimage.save(&buffer, "PNG");
+    }
+    else
+    {
+        qimage.save(&buffer, "JPEG", 75);
+    }
+
+    buffer.close();
+
+    return data;
+}
+
+void ThumbnailCreator::storePlaceholderInDatabase(int thumbId, const ThumbnailImage& image) const
+{
+    if (thumbId == -1)
+    {
+        return;
+    }
+
+    ThumbsDbAccess access;
+
+    if (access.db()->hasPlaceholder(thumbId))
+    {
+        return;
+    }
+
+    QByteArray placeholder = placeholderData(image);
+
+    if (!placeholder.isNull())
+    {
+        access.db()->replacePlaceholder(thumbId, placeholder);
+    }
+}
+
 ThumbsDbInfo ThumbnailCreator::loadThumbsDbInfo(const ThumbnailInfo& info) const
 {
     ThumbsDbAccess access;
@@ -163,6 +163,12 @@ public:
      */
     void deleteThumbnailsFromDisk(const QString& filePath) const;
 
+    /**
+     * Returns the size of the placeholders stored along the thumbnails in the database.
+     * See ThumbnailLoadThread::loadPlaceholders().
+     */
+    static int placeholderSize();
+
     /** Creates a default ThumbnailInfo for the given path using QFileInfo only
      */
     static ThumbnailInfo fileThumbnailInfo(const QString& path);
@@ -194,6 +200,8 @@ private:
     QImage scaleForStorage(const QImage& qimage) const;
 
     void storeInDatabase(const ThumbnailInfo& info, const ThumbnailImage& image) const;
+    void storePlaceholderInDatabase(int thumbId, const ThumbnailImage& image) const;
+    QByteArray placeholderData(const ThumbnailImage& image) const;
     ThumbsDbInfo loadThumbsDbInfo(const ThumbnailInfo& info) const;
     ThumbnailImage loadFromDatabase(const ThumbnailInfo& info) const;
     bool isInDatabase(const ThumbnailInfo& info) const;
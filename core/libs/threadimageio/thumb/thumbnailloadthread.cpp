@@ -28,9 +28,11 @@
 // Qt includes
 
 #include <QApplication>
+#include <QCache>
 #include <QEventLoop>
 #include <QHash>
 #include <QPainter>
+#include <QSet>
 #include <QMessageBox>
 #include <QIcon>
 #include <QMimeType>
@@ -48,6 +50,7 @@
 #include "iccprofile.h"
 #include "iccsettings.h"
 #include "metaenginesettings.h"
+#include "thumbsdb.h"
 #include "thumbsdbaccess.h"
 #include "thumbnailsize.h"
 #include "thumbnailtask.h"
@@ -83,6 +86,9 @@ public:
         provider(0),
         profile(IccProfile::sRGB())
     {
+        // 32x32 images are about 4 KB each, scaled pixmaps cost is counted in KB.
+        placeholders.setMaxCost(5000);
+        placeholderPixmaps.setMaxCost(32768);
     }
 
     ~ThumbnailLoadThreadStaticPriv()
@@ -97,6 +103,24 @@ public:
     ThumbnailCreator::StorageMethod storageMethod;
     ThumbnailInfoProvider*          provider;
     IccProfile                      profile;
+
+    /// Placeholders read from the database, keyed by file path. A null image means there is none.
+    QCache<QString, QImage>         placeholders;
+    /// Placeholders scaled for display at the last requested size, keyed by file path.
+    QCache<QString, QPixmap>        placeholderPixmaps;
+    QMutex                          placeholdersMutex;
+
+public:
+
+    /**
+     * Forget the placeholder of the file, which is read again from the database when needed.
+     * placeholdersMutex must be locked.
+     */
+    void removePlaceholder(const QString& filePath)
+    {
+        placeholders.remove(filePath);
+        placeholderPixmaps.remove(filePath);
+    }
 };
 
 Q_GLOBAL_STATIC(ThumbnailLoadThreadStaticPriv, static_d)
@@ -132,8 +156,15 @@ public:
 
     QList<LoadingDescription>          lastDescriptions;
 
+    /// The requesters of the waiting loading tasks, by cache key. A null requester
+    /// stands for all requests made without one, which are never cancelled.
+    QHash<QString, QSet<const QObject*> > requesters;
+    QMutex                             requestersMutex;
+
 public:
 
+    void addRequests(const QList<LoadingDescription>& descriptions, const QObject* const requester);
+
     LoadingDescription        createLoadingDescription(const ThumbnailIdentifier& identifier, int size, bool setLastDescription = true);
     LoadingDescription        createLoadingDescription(const ThumbnailIdentifier& identifier, int size,
                                                        const QRect& detailRect, bool setLastDescription = true);
@@ -380,14 +411,9 @@ bool ThumbnailLoadThread::Private::checkDescription(const LoadingDescription& de
 {
     QString cacheKey = description.cacheKey();
 
+    if (LoadingCache::cache()->hasThumbnailPixmap(cacheKey))
     {
-        LoadingCache* const cache = LoadingCache::cache();
-        LoadingCache::CacheLock lock(cache);
-
-        if (cache->hasThumbnailPixmap(cacheKey))
-        {
-            return false;
-        }
+        return false;
     }
 
     {
@@ -402,6 +428,16 @@ bool ThumbnailLoadThread::Private::checkDescription(const LoadingDescription& de
     return true;
 }
 
+void ThumbnailLoadThread::Private::addRequests(const QList<LoadingDescription>& descriptions, const QObject* const requester)
+{
+    QMutexLocker lock(&requestersMutex);
+
+    foreach (const LoadingDescription& description, descriptions)
+    {
+        requesters[description.cacheKey()] << requester;
+    }
+}
+
 QList<LoadingDescription> ThumbnailLoadThread::Private::makeDescriptions(const QList<ThumbnailIdentifier>& identifiers, int size)
 {
     QList<LoadingDescription> descriptions;
@@ -456,7 +492,7 @@ QList<LoadingDescription> ThumbnailLoadThread::Private::makeDescriptions(const Q
 
 bool ThumbnailLoadThread::find(const ThumbnailIdentifier& identifier, int size, QPixmap* retPixmap, bool emitSignal, const QRect& detailRect)
 {
-    const QPixmap* pix = 0;
+    QPixmap pix;
     LoadingDescription description;
 
     if (detailRect.isNull())
@@ -470,23 +506,20 @@ bool ThumbnailLoadThread::find(const ThumbnailIdentifier& identifier, int size,
 
     QString cacheKey = description.cacheKey();
 
-    {
-        LoadingCache* const cache = LoadingCache::cache();
-        LoadingCache::CacheLock lock(cache);
-        pix                       = cache->retrieveThumbnailPixmap(cacheKey);
-    }
+    // The pixmap store has its own locking, no CacheLock is needed for a lookup.
+    pix = LoadingCache::cache()->retrieveThumbnailPixmap(cacheKey);
 
-    if (pix)
+    if (!pix.isNull())
     {
         if (retPixmap)
         {
-            *retPixmap = *pix;
+            *retPixmap = pix;
         }
 
         if (emitSignal)
         {
             load(description);
-            emit signalThumbnailLoaded(description, QPixmap(*pix));
+            emit signalThumbnailLoaded(description, pix);
         }
 
         return true;
@@ -535,6 +568,11 @@ void ThumbnailLoadThread::findGroup(QList<ThumbnailIdentifier>& identifiers)
 }
 
 void ThumbnailLoadThread::findGroup(QList<ThumbnailIdentifier>& identifiers, int size)
+{
+    findGroup(identifiers, size, 0);
+}
+
+void ThumbnailLoadThread::findGroup(QList<ThumbnailIdentifier>& identifiers, int size, const QObject* const requester)
 {
     if (!checkSize(size))
     {
@@ -542,6 +580,7 @@ void ThumbnailLoadThread::findGroup(QList<ThumbnailIdentifier>& identifiers, int
     }
 
     QList<LoadingDescription> descriptions = d->makeDescriptions(identifiers, size);
+    d->addRequests(descriptions, requester);
     ManagedLoadSaveThread::prependThumbnailGroup(descriptions);
 }
 
@@ -580,6 +619,7 @@ void ThumbnailLoadThread::findGroup(const QList<QPair<ThumbnailIdentifier, QRect
     }
 
     QList<LoadingDescription> descriptions = d->makeDescriptions(idsAndRects, size);
+    d->addRequests(descriptions, 0);
     ManagedLoadSaveThread::prependThumbnailGroup(descriptions);
 }
 
@@ -638,6 +678,116 @@ void ThumbnailLoadThread::pregenerateGroup(const QList<ThumbnailIdentifier>& ide
     ManagedLoadSaveThread::preloadThumbnailGroup(descriptions);
 }
 
+// --- Placeholders ---
+
+void ThumbnailLoadThread::loadPlaceholders(const QList<ThumbnailIdentifier>& identifiers)
+{
+    if (static_d->storageMethod != ThumbnailCreator::ThumbnailDatabase)
+    {
+        return;
+    }
+
+    QStringList filePaths;
+
+    {
+        QMutexLocker lock(&static_d->placeholdersMutex);
+
+        foreach (const ThumbnailIdentifier& identifier, identifiers)
+        {
+            if (!identifier.filePath.isEmpty() && !static_d->placeholders.contains(identifier.filePath))
+            {
+                filePaths << identifier.filePath;
+            }
+        }
+    }
+
+    if (filePaths.isEmpty())
+    {
+        return;
+    }
+
+    QHash<QString, QByteArray> data = ThumbsDbAccess().db()->findPlaceholdersByFilePaths(filePaths);
+
+    QMutexLocker lock(&static_d->placeholdersMutex);
+
+    foreach (const QString& filePath, filePaths)
+    {
+        QImage* const image = new QImage;
+
+        if (data.contains(filePath))
+        {
+            image->loadFromData(data.value(filePath));
+        }
+
+        // Remember items without placeholder as well, not to query them again.
+        static_d->placeholders.insert(filePath, image);
+    }
+}
+
+bool ThumbnailLoadThread::findPlaceholder(const ThumbnailIdentifier& identifier, QPixmap& pixmap, int size)
+{
+    if (identifier.filePath.isEmpty())
+    {
+        return false;
+    }
+
+    int thumbSize     = d->thumbnailSizeForPixmapSize(size);
+
+    QMutexLocker lock(&static_d->placeholdersMutex);
+
+    QPixmap* cached   = static_d->placeholderPixmaps.object(identifier.filePath);
+
+    if (cached && qMax(cached->width(), cached->height()) == thumbSize)
+    {
+        pixmap = *cached;
+        return true;
+    }
+
+    QImage* const image = static_d->placeholders.object(identifier.filePath);
+
+    if (!image || image->isNull() || thumbSize <= 0)
+    {
+        return false;
+    }
+
+    cached = new QPixmap(QPixmap::fromImage(image->scaled(thumbSize, thumbSize,
+                                                          Qt::KeepAspectRatio,
+                                                          Qt::SmoothTransformation)));
+    pixmap = *cached;
+    static_d->placeholderPixmaps.insert(identifier.filePath, cached, qMax(1, cached->width() * cached->height() * 4 / 1024));
+
+    return true;
+}
+
+void ThumbnailLoadThread::cancelGroup(const QList<LoadingDescription>& descriptions, const QObject* const requester)
+{
+    QList<LoadingDescription> cancelled;
+
+    {
+        QMutexLocker lock(&d->requestersMutex);
+
+        foreach (const LoadingDescription& description, descriptions)
+        {
+            QHash<QString, QSet<const QObject*> >::iterator it = d->requesters.find(description.cacheKey());
+
+            if (it == d->requesters.end())
+            {
+                continue;
+            }
+
+            it->remove(requester);
+
+            if (it->isEmpty())
+            {
+                d->requesters.erase(it);
+                cancelled << description;
+            }
+        }
+    }
+
+    ManagedLoadSaveThread::removeThumbnailGroup(cancelled);
+}
+
 // --- Basic load() ---
 
 void ThumbnailLoadThread::load(const LoadingDescription& desc)
@@ -658,6 +808,7 @@ void ThumbnailLoadThread::load(const LoadingDescription& description, bool prelo
     }
     else
     {
+        d->addRequests(QList<LoadingDescription>() << description, 0);
         ManagedLoadSaveThread::loadThumbnail(description);
     }
 }
@@ -695,8 +846,17 @@ void ThumbnailLoadThread::thumbnailLoaded(const LoadingDescription& loadingDescr
     // call parent to send signalThumbnailLoaded(LoadingDescription, QImage) - signal is part of public API
     ManagedLoadSaveThread::thumbnailLoaded(loadingDescription, img);
 
+    {
+        QMutexLocker lock(&d->requestersMutex);
+        d->requesters.remove(loadingDescription.cacheKey());
+    }
+
     if (!d->wantPixmap)
     {
+        // The thumbnail may have been created and stored now, with a new placeholder.
+        QMutexLocker lock(&static_d->placeholdersMutex);
+        static_d->removePlaceholder(loadingDescription.filePath);
+
         return;
     }
 
@@ -762,10 +922,13 @@ void ThumbnailLoadThread::slotThumbnailLoaded(const LoadingDescription& descript
     }
 
     // put into cache
+    LoadingCache::cache()->putThumbnail(description.cacheKey(), pix, description.filePath);
+
+    // the thumbnail takes over. It may have been created and stored now,
+    // with a new placeholder: read it again from the database when needed.
     {
-        LoadingCache* const cache = LoadingCache::cache();
-        LoadingCache::CacheLock lock(cache);
-        cache->putThumbnail(description.cacheKey(), pix, description.filePath);
+        QMutexLocker lock(&static_d->placeholdersMutex);
+        static_d->removePlaceholder(description.filePath);
     }
 
     emit signalThumbnailLoaded(description, pix);
@@ -830,7 +993,6 @@ void ThumbnailLoadThread::deleteThumbnail(const QString& filePath)
 {
     {
         LoadingCache* const cache = LoadingCache::cache();
-        LoadingCache::CacheLock lock(cache);
         QStringList possibleKeys  = LoadingDescription::possibleThumbnailCacheKeys(filePath);
 
         foreach (const QString& cacheKey, possibleKeys)
@@ -839,6 +1001,11 @@ void ThumbnailLoadThread::deleteThumbnail(const QString& filePath)
         }
     }
 
+    {
+        QMutexLocker lock(&static_d->placeholdersMutex);
+        static_d->removePlaceholder(filePath);
+    }
+
     ThumbnailCreator creator(static_d->storageMethod);
 
     if (static_d->provider)
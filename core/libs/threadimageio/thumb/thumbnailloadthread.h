@@ -110,6 +110,11 @@ public:
     void findGroup(QList<ThumbnailIdentifier>& identifiers);
     void findGroup(QList<ThumbnailIdentifier>& identifiers, int size);
 
+    /**
+     * Same as above, the loading tasks can be cancelled with cancelGroup() by the same requester.
+     */
+    void findGroup(QList<ThumbnailIdentifier>& identifiers, int size, const QObject* const requester);
+
     /**
      * All tastes of find() methods, for loading the thumbnail of a detail
      */
@@ -136,6 +141,27 @@ public:
     void pregenerateGroup(const QList<ThumbnailIdentifier>& identifiers);
     void pregenerateGroup(const QList<ThumbnailIdentifier>& identifiers, int size);
 
+    /**
+     * Placeholders are very small thumbnails stored in the thumbnail database,
+     * which can be displayed until the thumbnail is loaded.
+     * loadPlaceholders() reads the placeholders of the given group with one query,
+     * skipping already known items. It is synchronous and only supported
+     * when thumbnails are stored in the database.
+     * findPlaceholder() returns the placeholder scaled to the given size,
+     * or false if none was loaded for the item.
+     */
+    void loadPlaceholders(const QList<ThumbnailIdentifier>& identifiers);
+    bool findPlaceholder(const ThumbnailIdentifier& identifier, QPixmap& pixmap, int size);
+
+    /**
+     * Cancel the waiting loading tasks of the given descriptions, as returned by
+     * lastDescriptions() after findGroup() with this requester, for example for
+     * items which scrolled out of view. A task is only removed if no other requester
+     * and no other find() call asked for the same thumbnail.
+     * The task currently loading is not stopped.
+     */
+    void cancelGroup(const QList<LoadingDescription>& descriptions, const QObject* const requester);
+
     /**
      * Load a thumbnail.
      * You do not need to use this method directly, it will not access the pixmap cache. Use find().
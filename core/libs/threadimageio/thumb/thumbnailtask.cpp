@@ -31,6 +31,7 @@
 // Qt includes
 
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QImage>
 #include <QVariant>
 #include <QMatrix>
@@ -93,12 +94,7 @@ void ThumbnailLoadingTask::execute()
         LoadingCache::CacheLock lock(cache);
 
         // find possible cached images
-        const QImage* const cachedImage = cache->retrieveThumbnail(m_loadingDescription.cacheKey());
-
-        if (cachedImage)
-        {
-            m_qimage = QImage(*cachedImage);
-        }
+        m_qimage = cache->retrieveThumbnail(m_loadingDescription.cacheKey());
 
         if (m_qimage.isNull())
         {
@@ -152,6 +148,9 @@ void ThumbnailLoadingTask::execute()
     {
         // Load or create thumbnail
 
+        QElapsedTimer timer;
+        timer.start();
+
         setupCreator();
 
         switch (m_loadingDescription.previewParameters.type)
@@ -179,7 +178,7 @@ void ThumbnailLoadingTask::execute()
         if (!m_qimage.isNull())
         {
             cache->putThumbnail(m_loadingDescription.cacheKey(), m_qimage,
-                                m_loadingDescription.filePath);
+                                m_loadingDescription.filePath, timer.elapsed());
         }
 
         // remove this from the list of loading processes in cache
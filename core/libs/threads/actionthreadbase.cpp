@@ -30,7 +30,6 @@
 #include <QMutexLocker>
 #include <QWaitCondition>
 #include <QMutex>
-#include <QThreadPool>
 
 // Local includes
 
@@ -65,28 +64,66 @@ public:
 
     explicit Private()
     {
-        running = false;
-        pool    = 0;
+        running  = false;
+        active   = 0;
+        maximum  = 1;
+        priority = ThreadScheduler::Batch;
     }
 
-    volatile bool       running;
+    volatile bool             running;
 
-    QWaitCondition      condVarJobs;
-    QMutex              mutex;
+    QWaitCondition            condVarJobs;
+    QMutex                    mutex;
 
-    ActionJobCollection todo;
-    ActionJobCollection pending;
-    ActionJobCollection processed;
+    ActionJobCollection       todo;
+    ActionJobCollection       pending;
+    ActionJobCollection       processed;
 
-    QThreadPool*        pool;
+    /// Pending jobs not started in the scheduler yet, in order of priority.
+    QList<ActionJob*>         queue;
+
+    /// Jobs started in the scheduler and not finished yet.
+    int                       active;
+    int                       maximum;
+    ThreadScheduler::Priority priority;
+};
+
+// -----------------------------------------------------------------
+
+/** Runs one job in the scheduler. The job itself is deleted by ActionThreadBase.
+ */
+class Q_DECL_HIDDEN ActionJobRunner : public QRunnable
+{
+public:
+
+    ActionJobRunner(ActionJob* const job, ActionThreadBase::Private* const d)
+        : job(job),
+          d(d)
+    {
+        setAutoDelete(true);
+    }
+
+    void run()
+    {
+        job->run();
+
+        QMutexLocker lock(&d->mutex);
+        d->active--;
+        d->condVarJobs.wakeAll();
+    }
+
+private:
+
+    ActionJob* const                 job;
+    ActionThreadBase::Private* const d;
 };
 
+// -----------------------------------------------------------------
+
 ActionThreadBase::ActionThreadBase(QObject* const parent)
     : QThread(parent),
       d(new Private)
 {
-    d->pool = new QThreadPool(this);
-
     defaultMaximumNumberOfThreads();
 }
 
@@ -98,7 +135,14 @@ ActionThreadBase::~ActionThreadBase()
     wait();
 
     //wait for the jobs to finish
-    d->pool->waitForDone();
+    {
+        QMutexLocker lock(&d->mutex);
+
+        while (d->active > 0)
+        {
+            d->condVarJobs.wait(&d->mutex);
+        }
+    }
 
     // Cleanup all jobs from memory
     foreach(ActionJob* const job, d->todo.keys())
@@ -121,21 +165,36 @@ ActionThreadBase::~ActionThreadBase()
 
 void ActionThreadBase::setMaximumNumberOfThreads(int n)
 {
-    d->pool->setMaxThreadCount(n);
+    QMutexLocker lock(&d->mutex);
+
+    d->maximum = qMax(n, 1);
+    d->condVarJobs.wakeAll();
+
     qCDebug(DIGIKAM_GENERAL_LOG) << "Using " << n << " CPU core to run threads";
 }
 
 int ActionThreadBase::maximumNumberOfThreads() const
 {
-    return d->pool->maxThreadCount();
+    return d->maximum;
 }
 
 void ActionThreadBase::defaultMaximumNumberOfThreads()
 {
-    const int maximumNumberOfThreads = qMax(QThread::idealThreadCount(), 1);
+    const int maximumNumberOfThreads = qMax(ThreadScheduler::instance()->maximumThreadCount(d->priority), 1);
     setMaximumNumberOfThreads(maximumNumberOfThreads);
 }
 
+void ActionThreadBase::setJobsPriority(ThreadScheduler::Priority priority)
+{
+    d->priority = priority;
+    defaultMaximumNumberOfThreads();
+}
+
+ThreadScheduler::Priority ActionThreadBase::jobsPriority() const
+{
+    return d->priority;
+}
+
 void ActionThreadBase::slotJobFinished()
 {
     ActionJob* const job = dynamic_cast<ActionJob*>(sender());
@@ -174,6 +233,7 @@ void ActionThreadBase::cancel()
     }
 
     d->pending.clear();
+    d->queue.clear();
     d->running = false;
 
     d->condVarJobs.wakeAll();
@@ -221,12 +281,27 @@ void ActionThreadBase::run()
                 connect(job, SIGNAL(signalDone()),
                         this, SLOT(slotJobFinished()));
 
-                d->pool->start(job, priority);
                 d->pending.insert(job, priority);
+
+                // As with QThreadPool, jobs with a higher priority value are started first.
+
+                int index = 0;
+
+                while (index < d->queue.size() && d->pending.value(d->queue.at(index)) >= priority)
+                {
+                    ++index;
+                }
+
+                d->queue.insert(index, job);
             }
 
             d->todo.clear();
         }
+        else if (!d->queue.isEmpty() && d->active < d->maximum)
+        {
+            d->active++;
+            ThreadScheduler::instance()->start(new ActionJobRunner(d->queue.takeFirst(), d), d->priority);
+        }
         else
         {
             d->condVarJobs.wait(&d->mutex);
@@ -35,6 +35,7 @@
 // Local includes
 
 #include "digikam_export.h"
+#include "threadscheduler.h"
 
 namespace Digikam
 {
@@ -98,7 +99,8 @@ public:
     explicit ActionThreadBase(QObject* const parent=0);
     virtual ~ActionThreadBase();
 
-    /** Adjust maximum number of threads used to parallelize collection of job processing.
+    /** Adjust maximum number of jobs of this instance processed at the same time.
+     *  The number of threads running jobs is also capped by ThreadScheduler for the whole application.
      */
     void setMaximumNumberOfThreads(int n);
 
@@ -111,6 +113,13 @@ public:
      */
     void defaultMaximumNumberOfThreads();
 
+    /** Set the priority of the jobs in the process-wide ThreadScheduler, which runs the jobs
+     *  of all ActionThreadBase instances. The default is ThreadScheduler::Batch.
+     *  The maximum number of threads is reset to the default for this priority.
+     */
+    void setJobsPriority(ThreadScheduler::Priority priority);
+    ThreadScheduler::Priority jobsPriority() const;
+
     /** Cancel processing of current jobs under progress.
      */
     void cancel();
@@ -121,8 +130,8 @@ protected:
      */
     void run();
 
-    /** Append a collection of jobs to process into QThreadPool.
-     *  Jobs are add to pending lists and will be deleted by ActionThreadBase, not QThreadPool.
+    /** Append a collection of jobs to process into ThreadScheduler.
+     *  Jobs are add to pending lists and will be deleted by ActionThreadBase, not ThreadScheduler.
      */
     void appendJobs(const ActionJobCollection& jobs);
 
@@ -140,6 +149,8 @@ protected Q_SLOTS:
 
 private:
 
+    friend class ActionJobRunner;
+
     class Private;
     Private* const d;
 };
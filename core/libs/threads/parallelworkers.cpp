@@ -29,8 +29,10 @@
 #include <QEvent>
 #include <QMetaMethod>
 #include <QMutex>
+#include <QMutexLocker>
 #include <QThread>
 #include <QMetaType>
+#include <QVector>
 #include <QWaitCondition>
 
 // Local includes
@@ -41,23 +43,134 @@
 namespace Digikam
 {
 
+/**
+ * A slot call with a copy of its arguments, waiting for a free worker.
+ */
+class Q_DECL_HIDDEN ParallelWorkers::PendingCall
+{
+public:
+
+    explicit PendingCall(const QMetaMethod& method)
+        : method(method),
+          types(method.parameterTypes())
+    {
+    }
+
+    ~PendingCall()
+    {
+        for (int i = 0 ; i < data.size() ; ++i)
+        {
+            if (data.at(i))
+            {
+                QMetaType::destroy(typeIds.at(i), data.at(i));
+            }
+        }
+    }
+
+    /**
+     * Calls the slot, in the thread of the worker.
+     */
+    void invoke(WorkerObject* const worker) const
+    {
+        QVector<QGenericArgument> args(10);
+
+        for (int i = 0 ; i < data.size() ; ++i)
+        {
+            args[i] = QGenericArgument(types.at(i).constData(), data.at(i));
+        }
+
+        method.invoke(worker, Qt::DirectConnection,
+                      args[0],
+                      args[1],
+                      args[2],
+                      args[3],
+                      args[4],
+                      args[5],
+                      args[6],
+                      args[7],
+                      args[8],
+                      args[9]);
+    }
+
+public:
+
+    QMetaMethod       method;
+    QList<QByteArray> types;
+    QVector<int>      typeIds;
+    QVector<void*>    data;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+/**
+ * A slot call posted to a worker by the dispatcher. Unlike the events of queued
+ * connections, it tells the worker that the call is counted in queuedCalls().
+ */
+class Q_DECL_HIDDEN ParallelWorkers::QueuedCallEvent : public QEvent
+{
+public:
+
+    explicit QueuedCallEvent(PendingCall* const call)
+        : QEvent(queuedCallEventType()),
+          call(call)
+    {
+    }
+
+    ~QueuedCallEvent()
+    {
+        delete call;
+    }
+
+public:
+
+    PendingCall* const call;
+};
+
+// -------------------------------------------------------------------------------------------------
+
 ParallelWorkers::ParallelWorkers()
-    : m_currentIndex(0),
-      m_replacementMetaObject(0),
+    : m_replacementMetaObject(0),
       m_originalStaticMetacall(0)
 {
 }
 
 ParallelWorkers::~ParallelWorkers()
 {
+    // The calls still waiting are processed by the workers before they quit.
+    dispatchPendingCalls(true);
+
     foreach (WorkerObject* const object, m_workers)
     {
+        object->setDispatcher(0);
         delete object;
     }
 
     delete m_replacementMetaObject;
 }
 
+int ParallelWorkers::maximumQueuedCalls()
+{
+    return 1;
+}
+
+QEvent::Type ParallelWorkers::queuedCallEventType()
+{
+    static const QEvent::Type type = static_cast<QEvent::Type>(QEvent::registerEventType());
+
+    return type;
+}
+
+void ParallelWorkers::processQueuedCall(WorkerObject* const worker, QEvent* const e)
+{
+    static_cast<QueuedCallEvent*>(e)->call->invoke(worker);
+}
+
+void ParallelWorkers::post(WorkerObject* const worker, PendingCall* const call)
+{
+    // The event takes the call, and deletes it once processed or discarded.
+    QCoreApplication::postEvent(worker, new QueuedCallEvent(call));
+}
+
 int ParallelWorkers::optimalWorkerCount()
 {
     return qMax(1, QThread::idealThreadCount());
@@ -74,10 +187,23 @@ void ParallelWorkers::schedule()
     {
         object->schedule();
     }
+
+    dispatchPendingCalls(false);
 }
 
 void ParallelWorkers::deactivate(WorkerObject::DeactivatingMode mode)
 {
+    if (mode == WorkerObject::FlushSignals)
+    {
+        QMutexLocker lock(&m_mutex);
+        qDeleteAll(m_pendingCalls);
+        m_pendingCalls.clear();
+    }
+    else if (mode == WorkerObject::PhaseOut)
+    {
+        dispatchPendingCalls(true);
+    }
+
     foreach (WorkerObject* const object, m_workers)
     {
         object->deactivate(mode);
@@ -118,9 +244,100 @@ void ParallelWorkers::add(WorkerObject* const worker)
     }
 */
 
+    worker->setDispatcher(this);
     m_workers << worker;
 }
 
+void ParallelWorkers::dispatch(PendingCall* const call)
+{
+    WorkerObject* target = 0;
+
+    {
+        QMutexLocker lock(&m_mutex);
+
+        // Earlier calls go first, the workers take them from the queue.
+
+        if (m_pendingCalls.isEmpty())
+        {
+            foreach (WorkerObject* const object, m_workers)
+            {
+                if (!target || object->queuedCalls() < target->queuedCalls())
+                {
+                    target = object;
+                }
+            }
+        }
+
+        if (!target || target->queuedCalls() >= maximumQueuedCalls())
+        {
+            m_pendingCalls << call;
+            return;
+        }
+
+        target->addQueuedCall();
+    }
+
+    target->schedule();
+    post(target, call);
+}
+
+void ParallelWorkers::dispatchPendingCalls(bool all)
+{
+    forever
+    {
+        PendingCall* call    = 0;
+        WorkerObject* target = 0;
+
+        {
+            QMutexLocker lock(&m_mutex);
+
+            if (m_pendingCalls.isEmpty())
+            {
+                return;
+            }
+
+            foreach (WorkerObject* const object, m_workers)
+            {
+                if (!target || object->queuedCalls() < target->queuedCalls())
+                {
+                    target = object;
+                }
+            }
+
+            if (!target || (!all && target->queuedCalls() >= maximumQueuedCalls()))
+            {
+                return;
+            }
+
+            call = m_pendingCalls.takeFirst();
+            target->addQueuedCall();
+        }
+
+        target->schedule();
+        post(target, call);
+    }
+}
+
+void ParallelWorkers::workerProcessedCall(WorkerObject* const worker)
+{
+    PendingCall* call = 0;
+
+    {
+        QMutexLocker lock(&m_mutex);
+
+        if (m_pendingCalls.isEmpty() || worker->queuedCalls() >= maximumQueuedCalls())
+        {
+            return;
+        }
+
+        call = m_pendingCalls.takeFirst();
+        worker->addQueuedCall();
+    }
+
+    // The worker is running: the call is queued to its own event loop.
+    post(worker, call);
+}
+
 /*
 bool ParallelWorkers::connect(const QObject* sender, const char* signal,
                               const char* method,
@@ -171,46 +388,26 @@ int ParallelWorkers::replacementStaticQtMetacall(QMetaObject::Call _c, int _id,
         QMetaMethod method = mobj->method(_id + mobj->methodOffset());
 
         // Copy the argument data - _a is going to be deleted in our current thread
-        QList<QByteArray> types = method.parameterTypes();
-        QVector<QGenericArgument> args(10);
+        PendingCall* const call = new PendingCall(method);
 
-        for (int i = 0 ; i < types.size() ; ++i)
+        for (int i = 0 ; i < call->types.size() ; ++i)
         {
-            int typeId = QMetaType::type(types[i].constData());
+            int typeId = QMetaType::type(call->types[i].constData());
 
             if (!typeId && _a[i+1])
             {
-                qCWarning(DIGIKAM_GENERAL_LOG) << "Unable to handle unregistered datatype" << types[i] << "Dropping signal.";
+                qCWarning(DIGIKAM_GENERAL_LOG) << "Unable to handle unregistered datatype" << call->types[i] << "Dropping signal.";
+                delete call;
                 return _id - properMethods;
             }
 
             // we use QMetaType to copy the data. _a[0] is reserved for a return parameter.
-            void* const data = QMetaType::create(typeId, _a[i+1]);
-            args[i]          = QGenericArgument(types[i].constData(), data);
+            call->typeIds << typeId;
+            call->data    << QMetaType::create(typeId, _a[i+1]);
         }
 
-        // Find the object to be invoked
-        WorkerObject* const obj = m_workers.at(m_currentIndex);
-
-        if (++m_currentIndex == m_workers.size())
-        {
-            m_currentIndex = 0;
-        }
-
-        obj->schedule();
-
-        // Invoke across-thread
-        method.invoke(obj, Qt::QueuedConnection,
-                      args[0],
-                      args[1],
-                      args[2],
-                      args[3],
-                      args[4],
-                      args[5],
-                      args[6],
-                      args[7],
-                      args[8],
-                      args[9]);
+        // Invoke on the least busy worker, or queue until a worker is free
+        dispatch(call);
 
         return _id - properMethods; // this return is used by replacementQtMetacall
     }
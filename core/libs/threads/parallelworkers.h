@@ -26,6 +26,9 @@
 
 // Qt includes
 
+#include <QEvent>
+#include <QList>
+#include <QMutex>
 #include <QObject>
 
 // Local includes
@@ -45,6 +48,10 @@ public:
      * ParallelWorkers is a helper class to distribute work over
      * several identical workers objects.
      * See ParallelAdapter for guidance how to use it.
+     *
+     * Each worker gets at most maximumQueuedCalls() slot calls at a time. The other calls
+     * wait in a queue shared by all workers, and the first worker done with its calls
+     * takes the next one. An expensive call thus only delays the calls of its own worker.
      */
     explicit ParallelWorkers();
     virtual ~ParallelWorkers();
@@ -66,6 +73,9 @@ public:
      */
     static int optimalWorkerCount();
 
+    /// The number of slot calls queued to one worker, before the calls wait in the shared queue
+    static int maximumQueuedCalls();
+
 public:
 
     /// Connects signals outbound from all workers to a given receiver
@@ -100,11 +110,31 @@ protected:
 
 protected:
 
+    class PendingCall;
+    class QueuedCallEvent;
+
     QList<WorkerObject*>   m_workers;
-    int                    m_currentIndex;
     QMetaObject*           m_replacementMetaObject;
 
     StaticMetacallFunction m_originalStaticMetacall;
+
+    QMutex                 m_mutex;
+    QList<PendingCall*>    m_pendingCalls;
+
+private:
+
+    void dispatch(PendingCall* const call);
+    void dispatchPendingCalls(bool all);
+    static void post(WorkerObject* const worker, PendingCall* const call);
+
+    // The event type of the slot calls posted to the workers, and their processing by the worker
+    static QEvent::Type queuedCallEventType();
+    static void processQueuedCall(WorkerObject* const worker, QEvent* const e);
+
+    // Called by a worker in its own thread after each processed slot call
+    void workerProcessedCall(WorkerObject* const worker);
+
+    friend class WorkerObject;
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -118,7 +148,7 @@ public:
     /**
      * Instead of using a single WorkerObject, create a ParallelAdapter for
      * your worker object subclass, and add() individual WorkerObjects.
-     * The load will be evenly distributed.
+     * Each slot call goes to the least busy worker, see ParallelWorkers.
      * Note: unlike with WorkerObject directly, there is no need to call schedule().
      * For inbound connections (signals connected to a WorkerObject's slot, to be processed,
      * use a Qt::DirectConnection on the adapter.
@@ -0,0 +1,576 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Process-wide work-stealing scheduler for short tasks
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "threadscheduler.h"
+
+// Qt includes
+
+#include <QAtomicInt>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+// Local includes
+
+#include "digikam_debug.h"
+
+namespace Digikam
+{
+
+static const int PriorityCount = ThreadScheduler::Maintenance + 1;
+
+/**
+ * The tasks of a ThreadSchedulerTasks group. All tasks of a group are done
+ * before the group is destroyed.
+ */
+class Q_DECL_HIDDEN SchedulerGroup
+{
+public:
+
+    explicit SchedulerGroup()
+        : remaining(0)
+    {
+    }
+
+    void taskDone()
+    {
+        QMutexLocker lock(&mutex);
+
+        if (--remaining == 0)
+        {
+            condition.wakeAll();
+        }
+    }
+
+public:
+
+    QMutex         mutex;
+    QWaitCondition condition;
+    int            remaining;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN SchedulerTask
+{
+public:
+
+    explicit SchedulerTask(ThreadScheduler::Priority priority)
+        : runnable(0),
+          group(0),
+          priority(priority),
+          claimed(0)
+    {
+    }
+
+    /**
+     * A task can be queued in a worker and run by the thread waiting for its group.
+     * Only the thread which claims it first runs it.
+     */
+    bool claim()
+    {
+        return claimed.testAndSetOrdered(0, 1);
+    }
+
+    void execute()
+    {
+        if (runnable)
+        {
+            runnable->run();
+
+            if (runnable->autoDelete())
+            {
+                delete runnable;
+            }
+        }
+        else
+        {
+            function();
+        }
+
+        if (group)
+        {
+            group->taskDone();
+        }
+    }
+
+public:
+
+    std::function<void()>     function;
+    QRunnable*                runnable;
+    SchedulerGroup*           group;
+    ThreadScheduler::Priority priority;
+
+private:
+
+    QAtomicInt                claimed;
+};
+
+typedef QSharedPointer<SchedulerTask> SchedulerTaskPtr;
+
+// -------------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN SchedulerWorker : public QThread
+{
+public:
+
+    explicit SchedulerWorker(ThreadScheduler::Private* const d, int index)
+        : d(d),
+          index(index),
+          priority(ThreadScheduler::Interactive)
+    {
+    }
+
+    void run();
+
+public:
+
+    ThreadScheduler::Private* const d;
+    const int                       index;
+
+    /// Tasks started by the task running in this worker, taken last in, first out.
+    QMutex                          mutex;
+    QList<SchedulerTaskPtr>         queues[PriorityCount];
+
+    /// Priority of the task running in this worker.
+    ThreadScheduler::Priority       priority;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN ThreadScheduler::Private
+{
+public:
+
+    explicit Private()
+        : maximumRunning(qMax(QThread::idealThreadCount(), 1)),
+          running(0),
+          runningBackground(0),
+          quit(false)
+    {
+    }
+
+    /**
+     * The tasks which are not Interactive never take the last slot, so that long jobs,
+     * as the maintenance ones, cannot starve the jobs the user waits for.
+     */
+    int backgroundLimit() const
+    {
+        return qMax(maximumRunning - 1, 1);
+    }
+
+    /**
+     * With only one slot, one more Interactive task can run beside a background one.
+     */
+    int runningLimit() const
+    {
+        return qMax(maximumRunning, backgroundLimit() + 1);
+    }
+
+    bool canRun() const
+    {
+        if (running >= runningLimit())
+        {
+            return false;
+        }
+
+        return ((queuedInteractive.load() > 0) ||
+                ((queued.load() > 0) && (runningBackground < backgroundLimit())));
+    }
+
+    void addWorkers(int count);
+    void push(const SchedulerTaskPtr& task);
+    void dequeued(int priority);
+    SchedulerTaskPtr take(SchedulerWorker* const self, bool background);
+
+    static SchedulerWorker* currentWorker();
+
+public:
+
+    QMutex                    mutex;
+    QWaitCondition            condition;
+
+    /// Tasks started from other threads, taken first in, first out.
+    QList<SchedulerTaskPtr>   queues[PriorityCount];
+
+    QVector<SchedulerWorker*> workers;
+    QAtomicInt                queued;
+    QAtomicInt                queuedInteractive;
+    int                       maximumRunning;
+    int                       running;
+    int                       runningBackground;
+    bool                      quit;
+};
+
+void ThreadScheduler::Private::addWorkers(int count)
+{
+    for (int i = 0 ; i < count ; ++i)
+    {
+        SchedulerWorker* const worker = new SchedulerWorker(this, workers.size());
+        workers << worker;
+        worker->start();
+    }
+}
+
+SchedulerWorker* ThreadScheduler::Private::currentWorker()
+{
+    return dynamic_cast<SchedulerWorker*>(QThread::currentThread());
+}
+
+void ThreadScheduler::Private::push(const SchedulerTaskPtr& task)
+{
+    SchedulerWorker* const worker = currentWorker();
+
+    if (worker && worker->d == this)
+    {
+        QMutexLocker lock(&worker->mutex);
+        worker->queues[task->priority] << task;
+    }
+    else
+    {
+        QMutexLocker lock(&mutex);
+        queues[task->priority] << task;
+    }
+
+    queued.ref();
+
+    if (task->priority == ThreadScheduler::Interactive)
+    {
+        queuedInteractive.ref();
+    }
+
+    QMutexLocker lock(&mutex);
+    condition.wakeOne();
+}
+
+void ThreadScheduler::Private::dequeued(int priority)
+{
+    queued.deref();
+
+    if (priority == ThreadScheduler::Interactive)
+    {
+        queuedInteractive.deref();
+    }
+}
+
+SchedulerTaskPtr ThreadScheduler::Private::take(SchedulerWorker* const self, bool background)
+{
+    SchedulerTaskPtr task;
+    const int        count = background ? PriorityCount : ThreadScheduler::Interactive + 1;
+
+    for (int priority = 0 ; priority < count ; ++priority)
+    {
+        // Own tasks first, the newest one: its data is still in the cache.
+        {
+            QMutexLocker lock(&self->mutex);
+
+            while (!self->queues[priority].isEmpty())
+            {
+                task = self->queues[priority].takeLast();
+                dequeued(priority);
+
+                if (task->claim())
+                {
+                    return task;
+                }
+            }
+        }
+
+        {
+            QMutexLocker lock(&mutex);
+
+            while (!queues[priority].isEmpty())
+            {
+                task = queues[priority].takeFirst();
+                dequeued(priority);
+
+                if (task->claim())
+                {
+                    return task;
+                }
+            }
+        }
+
+        // Steal the oldest task of the other workers.
+
+        QVector<SchedulerWorker*> victims;
+
+        {
+            QMutexLocker lock(&mutex);
+            victims = workers;
+        }
+
+        const int workerCount = victims.size();
+
+        for (int i = 1 ; i < workerCount ; ++i)
+        {
+            SchedulerWorker* const victim = victims.at((self->index + i) % workerCount);
+            QMutexLocker lock(&victim->mutex);
+
+            while (!victim->queues[priority].isEmpty())
+            {
+                task = victim->queues[priority].takeFirst();
+                dequeued(priority);
+
+                if (task->claim())
+                {
+                    return task;
+                }
+            }
+        }
+    }
+
+    return SchedulerTaskPtr();
+}
+
+void SchedulerWorker::run()
+{
+    forever
+    {
+        bool background = false;
+
+        {
+            QMutexLocker lock(&d->mutex);
+
+            while (!d->quit && !d->canRun())
+            {
+                d->condition.wait(&d->mutex);
+            }
+
+            if (d->quit)
+            {
+                return;
+            }
+
+            d->running++;
+
+            if (d->runningBackground < d->backgroundLimit())
+            {
+                d->runningBackground++;
+                background = true;
+            }
+        }
+
+        SchedulerTaskPtr task = d->take(this, background);
+
+        if (background && (!task || (task->priority == ThreadScheduler::Interactive)))
+        {
+            QMutexLocker lock(&d->mutex);
+            d->runningBackground--;
+            background = false;
+        }
+
+        if (task)
+        {
+            priority = task->priority;
+            task->execute();
+            priority = ThreadScheduler::Interactive;
+        }
+
+        {
+            QMutexLocker lock(&d->mutex);
+            d->running--;
+
+            if (background)
+            {
+                d->runningBackground--;
+            }
+
+            if (d->queued.load() > 0)
+            {
+                d->condition.wakeOne();
+            }
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN ThreadSchedulerCreator
+{
+public:
+
+    ThreadScheduler object;
+};
+
+Q_GLOBAL_STATIC(ThreadSchedulerCreator, creator)
+
+ThreadScheduler* ThreadScheduler::instance()
+{
+    return &creator->object;
+}
+
+ThreadScheduler::ThreadScheduler()
+    : d(new Private)
+{
+    QMutexLocker lock(&d->mutex);
+    d->addWorkers(d->runningLimit());
+}
+
+ThreadScheduler::~ThreadScheduler()
+{
+    {
+        QMutexLocker lock(&d->mutex);
+        d->quit = true;
+        d->condition.wakeAll();
+    }
+
+    foreach (SchedulerWorker* const worker, d->workers)
+    {
+        worker->wait();
+        delete worker;
+    }
+
+    delete d;
+}
+
+void ThreadScheduler::start(QRunnable* const runnable, Priority priority)
+{
+    SchedulerTaskPtr task(new SchedulerTask(priority));
+    task->runnable = runnable;
+    d->push(task);
+}
+
+void ThreadScheduler::start(const std::function<void()>& function, Priority priority)
+{
+    SchedulerTaskPtr task(new SchedulerTask(priority));
+    task->function = function;
+    d->push(task);
+}
+
+void ThreadScheduler::setMaximumThreadCount(int count)
+{
+    count = qMax(count, 1);
+
+    QMutexLocker lock(&d->mutex);
+
+    d->maximumRunning = count;
+
+    if (d->runningLimit() > d->workers.size())
+    {
+        d->addWorkers(d->runningLimit() - d->workers.size());
+    }
+
+    d->condition.wakeAll();
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Thread scheduler runs up to" << count << "tasks at the same time";
+}
+
+int ThreadScheduler::maximumThreadCount() const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return d->maximumRunning;
+}
+
+int ThreadScheduler::maximumThreadCount(Priority priority) const
+{
+    QMutexLocker lock(&d->mutex);
+
+    return ((priority == Interactive) ? d->runningLimit() : d->backgroundLimit());
+}
+
+ThreadScheduler::Priority ThreadScheduler::currentPriority() const
+{
+    SchedulerWorker* const worker = Private::currentWorker();
+
+    return (worker ? worker->priority : Interactive);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+class Q_DECL_HIDDEN ThreadSchedulerTasks::Private : public SchedulerGroup
+{
+public:
+
+    explicit Private(ThreadScheduler::Priority priority)
+        : priority(priority)
+    {
+    }
+
+public:
+
+    ThreadScheduler::Priority priority;
+    QList<SchedulerTaskPtr>   tasks;
+};
+
+ThreadSchedulerTasks::ThreadSchedulerTasks()
+    : d(new Private(ThreadScheduler::instance()->currentPriority()))
+{
+}
+
+ThreadSchedulerTasks::ThreadSchedulerTasks(ThreadScheduler::Priority priority)
+    : d(new Private(priority))
+{
+}
+
+ThreadSchedulerTasks::~ThreadSchedulerTasks()
+{
+    waitForDone();
+    delete d;
+}
+
+void ThreadSchedulerTasks::run(const std::function<void()>& function)
+{
+    SchedulerTaskPtr task(new SchedulerTask(d->priority));
+    task->function = function;
+    task->group    = d;
+
+    {
+        QMutexLocker lock(&d->mutex);
+        d->remaining++;
+    }
+
+    d->tasks << task;
+    ThreadScheduler::instance()->d->push(task);
+}
+
+void ThreadSchedulerTasks::waitForDone()
+{
+    // Run the tasks no worker took yet, so that nested groups always progress.
+
+    foreach (const SchedulerTaskPtr& task, d->tasks)
+    {
+        if (task->claim())
+        {
+            task->execute();
+        }
+    }
+
+    {
+        QMutexLocker lock(&d->mutex);
+
+        while (d->remaining > 0)
+        {
+            d->condition.wait(&d->mutex);
+        }
+    }
+
+    d->tasks.clear();
+}
+
+} // namespace Digikam
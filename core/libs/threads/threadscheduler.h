@@ -0,0 +1,185 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Process-wide work-stealing scheduler for short tasks
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_THREAD_SCHEDULER_H
+#define DIGIKAM_THREAD_SCHEDULER_H
+
+// C++ includes
+
+#include <functional>
+
+// Qt includes
+
+#include <QRunnable>
+
+// Local includes
+
+#include "digikam_export.h"
+
+namespace Digikam
+{
+
+/**
+ * ThreadScheduler runs the short CPU-bound tasks of the whole application, as the jobs
+ * of ActionThreadBase or the parallelized loops of the image filters, on one set of
+ * worker threads. The number of tasks running at the same time is capped globally,
+ * so that batch processing, maintenance tools and interactive work running together
+ * do not start more threads than there are cores.
+ *
+ * Each worker keeps its own queues: the tasks started from a worker are queued to this
+ * worker and run last in, first out, the tasks started from other threads are queued
+ * globally. A worker without tasks takes the oldest task of another worker.
+ * Tasks of a higher priority always run first. One slot is kept for the Interactive
+ * tasks: the other tasks may run for a long time and there is no preemption.
+ *
+ * Long-lived objects running an event loop, as WorkerObject and DynamicThread,
+ * are still scheduled by ThreadManager.
+ */
+class DIGIKAM_EXPORT ThreadScheduler
+{
+public:
+
+    enum Priority
+    {
+        Interactive = 0,  ///< The user waits for the result, as in the image editor.
+        Preview,          ///< Loading of previews and thumbnails.
+        Batch,            ///< Batch queue manager and export tools.
+        Maintenance       ///< Background maintenance, as fingerprints or face scans.
+    };
+
+public:
+
+    static ThreadScheduler* instance();
+
+    /**
+     * Queues the runnable. It is deleted after it ran if autoDelete() is true.
+     */
+    void start(QRunnable* const runnable, Priority priority);
+
+    /**
+     * Queues the function.
+     */
+    void start(const std::function<void()>& function, Priority priority);
+
+    /**
+     * The maximum number of tasks running at the same time, by default the number of cores.
+     */
+    void setMaximumThreadCount(int count);
+    int  maximumThreadCount() const;
+
+    /**
+     * The maximum number of tasks of this priority running at the same time.
+     * All priorities except Interactive leave one slot free.
+     */
+    int  maximumThreadCount(Priority priority) const;
+
+    /**
+     * Returns the priority of the task running in the current thread, or Interactive
+     * if the current thread is not a worker of the scheduler.
+     */
+    Priority currentPriority() const;
+
+private:
+
+    explicit ThreadScheduler();
+    ~ThreadScheduler();
+
+    // Disable
+    ThreadScheduler(const ThreadScheduler&);
+    ThreadScheduler& operator=(const ThreadScheduler&);
+
+private:
+
+    friend class ThreadSchedulerCreator;
+    friend class ThreadSchedulerTasks;
+    friend class SchedulerWorker;
+
+    class Private;
+    Private* const d;
+};
+
+// -------------------------------------------------------------------------------------------------------
+
+/**
+ * A group of tasks started together and waited for together, as a replacement for
+ * a list of QtConcurrent::run() futures:
+ *
+ *     ThreadSchedulerTasks tasks;
+ *
+ *     for (int j = 0 ; j < vals.count() - 1 ; ++j)
+ *     {
+ *         tasks.run(this, &BlurFilter::blurMultithreaded, vals[j], vals[j+1]);
+ *     }
+ *
+ *     tasks.waitForDone();
+ *
+ * The waiting thread runs the tasks of the group which did not start yet itself,
+ * so that groups can be nested and never wait for a free worker.
+ */
+class DIGIKAM_EXPORT ThreadSchedulerTasks
+{
+public:
+
+    /**
+     * The tasks use the priority of the task running in the current thread,
+     * see ThreadScheduler::currentPriority().
+     */
+    explicit ThreadSchedulerTasks();
+    explicit ThreadSchedulerTasks(ThreadScheduler::Priority priority);
+
+    /**
+     * Waits for the tasks.
+     */
+    ~ThreadSchedulerTasks();
+
+    void run(const std::function<void()>& function);
+
+    /**
+     * Calls the method of the object with a copy of the arguments, as QtConcurrent::run().
+     */
+    template <class Object, class Method, class... Args>
+    void run(Object* const object, Method method, const Args&... args)
+    {
+        run(std::function<void()>(std::bind(method, object, args...)));
+    }
+
+    /**
+     * Waits until all tasks are done. The group can be used again afterwards.
+     */
+    void waitForDone();
+
+private:
+
+    // Disable
+    ThreadSchedulerTasks(const ThreadSchedulerTasks&);
+    ThreadSchedulerTasks& operator=(const ThreadSchedulerTasks&);
+
+private:
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_THREAD_SCHEDULER_H
@@ -25,6 +25,7 @@
 
 // Qt includes
 
+#include <QAtomicInt>
 #include <QCoreApplication>
 #include <QEvent>
 #include <QMutex>
@@ -34,6 +35,7 @@
 // Local includes
 
 #include "digikam_debug.h"
+#include "parallelworkers.h"
 #include "threadmanager.h"
 
 namespace Digikam
@@ -50,6 +52,7 @@ public:
         runnable      = 0;
         inDestruction = false;
         priority      = QThread::InheritPriority;
+        dispatcher    = 0;
     }
 
     volatile WorkerObject::State state;
@@ -59,6 +62,9 @@ public:
     WorkerObjectRunnable*        runnable;
     bool                         inDestruction;
     QThread::Priority            priority;
+
+    QAtomicInt                   queuedCalls;
+    ParallelWorkers*             dispatcher;
 };
 
 WorkerObject::WorkerObject()
@@ -145,6 +151,21 @@ QThread::Priority WorkerObject::priority() const
     return d->priority;
 }
 
+void WorkerObject::addQueuedCall()
+{
+    d->queuedCalls.ref();
+}
+
+int WorkerObject::queuedCalls() const
+{
+    return d->queuedCalls.load();
+}
+
+void WorkerObject::setDispatcher(ParallelWorkers* const dispatcher)
+{
+    d->dispatcher = dispatcher;
+}
+
 bool WorkerObject::event(QEvent* e)
 {
     if (e->type() == QEvent::User)
@@ -154,6 +175,27 @@ bool WorkerObject::event(QEvent* e)
         return true;
     }
 
+    if (e->type() == ParallelWorkers::queuedCallEventType())
+    {
+        // Only the slot calls posted by the dispatcher are counted, not other queued calls.
+
+        ParallelWorkers::processQueuedCall(this, e);
+
+        int count = d->queuedCalls.load();
+
+        while (count > 0 && !d->queuedCalls.testAndSetOrdered(count, count - 1))
+        {
+            count = d->queuedCalls.load();
+        }
+
+        if (d->dispatcher)
+        {
+            d->dispatcher->workerProcessedCall(this);
+        }
+
+        return true;
+    }
+
     return QObject::event(e);
 }
 
@@ -232,6 +274,8 @@ void WorkerObject::deactivate(DeactivatingMode mode)
     if (mode == FlushSignals)
     {
         QCoreApplication::removePostedEvents(this, QEvent::MetaCall);
+        QCoreApplication::removePostedEvents(this, ParallelWorkers::queuedCallEventType());
+        d->queuedCalls.store(0);
     }
 
     // cannot say that this is thread-safe: thread()->quit();
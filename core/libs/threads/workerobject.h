@@ -38,6 +38,7 @@ class QEventLoop;
 namespace Digikam
 {
 
+class ParallelWorkers;
 class WorkerObjectRunnable;
 
 class DIGIKAM_EXPORT WorkerObject : public QObject
@@ -110,6 +111,15 @@ public:
     static bool disconnectAndSchedule(const QObject* sender, const char* signal,
                                       const WorkerObject* receiver, const char* method);
 
+    /** ParallelWorkers, distributing work over several worker objects, calls
+     *  addQueuedCall() before each slot call it posts to this object.
+     *  queuedCalls() returns the number of these calls not processed yet.
+     *  Other queued calls to this object are not counted.
+     *  The count is reset when the object is deactivated with FlushSignals.
+     */
+    void addQueuedCall();
+    int  queuedCalls() const;
+
 public Q_SLOTS:
 
     /**
@@ -178,10 +188,15 @@ protected:
 
     virtual bool event(QEvent* e);
 
+private:
+
+    void setDispatcher(ParallelWorkers* const dispatcher);
+
 private:
 
     friend class WorkerObjectRunnable;
     friend class ThreadManager;
+    friend class ParallelWorkers;
 
     class Private;
     Private* const d;
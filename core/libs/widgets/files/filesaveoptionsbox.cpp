@@ -33,6 +33,7 @@
 #include <QWidget>
 #include <QApplication>
 #include <QStyle>
+#include <QThread>
 
 // KDE includes
 
@@ -218,7 +219,9 @@ void FileSaveOptionsBox::applySettings()
     group.writeEntry(QLatin1String("JPEGCompression"),     d->JPEGOptions->getCompressionValue());
     group.writeEntry(QLatin1String("JPEGSubSampling"),     d->JPEGOptions->getSubSamplingValue());
     group.writeEntry(QLatin1String("PNGCompression"),      d->PNGOptions->getCompressionValue());
+    group.writeEntry(QLatin1String("PNGEncodingThreads"),  d->PNGOptions->getEncodingThreads());
     group.writeEntry(QLatin1String("TIFFCompression"),     d->TIFFOptions->getCompression());
+    group.writeEntry(QLatin1String("TIFFEncodingThreads"), d->TIFFOptions->getEncodingThreads());
 #ifdef HAVE_JASPER
     group.writeEntry(QLatin1String("JPEG2000Compression"), d->JPEG2000Options->getCompressionValue());
     group.writeEntry(QLatin1String("JPEG2000LossLess"),    d->JPEG2000Options->getLossLessCompression());
@@ -235,7 +238,9 @@ void FileSaveOptionsBox::readSettings()
     d->JPEGOptions->setCompressionValue( group.readEntry(QLatin1String("JPEGCompression"),         75) );
     d->JPEGOptions->setSubSamplingValue( group.readEntry(QLatin1String("JPEGSubSampling"),         1) );  // Medium subsampling
     d->PNGOptions->setCompressionValue( group.readEntry(QLatin1String("PNGCompression"),           9) );
+    d->PNGOptions->setEncodingThreads( group.readEntry(QLatin1String("PNGEncodingThreads"),        QThread::idealThreadCount()) );
     d->TIFFOptions->setCompression( group.readEntry(QLatin1String("TIFFCompression"),              false) );
+    d->TIFFOptions->setEncodingThreads( group.readEntry(QLatin1String("TIFFEncodingThreads"),      QThread::idealThreadCount()) );
 #ifdef HAVE_JASPER
     d->JPEG2000Options->setCompressionValue( group.readEntry(QLatin1String("JPEG2000Compression"), 75) );
     d->JPEG2000Options->setLossLessCompression( group.readEntry(QLatin1String("JPEG2000LossLess"), true) );
@@ -0,0 +1,150 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-07-02
+ * Description : Test the comment searches of ItemQueryBuilder
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "commentsearchtest.h"
+
+// Qt includes
+
+#include <QDir>
+#include <QTime>
+
+// Local includes
+
+#include "coredb.h"
+#include "coredbaccess.h"
+#include "collectionmanager.h"
+#include "collectionscanner.h"
+#include "iteminfo.h"
+#include "itemlister.h"
+#include "itemlisterreceiver.h"
+
+using namespace Digikam;
+
+const QString imageFolder(QFINDTESTDATA("data/testimages/a1/jpg/"));
+
+QTEST_GUILESS_MAIN(CommentSearchTest)
+
+/*
+ * A new temporary database is created, with a collection of two images.
+ * Each image gets a comment, a headline and a title.
+ */
+void CommentSearchTest::initTestCase()
+{
+    QDir collectionDir = QDir(imageFolder);
+    QVERIFY(collectionDir.exists());
+
+    m_dbFile = QDir::tempPath() + QLatin1String("/digikamtests-CommentSearchTest-") +
+               QTime::currentTime().toString(QLatin1String("hhmmsszzz"));
+    DbEngineParameters params(QLatin1String("QSQLITE"), m_dbFile, QLatin1String("QSQLITE"), m_dbFile);
+    CoreDbAccess::setParameters(params, CoreDbAccess::MainApplication);
+    QVERIFY(CoreDbAccess::checkReadyForUse(0));
+
+    CollectionManager::instance()->addLocation(QUrl::fromLocalFile(collectionDir.path()));
+    CollectionScanner().completeScan();
+
+    m_towerId = ItemInfo::fromLocalFile(collectionDir.filePath(QLatin1String("foto001.jpg"))).id();
+    m_treeId  = ItemInfo::fromLocalFile(collectionDir.filePath(QLatin1String("foto001bw.jpg"))).id();
+
+    QVERIFY(m_towerId != -1);
+    QVERIFY(m_treeId  != -1);
+
+    const QList<DatabaseComment::Type> types = QList<DatabaseComment::Type>() << DatabaseComment::Comment
+                                                                               << DatabaseComment::Headline
+                                                                               << DatabaseComment::Title;
+
+    foreach (const DatabaseComment::Type type, types)
+    {
+        CoreDbAccess().db()->setImageComment(m_towerId, QLatin1String("The old tower at night"), type,
+                                             QLatin1String("x-default"));
+        CoreDbAccess().db()->setImageComment(m_treeId,  QLatin1String("A tree in the meadow"),   type,
+                                             QLatin1String("x-default"));
+    }
+
+    qDebug() << "Full text index version:" << CoreDbAccess().db()->getFullTextIndexVersion();
+}
+
+void CommentSearchTest::cleanupTestCase()
+{
+    QFile(m_dbFile).remove();
+}
+
+QList<qlonglong> CommentSearchTest::search(const QString& field, SearchXml::Relation relation, const QString& value) const
+{
+    SearchXmlWriter writer;
+    writer.writeGroup();
+    writer.writeField(field, relation);
+    writer.writeValue(value);
+    writer.finishField();
+    writer.finishGroup();
+    writer.finish();
+
+    ItemListerValueListReceiver receiver;
+    ItemLister().listSearch(&receiver, writer.xml());
+
+    QList<qlonglong> ids;
+
+    foreach (const ItemListerRecord& record, receiver.records)
+    {
+        ids << record.imageID;
+    }
+
+    return ids;
+}
+
+void CommentSearchTest::testContainsInsideWord()
+{
+    // "ower" is only found inside "tower", as with a plain LIKE search
+
+    const QStringList fields = QStringList() << QLatin1String("comment")
+                                             << QLatin1String("headline")
+                                             << QLatin1String("title")
+                                             << QLatin1String("keyword");
+
+    foreach (const QString& field, fields)
+    {
+        QCOMPARE(search(field, SearchXml::Like, QLatin1String("ower")),    QList<qlonglong>() << m_towerId);
+        QCOMPARE(search(field, SearchXml::Like, QLatin1String("eado")),    QList<qlonglong>() << m_treeId);
+        QCOMPARE(search(field, SearchXml::Like, QLatin1String("ld tow")),  QList<qlonglong>() << m_towerId);
+    }
+}
+
+void CommentSearchTest::testContainsWords()
+{
+    // Short words and stopwords are found too
+
+    QCOMPARE(search(QLatin1String("comment"), SearchXml::Like, QLatin1String("tower at")), QList<qlonglong>() << m_towerId);
+    QCOMPARE(search(QLatin1String("comment"), SearchXml::Like, QLatin1String("A tree")),   QList<qlonglong>() << m_treeId);
+    QVERIFY(search(QLatin1String("comment"), SearchXml::Like, QLatin1String("towers")).isEmpty());
+}
+
+void CommentSearchTest::testEqual()
+{
+    // Equality searches use the full text index, if any, with the same results
+
+    QCOMPARE(search(QLatin1String("comment"), SearchXml::Equal, QLatin1String("The old tower at night")),
+             QList<qlonglong>() << m_towerId);
+    QCOMPARE(search(QLatin1String("title"),   SearchXml::Equal, QLatin1String("A tree in the meadow")),
+             QList<qlonglong>() << m_treeId);
+    QVERIFY(search(QLatin1String("comment"), SearchXml::Equal, QLatin1String("The old tower")).isEmpty());
+    QVERIFY(search(QLatin1String("comment"), SearchXml::Equal, QLatin1String("tower")).isEmpty());
+}
@@ -0,0 +1,57 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-07-02
+ * Description : Test the comment searches of ItemQueryBuilder
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_COMMENT_SEARCH_TEST_H
+#define DIGIKAM_COMMENT_SEARCH_TEST_H
+
+// Qt includes
+
+#include <QtTest>
+
+// Local includes
+
+#include "coredbsearchxml.h"
+
+class CommentSearchTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testContainsInsideWord();
+    void testContainsWords();
+    void testEqual();
+
+private:
+
+    QList<qlonglong> search(const QString& field, Digikam::SearchXml::Relation relation, const QString& value) const;
+
+    QString   m_dbFile;
+    qlonglong m_towerId;
+    qlonglong m_treeId;
+};
+
+#endif // DIGIKAM_COMMENT_SEARCH_TEST_H
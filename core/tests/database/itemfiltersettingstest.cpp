@@ -0,0 +1,257 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-07
+ * Description : Test and benchmark tags filtering of ItemFilterSettings
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "itemfiltersettingstest.h"
+
+// Qt includes
+
+#include <QTest>
+
+// Local includes
+
+#include "itemfiltersettings.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(ItemFilterSettingsTest)
+
+const int BenchmarkItems = 100000;
+const int BenchmarkTags  = 50;
+const int TagsInDatabase = 2000;
+
+/**
+ * The tags filter as implemented before bit sets, testing each filter tag
+ * with a linear search in the tags of the item. Used as reference.
+ */
+static bool linearMatchesTags(const QList<int>& tagIds,
+                              const QList<int>& includedTags,
+                              const QList<int>& excludedTags,
+                              ItemFilterSettings::MatchingCondition matchingCond,
+                              bool untaggedFilter)
+{
+    QList<int>::const_iterator it;
+    bool match = includedTags.isEmpty();
+
+    if (matchingCond == ItemFilterSettings::OrCondition)
+    {
+        for (it = includedTags.begin() ; it != includedTags.end() ; ++it)
+        {
+            if (tagIds.contains(*it))
+            {
+                match = true;
+                break;
+            }
+        }
+
+        match |= (untaggedFilter && tagIds.isEmpty());
+    }
+    else if (!untaggedFilter)
+    {
+        for (it = includedTags.begin() ; it != includedTags.end() ; ++it)
+        {
+            if (!tagIds.contains(*it))
+            {
+                break;
+            }
+        }
+
+        if (it == includedTags.end())
+        {
+            match = true;
+        }
+    }
+
+    for (it = excludedTags.begin() ; it != excludedTags.end() ; ++it)
+    {
+        if (tagIds.contains(*it))
+        {
+            match = false;
+            break;
+        }
+    }
+
+    return match;
+}
+
+void ItemFilterSettingsTest::initTestCase()
+{
+    qsrand(42);
+
+    // Items have between 0 and 15 distinct tags.
+
+    for (int i = 0 ; i < BenchmarkItems ; ++i)
+    {
+        QList<int> tags;
+        int count = qrand() % 16;
+
+        while (tags.size() < count)
+        {
+            int id = 1 + qrand() % TagsInDatabase;
+
+            if (!tags.contains(id))
+            {
+                tags << id;
+            }
+        }
+
+        m_itemTags << tags;
+    }
+
+    while (m_includedTags.size() < BenchmarkTags)
+    {
+        int id = 1 + qrand() % TagsInDatabase;
+
+        if (!m_includedTags.contains(id))
+        {
+            m_includedTags << id;
+        }
+    }
+
+    while (m_excludedTags.size() < 5)
+    {
+        int id = 1 + qrand() % TagsInDatabase;
+
+        if (!m_includedTags.contains(id) && !m_excludedTags.contains(id))
+        {
+            m_excludedTags << id;
+        }
+    }
+}
+
+void ItemFilterSettingsTest::cleanupTestCase()
+{
+}
+
+void ItemFilterSettingsTest::testMatchesTags()
+{
+    // AND condition only matches with few included tags, use a small subset too.
+
+    QList<QList<int> > includedSets;
+    includedSets << m_includedTags << m_includedTags.mid(0, 2) << QList<int>();
+
+    foreach (const QList<int>& included, includedSets)
+    {
+        foreach (ItemFilterSettings::MatchingCondition cond,
+                 QList<ItemFilterSettings::MatchingCondition>() << ItemFilterSettings::OrCondition
+                                                                << ItemFilterSettings::AndCondition)
+        {
+            ItemFilterSettings settings;
+            settings.setTagFilter(included, m_excludedTags, cond, false, QList<int>(), QList<int>());
+
+            foreach (const QList<int>& tags, m_itemTags)
+            {
+                QCOMPARE(settings.matchesTags(tags),
+                         linearMatchesTags(tags, included, m_excludedTags, cond, false));
+            }
+        }
+    }
+
+    // AND condition with an item having all included tags.
+
+    ItemFilterSettings settings;
+    settings.setTagFilter(QList<int>() << 3 << 5 << 3, QList<int>(),
+                          ItemFilterSettings::AndCondition, false, QList<int>(), QList<int>());
+
+    QVERIFY(settings.matchesTags(QList<int>() << 1 << 3 << 5));
+    QVERIFY(!settings.matchesTags(QList<int>() << 1 << 3));
+}
+
+void ItemFilterSettingsTest::testMatchesTagsUntagged()
+{
+    ItemFilterSettings orSettings;
+    orSettings.setTagFilter(m_includedTags, m_excludedTags, ItemFilterSettings::OrCondition,
+                            true, QList<int>(), QList<int>());
+
+    QVERIFY(orSettings.matchesTags(QList<int>()));
+    QVERIFY(orSettings.matchesTags(QList<int>() << m_includedTags.first()));
+    QVERIFY(!orSettings.matchesTags(QList<int>() << m_includedTags.first() << m_excludedTags.first()));
+
+    ItemFilterSettings andSettings;
+    andSettings.setTagFilter(m_includedTags, QList<int>(), ItemFilterSettings::AndCondition,
+                             true, QList<int>(), QList<int>());
+
+    QVERIFY(!andSettings.matchesTags(QList<int>()));
+    QVERIFY(!andSettings.matchesTags(m_includedTags));
+}
+
+void ItemFilterSettingsTest::benchmarkLinearTagsFilter_data()
+{
+    QTest::addColumn<int>("matchingCond");
+
+    QTest::newRow("or")  << (int)ItemFilterSettings::OrCondition;
+    QTest::newRow("and") << (int)ItemFilterSettings::AndCondition;
+}
+
+void ItemFilterSettingsTest::benchmarkLinearTagsFilter()
+{
+    QFETCH(int, matchingCond);
+
+    int matched = 0;
+
+    QBENCHMARK
+    {
+        matched = 0;
+
+        foreach (const QList<int>& tags, m_itemTags)
+        {
+            if (linearMatchesTags(tags, m_includedTags, m_excludedTags,
+                                  (ItemFilterSettings::MatchingCondition)matchingCond, false))
+            {
+                ++matched;
+            }
+        }
+    }
+
+    qDebug() << matched << "of" << m_itemTags.size() << "items match" << m_includedTags.size() << "tags";
+}
+
+void ItemFilterSettingsTest::benchmarkTagsFilter_data()
+{
+    benchmarkLinearTagsFilter_data();
+}
+
+void ItemFilterSettingsTest::benchmarkTagsFilter()
+{
+    QFETCH(int, matchingCond);
+
+    ItemFilterSettings settings;
+    settings.setTagFilter(m_includedTags, m_excludedTags, (ItemFilterSettings::MatchingCondition)matchingCond,
+                          false, QList<int>(), QList<int>());
+
+    int matched = 0;
+
+    QBENCHMARK
+    {
+        matched = 0;
+
+        foreach (const QList<int>& tags, m_itemTags)
+        {
+            if (settings.matchesTags(tags))
+            {
+                ++matched;
+            }
+        }
+    }
+
+    qDebug() << matched << "of" << m_itemTags.size() << "items match" << m_includedTags.size() << "tags";
+}
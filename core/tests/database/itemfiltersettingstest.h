@@ -0,0 +1,55 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-07
+ * Description : Test and benchmark tags filtering of ItemFilterSettings
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_ITEM_FILTER_SETTINGS_TEST_H
+#define DIGIKAM_ITEM_FILTER_SETTINGS_TEST_H
+
+// Qt includes
+
+#include <QtTest>
+#include <QList>
+
+class ItemFilterSettingsTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testMatchesTags();
+    void testMatchesTagsUntagged();
+    void benchmarkLinearTagsFilter_data();
+    void benchmarkLinearTagsFilter();
+    void benchmarkTagsFilter_data();
+    void benchmarkTagsFilter();
+
+    void initTestCase();
+    void cleanupTestCase();
+
+private:
+
+    QList<QList<int> > m_itemTags;
+    QList<int>         m_includedTags;
+    QList<int>         m_excludedTags;
+};
+
+#endif // DIGIKAM_ITEM_FILTER_SETTINGS_TEST_H
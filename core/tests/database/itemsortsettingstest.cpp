@@ -0,0 +1,129 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-07-02
+ * Description : Test file name comparison of ItemSortSettings
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "itemsortsettingstest.h"
+
+// C++ includes
+
+#include <algorithm>
+
+// Qt includes
+
+#include <QStringList>
+
+// Local includes
+
+#include "itemsortsettings.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(ItemSortSettingsTest)
+
+/**
+ * Plain names mixed with versioned names ("_v"), which are compared ignoring punctuation.
+ * Comparing "IMG_1000.jpg" with "IMG_1000_v1.jpg" gives another result with punctuation.
+ */
+static QStringList mixedNames()
+{
+    return QStringList() << QLatin1String("IMG_1000.jpg")
+                         << QLatin1String("IMG_1000_v1.jpg")
+                         << QLatin1String("IMG_1000_v2.jpg")
+                         << QLatin1String("IMG_0999.jpg")
+                         << QLatin1String("IMG_1001.jpg")
+                         << QLatin1String("IMG_1001_v1.jpg")
+                         << QLatin1String("beach.jpg")
+                         << QLatin1String("beach_v1.jpg")
+                         << QLatin1String("sunset.png")
+                         << QLatin1String("sunset_v3.png");
+}
+
+static int sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+class NameLessThan
+{
+public:
+
+    explicit NameLessThan(Qt::SortOrder order)
+        : order(order)
+    {
+    }
+
+    bool operator()(const QString& a, const QString& b) const
+    {
+        return ItemSortSettings::naturalCompare(a, b, order) < 0;
+    }
+
+private:
+
+    Qt::SortOrder order;
+};
+
+static QStringList sorted(QStringList names, Qt::SortOrder order)
+{
+    std::sort(names.begin(), names.end(), NameLessThan(order));
+
+    return names;
+}
+
+void ItemSortSettingsTest::testNaturalCompareSymmetry()
+{
+    const QStringList names = mixedNames();
+
+    foreach (const QString& a, names)
+    {
+        foreach (const QString& b, names)
+        {
+            QCOMPARE(sign(ItemSortSettings::naturalCompare(a, b, Qt::AscendingOrder)),
+                     - sign(ItemSortSettings::naturalCompare(b, a, Qt::AscendingOrder)));
+            QCOMPARE(sign(ItemSortSettings::naturalCompare(a, b, Qt::DescendingOrder)),
+                     - sign(ItemSortSettings::naturalCompare(b, a, Qt::DescendingOrder)));
+        }
+    }
+}
+
+void ItemSortSettingsTest::testSortVersionedNames()
+{
+    const QStringList names = mixedNames();
+    QStringList reversed;
+
+    foreach (const QString& name, names)
+    {
+        reversed.prepend(name);
+    }
+
+    const QStringList ascending = sorted(names, Qt::AscendingOrder);
+
+    QCOMPARE(sorted(reversed, Qt::AscendingOrder), ascending);
+
+    // Each version follows its original.
+
+    QVERIFY(ascending.indexOf(QLatin1String("IMG_1000.jpg")) < ascending.indexOf(QLatin1String("IMG_1000_v1.jpg")));
+    QVERIFY(ascending.indexOf(QLatin1String("beach.jpg"))    < ascending.indexOf(QLatin1String("beach_v1.jpg")));
+
+    const QStringList descending = sorted(names, Qt::DescendingOrder);
+
+    QCOMPARE(sorted(reversed, Qt::DescendingOrder), descending);
+}
@@ -0,0 +1,41 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-07-02
+ * Description : Test file name comparison of ItemSortSettings
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_ITEM_SORT_SETTINGS_TEST_H
+#define DIGIKAM_ITEM_SORT_SETTINGS_TEST_H
+
+// Qt includes
+
+#include <QtTest>
+
+class ItemSortSettingsTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testNaturalCompareSymmetry();
+    void testSortVersionedNames();
+};
+
+#endif // DIGIKAM_ITEM_SORT_SETTINGS_TEST_H
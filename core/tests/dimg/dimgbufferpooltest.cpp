@@ -0,0 +1,157 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Test of the DImg pixel buffer pool
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "dimgbufferpooltest.h"
+
+// Qt includes
+
+#include <QTest>
+
+// Local includes
+
+#include "dimg.h"
+#include "dimgbufferpool.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(DImgBufferPoolTest)
+
+static const qint64 poolSize = 64 * 1024 * 1024;
+
+void DImgBufferPoolTest::init()
+{
+    DImgBufferPool::instance()->setMaximumSize(poolSize);
+    DImgBufferPool::instance()->clear();
+    DImgBufferPool::instance()->resetStatistics();
+}
+
+void DImgBufferPoolTest::cleanupTestCase()
+{
+    DImgBufferPool::instance()->clear();
+}
+
+void DImgBufferPoolTest::testReuse()
+{
+    for (int i = 0 ; i < 10 ; ++i)
+    {
+        DImg img(1000, 1000, false, true);
+        QVERIFY(!img.isNull());
+    }
+
+    DImgBufferPool::Statistics stats = DImgBufferPool::instance()->statistics();
+
+    QCOMPARE(stats.allocations, qint64(1));
+    QCOMPARE(stats.reuses,      qint64(9));
+    QCOMPARE(stats.releases,    qint64(10));
+    QCOMPARE(stats.pooledBytes, qint64(1000 * 1000 * 4));
+}
+
+void DImgBufferPoolTest::testSizeTolerance()
+{
+    DImgBufferPool* const pool = DImgBufferPool::instance();
+    const size_t size          = 1024 * 1024;
+
+    uchar* const buffer = pool->acquire(size);
+    QVERIFY(buffer);
+    pool->release(buffer, size);
+
+    // Half the size: too much memory would be wasted.
+    uchar* const smaller = pool->acquire(size / 2);
+    QVERIFY(smaller != buffer);
+    delete [] smaller;
+
+    // Larger than the buffer.
+    uchar* const larger = pool->acquire(size + 1);
+    QVERIFY(larger != buffer);
+    delete [] larger;
+
+    // Less than 1/8 smaller.
+    QCOMPARE(pool->acquire(size - size / 10), buffer);
+    delete [] buffer;
+
+    // Below the minimum size, buffers are never pooled.
+    uchar* const tiny = pool->acquire(1024);
+    pool->release(tiny, 1024);
+
+    QCOMPARE(pool->statistics().pooledBytes, qint64(0));
+}
+
+void DImgBufferPoolTest::testMaximumSize()
+{
+    DImgBufferPool* const pool = DImgBufferPool::instance();
+    const size_t size          = 16 * 1024 * 1024;
+
+    pool->setMaximumSize(2 * size);
+
+    for (int i = 0 ; i < 3 ; ++i)
+    {
+        pool->release(new uchar[size], size);
+    }
+
+    DImgBufferPool::Statistics stats = pool->statistics();
+
+    QCOMPARE(stats.pooledBytes, qint64(2 * size));
+    QCOMPARE(stats.drops,       qint64(1));
+
+    // Disabling the pool frees everything.
+    pool->setMaximumSize(0);
+
+    {
+        DImg img(1000, 1000, true);
+    }
+
+    stats = pool->statistics();
+
+    QCOMPARE(stats.pooledBytes, qint64(0));
+    QCOMPARE(stats.reuses,      qint64(0));
+}
+
+void DImgBufferPoolTest::testTransformChain()
+{
+    // As a batch queue tool chain on several items: each step allocates a new buffer
+    // and releases the former one.
+
+    const int items = 5;
+
+    for (int i = 0 ; i < items ; ++i)
+    {
+        DImg img(1200, 800, true, true);
+        img.rotate(DImg::ROT90);
+        img.rotate(DImg::ROT270);
+        img.convertDepth(32);
+        img.crop(100, 100, 800, 600);
+
+        DImg copy = img.copy();
+        copy.rotate(DImg::ROT90);
+
+        QCOMPARE(copy.width(),  600U);
+        QCOMPARE(copy.height(), 800U);
+    }
+
+    DImgBufferPool::Statistics stats = DImgBufferPool::instance()->statistics();
+    qDebug() << stats.toString();
+
+    // Only the first two items need new buffers, the next ones take theirs from the pool.
+    QVERIFY(stats.allocations <= 8);
+    QVERIFY(stats.reuses      >= (items - 2) * 6);
+}
@@ -0,0 +1,114 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-15
+ * Description : Test of JPEG region and reduced size loading
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "dimgjpegregiontest.h"
+
+// C++ includes
+
+#include <cstdlib>
+
+// Qt includes
+
+#include <QRect>
+#include <QTest>
+
+// Local includes
+
+#include "dimg.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(DImgJpegRegionTest)
+
+static QString testFile()
+{
+    return QFINDTESTDATA("data/DSC00636.JPG");
+}
+
+/** Mean absolute difference of the color channels of two 8 bits images of the same size.
+ *  Fancy upsampling can differ slightly at the left border of a partially decoded region.
+ */
+static double meanDifference(const DImg& a, const DImg& b)
+{
+    const uchar* pa = a.bits();
+    const uchar* pb = b.bits();
+    qint64 sum      = 0;
+    qint64 count    = (qint64)a.width() * a.height() * 4;
+
+    for (qint64 i = 0 ; i < count ; ++i)
+    {
+        sum += std::abs((int)pa[i] - (int)pb[i]);
+    }
+
+    return (double)sum / (double)count;
+}
+
+void DImgJpegRegionTest::testRegion_data()
+{
+    QTest::addColumn<QRect>("region");
+
+    QTest::newRow("aligned")     << QRect(64, 32, 256, 128);
+    QTest::newRow("not aligned") << QRect(101, 57, 300, 201);
+    QTest::newRow("top left")    << QRect(0, 0, 50, 50);
+}
+
+void DImgJpegRegionTest::testRegion()
+{
+    QFETCH(QRect, region);
+
+    DImg full(testFile());
+    QVERIFY(!full.isNull());
+    QVERIFY(QRect(QPoint(0, 0), full.size()).contains(region));
+
+    DImg img;
+    img.setAttribute(QLatin1String("loadingRegion"), region);
+    QVERIFY(img.load(testFile()));
+
+    QCOMPARE(img.attribute(QLatin1String("loadedRegion")).toRect(), region);
+    QCOMPARE(img.size(), region.size());
+    QCOMPARE(img.originalSize(), full.size());
+
+    DImg expected = full.copy(region);
+    QVERIFY(meanDifference(img, expected) < 2.0);
+}
+
+void DImgJpegRegionTest::testScaledRegion()
+{
+    DImg full(testFile());
+    QVERIFY(!full.isNull());
+
+    QRect region(0, 0, full.width() / 2, full.height() / 2);
+    int   size = qMax(region.width(), region.height()) / 4;
+
+    DImg img;
+    img.setAttribute(QLatin1String("loadingRegion"),     region);
+    img.setAttribute(QLatin1String("scaledLoadingSize"), size);
+    QVERIFY(img.load(testFile()));
+
+    QCOMPARE(img.attribute(QLatin1String("loadedRegion")).toRect(), region);
+    QCOMPARE(img.originalSize(), full.size());
+
+    // The region is decoded at reduced size, but not smaller than requested.
+    QVERIFY((int)qMax(img.width(), img.height()) < qMax(region.width(), region.height()));
+    QVERIFY((int)qMax(img.width(), img.height()) >= size);
+}
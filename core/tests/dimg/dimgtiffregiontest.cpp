@@ -0,0 +1,98 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-22
+ * Description : Test of TIFF region loading
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "dimgtiffregiontest.h"
+
+// C++ includes
+
+#include <cstring>
+
+// Qt includes
+
+#include <QRect>
+#include <QTest>
+
+// Local includes
+
+#include "dimg.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(DImgTiffRegionTest)
+
+static QString tiffFile(const QTemporaryDir& dir, bool sixteenBit)
+{
+    return dir.filePath(sixteenBit ? QLatin1String("region16.tif") : QLatin1String("region8.tif"));
+}
+
+void DImgTiffRegionTest::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+
+    DImg img(QFINDTESTDATA("data/DSC00636.JPG"));
+    QVERIFY(!img.isNull());
+
+    // The TIFF loader uses several strips for this size.
+    QVERIFY(img.save(tiffFile(m_tempDir, false), DImg::TIFF));
+
+    img.convertDepth(64);
+    QVERIFY(img.save(tiffFile(m_tempDir, true), DImg::TIFF));
+}
+
+void DImgTiffRegionTest::testRegion_data()
+{
+    QTest::addColumn<bool>("sixteenBit");
+    QTest::addColumn<QRect>("region");
+
+    QTest::newRow("8 bits")             << false << QRect(101, 57, 300, 201);
+    QTest::newRow("8 bits top left")    << false << QRect(0, 0, 50, 50);
+    QTest::newRow("16 bits")            << true  << QRect(101, 57, 300, 201);
+    QTest::newRow("16 bits full width") << true  << QRect(0, 33, 640, 77);
+}
+
+void DImgTiffRegionTest::testRegion()
+{
+    QFETCH(bool,  sixteenBit);
+    QFETCH(QRect, region);
+
+    const QString path = tiffFile(m_tempDir, sixteenBit);
+    DImg full(path);
+    QVERIFY(!full.isNull());
+    QCOMPARE(full.sixteenBit(), sixteenBit);
+
+    region = region.intersected(QRect(QPoint(0, 0), full.size()));
+    QVERIFY(region.isValid());
+
+    DImg img;
+    img.setAttribute(QLatin1String("loadingRegion"), region);
+    QVERIFY(img.load(path));
+
+    QCOMPARE(img.attribute(QLatin1String("loadedRegion")).toRect(), region);
+    QCOMPARE(img.size(), region.size());
+    QCOMPARE(img.originalSize(), full.size());
+
+    // TIFF is lossless: the region must be exactly the same data.
+    DImg expected = full.copy(region);
+    QCOMPARE(img.numBytes(), expected.numBytes());
+    QVERIFY(memcmp(img.bits(), expected.bits(), img.numBytes()) == 0);
+}
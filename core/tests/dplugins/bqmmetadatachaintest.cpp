@@ -0,0 +1,122 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-07-02
+ * Description : Test metadata passed along a chain of batch tools
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "bqmmetadatachaintest.h"
+
+// Qt includes
+
+#include <QFile>
+#include <QStandardPaths>
+
+// Local includes
+
+#include "assigntemplate.h"
+#include "removemetadata.h"
+#include "dmetadata.h"
+#include "template.h"
+#include "templatemanager.h"
+
+using namespace Digikam;
+using namespace DigikamBqmAssignTemplatePlugin;
+using namespace DigikamBqmRemoveMetadataPlugin;
+
+const QString originalImageFile(QFINDTESTDATA("../metadataengine/data/nikon-e2100.jpg"));
+const QString templateTitle(QLatin1String("BqmMetadataChainTest"));
+
+QTEST_MAIN(BqmMetadataChainTest)
+
+void BqmMetadataChainTest::initTestCase()
+{
+    MetaEngine::initializeExiv2();
+
+    // Do not touch the templates of the user.
+    QStandardPaths::setTestModeEnabled(true);
+
+    QVERIFY(m_tempDir.isValid());
+    QVERIFY(QFile::exists(originalImageFile));
+
+    Template t;
+    t.setTemplateTitle(templateTitle);
+    t.setAuthors(QStringList() << QLatin1String("digiKam tester"));
+    t.setCredit(QLatin1String("BqmMetadataChainTest credit"));
+    TemplateManager::defaultManager()->insert(t);
+}
+
+void BqmMetadataChainTest::cleanupTestCase()
+{
+    TemplateManager::defaultManager()->clear();
+    MetaEngine::cleanupExiv2();
+}
+
+/**
+ * As done by Task: AssignTemplate only changes metadata, which is kept pending in memory.
+ * RemoveMetadata, last tool of the chain, must write it to the output file even if it
+ * removes nothing.
+ */
+void BqmMetadataChainTest::testAssignTemplateThenRemoveNothing()
+{
+    const QString input = m_tempDir.path() + QLatin1String("/input.jpg");
+    QFile::remove(input);
+    QVERIFY(QFile::copy(originalImageFile, input));
+
+    const QUrl inputUrl   = QUrl::fromLocalFile(input);
+    const QUrl workingUrl = QUrl::fromLocalFile(m_tempDir.path());
+
+    BatchToolSettings assignSettings;
+    assignSettings.insert(QLatin1String("TemplateTitle"), templateTitle);
+
+    AssignTemplate assign;
+    assign.setInputUrl(inputUrl);
+    assign.setWorkingUrl(workingUrl);
+    assign.setSettings(assignSettings);
+    assign.setLastChainedTool(false);
+    assign.setOutputUrlFromInputUrl();
+
+    QVERIFY(assign.apply());
+    QVERIFY(assign.hasPendingMetadata());
+
+    BatchToolSettings removeSettings;
+    removeSettings.insert(QLatin1String("RemoveExif"),     false);
+    removeSettings.insert(QLatin1String("RemoveIptc"),     false);
+    removeSettings.insert(QLatin1String("RemoveXmp"),      false);
+    removeSettings.insert(QLatin1String("RemoveXmpVideo"), false);
+
+    // Nothing was written by the first tool: the next one reads the same input file.
+
+    RemoveMetadata remove;
+    remove.setInputUrl(inputUrl);
+    remove.setWorkingUrl(workingUrl);
+    remove.setSettings(removeSettings);
+    remove.setLastChainedTool(true);
+    remove.setPendingMetadata(assign.pendingMetadata());
+    remove.setOutputUrlFromInputUrl();
+
+    QVERIFY(remove.apply());
+
+    DMetadata output;
+    QVERIFY(output.load(remove.outputUrl().toLocalFile()));
+
+    Template written = output.getMetadataTemplate();
+    QVERIFY(written.authors().contains(QLatin1String("digiKam tester")));
+    QCOMPARE(written.credit(),  QLatin1String("BqmMetadataChainTest credit"));
+}
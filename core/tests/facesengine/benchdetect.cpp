@@ -0,0 +1,130 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Face detection throughput benchmark CLI tool
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+// Qt includes
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImage>
+#include <QThread>
+#include <QtConcurrent>    // krazy:exclude=includes
+#include <QDebug>
+
+// Local includes
+
+#include "facedetector.h"
+
+using namespace Digikam;
+
+/**
+ * Detects the faces in one image out of step, starting at first, as one
+ * detection worker of the face pipeline does. Returns the number of faces.
+ */
+int detectSlice(const QList<QImage>& images, int first, int step)
+{
+    FaceDetector detector;
+    int faces = 0;
+
+    for (int i = first ; i < images.size() ; i += step)
+    {
+        faces += detector.detectFaces(images.at(i)).size();
+    }
+
+    return faces;
+}
+
+void benchmark(const QList<QImage>& images, int detectors, int rounds)
+{
+    QElapsedTimer timer;
+    int faces = 0;
+
+    timer.start();
+
+    for (int round = 0 ; round < rounds ; ++round)
+    {
+        QList<QFuture<int> > tasks;
+
+        for (int i = 0 ; i < detectors ; ++i)
+        {
+            tasks.append(QtConcurrent::run(&detectSlice, images, i, detectors));
+        }
+
+        foreach (QFuture<int> t, tasks)
+        {
+            faces += t.result();
+        }
+    }
+
+    const qint64 elapsed = qMax(timer.elapsed(), (qint64)1);
+
+    qDebug() << detectors << "detector(s):" << images.size() * rounds << "images," << faces << "faces in"
+             << elapsed << "ms =" << (images.size() * rounds * 1000.0 / elapsed) << "images/s";
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        qDebug() << "Bad Arguments!!!\nUsage: " << argv[0] << " <image directory> [rounds]";
+        return 0;
+    }
+
+    QCoreApplication app(argc, argv);
+
+    QDir dir(QString::fromLocal8Bit(argv[1]));
+    const int rounds = (argc > 2) ? qMax(1, QString::fromLocal8Bit(argv[2]).toInt()) : 3;
+
+    QList<QImage> images;
+
+    foreach (const QFileInfo& info, dir.entryInfoList(QDir::Files, QDir::Name))
+    {
+        QImage image(info.absoluteFilePath());
+
+        if (!image.isNull())
+        {
+            images << image;
+        }
+    }
+
+    if (images.isEmpty())
+    {
+        qDebug() << "No image found in" << dir.path();
+        return 0;
+    }
+
+    qDebug() << "Loaded" << images.size() << "images from" << dir.path();
+
+    // The first detection loads the cascades, it is not counted
+
+    detectSlice(images.mid(0, 1), 0, 1);
+
+    benchmark(images, 1, rounds);
+
+    // Same number of detectors as the face pipeline
+
+    benchmark(images, qMin(3, QThread::idealThreadCount()), rounds);
+
+    return 0;
+}
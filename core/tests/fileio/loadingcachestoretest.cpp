@@ -0,0 +1,225 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Unit tests of the loading cache store
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "loadingcachestoretest.h"
+
+// Qt includes
+
+#include <QFuture>
+#include <QList>
+#include <QTest>
+#include <QtConcurrent>    // krazy:exclude=includes
+
+// Local includes
+
+#include "loadingcachestore.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(LoadingCacheStoreTest)
+
+static QString key(const QString& prefix, int i)
+{
+    return prefix + QString::number(i);
+}
+
+void LoadingCacheStoreTest::testCostLimit()
+{
+    LoadingCacheStore<int> store(4);
+    store.setMaxCost(100);
+
+    for (int i = 0 ; i < 50 ; ++i)
+    {
+        QVERIFY(store.insert(key(QLatin1String("k"), i), i, 10));
+        QVERIFY(store.totalCost() <= 100);
+    }
+
+    QCOMPARE(store.count(), 10);
+
+    // Replacing a value does not count twice.
+    QVERIFY(store.insert(QLatin1String("k49"), 49, 10));
+    QCOMPARE(store.totalCost(), qint64(100));
+
+    // Shrinking the limit evicts immediately.
+    store.setMaxCost(30);
+    QVERIFY(store.totalCost() <= 30);
+
+    store.clear();
+    QCOMPARE(store.count(),     0);
+    QCOMPARE(store.totalCost(), qint64(0));
+}
+
+void LoadingCacheStoreTest::testOversizedEntry()
+{
+    LoadingCacheStore<int> store(4);
+    store.setMaxCost(100);
+
+    QVERIFY(store.insert(QLatin1String("a"), 1, 10));
+    QVERIFY(!store.insert(QLatin1String("a"), 2, 101));
+
+    // As with QCache, the previous value is gone.
+    QVERIFY(!store.contains(QLatin1String("a")));
+    QCOMPARE(store.statistics().rejections, quint64(1));
+
+    // An entry as large as the cache takes the room of all other shards.
+    for (int i = 0 ; i < 10 ; ++i)
+    {
+        store.insert(key(QLatin1String("k"), i), i, 10);
+    }
+
+    QVERIFY(store.insert(QLatin1String("big"), 0, 100));
+    QCOMPARE(store.count(), 1);
+    QVERIFY(store.contains(QLatin1String("big")));
+}
+
+void LoadingCacheStoreTest::testStatistics()
+{
+    LoadingCacheStore<int> store(2);
+    store.setMaxCost(3);
+
+    store.insert(QLatin1String("a"), 1, 1);
+    store.insert(QLatin1String("b"), 2, 1);
+    store.insert(QLatin1String("c"), 3, 1);
+    store.insert(QLatin1String("d"), 4, 1);
+
+    int value = 0;
+    QVERIFY(store.find(QLatin1String("d"), &value));
+    QCOMPARE(value, 4);
+    QVERIFY(!store.find(QLatin1String("x")));
+
+    LoadingCacheStatistics stats = store.statistics();
+    QCOMPARE(stats.hits,       quint64(1));
+    QCOMPARE(stats.misses,     quint64(1));
+    QCOMPARE(stats.insertions, quint64(4));
+    QCOMPARE(stats.evictions,  quint64(1));
+    QCOMPARE(stats.count,      3);
+    QCOMPARE(stats.totalCost,  qint64(3));
+    QCOMPARE(stats.maxCost,    qint64(3));
+    QCOMPARE(stats.hitRate(),  0.5);
+
+    store.resetStatistics();
+    QCOMPARE(store.statistics().hits, quint64(0));
+}
+
+void LoadingCacheStoreTest::testScanResistance()
+{
+    // A single shard makes the 2Q segments easy to reason about.
+    LoadingCacheStore<int> store(1);
+    store.setMaxCost(100);
+
+    // Build a working set of 20 entries which were requested again after eviction.
+    for (int round = 0 ; round < 2 ; ++round)
+    {
+        for (int i = 0 ; i < 20 ; ++i)
+        {
+            store.insert(key(QLatin1String("hot"), i), i, 1);
+        }
+
+        // Flush the probation segment, turning the working set into ghosts the first time.
+        for (int i = 0 ; i < 100 ; ++i)
+        {
+            store.insert(key(QLatin1String("flush"), round * 100 + i), i, 1);
+        }
+    }
+
+    // A long scan of entries seen only once, as when scrolling through a large album.
+    for (int i = 0 ; i < 10000 ; ++i)
+    {
+        store.insert(key(QLatin1String("scan"), i), i, 1);
+    }
+
+    for (int i = 0 ; i < 20 ; ++i)
+    {
+        QVERIFY2(store.contains(key(QLatin1String("hot"), i)), qPrintable(key(QLatin1String("hot"), i)));
+    }
+
+    QVERIFY(store.totalCost() <= 100);
+}
+
+void LoadingCacheStoreTest::testDecodeTimeWeighting()
+{
+    LoadingCacheStore<int> store(1);
+    store.setMaxCost(4);
+
+    // Same size, the oldest entry was expensive to decode.
+    store.insert(QLatin1String("slow"), 0, 1, 500);
+    store.insert(QLatin1String("fast1"), 1, 1, 1);
+    store.insert(QLatin1String("fast2"), 2, 1, 1);
+    store.insert(QLatin1String("fast3"), 3, 1, 1);
+    store.insert(QLatin1String("new"),   4, 1, 1);
+
+    QVERIFY(store.contains(QLatin1String("slow")));
+    QVERIFY(store.contains(QLatin1String("new")));
+    QCOMPARE(store.count(), 4);
+}
+
+static int hammer(LoadingCacheStore<int>* const store, int thread)
+{
+    int hits = 0;
+
+    for (int i = 0 ; i < 20000 ; ++i)
+    {
+        const QString k = key(QLatin1String("k"), (i * 7 + thread) % 500);
+
+        if (store->find(k))
+        {
+            ++hits;
+        }
+        else
+        {
+            store->insert(k, i, 1 + (i % 3));
+        }
+
+        if ((i % 97) == 0)
+        {
+            store->remove(k);
+        }
+    }
+
+    return hits;
+}
+
+void LoadingCacheStoreTest::testConcurrentAccess()
+{
+    LoadingCacheStore<int> store(16);
+    store.setMaxCost(400);
+
+    QList<QFuture<int> > tasks;
+
+    for (int t = 0 ; t < 8 ; ++t)
+    {
+        tasks << QtConcurrent::run(hammer, &store, t);
+    }
+
+    foreach (QFuture<int> task, tasks)
+    {
+        task.waitForFinished();
+    }
+
+    LoadingCacheStatistics stats = store.statistics();
+    QCOMPARE(stats.hits + stats.misses, quint64(8 * 20000));
+    QVERIFY(store.totalCost() <= 400);
+
+    store.clear();
+    QCOMPARE(store.totalCost(), qint64(0));
+}
@@ -0,0 +1,162 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-08
+ * Description : Regression test of multithreaded PGF encoding and decoding
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "pgfparalleltest.h"
+
+// Qt includes
+
+#include <QtConcurrent>    // krazy:exclude=includes
+#include <QByteArray>
+#include <QImage>
+#include <QTest>
+
+// Local includes
+
+#include "pgfutils.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(PGFParallelTest)
+
+static QImage testImage()
+{
+    QImage img(QFINDTESTDATA("data/test.png"));
+
+    return img.convertToFormat(QImage::Format_ARGB32);
+}
+
+static QByteArray encode(const QImage& img, int quality, bool parallel)
+{
+    QByteArray data;
+    PGFUtils::setParallelCodec(parallel);
+
+    if (!PGFUtils::writePGFImageData(img, data, quality))
+    {
+        return QByteArray();
+    }
+
+    return data;
+}
+
+void PGFParallelTest::cleanupTestCase()
+{
+    PGFUtils::setParallelCodec(true);
+}
+
+void PGFParallelTest::testEncodeData_data()
+{
+    QTest::addColumn<int>("quality");
+
+    // 0 is lossless, 3 is used to store thumbnails in database.
+    QTest::newRow("lossless")  << 0;
+    QTest::newRow("thumbnail") << 3;
+}
+
+void PGFParallelTest::testEncodeData()
+{
+    QFETCH(int, quality);
+
+    QImage img = testImage();
+    QVERIFY(!img.isNull());
+
+    QByteArray serial   = encode(img, quality, false);
+    QByteArray parallel = encode(img, quality, true);
+
+    QVERIFY(!serial.isEmpty());
+
+    // The encoder writes macro blocks in order: the streams must be identical.
+    QCOMPARE(parallel, serial);
+}
+
+void PGFParallelTest::testDecodeData()
+{
+    QImage img      = testImage();
+    QByteArray data = encode(img, 0, false);
+    QVERIFY(!data.isEmpty());
+
+    QImage serial, parallel;
+
+    PGFUtils::setParallelCodec(false);
+    QVERIFY(PGFUtils::readPGFImageData(data, serial));
+
+    PGFUtils::setParallelCodec(true);
+    QVERIFY(PGFUtils::readPGFImageData(data, parallel));
+
+    QCOMPARE(parallel.size(), img.size());
+    QCOMPARE(parallel, serial);
+
+    // Lossless compression
+    QCOMPARE(parallel, img);
+}
+
+void PGFParallelTest::testLoadScaled()
+{
+    // Same file than used with pgfscaled tool.
+    QString path = QFINDTESTDATA("data/raw.pgf");
+    QVERIFY(!path.isEmpty());
+
+    QImage serial, parallel;
+
+    PGFUtils::setParallelCodec(false);
+    QVERIFY(PGFUtils::loadPGFScaled(serial, path, 1280));
+
+    PGFUtils::setParallelCodec(true);
+    QVERIFY(PGFUtils::loadPGFScaled(parallel, path, 1280));
+
+    QVERIFY(!parallel.isNull());
+    QCOMPARE(parallel, serial);
+}
+
+static bool roundTrip(const QImage& img, const QByteArray& expected)
+{
+    QByteArray data;
+    QImage     decoded;
+
+    return (PGFUtils::writePGFImageData(img, data, 3) &&
+            (data == expected)                        &&
+            PGFUtils::readPGFImageData(data, decoded) &&
+            (decoded.size() == img.size()));
+}
+
+void PGFParallelTest::testConcurrentCallers()
+{
+    // Thumbnails are stored from several threads at the same time, all sharing the codec thread pool.
+
+    QImage img          = testImage();
+    QByteArray expected = encode(img, 3, false);
+    QVERIFY(!expected.isEmpty());
+
+    PGFUtils::setParallelCodec(true);
+
+    QList<QFuture<bool> > tasks;
+
+    for (int i = 0 ; i < 16 ; ++i)
+    {
+        tasks << QtConcurrent::run(roundTrip, img, expected);
+    }
+
+    foreach (QFuture<bool> t, tasks)
+    {
+        QVERIFY(t.result());
+    }
+}
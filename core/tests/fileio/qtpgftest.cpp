@@ -77,6 +77,31 @@ int main(int /*argc*/, char** /*argv*/)
 
     qDebug() << "PGF Encoding time: " << double(end - start)/CLOCKS_PER_SEC << " s";
 
+    // Same encoding without multithreading, the data must be identical.
+
+    QByteArray serialPgfData;
+    PGFUtils::setParallelCodec(false);
+
+    start = clock();
+
+    if (!PGFUtils::writePGFImageData(img, serialPgfData, 0, true))
+    {
+        qDebug() << "writePGFImageData failed...";
+        return -1;
+    }
+
+    end   = clock();
+
+    PGFUtils::setParallelCodec(true);
+
+    qDebug() << "PGF Encoding time without multithreading: " << double(end - start)/CLOCKS_PER_SEC << " s";
+
+    if (serialPgfData != pgfData)
+    {
+        qDebug() << "PGF data encoded with and without multithreading differ...";
+        return -1;
+    }
+
     // Write PGF file.
 
     QFile file(QLatin1String("test-datastream.pgf"));
@@ -0,0 +1,231 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Benchmark of the two stage thumbnail loading
+ *               with placeholders from the thumbnail database
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "thumbnailplaceholdertest.h"
+
+// Qt includes
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QPixmap>
+#include <QSemaphore>
+#include <QSignalSpy>
+#include <QTest>
+
+// Local includes
+
+#include "dbengineparameters.h"
+#include "loadingcache.h"
+#include "thumbnailcreator.h"
+#include "thumbnailinfo.h"
+#include "thumbnailloadthread.h"
+#include "thumbsdb.h"
+#include "thumbsdbaccess.h"
+
+using namespace Digikam;
+
+QTEST_MAIN(ThumbnailPlaceholderTest)
+
+const int ItemCount = 48;
+const int ThumbSize = 256;
+
+static void clearPixmapCache()
+{
+    LoadingCache* const cache = LoadingCache::cache();
+    LoadingCache::CacheLock lock(cache);
+    cache->removeThumbnails();
+}
+
+/**
+ * A thumbnail thread which does not take any task before resume() is called.
+ */
+class SuspendedThumbnailLoadThread : public ThumbnailLoadThread
+{
+public:
+
+    void resume()
+    {
+        m_resume.release();
+    }
+
+protected:
+
+    void run()
+    {
+        // Let the next runs of the thread pass as well.
+        m_resume.acquire();
+        m_resume.release();
+
+        ThumbnailLoadThread::run();
+    }
+
+private:
+
+    QSemaphore m_resume;
+};
+
+static QList<ThumbnailIdentifier> identifiers(const QStringList& files)
+{
+    QList<ThumbnailIdentifier> ids;
+
+    foreach (const QString& file, files)
+    {
+        ids << ThumbnailIdentifier(file);
+    }
+
+    return ids;
+}
+
+void ThumbnailPlaceholderTest::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+
+    QString original = QFINDTESTDATA("data/test.png");
+    QVERIFY(!original.isEmpty());
+
+    for (int i = 0 ; i < ItemCount ; ++i)
+    {
+        QString file = m_tempDir.path() + QString::fromLatin1("/item%1.png").arg(i);
+        QVERIFY(QFile::copy(original, file));
+        m_files << file;
+    }
+
+    // Must be done before the first thumbnail thread is created.
+    ThumbnailLoadThread::initializeThumbnailDatabase(DbEngineParameters::parametersForSQLiteDefaultFile(m_tempDir.path()));
+    QVERIFY(ThumbsDbAccess::isInitialized());
+}
+
+void ThumbnailPlaceholderTest::testPlaceholdersStored()
+{
+    ThumbnailLoadThread thread;
+    thread.setPixmapRequested(false);
+
+    foreach (const QString& file, m_files)
+    {
+        thread.thumbnailCreator()->pregenerate(ThumbnailIdentifier(file));
+    }
+
+    QHash<QString, QByteArray> placeholders = ThumbsDbAccess().db()->findPlaceholdersByFilePaths(m_files);
+    QCOMPARE(placeholders.size(), m_files.size());
+
+    QImage placeholder;
+    QVERIFY(placeholder.loadFromData(placeholders.value(m_files.first())));
+    QVERIFY(qMax(placeholder.width(), placeholder.height()) <= ThumbnailCreator::placeholderSize());
+}
+
+void ThumbnailPlaceholderTest::testTimeToFirstPaint()
+{
+    clearPixmapCache();
+
+    ThumbnailLoadThread thread;
+    QList<ThumbnailIdentifier> ids = identifiers(m_files);
+    QPixmap pix;
+
+    // Stage one: placeholders, read with one query and scaled synchronously.
+
+    QElapsedTimer timer;
+    timer.start();
+
+    thread.loadPlaceholders(ids);
+    int found = 0;
+
+    foreach (const ThumbnailIdentifier& id, ids)
+    {
+        if (thread.findPlaceholder(id, pix, ThumbSize))
+        {
+            ++found;
+        }
+    }
+
+    qint64 placeholdersTime = timer.nsecsElapsed();
+
+    QCOMPARE(found, ids.size());
+    QVERIFY(!pix.isNull());
+
+    // Stage two: full thumbnails, loaded by the thread.
+
+    QSignalSpy spy(&thread, SIGNAL(signalThumbnailLoaded(LoadingDescription,QPixmap)));
+    timer.restart();
+
+    thread.findGroup(ids, ThumbSize);
+
+    QTRY_VERIFY_WITH_TIMEOUT(spy.count() >= 1, 30000);
+    qint64 firstThumbnailTime = timer.nsecsElapsed();
+
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), ids.size(), 30000);
+    qint64 allThumbnailsTime  = timer.nsecsElapsed();
+
+    qDebug() << "Time to first paint for" << ids.size() << "items:"
+             << "placeholders" << placeholdersTime / 1000   << "us,"
+             << "first thumbnail" << firstThumbnailTime / 1000 << "us,"
+             << "all thumbnails" << allThumbnailsTime / 1000  << "us";
+
+    // The thumbnails are in the pixmap cache now and take precedence.
+    QVERIFY(thread.find(ids.first(), pix, ThumbSize));
+}
+
+void ThumbnailPlaceholderTest::testCancelGroup()
+{
+    clearPixmapCache();
+
+    SuspendedThumbnailLoadThread thread;
+    QList<ThumbnailIdentifier> ids = identifiers(m_files);
+    QSignalSpy spy(&thread, SIGNAL(signalThumbnailLoaded(LoadingDescription,QPixmap)));
+    QObject requester;
+
+    thread.findGroup(ids, ThumbSize, &requester);
+    QList<LoadingDescription> descriptions = thread.lastDescriptions();
+    QCOMPARE(descriptions.size(), ids.size());
+
+    // No task started yet, all are removed.
+    thread.cancelGroup(descriptions, &requester);
+    thread.resume();
+    thread.wait();
+
+    // Deliver the results queued to this thread, if any.
+    QTest::qWait(100);
+
+    QCOMPARE(spy.count(), 0);
+}
+
+void ThumbnailPlaceholderTest::testCancelSharedGroup()
+{
+    clearPixmapCache();
+
+    SuspendedThumbnailLoadThread thread;
+    QList<ThumbnailIdentifier> ids = identifiers(m_files);
+    QSignalSpy spy(&thread, SIGNAL(signalThumbnailLoaded(LoadingDescription,QPixmap)));
+    QObject first;
+    QObject second;
+
+    thread.findGroup(ids, ThumbSize, &first);
+    QList<LoadingDescription> descriptions = thread.lastDescriptions();
+    thread.findGroup(ids, ThumbSize, &second);
+
+    // The second requester still waits for the thumbnails.
+    thread.cancelGroup(descriptions, &first);
+    thread.resume();
+
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), ids.size(), 30000);
+}
@@ -0,0 +1,52 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Benchmark of the two stage thumbnail loading
+ *               with placeholders from the thumbnail database
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_THUMBNAIL_PLACEHOLDER_TEST_H
+#define DIGIKAM_THUMBNAIL_PLACEHOLDER_TEST_H
+
+// Qt includes
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QStringList>
+
+class ThumbnailPlaceholderTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void testPlaceholdersStored();
+    void testTimeToFirstPaint();
+    void testCancelGroup();
+    void testCancelSharedGroup();
+
+private:
+
+    QTemporaryDir m_tempDir;
+    QStringList   m_files;
+};
+
+#endif // DIGIKAM_THUMBNAIL_PLACEHOLDER_TEST_H
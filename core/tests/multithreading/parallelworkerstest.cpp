@@ -0,0 +1,137 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Test of the load distribution of parallel worker objects
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "parallelworkerstest.h"
+
+// Local includes
+
+#include "parallelworkers.h"
+
+using namespace Digikam;
+
+QTEST_GUILESS_MAIN(ParallelWorkersTest)
+
+/// One expensive call, as a huge RAW file, followed by many cheap ones.
+static const int shortCalls  = 20;
+static const int workerCount = 2;
+
+QSemaphore BlockingWorker::gate;
+
+void BlockingWorker::process(int id, bool blocking)
+{
+    if (blocking)
+    {
+        gate.acquire();
+    }
+
+    emit processed(id);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void ParallelWorkersTest::slotProcessed(int id)
+{
+    m_done[id] = sender();
+}
+
+void ParallelWorkersTest::testAllCallsProcessed()
+{
+    ParallelAdapter<BlockingWorker>* const adapter = new ParallelAdapter<BlockingWorker>();
+
+    for (int i = 0 ; i < 4 ; ++i)
+    {
+        adapter->add(new BlockingWorker);
+    }
+
+    QVERIFY(adapter->connect(SIGNAL(processed(int)), this, SLOT(slotProcessed(int)), Qt::QueuedConnection));
+    QVERIFY(connect(this, SIGNAL(work(int,bool)), adapter, SLOT(process(int,bool)), Qt::DirectConnection));
+
+    m_done.clear();
+
+    for (int id = 0 ; id < 100 ; ++id)
+    {
+        emit work(id, false);
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_done.size(), 100, 10000);
+
+    disconnect(this, 0, adapter, 0);
+    delete adapter;
+}
+
+void ParallelWorkersTest::testSkewedLoad()
+{
+    // The first call blocks its worker until all the cheap calls are done.
+    // Each call goes to a free worker: the cheap calls must all go around the blocked one.
+
+    ParallelAdapter<BlockingWorker>* const adapter = new ParallelAdapter<BlockingWorker>();
+
+    for (int i = 0 ; i < workerCount ; ++i)
+    {
+        adapter->add(new BlockingWorker);
+    }
+
+    QVERIFY(adapter->connect(SIGNAL(processed(int)), this, SLOT(slotProcessed(int)), Qt::QueuedConnection));
+    QVERIFY(connect(this, SIGNAL(work(int,bool)), adapter, SLOT(process(int,bool)), Qt::DirectConnection));
+
+    m_done.clear();
+
+    for (int id = 0 ; id <= shortCalls ; ++id)
+    {
+        emit work(id, (id == 0));
+    }
+
+    // Do not fail before releasing the gate, the blocked worker could not be deleted.
+
+    for (int i = 0 ; (i < 100) && (m_done.size() < shortCalls) ; ++i)
+    {
+        QTest::qWait(100);
+    }
+
+    const int  doneBeforeRelease = m_done.size();
+    const bool blockedCallDone   = m_done.contains(0);
+
+    BlockingWorker::gate.release();
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_done.size(), shortCalls + 1, 10000);
+
+    disconnect(this, 0, adapter, 0);
+    delete adapter;
+
+    QCOMPARE(doneBeforeRelease, shortCalls);
+    QVERIFY(!blockedCallDone);
+
+    // Call 0 is the blocking one: its worker got no other call.
+
+    QObject* const blocked = m_done.value(0);
+    QObject* const other   = m_done.value(1);
+
+    QVERIFY(blocked);
+    QVERIFY(other);
+    QVERIFY(blocked != other);
+
+    for (int id = 1 ; id <= shortCalls ; ++id)
+    {
+        QCOMPARE(m_done.value(id), other);
+    }
+}
@@ -0,0 +1,80 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Test of the load distribution of parallel worker objects
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_PARALLEL_WORKERS_TEST_H
+#define DIGIKAM_PARALLEL_WORKERS_TEST_H
+
+// Qt includes
+
+#include <QMap>
+#include <QSemaphore>
+#include <QtTest>
+
+// Local includes
+
+#include "workerobject.h"
+
+class BlockingWorker : public Digikam::WorkerObject
+{
+    Q_OBJECT
+
+public:
+
+    /// A blocking call waits until the test releases this gate.
+    static QSemaphore gate;
+
+public Q_SLOTS:
+
+    void process(int id, bool blocking);
+
+Q_SIGNALS:
+
+    void processed(int id);
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class ParallelWorkersTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void testAllCallsProcessed();
+    void testSkewedLoad();
+
+public Q_SLOTS:
+
+    void slotProcessed(int id);
+
+Q_SIGNALS:
+
+    void work(int id, bool blocking);
+
+private:
+
+    /// The worker which processed each call
+    QMap<int, QObject*> m_done;
+};
+
+#endif // DIGIKAM_PARALLEL_WORKERS_TEST_H
@@ -24,11 +24,16 @@
 #include "facepipeline.h"
 #include "facepipeline_p.h"
 
+// KDE includes
+
+#include <klocalizedstring.h>
+
 // Local includes
 
 #include "digikam_debug.h"
 #include "facebenchmarkers.h"
 #include "faceworkers.h"
+#include "facepipelinestatistics.h"
 #include "facepreviewloader.h"
 #include "faceitemretriever.h"
 #include "parallelpipes.h"
@@ -189,6 +194,11 @@ QString FacePipeline::benchmarkResult() const
     return QString();
 }
 
+QList<FacePipelineStageStatistics> FacePipeline::statistics() const
+{
+    return d->statistics->statistics();
+}
+
 void FacePipeline::plugDatabaseFilter(FilterMode mode)
 {
     d->databaseFilter = new ScanStateFilter(mode, d);
@@ -226,7 +236,8 @@ void FacePipeline::plugParallelFaceDetectors()
         return plugFaceDetector();
     }
 
-    // limit number of parallel detectors to 3, because of memory cost (cascades)
+    // The detectors share the loaded cascades, and each one scans the pyramid levels of its
+    // image on the global thread pool. Three of them keep the cores busy while the next images load.
     const int n          = qMin(3, QThread::idealThreadCount());
     d->parallelDetectors = new ParallelPipes;
 
@@ -281,50 +292,60 @@ void FacePipeline::plugDatabaseEditor()
 
 void FacePipeline::construct()
 {
+    QStringList stageNames;
+
     if (d->previewThread)
     {
         d->pipeline << d->previewThread;
+        stageNames  << i18n("Loading");
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add preview thread";
     }
 
     if (d->parallelDetectors)
     {
         d->pipeline << d->parallelDetectors;
+        stageNames  << i18n("Detection");
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add parallel thread detectors";
     }
     else if (d->detectionWorker)
     {
         d->pipeline << d->detectionWorker;
+        stageNames  << i18n("Detection");
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add single thread detector";
     }
 
     if (d->recognitionWorker)
     {
         d->pipeline << d->recognitionWorker;
+        stageNames  << i18n("Recognition");
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add recognition worker";
     }
 
     if (d->detectionBenchmarker)
     {
         d->pipeline << d->detectionBenchmarker;
+        stageNames  << i18n("Detection benchmark");
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add detection benchmaker";
     }
 
     if (d->recognitionBenchmarker)
     {
         d->pipeline << d->recognitionBenchmarker;
+        stageNames  << i18n("Recognition benchmark");
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add recognition benchmaker";
     }
 
     if (d->databaseWriter)
     {
         d->pipeline << d->databaseWriter;
+        stageNames  << i18n("Database writing");
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add database writer";
     }
 
     if (d->trainer)
     {
         d->pipeline << d->trainer;
+        stageNames  << i18n("Training");
         qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine: add faces trainer";
     }
 
@@ -334,6 +355,29 @@ void FacePipeline::construct()
         return;
     }
 
+    // The probes are connected first and directly: they see each package leaving
+    // a stage before it is queued to the next one.
+
+    d->statistics->setStages(stageNames);
+
+    QList<FacePipelineStageProbe*> probes;
+
+    for (int i = 0 ; i <= d->pipeline.size() ; ++i)
+    {
+        probes << new FacePipelineStageProbe(i, d->statistics, d);
+    }
+
+    connect(d, SIGNAL(startProcess(FacePipelineExtendedPackage::Ptr)),
+            probes.first(), SLOT(process(FacePipelineExtendedPackage::Ptr)),
+            Qt::DirectConnection);
+
+    for (int i = 0 ; i < d->pipeline.size() ; ++i)
+    {
+        connect(d->pipeline.at(i), SIGNAL(processed(FacePipelineExtendedPackage::Ptr)),
+                probes.at(i + 1), SLOT(process(FacePipelineExtendedPackage::Ptr)),
+                Qt::DirectConnection);
+    }
+
     connect(d, SIGNAL(startProcess(FacePipelineExtendedPackage::Ptr)),
             d->pipeline.first(), SLOT(process(FacePipelineExtendedPackage::Ptr)));
 
@@ -136,6 +136,39 @@ public:
 
 // ------------------------------------------------------------------------------------
 
+/**
+ * Throughput figures of one stage of the pipeline, as preview loading or detection,
+ * since the pipeline was started. Latencies are measured from the end of the previous
+ * stage, so they include the time spent waiting in the queue of the stage.
+ */
+class FacePipelineStageStatistics
+{
+public:
+
+    explicit FacePipelineStageStatistics();
+
+    /// Returns the figures on one line, for the log.
+    QString toString() const;
+
+public:
+
+    QString name;
+
+    /// Packages sent to the stage and not processed yet.
+    int     queueDepth;
+    int     processed;
+    double  itemsPerSecond;
+
+    /// Over the last packages, in milliseconds.
+    double  meanLatency;
+    double  p95Latency;
+
+    /// Time in milliseconds during which the stage had no package to process.
+    qint64  idleTime;
+};
+
+// ------------------------------------------------------------------------------------
+
 class FacePipeline : public QObject
 {
     Q_OBJECT
@@ -232,6 +265,13 @@ public:
     bool hasFinished() const;
     QString benchmarkResult() const;
 
+    /**
+     * Returns the figures of each stage of the constructed pipeline, in the order of the pipeline.
+     * They are updated while packages are processed, and statisticsChanged() is emitted
+     * periodically while the pipeline runs.
+     */
+    QList<FacePipelineStageStatistics> statistics() const;
+
     /**
      * Set the priority of the threads used by this pipeline.
      * The default setting is QThread::LowPriority.
@@ -313,6 +353,9 @@ Q_SIGNALS:
     /// Emitted when one or several packages were skipped, usually because they have already been scanned.
     void skipped(const QList<ItemInfo>& skippedInfos);
 
+    /// Emitted periodically while processing, see statistics().
+    void statisticsChanged();
+
 public:
 
     class Private;
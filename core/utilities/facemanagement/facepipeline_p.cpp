@@ -30,6 +30,7 @@
 // Local includes
 
 #include "digikam_debug.h"
+#include "facepipelinestatistics.h"
 #include "facepreviewloader.h"
 #include "parallelpipes.h"
 #include "scanstatefilter.h"
@@ -75,6 +76,17 @@ FacePipeline::Private::Private(FacePipeline* const q)
     packagesOnTheRoad      = 0;
     maxPackagesOnTheRoad   = 50;
     totalPackagesAdded     = 0;
+    statistics             = new FacePipelineStatistics;
+    statisticsTimer        = new QTimer(this);
+    statisticsTimer->setInterval(10000);
+
+    connect(statisticsTimer, SIGNAL(timeout()),
+            this, SLOT(slotLogStatistics()));
+}
+
+FacePipeline::Private::~Private()
+{
+    delete statistics;
 }
 
 void FacePipeline::Private::processBatch(const QList<ItemInfo>& infos)
@@ -187,6 +199,16 @@ void FacePipeline::Private::finishProcess(FacePipelineExtendedPackage::Ptr packa
     checkFinished();
 }
 
+void FacePipeline::Private::slotLogStatistics()
+{
+    foreach (const FacePipelineStageStatistics& stage, statistics->statistics())
+    {
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Face PipeLine:" << stage.toString();
+    }
+
+    emit q->statisticsChanged();
+}
+
 bool FacePipeline::Private::senderFlowControl(FacePipelineExtendedPackage::Ptr package)
 {
     if (packagesOnTheRoad > maxPackagesOnTheRoad)
@@ -251,6 +273,9 @@ void FacePipeline::Private::start()
     }
 
     started = true;
+    statistics->reset();
+    statisticsTimer->start();
+
     emit q->started(i18n("Applying face changes"));
 }
 
@@ -292,6 +317,8 @@ void FacePipeline::Private::stop()
     }
 
     started = false;
+    statisticsTimer->stop();
+    slotLogStatistics();
 }
 
 void FacePipeline::Private::wait()
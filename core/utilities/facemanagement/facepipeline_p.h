@@ -32,6 +32,7 @@
 #include <QMetaMethod>
 #include <QMutex>
 #include <QSharedData>
+#include <QTimer>
 #include <QWaitCondition>
 
 // Local includes
@@ -59,10 +60,18 @@ class ScanStateFilter;
 class Q_DECL_HIDDEN FacePipelineExtendedPackage : public FacePipelinePackage,
                                                   public QSharedData
 {
+public:
+
+    FacePipelineExtendedPackage()
+        : stageEntered(0)
+    {
+    }
+
 public:
 
     QString                                                           filePath;
     DImg                                                              detectionImage; // image scaled to about 0.5 Mpx
+    qint64                                                            stageEntered;   // see FacePipelineStatistics
     typedef QExplicitlySharedDataPointer<FacePipelineExtendedPackage> Ptr;
 
 public:
@@ -88,6 +97,8 @@ public:
 
 // ----------------------------------------------------------------------------------------
 
+class FacePipelineStatistics;
+
 class Q_DECL_HIDDEN FacePipeline::Private : public QObject
 {
     Q_OBJECT
@@ -95,6 +106,7 @@ class Q_DECL_HIDDEN FacePipeline::Private : public QObject
 public:
 
     explicit Private(FacePipeline* const q);
+    ~Private();
 
     void processBatch(const QList<ItemInfo>& infos);
     void sendFromFilter(const QList<FacePipelineExtendedPackage::Ptr>& packages);
@@ -142,9 +154,13 @@ public:
 
     QList<FacePipelineExtendedPackage::Ptr> delayedPackages;
 
+    FacePipelineStatistics*                 statistics;
+    QTimer*                                 statisticsTimer;
+
 public Q_SLOTS:
 
     void finishProcess(FacePipelineExtendedPackage::Ptr package);
+    void slotLogStatistics();
 
 Q_SIGNALS:
 
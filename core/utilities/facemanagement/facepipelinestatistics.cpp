@@ -0,0 +1,213 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Throughput figures of the face pipeline stages
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "facepipelinestatistics.h"
+
+// C++ includes
+
+#include <algorithm>
+
+// Qt includes
+
+#include <QMutexLocker>
+
+namespace Digikam
+{
+
+/// Number of packages used for the mean and the 95th percentile of the latency.
+static const int latencyWindow = 500;
+
+FacePipelineStageStatistics::FacePipelineStageStatistics()
+    : queueDepth(0),
+      processed(0),
+      itemsPerSecond(0.0),
+      meanLatency(0.0),
+      p95Latency(0.0),
+      idleTime(0)
+{
+}
+
+QString FacePipelineStageStatistics::toString() const
+{
+    return QString::fromLatin1("%1: %2 done, %3/s, %4 queued, latency mean %5 ms p95 %6 ms, idle %7 s")
+           .arg(name)
+           .arg(processed)
+           .arg(itemsPerSecond, 0, 'f', 1)
+           .arg(queueDepth)
+           .arg(meanLatency, 0, 'f', 0)
+           .arg(p95Latency,  0, 'f', 0)
+           .arg(idleTime / 1000.0, 0, 'f', 1);
+}
+
+// ----------------------------------------------------------------------------------------
+
+FacePipelineStatistics::Stage::Stage()
+    : queueDepth(0),
+      processed(0),
+      idleSince(0),
+      idleTime(0),
+      nextLatency(0)
+{
+}
+
+FacePipelineStatistics::FacePipelineStatistics()
+{
+    clock.start();
+}
+
+FacePipelineStatistics::~FacePipelineStatistics()
+{
+}
+
+void FacePipelineStatistics::setStages(const QStringList& names)
+{
+    QMutexLocker lock(&mutex);
+
+    stages.clear();
+
+    foreach (const QString& name, names)
+    {
+        Stage stage;
+        stage.name = name;
+        stages << stage;
+    }
+}
+
+void FacePipelineStatistics::reset()
+{
+    QMutexLocker lock(&mutex);
+
+    clock.restart();
+
+    for (int i = 0 ; i < stages.size() ; ++i)
+    {
+        Stage& stage     = stages[i];
+        stage.queueDepth = 0;
+        stage.processed  = 0;
+        stage.idleSince  = 0;
+        stage.idleTime   = 0;
+        stage.latencies.clear();
+        stage.nextLatency = 0;
+    }
+}
+
+void FacePipelineStatistics::passBoundary(int boundary, FacePipelineExtendedPackage* const package)
+{
+    QMutexLocker lock(&mutex);
+
+    const qint64 now = clock.elapsed();
+
+    // The package leaves the previous stage...
+
+    if (boundary > 0 && boundary <= stages.size())
+    {
+        Stage& stage         = stages[boundary - 1];
+        const qint64 latency = now - package->stageEntered;
+
+        if (stage.latencies.size() < latencyWindow)
+        {
+            stage.latencies << latency;
+        }
+        else
+        {
+            stage.latencies[stage.nextLatency] = latency;
+            stage.nextLatency                  = (stage.nextLatency + 1) % latencyWindow;
+        }
+
+        stage.processed++;
+
+        if (--stage.queueDepth <= 0)
+        {
+            stage.queueDepth = 0;
+            stage.idleSince  = now;
+        }
+    }
+
+    // ...and enters the next one.
+
+    if (boundary < stages.size())
+    {
+        Stage& stage = stages[boundary];
+
+        if (stage.queueDepth++ == 0)
+        {
+            stage.idleTime += now - stage.idleSince;
+        }
+    }
+
+    package->stageEntered = now;
+}
+
+QList<FacePipelineStageStatistics> FacePipelineStatistics::statistics() const
+{
+    QMutexLocker lock(&mutex);
+
+    const qint64 now = clock.elapsed();
+    QList<FacePipelineStageStatistics> list;
+
+    foreach (const Stage& stage, stages)
+    {
+        FacePipelineStageStatistics stats;
+        stats.name           = stage.name;
+        stats.queueDepth     = stage.queueDepth;
+        stats.processed      = stage.processed;
+        stats.itemsPerSecond = (now > 0) ? (stage.processed * 1000.0 / now) : 0.0;
+        stats.idleTime       = stage.idleTime + (stage.queueDepth ? 0 : (now - stage.idleSince));
+
+        if (!stage.latencies.isEmpty())
+        {
+            QVector<qint64> sorted = stage.latencies;
+            std::sort(sorted.begin(), sorted.end());
+
+            qint64 sum = 0;
+
+            foreach (qint64 latency, sorted)
+            {
+                sum += latency;
+            }
+
+            stats.meanLatency = double(sum) / sorted.size();
+            stats.p95Latency  = sorted.at(qMin(sorted.size() - 1, (sorted.size() * 95) / 100));
+        }
+
+        list << stats;
+    }
+
+    return list;
+}
+
+// ----------------------------------------------------------------------------------------
+
+FacePipelineStageProbe::FacePipelineStageProbe(int boundary, FacePipelineStatistics* const statistics, QObject* const parent)
+    : QObject(parent),
+      boundary(boundary),
+      statistics(statistics)
+{
+}
+
+void FacePipelineStageProbe::process(FacePipelineExtendedPackage::Ptr package)
+{
+    statistics->passBoundary(boundary, package.data());
+}
+
+} // namespace Digikam
@@ -0,0 +1,126 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-12
+ * Description : Throughput figures of the face pipeline stages
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_FACE_PIPELINE_STATISTICS_H
+#define DIGIKAM_FACE_PIPELINE_STATISTICS_H
+
+// Qt includes
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QStringList>
+#include <QVector>
+
+// Local includes
+
+#include "facepipeline_p.h"
+
+namespace Digikam
+{
+
+/**
+ * Records the passage of the packages from one stage to the next.
+ * The stages are numbered in the order of the pipeline. The boundary i lies between
+ * stage i-1 and stage i: boundary 0 is the entry of the pipeline, boundary n its exit.
+ * The boundaries are passed in the threads of the stages, all methods are thread-safe.
+ */
+class Q_DECL_HIDDEN FacePipelineStatistics
+{
+public:
+
+    explicit FacePipelineStatistics();
+    ~FacePipelineStatistics();
+
+    void setStages(const QStringList& names);
+
+    /**
+     * Clears all figures. Called when the pipeline starts.
+     */
+    void reset();
+
+    void passBoundary(int boundary, FacePipelineExtendedPackage* const package);
+
+    QList<FacePipelineStageStatistics> statistics() const;
+
+private:
+
+    class Stage
+    {
+    public:
+
+        explicit Stage();
+
+    public:
+
+        QString          name;
+        int              queueDepth;
+        int              processed;
+        qint64           idleSince;
+        qint64           idleTime;
+
+        /// Latencies of the last packages, used as a ring buffer.
+        QVector<qint64>  latencies;
+        int              nextLatency;
+    };
+
+private:
+
+    // Disable
+    FacePipelineStatistics(const FacePipelineStatistics&);
+    FacePipelineStatistics& operator=(const FacePipelineStatistics&);
+
+private:
+
+    mutable QMutex mutex;
+    QElapsedTimer  clock;
+    QList<Stage>   stages;
+};
+
+// ----------------------------------------------------------------------------------------
+
+/**
+ * Receives the packages at one boundary of the pipeline. The probe is connected
+ * with a direct connection before the next stage, so it runs in the thread of the
+ * previous stage and before the package is queued to the next one.
+ */
+class Q_DECL_HIDDEN FacePipelineStageProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit FacePipelineStageProbe(int boundary, FacePipelineStatistics* const statistics, QObject* const parent);
+
+public Q_SLOTS:
+
+    void process(FacePipelineExtendedPackage::Ptr package);
+
+private:
+
+    const int                     boundary;
+    FacePipelineStatistics* const statistics;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_FACE_PIPELINE_STATISTICS_H
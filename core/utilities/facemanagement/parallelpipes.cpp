@@ -97,14 +97,31 @@ void ParallelPipes::add(WorkerObject* const worker)
 
 void ParallelPipes::process(FacePipelineExtendedPackage::Ptr package)
 {
-    // Here, we send the package to one of the workers, in turn
-    m_methods.at(m_currentIndex).invoke(m_workers.at(m_currentIndex), Qt::QueuedConnection,
-                                        Q_ARG(FacePipelineExtendedPackage::Ptr, package));
+    if (m_workers.isEmpty())
+    {
+        return;
+    }
+
+    // Here, we send the package to the worker with the fewest packages waiting.
+    // Among equally busy workers, we start with the next one in turn.
 
-    if (++m_currentIndex == m_workers.size())
+    int index = m_currentIndex;
+
+    for (int i = 1 ; i < m_workers.size() ; ++i)
     {
-        m_currentIndex = 0;
+        const int candidate = (m_currentIndex + i) % m_workers.size();
+
+        if (m_workers.at(candidate)->queuedCalls() < m_workers.at(index)->queuedCalls())
+        {
+            index = candidate;
+        }
     }
+
+    m_workers.at(index)->addQueuedCall();
+    m_methods.at(index).invoke(m_workers.at(index), Qt::QueuedConnection,
+                               Q_ARG(FacePipelineExtendedPackage::Ptr, package));
+
+    m_currentIndex = (index + 1) % m_workers.size();
 }
 
 } // namespace Digikam
@@ -263,13 +263,15 @@ QMap<QString, QVariant> EditorCore::Private::ioAttributes(IOFileSettings* const
     // PNG file format.
     if (mimeType.toUpper() == QLatin1String("PNG"))
     {
-        attributes.insert(QLatin1String("quality"), iofileSettings->PNGCompression);
+        attributes.insert(QLatin1String("quality"),         iofileSettings->PNGCompression);
+        attributes.insert(QLatin1String("encodingThreads"), iofileSettings->PNGEncodingThreads);
     }
 
     // TIFF file format.
     if (mimeType.toUpper() == QLatin1String("TIFF") || mimeType.toUpper() == QLatin1String("TIF"))
     {
-        attributes.insert(QLatin1String("compress"), iofileSettings->TIFFCompression);
+        attributes.insert(QLatin1String("compress"),        iofileSettings->TIFFCompression);
+        attributes.insert(QLatin1String("encodingThreads"), iofileSettings->TIFFEncodingThreads);
     }
 
     // JPEG 2000 file format.
@@ -24,6 +24,10 @@
 #ifndef DIGIKAM_IO_FILE_SETTINGS_H
 #define DIGIKAM_IO_FILE_SETTINGS_H
 
+// Qt includes
+
+#include <QThread>
+
 // Local includes
 
 #include "drawdecoding.h"
@@ -42,7 +46,9 @@ public:
         JPEGCompression     = 75;
         JPEGSubSampling     = 1;    // Medium sub-sampling
         PNGCompression      = 9;
+        PNGEncodingThreads  = QThread::idealThreadCount();
         TIFFCompression     = false;
+        TIFFEncodingThreads = QThread::idealThreadCount();
         JPEG2000Compression = 75;
         JPEG2000LossLess    = true;
         PGFCompression      = 3;
@@ -65,9 +71,15 @@ public:
     // PNG compression value.
     int  PNGCompression;
 
+    // Number of threads used to compress PNG files.
+    int  PNGEncodingThreads;
+
     // TIFF deflate compression.
     bool TIFFCompression;
 
+    // Number of threads used to compress TIFF files.
+    int  TIFFEncodingThreads;
+
     // JPEG2000 quality value.
     int  JPEG2000Compression;
 
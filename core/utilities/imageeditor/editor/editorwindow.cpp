@@ -50,6 +50,7 @@
 #include <QPointer>
 #include <QProgressBar>
 #include <QSplitter>
+#include <QThread>
 #include <QTimer>
 #include <QToolButton>
 #include <QVBoxLayout>
@@ -865,9 +866,13 @@ void EditorWindow::applyIOSettings()
 
     m_IOFileSettings->PNGCompression      = PNGSettings::convertCompressionForLibPng(group.readEntry(d->configPngCompressionEntry, 1));
 
+    m_IOFileSettings->PNGEncodingThreads  = group.readEntry(d->configPngEncodingThreadsEntry, QThread::idealThreadCount());
+
     // TIFF compression setting.
     m_IOFileSettings->TIFFCompression     = group.readEntry(d->configTiffCompressionEntry, false);
 
+    m_IOFileSettings->TIFFEncodingThreads = group.readEntry(d->configTiffEncodingThreadsEntry, QThread::idealThreadCount());
+
     // JPEG2000 quality slider settings : 1 - 100
     m_IOFileSettings->JPEG2000Compression = group.readEntry(d->configJpeg2000CompressionEntry, 100);
 
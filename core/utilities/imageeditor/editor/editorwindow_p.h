@@ -124,8 +124,10 @@ public:
     static const QString         configPgfCompressionEntry;
     static const QString         configPgfLossLessEntry;
     static const QString         configPngCompressionEntry;
+    static const QString         configPngEncodingThreadsEntry;
     static const QString         configSplitterStateEntry;
     static const QString         configTiffCompressionEntry;
+    static const QString         configTiffEncodingThreadsEntry;
     static const QString         configUnderExposureColorEntry;
     static const QString         configUnderExposureIndicatorEntry;
     static const QString         configUnderExposurePercentsEntry;
@@ -200,8 +202,10 @@ const QString EditorWindow::Private::configJpegSubSamplingEntry(QLatin1String("J
 const QString EditorWindow::Private::configPgfCompressionEntry(QLatin1String("PGFCompression"));
 const QString EditorWindow::Private::configPgfLossLessEntry(QLatin1String("PGFLossLess"));
 const QString EditorWindow::Private::configPngCompressionEntry(QLatin1String("PNGCompression"));
+const QString EditorWindow::Private::configPngEncodingThreadsEntry(QLatin1String("PNGEncodingThreads"));
 const QString EditorWindow::Private::configSplitterStateEntry(QLatin1String("SplitterState"));
 const QString EditorWindow::Private::configTiffCompressionEntry(QLatin1String("TIFFCompression"));
+const QString EditorWindow::Private::configTiffEncodingThreadsEntry(QLatin1String("TIFFEncodingThreads"));
 const QString EditorWindow::Private::configUnderExposureColorEntry(QLatin1String("UnderExposureColor"));
 const QString EditorWindow::Private::configUnderExposureIndicatorEntry(QLatin1String("UnderExposureIndicator"));
 const QString EditorWindow::Private::configUnderExposurePercentsEntry(QLatin1String("UnderExposurePercentsEntry"));
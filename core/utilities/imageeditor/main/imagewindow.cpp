@@ -120,6 +120,9 @@ void ImageWindow::closeEvent(QCloseEvent* e)
 
     m_canvas->resetImage();
 
+    // The editor session is over: free the pixel buffers kept for it.
+    DImgBufferPool::instance()->clear();
+
     // There is one nasty habit with the thumbnail bar if it is floating: it
     // doesn't close when the parent window does, so it needs to be manually
     // closed. If the light table is opened again, its original state needs to
@@ -80,6 +80,7 @@
 #include "ddragobjects.h"
 #include "deletedialog.h"
 #include "dimg.h"
+#include "dimgbufferpool.h"
 #include "editorcore.h"
 #include "dimagehistory.h"
 #include "digikamapp.h"
@@ -218,6 +218,9 @@ FacesDetector::FacesDetector(const FaceScanSettings& settings, ProgressItem* con
     connect(&d->pipeline, SIGNAL(skipped(QList<ItemInfo>)),
             this, SLOT(slotImagesSkipped(QList<ItemInfo>)));
 
+    connect(&d->pipeline, SIGNAL(statisticsChanged()),
+            this, SLOT(slotShowStatistics()));
+
     connect(this, SIGNAL(progressItemCanceled(ProgressItem*)),
             this, SLOT(slotCancel()));
 
@@ -397,4 +400,27 @@ void FacesDetector::slotShowOneDetected(const FacePipelinePackage& /*package*/)
     advance(1);
 }
 
+void FacesDetector::slotShowStatistics()
+{
+    // Show the stage with the longest queue, which is the one slowing down the pipeline
+
+    FacePipelineStageStatistics slowest;
+
+    foreach (const FacePipelineStageStatistics& stage, d->pipeline.statistics())
+    {
+        if (slowest.name.isEmpty() || stage.queueDepth > slowest.queueDepth)
+        {
+            slowest = stage;
+        }
+    }
+
+    if (!slowest.name.isEmpty())
+    {
+        setStatus(i18n("%1: %2 items/s, %3 waiting",
+                       slowest.name,
+                       QString::number(slowest.itemsPerSecond, 'f', 1),
+                       slowest.queueDepth));
+    }
+}
+
 } // namespace Digikam
@@ -58,6 +58,7 @@ private Q_SLOTS:
     void slotItemsInfo(const ItemInfoList&);
     void slotImagesSkipped(const QList<ItemInfo>&);
     void slotShowOneDetected(const FacePipelinePackage&);
+    void slotShowStatistics();
     void slotDone();
     void slotCancel();
 
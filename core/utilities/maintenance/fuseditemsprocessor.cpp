@@ -0,0 +1,257 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-02
+ * Description : Maintenance tool running thumbnails, finger-prints,
+ *               image quality and face detection in a single pass.
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "fuseditemsprocessor.h"
+
+// Qt includes
+
+#include <QApplication>
+#include <QString>
+#include <QIcon>
+#include <QHash>
+#include <QSet>
+
+// KDE includes
+
+#include <kconfiggroup.h>
+#include <ksharedconfig.h>
+#include <klocalizedstring.h>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "coredb.h"
+#include "albummanager.h"
+#include "coredbaccess.h"
+#include "thumbsdbaccess.h"
+#include "thumbsdb.h"
+#include "tagscache.h"
+#include "maintenancesettings.h"
+#include "maintenancethread.h"
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN FusedItemsProcessor::Private
+{
+public:
+
+    explicit Private()
+      : thread(0)
+    {
+    }
+
+    MaintenanceSettings  settings;
+
+    FusedTask::Consumers consumers;
+
+    MaintenanceThread*   thread;
+};
+
+FusedItemsProcessor::FusedItemsProcessor(const MaintenanceSettings& settings, ProgressItem* const parent)
+    : MaintenanceTool(QLatin1String("FusedItemsProcessor"), parent),
+      d(new Private)
+{
+    setLabel(i18n("Items Processing"));
+    ProgressManager::addProgressItem(this);
+
+    d->settings  = settings;
+    d->consumers = consumers(settings);
+    d->thread    = new MaintenanceThread(this);
+
+    connect(d->thread, SIGNAL(signalCompleted()),
+            this, SLOT(slotDone()));
+
+    connect(d->thread, SIGNAL(signalAdvance(QImage)),
+            this, SLOT(slotAdvance(QImage)));
+}
+
+FusedItemsProcessor::~FusedItemsProcessor()
+{
+    delete d;
+}
+
+FusedTask::Consumers FusedItemsProcessor::consumers(const MaintenanceSettings& settings)
+{
+    FusedTask::Consumers consumers = FusedTask::NoConsumer;
+
+    if (settings.thumbnails)
+    {
+        consumers |= FusedTask::Thumbnails;
+    }
+
+    if (settings.fingerPrints)
+    {
+        consumers |= FusedTask::FingerPrints;
+    }
+
+    if (settings.qualitySort && settings.quality.enableSorter)
+    {
+        consumers |= FusedTask::ImageQuality;
+    }
+
+    // Recognition and benchmarks are not image based: they still run through the face pipeline.
+    if (settings.faceManagement && (settings.faceSettings.task == FaceScanSettings::Detect))
+    {
+        consumers |= FusedTask::FaceDetection;
+    }
+
+    return consumers;
+}
+
+void FusedItemsProcessor::setUseMultiCoreCPU(bool b)
+{
+    d->thread->setUseMultiCore(b);
+}
+
+void FusedItemsProcessor::slotCancel()
+{
+    d->thread->cancel();
+    MaintenanceTool::slotCancel();
+}
+
+void FusedItemsProcessor::slotStart()
+{
+    MaintenanceTool::slotStart();
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+
+    AlbumList albumList;
+    albumList << d->settings.albums;
+    albumList << d->settings.tags;
+
+    if (albumList.isEmpty())
+    {
+        albumList = AlbumManager::instance()->allPAlbums();
+    }
+
+    // Items with a thumbnail already stored, if only missing thumbnails must be generated.
+    QHash<QString, int> thumbPaths;
+
+    if ((d->consumers & FusedTask::Thumbnails) && d->settings.scanThumbs)
+    {
+        thumbPaths = ThumbsDbAccess().db()->getFilePathsWithThumbnail();
+    }
+
+    // Items which do not have any Pick Label assigned, if only these must be sorted.
+    QSet<QString> noPickPaths;
+
+    if ((d->consumers & FusedTask::ImageQuality) &&
+        (d->settings.qualityScanMode == ImageQualitySorter::NonAssignedItems))
+    {
+        noPickPaths = CoreDbAccess().db()->getItemsURLsWithTag(TagsCache::instance()->tagForPickLabel(NoPickLabel)).toSet();
+    }
+
+    QStringList         allPicturesPath;
+    QHash<QString, int> itemConsumers;
+
+    for (AlbumList::const_iterator it = albumList.constBegin();
+         !canceled() && (it != albumList.constEnd()); ++it)
+    {
+        if (!(*it))
+        {
+            continue;
+        }
+
+        QStringList aPaths;
+
+        if ((*it)->type() == Album::PHYSICAL)
+        {
+            aPaths = CoreDbAccess().db()->getItemURLsInAlbum((*it)->id());
+        }
+        else if ((*it)->type() == Album::TAG)
+        {
+            aPaths = CoreDbAccess().db()->getItemURLsInTag((*it)->id());
+        }
+
+        foreach (const QString& path, aPaths)
+        {
+            if (itemConsumers.contains(path))
+            {
+                continue;
+            }
+
+            FusedTask::Consumers consumers = d->consumers;
+
+            if (thumbPaths.contains(path))
+            {
+                consumers &= ~FusedTask::Thumbnails;
+            }
+
+            if ((consumers & FusedTask::ImageQuality)                               &&
+                (d->settings.qualityScanMode == ImageQualitySorter::NonAssignedItems) &&
+                !noPickPaths.contains(path))
+            {
+                consumers &= ~FusedTask::ImageQuality;
+            }
+
+            // Finger-prints and faces states are checked by the tasks, in parallel.
+
+            if (consumers != FusedTask::NoConsumer)
+            {
+                itemConsumers.insert(path, (int)consumers);
+                allPicturesPath << path;
+            }
+        }
+    }
+
+    QApplication::restoreOverrideCursor();
+
+    if (allPicturesPath.isEmpty())
+    {
+        slotDone();
+        return;
+    }
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Fused processing of" << allPicturesPath.count()
+                                 << "items with consumers" << (int)d->consumers;
+
+    setTotalItems(allPicturesPath.count());
+
+    d->thread->processFused(allPicturesPath,
+                            itemConsumers,
+                            !d->settings.scanFingerPrints,
+                            d->settings.quality,
+                            d->settings.faceSettings);
+    d->thread->start();
+}
+
+void FusedItemsProcessor::slotAdvance(const QImage& img)
+{
+    setThumbnail(QIcon(QPixmap::fromImage(img)));
+    advance(1);
+}
+
+void FusedItemsProcessor::slotDone()
+{
+    if (d->consumers & FusedTask::FingerPrints)
+    {
+        // Switch on scanned for finger-prints flag on digiKam config file.
+        KSharedConfig::openConfig()->group(QLatin1String("General Settings")).writeEntry(QLatin1String("Finger Prints Generator First Run"), true);
+    }
+
+    MaintenanceTool::slotDone();
+}
+
+} // namespace Digikam
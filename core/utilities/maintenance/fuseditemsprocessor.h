@@ -0,0 +1,77 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-02
+ * Description : Maintenance tool running thumbnails, finger-prints,
+ *               image quality and face detection in a single pass.
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_FUSED_ITEMS_PROCESSOR_H
+#define DIGIKAM_FUSED_ITEMS_PROCESSOR_H
+
+// Qt includes
+
+#include <QObject>
+#include <QImage>
+
+// Local includes
+
+#include "maintenancetool.h"
+#include "fusedtask.h"
+
+namespace Digikam
+{
+
+class MaintenanceSettings;
+
+class FusedItemsProcessor : public MaintenanceTool
+{
+    Q_OBJECT
+
+public:
+
+    /** Process all tools enabled in settings which can share a decoded image,
+     *  see consumers(). Items are taken from settings albums and tags.
+     *  If both lists are empty, whole Albums collection is processed.
+     */
+    explicit FusedItemsProcessor(const MaintenanceSettings& settings, ProgressItem* const parent = 0);
+    ~FusedItemsProcessor();
+
+    void setUseMultiCoreCPU(bool b);
+
+    /** Return the tools from settings which can be processed in a single pass.
+     */
+    static FusedTask::Consumers consumers(const MaintenanceSettings& settings);
+
+private Q_SLOTS:
+
+    void slotStart();
+    void slotDone();
+    void slotCancel();
+    void slotAdvance(const QImage&);
+
+private:
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+#endif // DIGIKAM_FUSED_ITEMS_PROCESSOR_H
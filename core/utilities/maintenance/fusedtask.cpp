@@ -0,0 +1,370 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-02
+ * Description : Thread actions task for fused maintenance pipeline.
+ *               Each item is decoded once and dispatched to all
+ *               enabled consumers.
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#include "fusedtask.h"
+
+// Qt includes
+
+#include <QMutex>
+#include <QIcon>
+
+// Local includes
+
+#include "digikam_debug.h"
+#include "dimg.h"
+#include "haariface.h"
+#include "previewloadthread.h"
+#include "thumbnailloadthread.h"
+#include "threadscheduler.h"
+#include "thumbnailcreator.h"
+#include "imagequalitycontainer.h"
+#include "imagequalityparser.h"
+#include "facedetector.h"
+#include "faceutils.h"
+#include "facescansettings.h"
+#include "iteminfo.h"
+#include "maintenancedata.h"
+#include "similaritydb.h"
+#include "similaritydbaccess.h"
+
+namespace Digikam
+{
+
+class Q_DECL_HIDDEN FusedTask::Private
+{
+public:
+
+    explicit Private()
+        : thumbsThread(0),
+          facesThread(0),
+          imgqsort(0),
+          data(0)
+    {
+    }
+
+    void processThumbnail(const QString& path, const DImg& image);
+    void processFingerPrint(const ItemInfo& info, const DImg& image);
+    void processImageQuality(const ItemInfo& info, const DImg& image);
+    void processFaceDetection(const ItemInfo& info, const DImg& image);
+
+    /// Downscale image to size only if it is larger, as a preview loaded at this size would be.
+    static DImg scaledImage(const DImg& image, int size);
+
+public:
+
+    ThumbnailLoadThread*  thumbsThread;
+    ThumbnailLoadThread*  facesThread;
+
+    ImageQualityContainer quality;
+    ImageQualityParser*   imgqsort;
+    QMutex                imgqsortMutex;
+
+    FaceScanSettings      faceSettings;
+    FaceDetector          detector;
+
+    QImage                okImage;
+
+    MaintenanceData*      data;
+};
+
+DImg FusedTask::Private::scaledImage(const DImg& image, int size)
+{
+    if ((int)qMax(image.width(), image.height()) > size)
+    {
+        return image.smoothScale(size, size, Qt::KeepAspectRatio);
+    }
+
+    return image;
+}
+
+void FusedTask::Private::processThumbnail(const QString& path, const DImg& image)
+{
+    // The thumbnail must be replaced, not only completed.
+    ThumbnailLoadThread::deleteThumbnail(path);
+
+    ThumbnailCreator* const creator = thumbsThread->thumbnailCreator();
+
+    if (image.isNull())
+    {
+        // Video and audio files, or decoding failure: let the creator find a suitable source.
+        creator->pregenerate(ThumbnailIdentifier(path));
+        return;
+    }
+
+    // Preview image is already Exif rotated. It is stored as well, like detail thumbnails.
+    creator->store(path, scaledImage(image, creator->storedSize()).copyQImage());
+}
+
+void FusedTask::Private::processFingerPrint(const ItemInfo& info, const DImg& image)
+{
+    // compute Haar fingerprint and store it to DB
+    HaarIface haarIface;
+    haarIface.indexImage(info.filePath(), scaledImage(image, HaarIface::preferredSize()));
+}
+
+void FusedTask::Private::processImageQuality(const ItemInfo& info, const DImg& image)
+{
+    PickLabel pick;
+
+    imgqsortMutex.lock();
+    imgqsort = new ImageQualityParser(scaledImage(image, 1024), quality, &pick);
+    imgqsortMutex.unlock();
+
+    imgqsort->startAnalyse();
+
+    ItemInfo(info).setPickLabel(pick);
+
+    imgqsortMutex.lock();
+    delete imgqsort; //delete image data after setting label
+    imgqsort = 0;
+    imgqsortMutex.unlock();
+}
+
+void FusedTask::Private::processFaceDetection(const ItemInfo& info, const DImg& image)
+{
+    int recommendedSize         = detector.recommendedImageSize(image.size());
+    QList<QRectF> detectedFaces = detector.detectFaces(scaledImage(image, recommendedSize).copyQImage(),
+                                                       image.originalSize());
+
+    qCDebug(DIGIKAM_GENERAL_LOG) << "Found" << detectedFaces.size() << "faces in"
+                                 << info.name() << image.size()
+                                 << image.originalSize();
+
+    FaceUtils utils;
+
+    // Rescan means that a new scan discarded unconfirmed results of previous scans.
+    if (faceSettings.alreadyScannedHandling == FaceScanSettings::Rescan)
+    {
+        utils.removeFaces(utils.unconfirmedFaceTagsIfaces(info.id()));
+    }
+
+    // mark the whole image as scanned-for-faces
+    utils.markAsScanned(info);
+
+    if (!detectedFaces.isEmpty())
+    {
+        QList<FaceTagsIface> databaseFaces = utils.writeUnconfirmedResults(info.id(),
+                                                                           detectedFaces,
+                                                                           QList<Identity>(),
+                                                                           image.originalSize());
+        utils.storeThumbnails(facesThread, info.filePath(), databaseFaces, image);
+    }
+}
+
+// -------------------------------------------------------
+
+FusedTask::FusedTask()
+    : ActionJob(),
+      d(new Private)
+{
+    // These threads are never started. They only host thumbnail creators used synchronously from this task.
+    d->thumbsThread = new ThumbnailLoadThread;
+    d->thumbsThread->setPixmapRequested(false);
+    d->thumbsThread->setThumbnailSize(ThumbnailLoadThread::maximumThumbnailSize());
+
+    d->facesThread  = new ThumbnailLoadThread;
+    d->facesThread->setPixmapRequested(false);
+    d->facesThread->setThumbnailSize(ThumbnailLoadThread::maximumThumbnailSize());
+
+    QPixmap okPix   = QIcon::fromTheme(QLatin1String("dialog-ok")).pixmap(22, 22);
+    d->okImage      = okPix.toImage();
+}
+
+FusedTask::~FusedTask()
+{
+    slotCancel();
+    cancel();
+
+    delete d->thumbsThread;
+    delete d->facesThread;
+    delete d;
+}
+
+void FusedTask::setMaintenanceData(MaintenanceData* const data)
+{
+    d->data = data;
+}
+
+void FusedTask::setQuality(const ImageQualityContainer& quality)
+{
+    d->quality = quality;
+}
+
+void FusedTask::setFaceSettings(const FaceScanSettings& settings)
+{
+    d->faceSettings = settings;
+
+    QVariantMap params;
+    params[QLatin1String("accuracy")]    = settings.accuracy;
+    params[QLatin1String("specificity")] = 0.8;
+    d->detector.setParameters(params);
+}
+
+int FusedTask::decodingSize(Consumers consumers)
+{
+    int size = 0;
+
+    if (consumers & Thumbnails)
+    {
+        size = qMax(size, ThumbnailLoadThread::maximumThumbnailSize());
+    }
+
+    if (consumers & FingerPrints)
+    {
+        size = qMax(size, HaarIface::preferredSize());
+    }
+
+    if (consumers & ImageQuality)
+    {
+        // 1024 pixels size image must be enough to get suitable Quality results.
+        size = qMax(size, 1024);
+    }
+
+    if (consumers & FaceDetection)
+    {
+        size = qMax(size, FaceDetector().recommendedImageSize());
+    }
+
+    return size;
+}
+
+int FusedTask::memoryCost(int size)
+{
+    // 8 bits RGBA decoded image plus roughly the same amount for the downscaled copies.
+    qint64 bytes = (qint64)size * size * 4 * 2;
+
+    return (int)(bytes / (1024 * 1024)) + 1;
+}
+
+void FusedTask::slotCancel()
+{
+    QMutexLocker lock(&d->imgqsortMutex);
+
+    if (d->imgqsort)
+    {
+        d->imgqsort->cancelAnalyse();
+    }
+}
+
+void FusedTask::run()
+{
+    // While we have data (using this as check for non-null)
+    while (d->data)
+    {
+        if (m_cancel)
+        {
+            return;
+        }
+
+        QString path = d->data->getImagePath();
+
+        if (path.isEmpty())
+        {
+            break;
+        }
+
+        Consumers consumers = Consumers(d->data->getFusedConsumers(path));
+        ItemInfo info       = ItemInfo::fromLocalFile(path);
+
+        // Drop the consumers which have nothing to do with this item.
+
+        if ((consumers & FingerPrints) &&
+            !(info.category() == DatabaseItem::Category::Image                  &&
+              (d->data->getRebuildAllFingerprints()                             ||
+               SimilarityDbAccess().db()->hasDirtyOrMissingFingerprint(info))))
+        {
+            consumers &= ~FingerPrints;
+        }
+
+        if ((consumers & FaceDetection) &&
+            (d->faceSettings.alreadyScannedHandling == FaceScanSettings::Skip) &&
+            FaceUtils().hasBeenScanned(info))
+        {
+            consumers &= ~FaceDetection;
+        }
+
+        if (consumers == NoConsumer)
+        {
+            emit signalFinished(d->okImage);
+            continue;
+        }
+
+        // Decode the item once at the largest size needed. Wait for memory if too many images are in flight.
+
+        int  size = decodingSize(consumers);
+        int  cost = memoryCost(size);
+        DImg dimg;
+
+        d->data->acquireMemory(cost);
+
+        if (info.category() == DatabaseItem::Category::Image)
+        {
+            dimg = PreviewLoadThread::loadFastSynchronously(path, size);
+        }
+
+        if (!m_cancel)
+        {
+            // Fan out the decoded image to all consumers in parallel.
+
+            ThreadSchedulerTasks tasks;
+
+            if (consumers & Thumbnails)
+            {
+                tasks.run(d, &Private::processThumbnail, path, dimg);
+            }
+
+            if (!dimg.isNull())
+            {
+                if (consumers & FingerPrints)
+                {
+                    tasks.run(d, &Private::processFingerPrint, info, dimg);
+                }
+
+                if (consumers & ImageQuality)
+                {
+                    tasks.run(d, &Private::processImageQuality, info, dimg);
+                }
+
+                if (consumers & FaceDetection)
+                {
+                    tasks.run(d, &Private::processFaceDetection, info, dimg);
+                }
+            }
+
+            tasks.waitForDone();
+        }
+
+        // Dispatch progress to Progress Manager
+        QImage qimg = dimg.smoothScale(22, 22, Qt::KeepAspectRatio).copyQImage();
+
+        d->data->releaseMemory(cost);
+
+        emit signalFinished(qimg);
+    }
+
+    emit signalDone();
+}
+
+} // namespace Digikam
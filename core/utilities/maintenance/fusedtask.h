@@ -0,0 +1,103 @@
+/* ============================================================
+ *
+ * This file is a part of digiKam project
+ * https://www.digikam.org
+ *
+ * Date        : 2019-06-02
+ * Description : Thread actions task for fused maintenance pipeline.
+ *               Each item is decoded once and dispatched to all
+ *               enabled consumers.
+ *
+ * Copyright (C) 2019 by Gilles Caulier <caulier dot gilles at gmail dot com>
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation;
+ * either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * ============================================================ */
+
+#ifndef DIGIKAM_FUSED_TASK_H
+#define DIGIKAM_FUSED_TASK_H
+
+// Qt includes
+
+#include <QImage>
+#include <QFlags>
+
+// Local includes
+
+#include "actionthreadbase.h"
+
+namespace Digikam
+{
+
+class MaintenanceData;
+class ImageQualityContainer;
+class FaceScanSettings;
+
+class FusedTask : public ActionJob
+{
+    Q_OBJECT
+
+public:
+
+    /** The tools which can share the same decoded image.
+     */
+    enum Consumer
+    {
+        NoConsumer    = 0,
+        Thumbnails    = 1 << 0,
+        FingerPrints  = 1 << 1,
+        ImageQuality  = 1 << 2,
+        FaceDetection = 1 << 3
+    };
+    Q_DECLARE_FLAGS(Consumers, Consumer)
+
+public:
+
+    explicit FusedTask();
+    ~FusedTask();
+
+    void setMaintenanceData(MaintenanceData* const data=0);
+    void setQuality(const ImageQualityContainer& quality);
+    void setFaceSettings(const FaceScanSettings& settings);
+
+    /** Return the size to use to decode an item once for all the given consumers.
+     */
+    static int decodingSize(Consumers consumers);
+
+    /** Return the estimated memory cost in megabytes to hold an image decoded
+     *  at the given size, including the downscaled copies passed to the consumers.
+     */
+    static int memoryCost(int size);
+
+Q_SIGNALS:
+
+    void signalFinished(const QImage&);
+
+public Q_SLOTS:
+
+    void slotCancel();
+
+protected:
+
+    void run();
+
+private:
+
+    class Private;
+    Private* const d;
+};
+
+} // namespace Digikam
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Digikam::FusedTask::Consumers)
+
+#endif // DIGIKAM_FUSED_TASK_H
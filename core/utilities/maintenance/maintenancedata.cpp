@@ -26,6 +26,7 @@
 // Qt includes
 
 #include <QMutex>
+#include <QSemaphore>
 
 // Local includes
 
@@ -41,6 +42,7 @@ public:
     explicit Private()
     {
         rebuildAllFingerprints = true;
+        memoryBudget           = 0;
     }
 
     QList<qlonglong>              imageIdList;
@@ -50,8 +52,13 @@ public:
     QList<Identity>               identitiesList;
     QList<qlonglong>              similarityImageIdList;
 
+    QHash<QString, int>           fusedConsumers;
+
     bool                          rebuildAllFingerprints;
 
+    int                           memoryBudget;
+    QSemaphore                    memory;
+
     QMutex                        mutex;
 };
 
@@ -100,6 +107,20 @@ void MaintenanceData::setRebuildAllFingerprints(bool b)
     d->rebuildAllFingerprints = b;
 }
 
+void MaintenanceData::setFusedConsumers(const QHash<QString, int>& consumers)
+{
+    d->fusedConsumers = consumers;
+}
+
+void MaintenanceData::setMemoryBudget(int megabytes)
+{
+    // Only change budget when no image is in flight.
+
+    d->memory.acquire(d->memory.available());
+    d->memoryBudget = qMax(1, megabytes);
+    d->memory.release(d->memoryBudget);
+}
+
 qlonglong MaintenanceData::getImageId() const
 {
     d->mutex.lock();
@@ -189,4 +210,31 @@ bool MaintenanceData::getRebuildAllFingerprints() const
     return d->rebuildAllFingerprints;
 }
 
+int MaintenanceData::getFusedConsumers(const QString& path) const
+{
+    return d->fusedConsumers.value(path, 0);
+}
+
+int MaintenanceData::memoryBudget() const
+{
+    return d->memoryBudget;
+}
+
+void MaintenanceData::acquireMemory(int megabytes) const
+{
+    if (d->memoryBudget > 0)
+    {
+        // A single image larger than the whole budget must not block forever.
+        d->memory.acquire(qBound(1, megabytes, d->memoryBudget));
+    }
+}
+
+void MaintenanceData::releaseMemory(int megabytes) const
+{
+    if (d->memoryBudget > 0)
+    {
+        d->memory.release(qBound(1, megabytes, d->memoryBudget));
+    }
+}
+
 } // namespace Digikam
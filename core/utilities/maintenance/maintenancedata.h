@@ -24,6 +24,10 @@
 #ifndef DIGIKAM_MAINTENANCE_DATA_H
 #define DIGIKAM_MAINTENANCE_DATA_H
 
+// Qt includes
+
+#include <QHash>
+
 // Local includes
 
 #include "iteminfo.h"
@@ -50,6 +54,16 @@ public:
 
     void      setRebuildAllFingerprints(bool b);
 
+    /** Per item path, the list of fused pipeline consumers (see FusedTask::Consumers)
+     *  to feed with the decoded image.
+     */
+    void      setFusedConsumers(const QHash<QString, int>& consumers);
+
+    /** Memory budget in megabytes shared by all tasks to hold decoded images in flight.
+     *  Tasks must call acquireMemory() before to decode an image and releaseMemory() when done.
+     */
+    void      setMemoryBudget(int megabytes);
+
     qlonglong getImageId()                 const;
     int       getThumbnailId()             const;
     QString   getImagePath()               const;
@@ -58,6 +72,11 @@ public:
     qlonglong getSimilarityImageId()       const;
 
     bool      getRebuildAllFingerprints() const;
+    int       getFusedConsumers(const QString& path) const;
+
+    int       memoryBudget()               const;
+    void      acquireMemory(int megabytes) const;
+    void      releaseMemory(int megabytes) const;
 
 private:
 
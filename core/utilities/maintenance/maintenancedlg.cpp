@@ -82,9 +82,11 @@ public:
       : buttons(0),
         logo(0),
         title(0),
+        scanDeepVerify(0),
         scanThumbs(0),
         scanFingerPrints(0),
         useMutiCoreCPU(0),
+        fusedPipeline(0),
         cleanThumbsDb(0),
         cleanFacesDb(0),
         shrinkDatabases(0),
@@ -97,6 +99,7 @@ public:
         vbox(0),
         vbox2(0),
         vbox3(0),
+        vbox4(0),
         duplicatesBox(0),
         hbox3(0),
         similarityRange(0),
@@ -109,7 +112,9 @@ public:
 
     static const QString configGroupName;
     static const QString configUseMutiCoreCPU;
+    static const QString configFusedPipeline;
     static const QString configNewItems;
+    static const QString configScanDeepVerify;
     static const QString configThumbnails;
     static const QString configScanThumbs;
     static const QString configFingerPrints;
@@ -132,9 +137,11 @@ public:
     QDialogButtonBox*    buttons;
     QLabel*              logo;
     QLabel*              title;
+    QCheckBox*           scanDeepVerify;
     QCheckBox*           scanThumbs;
     QCheckBox*           scanFingerPrints;
     QCheckBox*           useMutiCoreCPU;
+    QCheckBox*           fusedPipeline;
     QCheckBox*           cleanThumbsDb;
     QCheckBox*           cleanFacesDb;
     QCheckBox*           shrinkDatabases;
@@ -147,6 +154,7 @@ public:
     DVBox*               vbox;
     DVBox*               vbox2;
     DVBox*               vbox3;
+    DVBox*               vbox4;
     DVBox*               duplicatesBox;
     DHBox*               hbox3;
     DIntRangeBox*        similarityRange;
@@ -158,7 +166,9 @@ public:
 
 const QString MaintenanceDlg::Private::configGroupName(QLatin1String("MaintenanceDlg Settings"));
 const QString MaintenanceDlg::Private::configUseMutiCoreCPU(QLatin1String("UseMutiCoreCPU"));
+const QString MaintenanceDlg::Private::configFusedPipeline(QLatin1String("FusedPipeline"));
 const QString MaintenanceDlg::Private::configNewItems(QLatin1String("NewItems"));
+const QString MaintenanceDlg::Private::configScanDeepVerify(QLatin1String("ScanDeepVerify"));
 const QString MaintenanceDlg::Private::configThumbnails(QLatin1String("Thumbnails"));
 const QString MaintenanceDlg::Private::configScanThumbs(QLatin1String("ScanThumbs"));
 const QString MaintenanceDlg::Private::configFingerPrints(QLatin1String("FingerPrints"));
@@ -210,12 +220,21 @@ MaintenanceDlg::MaintenanceDlg(QWidget* const parent)
     DVBox* const options       = new DVBox;
     d->albumSelectors          = new AlbumSelectors(i18nc("@label", "Process items from:"), d->configGroupName, options);
     d->useMutiCoreCPU          = new QCheckBox(i18nc("@option:check", "Work on all processor cores (when it possible)"), options);
+    d->fusedPipeline           = new QCheckBox(i18nc("@option:check", "Load each item only once for all selected tools"), options);
+    d->fusedPipeline->setWhatsThis(i18n("If this option is enabled, thumbnails, finger-prints, image quality "
+                                        "and face detection share the same decoded image. This is faster "
+                                        "but uses more memory."));
     d->expanderBox->insertItem(Private::Options, options, QIcon::fromTheme(QLatin1String("configure")), i18n("Common Options"), QLatin1String("Options"), true);
 
     // --------------------------------------------------------------------------------------
 
-    d->expanderBox->insertItem(Private::NewItems, new QLabel(i18n("<qt>No option<br/>"
-                               "<i>Note: only Albums Collection are processed by this tool.</i></qt>")),
+    d->vbox4                   = new DVBox;
+    new QLabel(i18n("<qt><i>Note: only Albums Collection are processed by this tool.</i></qt>"), d->vbox4);
+    d->scanDeepVerify          = new QCheckBox(i18n("Also check folders unchanged since the last scan (slower)"), d->vbox4);
+    d->scanDeepVerify->setWhatsThis(i18n("If this option is disabled, folders where no file was added, removed or renamed "
+                                         "since the last scan are skipped. Enable it to check all files again, "
+                                         "for example after they were edited in place by another application."));
+    d->expanderBox->insertItem(Private::NewItems, d->vbox4,
                                QIcon::fromTheme(QLatin1String("view-refresh")), i18n("Scan for new items"), QLatin1String("NewItems"), false);
     d->expanderBox->setCheckBoxVisible(Private::NewItems, true);
 
@@ -413,7 +432,9 @@ MaintenanceSettings MaintenanceDlg::settings() const
     prm.albums                              = d->albumSelectors->selectedAlbums();
     prm.tags                                = d->albumSelectors->selectedTags();
     prm.useMutiCoreCPU                      = d->useMutiCoreCPU->isChecked();
+    prm.fusedPipeline                       = d->fusedPipeline->isChecked();
     prm.newItems                            = d->expanderBox->isChecked(Private::NewItems);
+    prm.scanDeepVerify                      = d->scanDeepVerify->isChecked();
     prm.databaseCleanup                     = d->expanderBox->isChecked(Private::DbCleanup);
     prm.cleanThumbDb                        = d->cleanThumbsDb->isChecked();
     prm.cleanFacesDb                        = d->cleanFacesDb->isChecked();
@@ -451,7 +472,9 @@ void MaintenanceDlg::readSettings()
     MaintenanceSettings prm;
 
     d->useMutiCoreCPU->setChecked(group.readEntry(d->configUseMutiCoreCPU,                                  prm.useMutiCoreCPU));
+    d->fusedPipeline->setChecked(group.readEntry(d->configFusedPipeline,                                    prm.fusedPipeline));
     d->expanderBox->setChecked(Private::NewItems,           group.readEntry(d->configNewItems,              prm.newItems));
+    d->scanDeepVerify->setChecked(group.readEntry(d->configScanDeepVerify,                                  prm.scanDeepVerify));
 
     d->expanderBox->setChecked(Private::DbCleanup,          group.readEntry(d->configCleanupDatabase,       prm.databaseCleanup));
     d->cleanThumbsDb->setChecked(group.readEntry(d->configCleanupThumbDatabase,                             prm.cleanThumbDb));
@@ -500,7 +523,9 @@ void MaintenanceDlg::writeSettings()
     MaintenanceSettings prm   = settings();
 
     group.writeEntry(d->configUseMutiCoreCPU,        prm.useMutiCoreCPU);
+    group.writeEntry(d->configFusedPipeline,         prm.fusedPipeline);
     group.writeEntry(d->configNewItems,              prm.newItems);
+    group.writeEntry(d->configScanDeepVerify,        prm.scanDeepVerify);
     group.writeEntry(d->configCleanupDatabase,       prm.databaseCleanup);
     group.writeEntry(d->configCleanupThumbDatabase,  prm.cleanThumbDb);
     group.writeEntry(d->configCleanupFacesDatabase,  prm.cleanFacesDb);
@@ -556,6 +581,7 @@ void MaintenanceDlg::slotItemToggled(int index, bool b)
             break;
 
         default :  // NewItems
+            d->vbox4->setEnabled(b);
             break;
     }
 }
@@ -49,6 +49,7 @@
 #include "progressmanager.h"
 #include "facesdetector.h"
 #include "dbcleaner.h"
+#include "fuseditemsprocessor.h"
 
 namespace Digikam
 {
@@ -68,6 +69,8 @@ public:
         imageQualitySorter    = 0;
         facesDetector         = 0;
         databaseCleaner       = 0;
+        fusedItemsProcessor   = 0;
+        fusedConsumers        = FusedTask::NoConsumer;
     }
 
     bool                   running;
@@ -84,6 +87,10 @@ public:
     ImageQualitySorter*    imageQualitySorter;
     FacesDetector*         facesDetector;
     DbCleaner*             databaseCleaner;
+    FusedItemsProcessor*   fusedItemsProcessor;
+
+    /// Tools already processed by fusedItemsProcessor, to skip at their own stage.
+    FusedTask::Consumers   fusedConsumers;
 };
 
 MaintenanceMngr::MaintenanceMngr(QObject* const parent)
@@ -132,6 +139,11 @@ void MaintenanceMngr::slotToolCompleted(ProgressItem* tool)
         d->databaseCleaner = 0;
         stage3();
     }
+    else if (tool == dynamic_cast<ProgressItem*>(d->fusedItemsProcessor))
+    {
+        d->fusedItemsProcessor = 0;
+        stage4();
+    }
     else if (tool == dynamic_cast<ProgressItem*>(d->thumbsGenerator))
     {
         d->thumbsGenerator = 0;
@@ -168,6 +180,7 @@ void MaintenanceMngr::slotToolCanceled(ProgressItem* tool)
 {
     if (tool == dynamic_cast<ProgressItem*>(d->newItemsFinder)        ||
         tool == dynamic_cast<ProgressItem*>(d->thumbsGenerator)       ||
+        tool == dynamic_cast<ProgressItem*>(d->fusedItemsProcessor)   ||
         tool == dynamic_cast<ProgressItem*>(d->fingerPrintsGenerator) ||
         tool == dynamic_cast<ProgressItem*>(d->duplicatesFinder)      ||
         tool == dynamic_cast<ProgressItem*>(d->databaseCleaner)       ||
@@ -187,7 +200,8 @@ void MaintenanceMngr::stage1()
     {
         if (d->settings.wholeAlbums)
         {
-            d->newItemsFinder = new NewItemsFinder();
+            d->newItemsFinder = new NewItemsFinder(d->settings.scanDeepVerify ? NewItemsFinder::DeepCollectionScan
+                                                                              : NewItemsFinder::CompleteCollectionScan);
         }
         else
         {
@@ -236,6 +250,33 @@ void MaintenanceMngr::stage3()
 {
     qCDebug(DIGIKAM_GENERAL_LOG) << "stage3";
 
+    d->fusedConsumers = FusedTask::NoConsumer;
+
+    if (d->settings.fusedPipeline)
+    {
+        FusedTask::Consumers consumers = FusedItemsProcessor::consumers(d->settings);
+        int count                      = 0;
+
+        for (int flag = FusedTask::Thumbnails ; flag <= FusedTask::FaceDetection ; flag <<= 1)
+        {
+            if (consumers & flag)
+            {
+                ++count;
+            }
+        }
+
+        // A single tool does not decode items more than once.
+        if (count > 1)
+        {
+            d->fusedConsumers      = consumers;
+            d->fusedItemsProcessor = new FusedItemsProcessor(d->settings);
+            d->fusedItemsProcessor->setNotificationEnabled(false);
+            d->fusedItemsProcessor->setUseMultiCoreCPU(d->settings.useMutiCoreCPU);
+            d->fusedItemsProcessor->start();
+            return;
+        }
+    }
+
     if (d->settings.thumbnails)
     {
         bool rebuildAll = (d->settings.scanThumbs == false);
@@ -258,7 +299,7 @@ void MaintenanceMngr::stage4()
 {
     qCDebug(DIGIKAM_GENERAL_LOG) << "stage4";
 
-    if (d->settings.fingerPrints)
+    if (d->settings.fingerPrints && !(d->fusedConsumers & FusedTask::FingerPrints))
     {
         bool rebuildAll = (d->settings.scanFingerPrints == false);
         AlbumList list;
@@ -297,7 +338,7 @@ void MaintenanceMngr::stage6()
 {
     qCDebug(DIGIKAM_GENERAL_LOG) << "stage6";
 
-    if (d->settings.faceManagement)
+    if (d->settings.faceManagement && !(d->fusedConsumers & FusedTask::FaceDetection))
     {
         // NOTE : Use multi-core CPU option is passed through FaceScanSettings
         d->settings.faceSettings.useFullCpu = d->settings.useMutiCoreCPU;
@@ -315,7 +356,8 @@ void MaintenanceMngr::stage7()
 {
     qCDebug(DIGIKAM_GENERAL_LOG) << "stage7";
 
-    if (d->settings.qualitySort && d->settings.quality.enableSorter)
+    if (d->settings.qualitySort && d->settings.quality.enableSorter &&
+        !(d->fusedConsumers & FusedTask::ImageQuality))
     {
         AlbumList list;
         list << d->settings.albums;
@@ -31,8 +31,10 @@ MaintenanceSettings::MaintenanceSettings()
     wholeAlbums           = true;
     wholeTags             = true;
     useMutiCoreCPU        = false;
+    fusedPipeline         = false;
 
     newItems              = false;
+    scanDeepVerify        = false;
 
     thumbnails            = false;
     scanThumbs            = false;
@@ -72,7 +74,9 @@ QDebug operator<<(QDebug dbg, const MaintenanceSettings& s)
     dbg.nospace() << "Albums                : " << s.albums.count() << endl;
     dbg.nospace() << "Tags                  : " << s.tags.count() << endl;
     dbg.nospace() << "useMutiCoreCPU        : " << s.useMutiCoreCPU << endl;
+    dbg.nospace() << "fusedPipeline         : " << s.fusedPipeline << endl;
     dbg.nospace() << "newItems              : " << s.newItems << endl;
+    dbg.nospace() << "scanDeepVerify        : " << s.scanDeepVerify << endl;
     dbg.nospace() << "thumbnails            : " << s.thumbnails << endl;
     dbg.nospace() << "scanThumbs            : " << s.scanThumbs << endl;
     dbg.nospace() << "fingerPrints          : " << s.fingerPrints << endl;
@@ -59,8 +59,14 @@ public:
     /// Use Multi-core CPU to process items.
     bool                                    useMutiCoreCPU;
 
+    /// Decode each item once and share it with all enabled tools which need an image
+    /// (thumbnails, finger-prints, image quality and face detection).
+    bool                                    fusedPipeline;
+
     /// Find new items on whole collection.
     bool                                    newItems;
+    /// Also check the folders which did not change since the last scan.
+    bool                                    scanDeepVerify;
 
     /// Generate thumbnails
     bool                                    thumbnails;
@@ -36,6 +36,9 @@
 #include "thumbstask.h"
 #include "fingerprintstask.h"
 #include "imagequalitytask.h"
+#include "fusedtask.h"
+#include "facescansettings.h"
+#include "kmemoryinfo.h"
 #include "imagequalitycontainer.h"
 #include "databasetask.h"
 #include "maintenancedata.h"
@@ -48,6 +51,7 @@ MaintenanceThread::MaintenanceThread(QObject* const parent)
       data(new MaintenanceData)
 {
     setObjectName(QLatin1String("MaintenanceThread"));
+    setJobsPriority(ThreadScheduler::Maintenance);
 
     connect(this, SIGNAL(finished()),
             this, SLOT(slotThreadFinished()));
@@ -170,6 +174,43 @@ void MaintenanceThread::sortByImageQuality(const QStringList& paths, const Image
     appendJobs(collection);
 }
 
+void MaintenanceThread::processFused(const QStringList& paths,
+                                     const QHash<QString, int>& consumers,
+                                     bool rebuildAllFingerprints,
+                                     const ImageQualityContainer& quality,
+                                     const FaceScanSettings& faceSettings)
+{
+    ActionJobCollection collection;
+
+    data->setImagePaths(paths);
+    data->setFusedConsumers(consumers);
+    data->setRebuildAllFingerprints(rebuildAllFingerprints);
+
+    // Limit decoded images in flight to 5% of physical memory.
+    KMemoryInfo memory = KMemoryInfo::currentInfo();
+    data->setMemoryBudget(qBound(64, int(memory.megabytes(KMemoryInfo::TotalRam) * 0.05), 1024));
+
+    for (int i = 1 ; i <= maximumNumberOfThreads() ; ++i)
+    {
+        FusedTask* const t = new FusedTask();
+        t->setQuality(quality);
+        t->setFaceSettings(faceSettings);
+        t->setMaintenanceData(data);
+
+        connect(t, SIGNAL(signalFinished(QImage)),
+                this, SIGNAL(signalAdvance(QImage)));
+
+        connect(this, SIGNAL(signalCanceled()),
+                t, SLOT(slotCancel()), Qt::QueuedConnection);
+
+        collection.insert(t, 0);
+
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Creating a fused task for processing items.";
+    }
+
+    appendJobs(collection);
+}
+
 void MaintenanceThread::computeDatabaseJunk(bool thumbsDb, bool facesDb, bool similarityDb)
 {
     ActionJobCollection collection;
@@ -25,6 +25,10 @@
 #ifndef DIGIKAM_MAINTENANCE_THREAD_H
 #define DIGIKAM_MAINTENANCE_THREAD_H
 
+// Qt includes
+
+#include <QHash>
+
 // Local includes
 
 #include "actionthreadbase.h"
@@ -38,6 +42,7 @@ namespace Digikam
 {
 
 class ImageQualityContainer;
+class FaceScanSettings;
 class MaintenanceData;
 
 class MaintenanceThread : public ActionThreadBase
@@ -56,6 +61,15 @@ public:
     void generateFingerprints(const QList<qlonglong>& itemIds, bool rebuildAll);
     void sortByImageQuality(const QStringList& paths, const ImageQualityContainer& quality);
 
+    /** Decode each item once and dispatch the image to all consumers set for this item.
+     *  consumers maps item paths to FusedTask::Consumers flags.
+     */
+    void processFused(const QStringList& paths,
+                      const QHash<QString, int>& consumers,
+                      bool rebuildAllFingerprints,
+                      const ImageQualityContainer& quality,
+                      const FaceScanSettings& faceSettings);
+
     void computeDatabaseJunk(bool thumbsDb=false, bool facesDb=false, bool similarityDb=false);
     void cleanCoreDb(const QList<qlonglong>& imageIds);
     void cleanThumbsDb(const QList<int>& thumbnailIds);
@@ -121,10 +121,13 @@ void NewItemsFinder::slotStart()
         }
 
         case CompleteCollectionScan:
+        case DeepCollectionScan:
         {
-            qCDebug(DIGIKAM_GENERAL_LOG) << "scan mode: CompleteCollectionScan";
+            bool deepVerify = (d->mode == DeepCollectionScan);
 
-            ScanController::instance()->completeCollectionScanInBackground(false);
+            qCDebug(DIGIKAM_GENERAL_LOG) << "scan mode:" << (deepVerify ? "DeepCollectionScan" : "CompleteCollectionScan");
+
+            ScanController::instance()->completeCollectionScanInBackground(false, deepVerify);
 
             if (d->cancel)
             {
@@ -135,7 +138,7 @@ void NewItemsFinder::slotStart()
                     this, SLOT(slotDone()));
 
             ScanController::instance()->allowToScanDeferredFiles();
-            ScanController::instance()->completeCollectionScanInBackground(true);
+            ScanController::instance()->completeCollectionScanInBackground(true, deepVerify);
             break;
         }
 
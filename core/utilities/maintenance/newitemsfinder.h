@@ -47,7 +47,8 @@ public:
     {
         CompleteCollectionScan,   /** Scan whole collection immediately.                  */
         ScanDeferredFiles,        /** Defer whole collection scan.                      */
-        ScheduleCollectionScan    /** Scan immediately folders list passed in constructor. */
+        ScheduleCollectionScan,   /** Scan immediately folders list passed in constructor. */
+        DeepCollectionScan        /** Scan whole collection immediately, including unchanged folders. */
     };
 
 public:
@@ -29,6 +29,7 @@
 #include "digikam_debug.h"
 #include "digikam_config.h"
 #include "collectionscanner.h"
+#include "dimgbufferpool.h"
 #include "task.h"
 
 namespace Digikam
@@ -138,6 +139,14 @@ void ActionThread::slotThreadFinished()
     if (isEmpty())
     {
         qCDebug(DIGIKAM_GENERAL_LOG) << "List of Pending Jobs is empty";
+
+        // The queue run is over: do not keep its pixel buffers while idle.
+
+        DImgBufferPool* const pool = DImgBufferPool::instance();
+        qCDebug(DIGIKAM_GENERAL_LOG) << "Pixel buffer pool:" << pool->statistics().toString();
+        pool->clear();
+        pool->resetStatistics();
+
         emit signalQueueProcessed();
     }
 }
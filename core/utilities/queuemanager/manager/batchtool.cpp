@@ -27,6 +27,7 @@
 
 #include <QDataStream>
 #include <QDateTime>
+#include <QFile>
 #include <QFileInfo>
 #include <QPolygon>
 #include <QTemporaryFile>
@@ -68,6 +69,7 @@ public:
         branchHistory(true),
         cancel(false),
         last(false),
+        metadataPending(false),
         observer(0),
         toolGroup(BaseTool),
         rawLoadingRule(QueueSettings::DEMOSAICING),
@@ -80,6 +82,7 @@ public:
     bool                          branchHistory;
     bool                          cancel;
     bool                          last;
+    bool                          metadataPending;
 
     QString                       errorMessage;
     QString                       toolTitle;          // User friendly tool title.
@@ -91,6 +94,8 @@ public:
     QUrl                          workingUrl;
 
     DImg                          image;
+    MetaEngineData                pendingMetadata;
+    QDateTime                     pendingFileDate;
 
     ItemInfo                      imageinfo;
 
@@ -292,6 +297,11 @@ QString BatchTool::outputSuffix() const
     return QString();
 }
 
+bool BatchTool::needsInputFile() const
+{
+    return false;
+}
+
 void BatchTool::setImageData(const DImg& img)
 {
     d->image = img;
@@ -402,6 +412,32 @@ bool BatchTool::isLastChainedTool() const
     return d->last;
 }
 
+void BatchTool::setPendingMetadata(const MetaEngineData& data)
+{
+    d->pendingMetadata = data;
+    d->metadataPending = true;
+}
+
+MetaEngineData BatchTool::pendingMetadata() const
+{
+    return d->pendingMetadata;
+}
+
+bool BatchTool::hasPendingMetadata() const
+{
+    return d->metadataPending;
+}
+
+void BatchTool::setPendingFileDate(const QDateTime& date)
+{
+    d->pendingFileDate = date;
+}
+
+QDateTime BatchTool::pendingFileDate() const
+{
+    return d->pendingFileDate;
+}
+
 void BatchTool::setOutputUrlFromInputUrl()
 {
     QString randomString(QUuid::createUuid().toString());
@@ -438,29 +474,57 @@ bool BatchTool::loadToDImg() const
         return true;
     }
 
+    bool ret = false;
+
     if (d->rawLoadingRule == QueueSettings::USEEMBEDEDJPEG && isRawFile(inputUrl()))
     {
         QImage img;
-        bool   ret = DRawDecoder::loadRawPreview(img, inputUrl().toLocalFile());
+        ret = DRawDecoder::loadRawPreview(img, inputUrl().toLocalFile());
         DMetadata meta(inputUrl().toLocalFile());
         meta.setItemDimensions(QSize(img.width(), img.height()));
         d->image   = DImg(img);
         d->image.setMetadata(meta.data());
-        return ret;
+    }
+    else
+    {
+        ret = d->image.load(inputUrl().toLocalFile(), d->observer, DRawDecoding(rawDecodingSettings()));
     }
 
-    return (d->image.load(inputUrl().toLocalFile(), d->observer, DRawDecoding(rawDecodingSettings())));
+    // The image data carries the metadata changed by previous tools from now on.
+    if (ret && d->metadataPending)
+    {
+        d->image.setMetadata(d->pendingMetadata);
+        d->pendingMetadata = MetaEngineData();
+        d->metadataPending = false;
+    }
+
+    return ret;
 }
 
 bool BatchTool::savefromDImg() const
 {
-    if (!isLastChainedTool() && outputSuffix().isEmpty())
+    if (!isLastChainedTool())
     {
+        // The image data goes on to the next tool. The format chosen by a convert tool
+        // is used when the last chained tool writes the image.
+
+        if (!outputSuffix().isEmpty())
+        {
+            d->image.setAttribute(QLatin1String("batchOutputFormat"), outputSuffix().toUpper());
+        }
+
         return true;
     }
 
     DImg::FORMAT detectedFormat = d->image.detectedFormat();
     QString frm                 = outputSuffix().toUpper();
+
+    if (frm.isEmpty())
+    {
+        frm = d->image.attribute(QLatin1String("batchOutputFormat")).toString();
+    }
+
+    d->image.removeAttribute(QLatin1String("batchOutputFormat"));
     bool resetOrientation       = getResetExifOrientationAllowed() &&
                                   (getNeedResetExifOrientation() || detectedFormat == DImg::RAW);
 
@@ -480,11 +544,13 @@ bool BatchTool::savefromDImg() const
         }
         else if (detectedFormat == DImg::PNG)
         {
-            d->image.setAttribute(QLatin1String("quality"),     PNGSettings::convertCompressionForLibPng(ioFileSettings().PNGCompression));
+            d->image.setAttribute(QLatin1String("quality"),         PNGSettings::convertCompressionForLibPng(ioFileSettings().PNGCompression));
+            d->image.setAttribute(QLatin1String("encodingThreads"), ioFileSettings().PNGEncodingThreads);
         }
         else if (detectedFormat == DImg::TIFF)
         {
-            d->image.setAttribute(QLatin1String("compress"),    ioFileSettings().TIFFCompression);
+            d->image.setAttribute(QLatin1String("compress"),        ioFileSettings().TIFFCompression);
+            d->image.setAttribute(QLatin1String("encodingThreads"), ioFileSettings().TIFFEncodingThreads);
         }
         else if (detectedFormat == DImg::JP2K)
         {
@@ -513,6 +579,67 @@ DImg& BatchTool::image() const
     return d->image;
 }
 
+bool BatchTool::loadMetadata(DMetadata& meta) const
+{
+    if (!d->image.isNull())
+    {
+        meta.setData(d->image.getMetadata());
+        return true;
+    }
+
+    if (d->metadataPending)
+    {
+        meta.setData(d->pendingMetadata);
+        return true;
+    }
+
+    return meta.load(inputUrl().toLocalFile());
+}
+
+bool BatchTool::saveMetadata(const DMetadata& meta, bool changed)
+{
+    if (!d->image.isNull())
+    {
+        if (changed)
+        {
+            d->image.setMetadata(meta.data());
+        }
+
+        return savefromDImg();
+    }
+
+    if (changed)
+    {
+        setPendingMetadata(meta.data());
+    }
+
+    if (!isLastChainedTool())
+    {
+        // Nothing is written: the next tool gets the pending metadata and the same input file.
+        return true;
+    }
+
+    QFile::remove(outputUrl().toLocalFile());
+
+    if (!QFile::copy(inputUrl().toLocalFile(), outputUrl().toLocalFile()))
+    {
+        return false;
+    }
+
+    bool ret = true;
+
+    if (d->metadataPending)
+    {
+        DMetadata output(d->pendingMetadata);
+        ret = output.save(outputUrl().toLocalFile());
+    }
+
+    d->pendingMetadata = MetaEngineData();
+    d->metadataPending = false;
+
+    return ret;
+}
+
 bool BatchTool::apply()
 {
     d->cancel = false;
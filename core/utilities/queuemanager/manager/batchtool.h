@@ -28,6 +28,7 @@
 
 #include <QObject>
 #include <QIcon>
+#include <QDateTime>
 
 // Local includes
 
@@ -45,6 +46,7 @@ namespace Digikam
 
 class DImgBuiltinFilter;
 class DImgThreadedFilter;
+class DMetadata;
 class DPluginBqm;
 
 /** A map of batch tool settings (setting key, setting value).
@@ -140,10 +142,24 @@ public:
     ItemInfo imageInfo() const;
 
     /** Manage flag properties to indicate if this tool is last one to process on current item.
+        Only the last chained tool writes its result to the output url.
      */
     void setLastChainedTool(bool last);
     bool isLastChainedTool() const;
 
+    /** Manage metadata changed by previous metadata tools of the chain and not written to disk yet.
+        It is only used when the chain carries no image data, see loadMetadata() and saveMetadata().
+     */
+    void setPendingMetadata(const MetaEngineData& data);
+    MetaEngineData pendingMetadata() const;
+    bool hasPendingMetadata() const;
+
+    /** Manage file modification date set by a previous tool of the chain which did not write any file.
+        It is applied to the output file once the last chained tool wrote it, see Task.
+     */
+    void setPendingFileDate(const QDateTime& date);
+    QDateTime pendingFileDate() const;
+
     /** Set output url using input url content + annotation based on time stamp + file
         extension defined by outputSuffix().
         if outputSuffix() return null, file extension is the same than original.
@@ -226,6 +242,13 @@ public:
      */
     virtual QString outputSuffix() const;
 
+    /** Re-implement this method to return true if the tool reads the file at inputUrl() itself
+        instead of the image data passed along the chain, as external programs do. The previous
+        tool of the chain then writes its result to disk.
+        This method return false by default.
+     */
+    virtual bool needsInputFile() const;
+
     /** Re-implement this method to initialize Settings Widget value with default settings.
      */
     virtual BatchToolSettings defaultSettings() = 0;
@@ -263,6 +286,17 @@ protected:
      */
     bool isCancelled() const;
 
+    /** For metadata tools: get the metadata of the current item, from the image data passed along
+        the chain, from the metadata pending from previous tools, or else from the input file.
+     */
+    bool loadMetadata(DMetadata& meta) const;
+
+    /** For metadata tools: store the metadata of the current item in the image data passed along
+        the chain, or keep it pending for the next tool. The last chained tool writes it to a copy
+        of the input file. If changed is false, the metadata pending from previous tools is kept.
+     */
+    bool saveMetadata(const DMetadata& meta, bool changed = true);
+
     /**
      * Use this if you have a filter ready to run.
      * Will call startFilterDirectly and apply the result to image().
@@ -26,6 +26,7 @@
 
 // Qt includes
 
+#include <QDateTime>
 #include <QFileInfo>
 
 // KDE includes
@@ -56,6 +57,22 @@ public:
         tool   = 0;
     }
 
+    /**
+     * Returns true if the tool at this position of the workflow writes its result to disk.
+     * This is the case for the last tool, and before a tool reading its input file itself,
+     * as user scripts. All other tools pass their result to the next one in memory.
+     */
+    bool writesToDisk(int position) const;
+
+    /**
+     * Returns true if the metadata tool at this position must work on the image data,
+     * because an image tool follows it before the result is written to disk. The image is
+     * loaded first, and the metadata is written once with the image by the last tool.
+     */
+    bool needsImageData(int position) const;
+
+public:
+
     bool               cancel;
 
     BatchTool*         tool;
@@ -64,6 +81,43 @@ public:
     AssignedBatchTools tools;
 };
 
+bool Task::Private::writesToDisk(int position) const
+{
+    if (position >= tools.m_toolsList.count() - 1)
+    {
+        return true;
+    }
+
+    const BatchToolSet& next = tools.m_toolsList.at(position + 1);
+
+    if (next.group == BatchTool::CustomTool)
+    {
+        return true;
+    }
+
+    BatchTool* const nextTool = BatchToolsFactory::instance()->findTool(next.name, next.group);
+
+    return (nextTool && nextTool->needsInputFile());
+}
+
+bool Task::Private::needsImageData(int position) const
+{
+    if (tools.m_toolsList.at(position).group != BatchTool::MetadataTool)
+    {
+        return false;
+    }
+
+    for (int i = position ; !writesToDisk(i) ; ++i)
+    {
+        if (tools.m_toolsList.at(i + 1).group != BatchTool::MetadataTool)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 // -------------------------------------------------------
 
 Task::Task()
@@ -131,16 +185,25 @@ void Task::run()
 
     // Loop with all batch tools operations to apply on item.
 
-    bool        success = false;
-    int         index   = 0;
-    QUrl        outUrl  = d->tools.m_itemUrl;
-    QUrl        workUrl = !d->settings.useOrgAlbum ? d->settings.workingUrl
-                                                   : d->tools.m_itemUrl.adjusted(QUrl::RemoveFilename);
+    bool        success  = false;
+    int         index    = 0;
+    int         position = 0;
+    QUrl        outUrl   = d->tools.m_itemUrl;
+    QUrl        fileUrl  = d->tools.m_itemUrl;
+    QUrl        workUrl  = !d->settings.useOrgAlbum ? d->settings.workingUrl
+                                                    : d->tools.m_itemUrl.adjusted(QUrl::RemoveFilename);
     QUrl        inUrl;
     QList<QUrl> tmp2del;
     DImg        tmpImage;
     QString     errMsg;
 
+    // Metadata changed by metadata tools while the chain carries no image data.
+    MetaEngineData pendingMetadata;
+    bool           metadataPending = false;
+
+    // File modification date set by a tool which did not write the file.
+    QDateTime      pendingFileDate;
+
     // ItemInfo must be tread-safe.
     ItemInfo source = ItemInfo::fromUrl(d->tools.m_itemUrl);
     bool timeAdjust  = false;
@@ -149,9 +212,11 @@ void Task::run()
     {
         d->tool     = BatchToolsFactory::instance()->findTool(set.name, set.group)->clone();
         timeAdjust |= (set.name == QLatin1String("TimeAdjust"));
-        inUrl       = outUrl;
         index       = set.index + 1;
 
+        // Without image data, the tool reads the last file really written to disk.
+        inUrl       = tmpImage.isNull() ? fileUrl : outUrl;
+
         qCDebug(DIGIKAM_GENERAL_LOG) << "Tool : index= " << index
                  << " :: name= "     << set.name
                  << " :: group= "    << set.group
@@ -167,30 +232,41 @@ void Task::run()
         d->tool->setDRawDecoderSettings(d->settings.rawDecodingSettings);
         d->tool->setResetExifOrientationAllowed(d->settings.exifSetOrientation);
 
-        if (index == d->tools.m_toolsList.count())
-        {
-            d->tool->setLastChainedTool(true);
-        }
-        // If the next tool is under the custom group (user script)
-        // treat as the last chained tool, i.e. save image to file
-        else if (d->tools.m_toolsList[index].group == BatchTool::CustomTool)
-        {
-            d->tool->setLastChainedTool(true);
-        }
-        else
+        d->tool->setLastChainedTool(d->writesToDisk(position));
+
+        if (metadataPending)
         {
-            d->tool->setLastChainedTool(false);
+            d->tool->setPendingMetadata(pendingMetadata);
         }
 
+        d->tool->setPendingFileDate(pendingFileDate);
+
         d->tool->setOutputUrlFromInputUrl();
         d->tool->setBranchHistory(true);
 
-        outUrl   = d->tool->outputUrl();
-        success  = d->tool->apply();
-        tmpImage = d->tool->imageData();
-        errMsg   = d->tool->errorDescription();
+        outUrl  = d->tool->outputUrl();
+        success = true;
+
+        if (tmpImage.isNull() && d->needsImageData(position))
+        {
+            success = d->tool->loadToDImg();
+        }
+
+        success         = success && d->tool->apply();
+        tmpImage        = d->tool->imageData();
+        errMsg          = d->tool->errorDescription();
+        metadataPending = d->tool->hasPendingMetadata();
+        pendingMetadata = d->tool->pendingMetadata();
+        pendingFileDate = d->tool->pendingFileDate();
         tmp2del.append(outUrl);
 
+        if (QFileInfo(outUrl.toLocalFile()).size() > 0)
+        {
+            fileUrl = outUrl;
+        }
+
+        position++;
+
         delete d->tool;
         d->tool = 0;
 
@@ -208,6 +284,10 @@ void Task::run()
         }
     }
 
+    // Give the pixel buffers of the chain back to the pool for the next item.
+
+    tmpImage = DImg();
+
     // Clean up all tmp url.
 
     // We don't remove last output tmp url.
@@ -239,6 +319,13 @@ void Task::run()
         QFile::remove(outUrl.toLocalFile());
         dest.clear();
     }
+    else if (success && pendingFileDate.isValid())
+    {
+        if (!DFileOperations::setModificationTime(outUrl.toLocalFile(), pendingFileDate))
+        {
+            qCWarning(DIGIKAM_GENERAL_LOG) << "Failed to set modification time for file" << outUrl;
+        }
+    }
 
     if (!dest.isEmpty())
     {
@@ -257,10 +257,18 @@ bool WorkflowManager::save()
             data.setAttribute(QLatin1String("value"), q.qSettings.ioFileSettings.PNGCompression);
             elm.appendChild(data);
 
+            data = doc.createElement(QLatin1String("pngencodingthreads"));
+            data.setAttribute(QLatin1String("value"), q.qSettings.ioFileSettings.PNGEncodingThreads);
+            elm.appendChild(data);
+
             data = doc.createElement(QLatin1String("tiffcompression"));
             data.setAttribute(QLatin1String("value"), q.qSettings.ioFileSettings.TIFFCompression);
             elm.appendChild(data);
 
+            data = doc.createElement(QLatin1String("tiffencodingthreads"));
+            data.setAttribute(QLatin1String("value"), q.qSettings.ioFileSettings.TIFFEncodingThreads);
+            elm.appendChild(data);
+
             data = doc.createElement(QLatin1String("jpeg2000lossless"));
             data.setAttribute(QLatin1String("value"), q.qSettings.ioFileSettings.JPEG2000LossLess);
             elm.appendChild(data);
@@ -447,10 +455,18 @@ bool WorkflowManager::load(QStringList& failed)
                 {
                     q.qSettings.ioFileSettings.PNGCompression = val2.toUInt(&ok);
                 }
+                else if (name2 == QLatin1String("pngencodingthreads"))
+                {
+                    q.qSettings.ioFileSettings.PNGEncodingThreads = val2.toUInt(&ok);
+                }
                 else if (name2 == QLatin1String("tiffcompression"))
                 {
                     q.qSettings.ioFileSettings.TIFFCompression = (bool)val2.toUInt(&ok);
                 }
+                else if (name2 == QLatin1String("tiffencodingthreads"))
+                {
+                    q.qSettings.ioFileSettings.TIFFEncodingThreads = val2.toUInt(&ok);
+                }
                 else if (name2 == QLatin1String("jpeg2000lossless"))
                 {
                     q.qSettings.ioFileSettings.JPEG2000LossLess = (bool)val2.toUInt(&ok);
@@ -36,6 +36,7 @@
 #include <QVBoxLayout>
 #include <QApplication>
 #include <QStyle>
+#include <QThread>
 #include <QIcon>
 
 // KDE includes
@@ -386,7 +387,9 @@ void QueueSettingsView::slotResetSettings()
     d->jpgSettings->setCompressionValue(75);
     d->jpgSettings->setSubSamplingValue(1);
     d->pngSettings->setCompressionValue(9);
+    d->pngSettings->setEncodingThreads(QThread::idealThreadCount());
     d->tifSettings->setCompression(false);
+    d->tifSettings->setEncodingThreads(QThread::idealThreadCount());
 #ifdef HAVE_JASPER
     d->j2kSettings->setLossLessCompression(true);
     d->j2kSettings->setCompressionValue(75);
@@ -419,7 +422,9 @@ void QueueSettingsView::slotQueueSelected(int, const QueueSettings& settings, co
     d->jpgSettings->setCompressionValue(settings.ioFileSettings.JPEGCompression);
     d->jpgSettings->setSubSamplingValue(settings.ioFileSettings.JPEGSubSampling);
     d->pngSettings->setCompressionValue(settings.ioFileSettings.PNGCompression);
+    d->pngSettings->setEncodingThreads(settings.ioFileSettings.PNGEncodingThreads);
     d->tifSettings->setCompression(settings.ioFileSettings.TIFFCompression);
+    d->tifSettings->setEncodingThreads(settings.ioFileSettings.TIFFEncodingThreads);
 #ifdef HAVE_JASPER
     d->j2kSettings->setLossLessCompression(settings.ioFileSettings.JPEG2000LossLess);
     d->j2kSettings->setCompressionValue(settings.ioFileSettings.JPEG2000Compression);
@@ -451,7 +456,9 @@ void QueueSettingsView::slotSettingsChanged()
     settings.ioFileSettings.JPEGCompression     = d->jpgSettings->getCompressionValue();
     settings.ioFileSettings.JPEGSubSampling     = d->jpgSettings->getSubSamplingValue();
     settings.ioFileSettings.PNGCompression      = d->pngSettings->getCompressionValue();
+    settings.ioFileSettings.PNGEncodingThreads  = d->pngSettings->getEncodingThreads();
     settings.ioFileSettings.TIFFCompression     = d->tifSettings->getCompression();
+    settings.ioFileSettings.TIFFEncodingThreads = d->tifSettings->getEncodingThreads();
 #ifdef HAVE_JASPER
     settings.ioFileSettings.JPEG2000LossLess    = d->j2kSettings->getLossLessCompression();
     settings.ioFileSettings.JPEG2000Compression = d->j2kSettings->getCompressionValue();
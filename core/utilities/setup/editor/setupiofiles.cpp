@@ -27,6 +27,7 @@
 
 #include <QCheckBox>
 #include <QGroupBox>
+#include <QThread>
 #include <QVBoxLayout>
 
 // KDE includes
@@ -81,7 +82,9 @@ public:
     static const QString configJPEGCompressionEntry;
     static const QString configJPEGSubSamplingEntry;
     static const QString configPNGCompressionEntry;
+    static const QString configPNGEncodingThreadsEntry;
     static const QString configTIFFCompressionEntry;
+    static const QString configTIFFEncodingThreadsEntry;
     static const QString configJPEG2000CompressionEntry;
     static const QString configJPEG2000LossLessEntry;
     static const QString configPGFCompressionEntry;
@@ -103,7 +106,9 @@ const QString SetupIOFiles::Private::configGroupName(QLatin1String("ImageViewer
 const QString SetupIOFiles::Private::configJPEGCompressionEntry(QLatin1String("JPEGCompression"));
 const QString SetupIOFiles::Private::configJPEGSubSamplingEntry(QLatin1String("JPEGSubSampling"));
 const QString SetupIOFiles::Private::configPNGCompressionEntry(QLatin1String("PNGCompression"));
+const QString SetupIOFiles::Private::configPNGEncodingThreadsEntry(QLatin1String("PNGEncodingThreads"));
 const QString SetupIOFiles::Private::configTIFFCompressionEntry(QLatin1String("TIFFCompression"));
+const QString SetupIOFiles::Private::configTIFFEncodingThreadsEntry(QLatin1String("TIFFEncodingThreads"));
 const QString SetupIOFiles::Private::configJPEG2000CompressionEntry(QLatin1String("JPEG2000Compression"));
 const QString SetupIOFiles::Private::configJPEG2000LossLessEntry(QLatin1String("JPEG2000LossLess"));
 const QString SetupIOFiles::Private::configPGFCompressionEntry(QLatin1String("PGFCompression"));
@@ -164,7 +169,9 @@ void SetupIOFiles::applySettings()
     group.writeEntry(d->configJPEGCompressionEntry,     d->JPEGOptions->getCompressionValue());
     group.writeEntry(d->configJPEGSubSamplingEntry,     d->JPEGOptions->getSubSamplingValue());
     group.writeEntry(d->configPNGCompressionEntry,      d->PNGOptions->getCompressionValue());
+    group.writeEntry(d->configPNGEncodingThreadsEntry,  d->PNGOptions->getEncodingThreads());
     group.writeEntry(d->configTIFFCompressionEntry,     d->TIFFOptions->getCompression());
+    group.writeEntry(d->configTIFFEncodingThreadsEntry, d->TIFFOptions->getEncodingThreads());
 #ifdef HAVE_JASPER
     group.writeEntry(d->configJPEG2000CompressionEntry, d->JPEG2000Options->getCompressionValue());
     group.writeEntry(d->configJPEG2000LossLessEntry,    d->JPEG2000Options->getLossLessCompression());
@@ -182,7 +189,9 @@ void SetupIOFiles::readSettings()
     d->JPEGOptions->setCompressionValue(group.readEntry(d->configJPEGCompressionEntry,         75));
     d->JPEGOptions->setSubSamplingValue(group.readEntry(d->configJPEGSubSamplingEntry,         1));  // Medium sub-sampling
     d->PNGOptions->setCompressionValue(group.readEntry(d->configPNGCompressionEntry,           9));
+    d->PNGOptions->setEncodingThreads(group.readEntry(d->configPNGEncodingThreadsEntry,        QThread::idealThreadCount()));
     d->TIFFOptions->setCompression(group.readEntry(d->configTIFFCompressionEntry,              false));
+    d->TIFFOptions->setEncodingThreads(group.readEntry(d->configTIFFEncodingThreadsEntry,      QThread::idealThreadCount()));
 #ifdef HAVE_JASPER
     d->JPEG2000Options->setCompressionValue(group.readEntry(d->configJPEG2000CompressionEntry, 75));
     d->JPEG2000Options->setLossLessCompression(group.readEntry(d->configJPEG2000LossLessEntry, true));